@@ -0,0 +1,229 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Minimal self-contained timing harness used by the woj::bitset benchmark suite
+
+namespace woj::bench
+{
+    /**
+     * Prevents the compiler from optimizing away the computation of value
+     * @param value Value that must be considered observable
+     */
+    template <typename T>
+    inline void do_not_optimize(const T& value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    /**
+     * Benchmark run options
+     */
+    struct options
+    {
+        /**
+         * Minimal measured time of a single benchmark case, in seconds
+         */
+        double min_time = 0.1;
+
+        /**
+         * Largest size (bit count) to run
+         */
+        std::size_t max_bits = std::size_t{ 1 } << 30;
+
+        /**
+         * Only cases whose name contains this string are run (empty runs everything)
+         */
+        std::string filter;
+
+        /**
+         * Path of the JSON report
+         */
+        std::string output = "bitset_bench.json";
+    };
+
+    /**
+     * Single measured benchmark case
+     */
+    struct result
+    {
+        std::string benchmark;
+        std::string implementation;
+        std::string block_type;
+        std::size_t bits = 0;
+        std::size_t param = 0;
+        std::size_t iterations = 0;
+        std::size_t ops_per_iteration = 1;
+        double ns_per_iteration = 0;
+        double ns_per_op = 0;
+        std::uint64_t checksum = 0;
+        bool valid = true;
+        bool consistent = true;
+    };
+
+    /**
+     * Runs benchmark cases, collects their results and writes them as JSON
+     */
+    class runner
+    {
+    public:
+        explicit runner(options opts) : m_options(std::move(opts)) {}
+
+        /**
+         * @return Options the runner was created with
+         */
+        [[nodiscard]] const options& opts() const noexcept { return m_options; }
+
+        /**
+         * Checks whenever the benchmark should run
+         * @param benchmark Name of the benchmark
+         * @param bits Size of the benchmarked set (bit count)
+         * @return true if the benchmark passes the size limit and the name filter
+         */
+        [[nodiscard]] bool enabled(const std::string& benchmark, const std::size_t bits) const noexcept
+        {
+            return bits <= m_options.max_bits && (m_options.filter.empty() || benchmark.find(m_options.filter) != std::string::npos);
+        }
+
+        /**
+         * Measures fn, repeating it until at least min_time seconds were spent in a single batch
+         * @param info Description of the case (timing fields are filled by the runner)
+         * @param fn Callable performing info.ops_per_iteration operations per call
+         * @return Reference to the stored result, the caller may attach checksum/validity to it
+         */
+        template <typename Fn>
+        result& run(result info, Fn&& fn)
+        {
+            using clock = std::chrono::steady_clock;
+
+            // Warm up caches and page in the memory touched by fn
+            fn();
+
+            std::size_t iterations = 1;
+            double elapsed = 0;
+            for (;;)
+            {
+                const auto start = clock::now();
+                for (std::size_t i = 0; i < iterations; ++i)
+                    fn();
+                elapsed = std::chrono::duration<double>(clock::now() - start).count();
+                if (elapsed >= m_options.min_time || iterations >= (std::size_t{ 1 } << 40))
+                    break;
+
+                // Aim slightly above min_time, but grow at most 10x per round
+                const double scale = elapsed > 0 ? m_options.min_time * 1.2 / elapsed : 10.0;
+                iterations = static_cast<std::size_t>(static_cast<double>(iterations) * (std::min)((std::max)(scale, 2.0), 10.0));
+            }
+
+            info.iterations = iterations;
+            info.ns_per_iteration = elapsed * 1e9 / static_cast<double>(iterations);
+            info.ns_per_op = info.ns_per_iteration / static_cast<double>(info.ops_per_iteration ? info.ops_per_iteration : 1);
+            std::fprintf(stderr, "%-28s %-24s %-9s %12zu %6zu %14.3f ns/op\n", info.benchmark.c_str(), info.implementation.c_str(), info.block_type.c_str(), info.bits, info.param, info.ns_per_op);
+            m_results.push_back(std::move(info));
+            return m_results.back();
+        }
+
+        /**
+         * Compares checksums of all implementations that ran the same (benchmark, bits, param) case
+         * @return Number of inconsistent results
+         */
+        std::size_t cross_check()
+        {
+            std::map<std::tuple<std::string, std::size_t, std::size_t>, std::uint64_t> reference;
+            std::size_t inconsistent = 0;
+            for (const result& r : m_results)
+                reference.emplace(std::make_tuple(r.benchmark, r.bits, r.param), r.checksum);
+            for (result& r : m_results)
+            {
+                r.consistent = reference[std::make_tuple(r.benchmark, r.bits, r.param)] == r.checksum;
+                if (!r.consistent || !r.valid)
+                {
+                    ++inconsistent;
+                    std::fprintf(stderr, "warning: %s/%s/%s/%zu/%zu produced %s result\n", r.benchmark.c_str(), r.implementation.c_str(), r.block_type.c_str(), r.bits, r.param, r.valid ? "a diverging" : "an invalid");
+                }
+            }
+            return inconsistent;
+        }
+
+        /**
+         * Writes all results as JSON
+         * @param os Stream to write to
+         * @param context Additional key/value pairs describing the run
+         */
+        void write_json(std::ostream& os, const std::vector<std::pair<std::string, std::string>>& context) const
+        {
+            os << "{\n  \"context\": {";
+            for (std::size_t i = 0; i < context.size(); ++i)
+                os << (i ? ",\n" : "\n") << "    \"" << escape(context[i].first) << "\": \"" << escape(context[i].second) << '"';
+            os << "\n  },\n  \"benchmarks\": [";
+            for (std::size_t i = 0; i < m_results.size(); ++i)
+            {
+                const result& r = m_results[i];
+                os << (i ? ",\n" : "\n")
+                    << "    {\"benchmark\": \"" << escape(r.benchmark)
+                    << "\", \"implementation\": \"" << escape(r.implementation)
+                    << "\", \"block_type\": \"" << escape(r.block_type)
+                    << "\", \"bits\": " << r.bits
+                    << ", \"param\": " << r.param
+                    << ", \"iterations\": " << r.iterations
+                    << ", \"ops_per_iteration\": " << r.ops_per_iteration
+                    << ", \"ns_per_iteration\": " << r.ns_per_iteration
+                    << ", \"ns_per_op\": " << r.ns_per_op
+                    << ", \"checksum\": " << r.checksum
+                    << ", \"valid\": " << (r.valid ? "true" : "false")
+                    << ", \"consistent\": " << (r.consistent ? "true" : "false") << '}';
+            }
+            os << "\n  ]\n}\n";
+        }
+
+    private:
+        static std::string escape(const std::string& str)
+        {
+            std::string result;
+            result.reserve(str.size());
+            for (const char c : str)
+            {
+                if (c == '"' || c == '\\')
+                    result += '\\';
+                result += c;
+            }
+            return result;
+        }
+
+        options m_options;
+        std::vector<result> m_results;
+    };
+
+    /**
+     * Deterministic 64-bit generator (splitmix64), so every implementation sees the same indices
+     */
+    class splitmix64
+    {
+    public:
+        explicit constexpr splitmix64(const std::uint64_t seed) noexcept : m_state(seed) {}
+
+        constexpr std::uint64_t operator()() noexcept
+        {
+            std::uint64_t z = m_state += 0x9e3779b97f4a7c15ull;
+            z = (z ^ z >> 30) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ z >> 27) * 0x94d049bb133111ebull;
+            return z ^ z >> 31;
+        }
+
+    private:
+        std::uint64_t m_state;
+    };
+}
@@ -0,0 +1,733 @@
+#include "bench.hpp"
+#include "woj/bitset.hpp"
+#include "woj/prime_sieve.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef WOJ_BENCH_BUILD_TYPE
+#define WOJ_BENCH_BUILD_TYPE "unknown"
+#endif
+
+namespace
+{
+    using woj::bench::result;
+    using woj::bench::runner;
+
+    // Sizes (bit count) every implementation is measured at, fixed-size sets need them at compile time
+    using bench_sizes = std::index_sequence<64, 1000, std::size_t{ 1 } << 16, std::size_t{ 1 } << 20, std::size_t{ 1 } << 24, std::size_t{ 1 } << 30>;
+
+    // Number of random indices used by the single-bit benchmarks
+    constexpr std::size_t random_ops = 4096;
+
+    // Steps used by the strided range benchmarks
+    constexpr std::size_t steps[] = { 2, 3, 7, 64, 100, 1000 };
+
+    // Largest set converted to/from strings (the string costs a byte per bit)
+    constexpr std::size_t string_limit = std::size_t{ 1 } << 24;
+
+    // Largest fixed-size set used by operators returning a new instance (the result lives on the stack)
+    constexpr std::size_t stack_copy_limit = std::size_t{ 1 } << 22;
+
+    // dynamic_bitset::push_back reallocates each time a block fills up, so the cost is quadratic
+    constexpr std::size_t push_back_limit = std::size_t{ 1 } << 20;
+
+    template <typename T>
+    std::string block_name()
+    {
+        return "uint" + std::to_string(sizeof(T) * CHAR_BIT) + "_t";
+    }
+
+    /**
+     * Operations shared by woj::bitset and woj::dynamic_bitset
+     * @tparam Set Full bitset type
+     */
+    template <typename Set>
+    struct woj_common
+    {
+        using set_type = Set;
+
+        static std::string block() { return block_name<typename Set::block_type>(); }
+        static std::unique_ptr<Set> copy(const Set& s) { return std::make_unique<Set>(s); }
+        static void set(Set& s, const std::size_t i) { s.set(i); }
+        static bool test(const Set& s, const std::size_t i) { return s.test(i); }
+        static void flip(Set& s, const std::size_t i) { s.flip(i); }
+        static void set_many(Set& s, const std::vector<std::size_t>& indices, const bool partition) { s.set_many(indices, partition); }
+        static void test_many(const Set& s, const std::vector<std::size_t>& indices, bool* results) { s.test_many(indices, results); }
+        static void fill_range(Set& s, const std::size_t b, const std::size_t e, const bool v) { s.fill_range(b, e, v); }
+        static void flip_range(Set& s, const std::size_t b, const std::size_t e) { s.flip_range(b, e); }
+        static void fill_range_step(Set& s, const std::size_t b, const std::size_t e, const std::size_t step, const bool v) { s.fill_range(b, e, step, v); }
+        static void flip_range_step(Set& s, const std::size_t b, const std::size_t e, const std::size_t step) { s.flip_range(b, e, step); }
+        static void shift_left(Set& s, const std::size_t n) { s <<= n; }
+        static void shift_right(Set& s, const std::size_t n) { s >>= n; }
+        static std::unique_ptr<Set> shift_left_copy(const Set& s, const std::size_t n) { return std::unique_ptr<Set>(new Set(s << n)); }
+        static std::size_t count(const Set& s) { return s.count(); }
+        static std::size_t count_range(const Set& s, const std::size_t b, const std::size_t e) { return s.count(b, e); }
+        static std::size_t hash(const Set& s) { return std::hash<Set>{}(s); }
+        static bool equal_numeric(const Set& s, const Set& o) { return s.compare_numeric(o) == 0; }
+        static bool equal_lexicographic(const Set& s, const Set& o) { return s.compare_lexicographic(o) == 0; }
+        static bool is_subset_of(const Set& s, const Set& o) { return s.is_subset_of(o); }
+        static bool intersects(const Set& s, const Set& o) { return s.intersects(o); }
+        static std::uint64_t get_bits(const Set& s, const std::size_t pos, const std::size_t len) { return s.get_bits(pos, len); }
+        static void set_bits(Set& s, const std::size_t pos, const std::size_t len, const std::uint64_t v) { s.set_bits(pos, len, v); }
+        static std::unique_ptr<Set> compress(const Set& s, const Set& mask) { return std::unique_ptr<Set>(new Set(s.compress(mask))); }
+        static std::unique_ptr<Set> expand(const Set& s, const Set& mask) { return std::unique_ptr<Set>(new Set(s.expand(mask))); }
+        static void bit_and(Set& s, const Set& o) { s &= o; }
+        static void bit_or(Set& s, const Set& o) { s |= o; }
+        static void bit_xor(Set& s, const Set& o) { s ^= o; }
+        static std::unique_ptr<Set> bit_not(const Set& s) { return std::unique_ptr<Set>(new Set(~s)); }
+        static std::unique_ptr<Set> from_string(const std::string& str, std::size_t) { return std::unique_ptr<Set>(new Set(str)); }
+
+        static std::size_t iterate(const Set& s)
+        {
+            std::size_t n = 0;
+            for (const bool bit : s)
+                n += bit;
+            return n;
+        }
+    };
+
+    template <typename BlockType, std::size_t Size>
+    struct woj_fixed : woj_common<woj::bitset<BlockType, Size>>
+    {
+        using set_type = woj::bitset<BlockType, Size>;
+        static constexpr std::size_t copy_limit = stack_copy_limit;
+
+        static std::string name() { return "woj::bitset"; }
+        static std::unique_ptr<set_type> make(std::size_t) { return std::make_unique<set_type>(); }
+        static std::string to_string(const set_type& s) { return s.to_string(); }
+    };
+
+    template <typename BlockType>
+    struct woj_dynamic : woj_common<woj::dynamic_bitset<BlockType>>
+    {
+        using set_type = woj::dynamic_bitset<BlockType>;
+        static constexpr std::size_t copy_limit = static_cast<std::size_t>(-1);
+
+        static std::string name() { return "woj::dynamic_bitset"; }
+        static std::unique_ptr<set_type> make(const std::size_t bits) { return std::make_unique<set_type>(bits); }
+
+        static std::string to_string(const set_type& s)
+        {
+            const std::unique_ptr<char[]> c_str(s.to_c_string());
+            return c_str.get();
+        }
+
+        static void resize(set_type& s, const std::size_t n) { s.resize(n); }
+        static void push_back(set_type& s, const bool v) { s.push_back(v); }
+    };
+
+    template <std::size_t Size>
+    struct std_bitset
+    {
+        using set_type = std::bitset<Size>;
+        static constexpr std::size_t copy_limit = stack_copy_limit;
+
+        static std::string name() { return "std::bitset"; }
+        static std::string block() { return "native"; }
+        static std::unique_ptr<set_type> make(std::size_t) { return std::make_unique<set_type>(); }
+        static std::unique_ptr<set_type> copy(const set_type& s) { return std::make_unique<set_type>(s); }
+        static void set(set_type& s, const std::size_t i) { s[i] = true; }
+        static bool test(const set_type& s, const std::size_t i) { return s[i]; }
+        static void flip(set_type& s, const std::size_t i) { s[i].flip(); }
+
+        static void fill_range(set_type& s, const std::size_t b, const std::size_t e, const bool v)
+        {
+            for (std::size_t i = b; i < e; ++i)
+                s[i] = v;
+        }
+
+        static void flip_range(set_type& s, const std::size_t b, const std::size_t e)
+        {
+            for (std::size_t i = b; i < e; ++i)
+                s[i].flip();
+        }
+
+        static void fill_range_step(set_type& s, const std::size_t b, const std::size_t e, const std::size_t step, const bool v)
+        {
+            for (std::size_t i = b; i < e; i += step)
+                s[i] = v;
+        }
+
+        static void flip_range_step(set_type& s, const std::size_t b, const std::size_t e, const std::size_t step)
+        {
+            for (std::size_t i = b; i < e; i += step)
+                s[i].flip();
+        }
+
+        static void shift_left(set_type& s, const std::size_t n) { s <<= n; }
+        static void shift_right(set_type& s, const std::size_t n) { s >>= n; }
+        static std::unique_ptr<set_type> shift_left_copy(const set_type& s, const std::size_t n) { return std::unique_ptr<set_type>(new set_type(s << n)); }
+        static std::size_t count(const set_type& s) { return s.count(); }
+
+        static std::size_t count_range(const set_type& s, const std::size_t b, const std::size_t e)
+        {
+            std::size_t n = 0;
+            for (std::size_t i = b; i < e; ++i)
+                n += s[i];
+            return n;
+        }
+
+        static std::size_t hash(const set_type& s) { return std::hash<set_type>{}(s); }
+
+        static bool is_subset_of(const set_type& s, const set_type& o)
+        {
+            const auto difference = std::make_unique<set_type>(o);
+            difference->flip();
+            *difference &= s;
+            return difference->none();
+        }
+
+        static bool intersects(const set_type& s, const set_type& o)
+        {
+            const auto intersection = std::make_unique<set_type>(o);
+            *intersection &= s;
+            return intersection->any();
+        }
+        static void bit_and(set_type& s, const set_type& o) { s &= o; }
+        static void bit_or(set_type& s, const set_type& o) { s |= o; }
+        static void bit_xor(set_type& s, const set_type& o) { s ^= o; }
+        static std::unique_ptr<set_type> bit_not(const set_type& s) { return std::unique_ptr<set_type>(new set_type(~s)); }
+        static std::string to_string(const set_type& s) { return s.to_string(); }
+        static std::unique_ptr<set_type> from_string(const std::string& str, std::size_t) { return std::unique_ptr<set_type>(new set_type(str)); }
+
+        static std::size_t iterate(const set_type& s)
+        {
+            std::size_t n = 0;
+            for (std::size_t i = 0; i < Size; ++i)
+                n += s[i];
+            return n;
+        }
+    };
+
+    struct std_vector_bool
+    {
+        using set_type = std::vector<bool>;
+        static constexpr std::size_t copy_limit = static_cast<std::size_t>(-1);
+
+        static std::string name() { return "std::vector<bool>"; }
+        static std::string block() { return "native"; }
+        static std::unique_ptr<set_type> make(const std::size_t bits) { return std::make_unique<set_type>(bits); }
+        static std::unique_ptr<set_type> copy(const set_type& s) { return std::make_unique<set_type>(s); }
+        static void set(set_type& s, const std::size_t i) { s[i] = true; }
+        static bool test(const set_type& s, const std::size_t i) { return s[i]; }
+        static void flip(set_type& s, const std::size_t i) { s[i].flip(); }
+        static void fill_range(set_type& s, const std::size_t b, const std::size_t e, const bool v) { std::fill(s.begin() + b, s.begin() + e, v); }
+
+        static void flip_range(set_type& s, const std::size_t b, const std::size_t e)
+        {
+            for (std::size_t i = b; i < e; ++i)
+                s[i].flip();
+        }
+
+        static void fill_range_step(set_type& s, const std::size_t b, const std::size_t e, const std::size_t step, const bool v)
+        {
+            for (std::size_t i = b; i < e; i += step)
+                s[i] = v;
+        }
+
+        static void flip_range_step(set_type& s, const std::size_t b, const std::size_t e, const std::size_t step)
+        {
+            for (std::size_t i = b; i < e; i += step)
+                s[i].flip();
+        }
+
+        static std::size_t count(const set_type& s) { return static_cast<std::size_t>(std::count(s.begin(), s.end(), true)); }
+        static std::size_t count_range(const set_type& s, const std::size_t b, const std::size_t e) { return static_cast<std::size_t>(std::count(s.begin() + b, s.begin() + e, true)); }
+        static std::size_t hash(const set_type& s) { return std::hash<set_type>{}(s); }
+
+        static bool is_subset_of(const set_type& s, const set_type& o)
+        {
+            for (std::size_t i = 0; i < s.size(); ++i)
+                if (s[i] && !o[i])
+                    return false;
+            return true;
+        }
+
+        static bool intersects(const set_type& s, const set_type& o)
+        {
+            for (std::size_t i = 0; i < s.size(); ++i)
+                if (s[i] && o[i])
+                    return true;
+            return false;
+        }
+
+        static std::string to_string(const set_type& s)
+        {
+            std::string result(s.size(), '0');
+            for (std::size_t i = 0; i < s.size(); ++i)
+                if (s[i])
+                    result[i] = '1';
+            return result;
+        }
+
+        static std::unique_ptr<set_type> from_string(const std::string& str, const std::size_t bits)
+        {
+            auto result = std::make_unique<set_type>(bits);
+            for (std::size_t i = 0; i < bits; ++i)
+                (*result)[i] = str[i] == '1';
+            return result;
+        }
+
+        static std::size_t iterate(const set_type& s)
+        {
+            std::size_t n = 0;
+            for (const bool bit : s)
+                n += bit;
+            return n;
+        }
+
+        static void resize(set_type& s, const std::size_t n) { s.resize(n); }
+        static void push_back(set_type& s, const bool v) { s.push_back(v); }
+    };
+
+    /**
+     * Position-sensitive digest of a set, identical for every implementation holding the same bits
+     */
+    template <typename Impl>
+    std::uint64_t digest(const typename Impl::set_type& s, const std::vector<std::size_t>& samples)
+    {
+        std::uint64_t hash = Impl::count(s);
+        for (const std::size_t i : samples)
+            hash = hash * 0x100000001b3ull ^ (Impl::test(s, i) ? i + 1 : 0);
+        return hash;
+    }
+
+    /**
+     * Runs every benchmark supported by Impl at the given size
+     * @tparam Impl Adapter describing the implementation
+     * @param r Runner collecting the results
+     * @param bits Size of the benchmarked sets (bit count)
+     */
+    template <typename Impl>
+    void run_suite(runner& r, const std::size_t bits)
+    {
+        using set_type = typename Impl::set_type;
+
+        if (bits > r.opts().max_bits)
+            return;
+
+        // Same pseudo-random content and indices for every implementation
+        std::vector<std::size_t> indices(random_ops);
+        {
+            woj::bench::splitmix64 rng(bits);
+            for (std::size_t& i : indices)
+                i = static_cast<std::size_t>(rng() % bits);
+        }
+
+        const std::unique_ptr<set_type> seed = Impl::make(bits);
+        const std::unique_ptr<set_type> operand = Impl::make(bits);
+        {
+            woj::bench::splitmix64 rng(~bits);
+            std::uint64_t word = 0;
+            for (std::size_t i = 0; i < bits; ++i)
+            {
+                if (!(i % 64))
+                    word = rng();
+                if (word >> i % 64 & 1)
+                    Impl::set(*seed, i);
+                if (word >> (i + 17) % 64 & 1)
+                    Impl::set(*operand, i);
+            }
+        }
+
+        const auto info = [&](const char* benchmark, const std::size_t ops, const std::size_t param = 0)
+        {
+            result res;
+            res.benchmark = benchmark;
+            res.implementation = Impl::name();
+            res.block_type = Impl::block();
+            res.bits = bits;
+            res.param = param;
+            res.ops_per_iteration = ops ? ops : 1;
+            return res;
+        };
+
+        // Times op on a copy of the seed, then applies it once to a fresh copy for the checksum
+        const auto measure = [&](result res, auto&& op)
+        {
+            if (!r.enabled(res.benchmark, bits))
+                return;
+            const std::unique_ptr<set_type> state = Impl::copy(*seed);
+            result& stored = r.run(std::move(res), [&] { woj::bench::do_not_optimize(op(*state)); });
+            const std::unique_ptr<set_type> check = Impl::copy(*seed);
+            const std::uint64_t value = op(*check);
+            stored.checksum = digest<Impl>(*check, indices) ^ value;
+        };
+
+        const std::size_t begin = (std::min)(bits, std::size_t{ 3 });
+        const std::size_t end = bits - (std::min)(bits - begin, std::size_t{ 5 });
+
+        // Single bit access
+        measure(info("set_random", random_ops), [&](set_type& s) { for (const std::size_t i : indices) Impl::set(s, i); return std::uint64_t{ 0 }; });
+        measure(info("test_random", random_ops), [&](set_type& s)
+        {
+            std::uint64_t n = 0;
+            for (const std::size_t i : indices)
+                n += Impl::test(s, i);
+            return n;
+        });
+        measure(info("flip_random", random_ops), [&](set_type& s) { for (const std::size_t i : indices) Impl::flip(s, i); return std::uint64_t{ 0 }; });
+
+        // Batched single bit access
+        if constexpr (requires(set_type& s, bool* results) { Impl::set_many(s, indices, false); Impl::test_many(s, indices, results); })
+        {
+            const std::unique_ptr<bool[]> results(new bool[indices.size()]);
+            measure(info("set_many", random_ops), [&](set_type& s) { Impl::set_many(s, indices, false); return std::uint64_t{ 0 }; });
+            measure(info("set_many_partitioned", random_ops), [&](set_type& s) { Impl::set_many(s, indices, true); return std::uint64_t{ 0 }; });
+            measure(info("test_many", random_ops), [&](set_type& s)
+            {
+                Impl::test_many(s, indices, results.get());
+                return static_cast<std::uint64_t>(std::count(results.get(), results.get() + indices.size(), true));
+            });
+        }
+
+        // Contiguous ranges with unaligned edges
+        measure(info("set_range", end - begin), [&](set_type& s) { Impl::fill_range(s, begin, end, true); return std::uint64_t{ 0 }; });
+        measure(info("reset_range", end - begin), [&](set_type& s) { Impl::fill_range(s, begin, end, false); return std::uint64_t{ 0 }; });
+        measure(info("flip_range", end - begin), [&](set_type& s) { Impl::flip_range(s, begin, end); return std::uint64_t{ 0 }; });
+
+        // Strided ranges
+        for (const std::size_t step : steps)
+        {
+            const std::size_t touched = (end - begin + step - 1) / step;
+            measure(info("fill_range_step", touched, step), [&](set_type& s) { Impl::fill_range_step(s, begin, end, step, true); return std::uint64_t{ 0 }; });
+            measure(info("flip_range_step", touched, step), [&](set_type& s) { Impl::flip_range_step(s, begin, end, step); return std::uint64_t{ 0 }; });
+        }
+
+        // Shifts
+        if constexpr (requires(set_type& s) { Impl::shift_left(s, 1); })
+        {
+            measure(info("shift_left", bits, 13), [&](set_type& s) { Impl::shift_left(s, 13); return std::uint64_t{ 0 }; });
+            measure(info("shift_right", bits, 13), [&](set_type& s) { Impl::shift_right(s, 13); return std::uint64_t{ 0 }; });
+            if (bits <= Impl::copy_limit)
+                measure(info("shift_left_copy", bits, 13), [&](set_type& s) { return static_cast<std::uint64_t>(Impl::count(*Impl::shift_left_copy(s, 13))); });
+        }
+
+        // Population count
+        measure(info("count", bits), [&](set_type& s) { return static_cast<std::uint64_t>(Impl::count(s)); });
+        measure(info("count_range", end - begin), [&](set_type& s) { return static_cast<std::uint64_t>(Impl::count_range(s, begin, end)); });
+
+        // Three-way comparison against an equal set (worst case, every block is compared)
+        if constexpr (requires(const set_type& s) { Impl::equal_numeric(s, s); })
+        {
+            measure(info("compare_numeric", bits), [&](set_type& s) { return static_cast<std::uint64_t>(Impl::equal_numeric(s, *seed)); });
+            measure(info("compare_lexicographic", bits), [&](set_type& s) { return static_cast<std::uint64_t>(Impl::equal_lexicographic(s, *seed)); });
+        }
+
+        // Set predicates, worst cases (the whole set is scanned)
+        if constexpr (requires(const set_type& s) { Impl::is_subset_of(s, s); Impl::intersects(s, s); })
+        {
+            const std::unique_ptr<set_type> complement = Impl::copy(*seed);
+            Impl::flip_range(*complement, 0, bits);
+            measure(info("is_subset_of", bits), [&](set_type& s) { return static_cast<std::uint64_t>(Impl::is_subset_of(s, *seed)); });
+            measure(info("intersects", bits), [&](set_type& s) { return static_cast<std::uint64_t>(Impl::intersects(s, *complement)); });
+        }
+
+        // Unaligned multi-bit fields
+        if constexpr (requires(set_type& s) { Impl::set_bits(s, 0, 1, Impl::get_bits(s, 0, 1)); })
+        {
+            const std::size_t len = (std::min)(bits, std::size_t{ 37 });
+            measure(info("get_bits_random", random_ops, len), [&](set_type& s)
+            {
+                std::uint64_t n = 0;
+                for (const std::size_t i : indices)
+                    n += Impl::get_bits(s, (std::min)(i, bits - len), len);
+                return n;
+            });
+            measure(info("set_bits_random", random_ops, len), [&](set_type& s) { for (const std::size_t i : indices) Impl::set_bits(s, (std::min)(i, bits - len), len, i * 0x9e3779b97f4a7c15ull); return std::uint64_t{ 0 }; });
+        }
+
+        // Parallel bit extract/deposit by a random mask
+        if constexpr (requires(const set_type& s) { Impl::compress(s, s); Impl::expand(s, s); })
+        {
+            if (bits <= Impl::copy_limit)
+            {
+                measure(info("compress", bits), [&](set_type& s) { return static_cast<std::uint64_t>(Impl::count(*Impl::compress(s, *operand))); });
+                measure(info("expand", bits), [&](set_type& s) { return static_cast<std::uint64_t>(Impl::count(*Impl::expand(s, *operand))); });
+            }
+        }
+
+        // Hashing (hash values differ between implementations, only the cost is compared)
+        measure(info("hash", bits), [&](set_type& s) { woj::bench::do_not_optimize(Impl::hash(s)); return std::uint64_t{ 0 }; });
+
+        // Bitwise operations
+        if constexpr (requires(set_type& s) { Impl::bit_and(s, s); })
+        {
+            measure(info("and", bits), [&](set_type& s) { Impl::bit_and(s, *operand); return std::uint64_t{ 0 }; });
+            measure(info("or", bits), [&](set_type& s) { Impl::bit_or(s, *operand); return std::uint64_t{ 0 }; });
+            measure(info("xor", bits), [&](set_type& s) { Impl::bit_xor(s, *operand); return std::uint64_t{ 0 }; });
+            if (bits <= Impl::copy_limit)
+                measure(info("not", bits), [&](set_type& s) { return static_cast<std::uint64_t>(Impl::count(*Impl::bit_not(s))); });
+        }
+
+        // String conversion
+        if (bits <= string_limit)
+        {
+            measure(info("to_string", bits), [&](set_type& s)
+            {
+                const std::string str = Impl::to_string(s);
+                return static_cast<std::uint64_t>(std::count(str.begin(), str.end(), '1'));
+            });
+
+            const std::string str = Impl::to_string(*seed);
+            measure(info("from_string", bits), [&](set_type&) { return digest<Impl>(*Impl::from_string(str, bits), indices); });
+        }
+
+        // Iteration
+        measure(info("iterate", bits), [&](set_type& s) { return static_cast<std::uint64_t>(Impl::iterate(s)); });
+
+        // Growth
+        if constexpr (requires(set_type& s) { Impl::resize(s, 1); Impl::push_back(s, true); })
+        {
+            measure(info("resize", bits), [&](set_type&)
+            {
+                set_type s;
+                Impl::resize(s, bits);
+                Impl::resize(s, bits / 2);
+                return static_cast<std::uint64_t>(s.size());
+            });
+            if (bits <= push_back_limit)
+            {
+                measure(info("push_back", bits), [&](set_type&)
+                {
+                    set_type s;
+                    for (std::size_t i = 0; i < bits; ++i)
+                        Impl::push_back(s, i % 3 == 0);
+                    return static_cast<std::uint64_t>(Impl::count(s));
+                });
+            }
+        }
+    }
+
+    template <typename BlockType, std::size_t... Sizes>
+    void run_woj(runner& r, std::index_sequence<Sizes...>)
+    {
+        (run_suite<woj_fixed<BlockType, Sizes>>(r, Sizes), ...);
+        (run_suite<woj_dynamic<BlockType>>(r, Sizes), ...);
+    }
+
+    template <std::size_t... Sizes>
+    void run_std(runner& r, std::index_sequence<Sizes...>)
+    {
+        (run_suite<std_bitset<Sizes>>(r, Sizes), ...);
+        (run_suite<std_vector_bool>(r, Sizes), ...);
+    }
+
+    /**
+     * Counts primes with the segmented sieve, a stress test of the strided reset_range kernel
+     * @param r Runner collecting the results
+     */
+    void run_sieve(runner& r)
+    {
+        for (const std::uint64_t limit : { std::uint64_t{ 10000000 }, std::uint64_t{ 1000000000 } })
+        {
+            for (const unsigned threads : { 1u, 0u })
+            {
+                result info;
+                info.benchmark = threads == 1 ? "prime_sieve" : "prime_sieve_threads";
+                info.implementation = "woj::prime_sieve";
+                info.block_type = block_name<std::uint64_t>();
+                info.bits = static_cast<std::size_t>(limit / 2);
+                info.param = threads;
+                info.ops_per_iteration = info.bits;
+                if (!r.enabled(info.benchmark, info.bits))
+                    continue;
+
+                const woj::prime_sieve sieve(limit);
+                result& stored = r.run(std::move(info), [&] { woj::bench::do_not_optimize(sieve.count(threads)); });
+                stored.checksum = sieve.count(threads);
+            }
+        }
+    }
+
+    /**
+     * Multiplies and transposes random square bit_matrix instances (bits is the element count, param the dimension)
+     * @param r Runner collecting the results
+     */
+    void run_matrix(runner& r)
+    {
+        for (const std::size_t size : { std::size_t{ 1024 }, std::size_t{ 8192 } })
+        {
+            const std::size_t bits = size * size;
+            if (!r.enabled("matrix_multiply", bits) && !r.enabled("matrix_transpose", bits))
+                continue;
+
+            woj::bench::splitmix64 random(size);
+            woj::bit_matrix<std::uint64_t> lhs(size, size), rhs(size, size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                for (std::size_t j = 0; j < size / 64; ++j)
+                {
+                    lhs[i].get_block(j) = random();
+                    rhs[i].get_block(j) = random();
+                }
+            }
+            const auto count = [](const woj::bit_matrix<std::uint64_t>& matrix) {
+                std::uint64_t total = 0;
+                for (std::size_t i = 0; i < matrix.rows(); ++i)
+                    total += matrix[i].count();
+                return total;
+            };
+
+            result info;
+            info.implementation = "woj::bit_matrix";
+            info.block_type = block_name<std::uint64_t>();
+            info.bits = bits;
+            info.param = size;
+
+            info.benchmark = "matrix_multiply";
+            if (r.enabled(info.benchmark, bits))
+            {
+                result& stored = r.run(info, [&] { woj::bench::do_not_optimize((lhs * rhs).rows()); });
+                stored.checksum = count(lhs * rhs);
+            }
+
+            info.benchmark = "matrix_transpose";
+            if (r.enabled(info.benchmark, bits))
+            {
+                result& stored = r.run(info, [&] { woj::bench::do_not_optimize(lhs.transpose().rows()); });
+                stored.checksum = count(lhs.transpose());
+            }
+        }
+    }
+
+    /**
+     * Queries a blocked_bloom_filter holding 20M keys at 10 bits per key with as many absent keys, batched and one at a time
+     * (bits is the filter size, param the key count, the checksum is the count of false positives)
+     * @param r Runner collecting the results
+     */
+    void run_bloom(runner& r)
+    {
+        constexpr std::size_t keys = 20000000;
+        constexpr std::size_t bits_per_key = 10;
+        if (!r.enabled("bloom_contains_many", keys * bits_per_key) && !r.enabled("bloom_contains", keys * bits_per_key))
+            return;
+
+        woj::bench::splitmix64 random(keys);
+        std::vector<std::uint64_t> present(keys), absent(keys);
+        for (std::size_t i = 0; i < keys; ++i)
+        {
+            present[i] = random();
+            absent[i] = random();
+        }
+        auto filter = woj::blocked_bloom_filter::for_keys(keys, bits_per_key);
+        filter.insert_many(present);
+
+        const std::size_t false_positives = filter.contains_many(absent);
+        std::fprintf(stderr, "blocked_bloom_filter: %zu keys, %zu bits per key, %.3f%% false positives\n", keys, bits_per_key, 100.0 * static_cast<double>(false_positives) / keys);
+
+        result info;
+        info.implementation = "woj::blocked_bloom_filter";
+        info.block_type = block_name<std::uint64_t>();
+        info.bits = filter.size();
+        info.param = keys;
+        info.ops_per_iteration = keys;
+
+        info.benchmark = "bloom_contains_many";
+        if (r.enabled(info.benchmark, info.bits))
+            r.run(info, [&] { woj::bench::do_not_optimize(filter.contains_many(absent)); }).checksum = false_positives;
+
+        info.benchmark = "bloom_contains";
+        if (r.enabled(info.benchmark, info.bits))
+        {
+            r.run(info, [&] {
+                std::size_t found = 0;
+                for (const std::uint64_t key : absent)
+                    found += filter.contains(std::hash<std::uint64_t>{}(key));
+                woj::bench::do_not_optimize(found);
+            }).checksum = false_positives;
+        }
+    }
+
+    std::string compiler_name()
+    {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc " + std::to_string(_MSC_VER);
+#else
+        return "unknown";
+#endif
+    }
+
+    void usage(const char* argv0)
+    {
+        std::fprintf(stderr,
+            "usage: %s [--min-time seconds] [--max-bits n] [--filter name] [--out file.json]\n"
+            "  --min-time  minimal measured time per case (default 0.1)\n"
+            "  --max-bits  skip sizes above n bits (default 1073741824)\n"
+            "  --filter    only run benchmarks whose name contains the string\n"
+            "  --out       path of the JSON report (default bitset_bench.json)\n", argv0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    woj::bench::options opts;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (i + 1 < argc && arg == "--min-time")
+            opts.min_time = std::strtod(argv[++i], nullptr);
+        else if (i + 1 < argc && arg == "--max-bits")
+            opts.max_bits = std::strtoull(argv[++i], nullptr, 10);
+        else if (i + 1 < argc && arg == "--filter")
+            opts.filter = argv[++i];
+        else if (i + 1 < argc && arg == "--out")
+            opts.output = argv[++i];
+        else
+        {
+            usage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    runner r(opts);
+    run_woj<uint8_t>(r, bench_sizes{});
+    run_woj<uint16_t>(r, bench_sizes{});
+    run_woj<uint32_t>(r, bench_sizes{});
+    run_woj<uint64_t>(r, bench_sizes{});
+#if defined(__SIZEOF_INT128__)
+    run_woj<woj::uint128_block>(r, bench_sizes{});
+#endif
+    run_std(r, bench_sizes{});
+    run_sieve(r);
+    run_matrix(r);
+    run_bloom(r);
+
+    const std::size_t inconsistent = r.cross_check();
+
+    char date[32] = {};
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    std::ofstream out(opts.output);
+    if (!out)
+    {
+        std::fprintf(stderr, "error: cannot open %s\n", opts.output.c_str());
+        return 1;
+    }
+    r.write_json(out, {
+        { "date", date },
+        { "compiler", compiler_name() },
+        { "build_type", WOJ_BENCH_BUILD_TYPE },
+        { "min_time", std::to_string(opts.min_time) },
+        { "max_bits", std::to_string(opts.max_bits) },
+        { "filter", opts.filter },
+        { "inconsistent_results", std::to_string(inconsistent) }
+    });
+    std::fprintf(stderr, "wrote %s\n", opts.output.c_str());
+    return 0;
+}
@@ -7,18 +7,49 @@
 #include <utility>
 #include <new>
 #include <cstring>
+#include <climits>
+#include <string>
 #include <type_traits>
+#include <functional>
+#include <compare>
+#include <bit>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <vector>
+#include <array>
+#include <bitset>
+#include <iterator>
+#include <memory>
+#include <atomic>
+#include <ranges>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
 
 // Note: (std::numeric_limits<BlockType>::max)() is used instead of std::numeric_limits<BlockType>::max() because Windows.h defines a macro max which conflicts with std::numeric_limits<BlockType>::max()
 
 namespace woj
 {
+#if defined(__SIZEOF_INT128__)
+    /**
+     * 128-bit unsigned block type, __extension__ keeps -Wpedantic quiet in translation units that never use it
+     */
+    __extension__ typedef unsigned __int128 uint128_block;
+#endif
+
     /**
 	 * check if type is unsigned integer
 	 * @tparam T Type to check
 	 */
     template <typename T>
-    concept unsigned_integer = std::is_unsigned_v<T> && std::is_integral_v<T> && !std::is_const_v<T> && !std::is_same_v<bool, T> && /* to suppress warnings */ !std::is_pointer_v<T> && !std::is_reference_v<T>;
+    concept unsigned_integer = std::is_unsigned_v<T> && std::is_integral_v<T> && !std::is_const_v<T> && !std::is_same_v<bool, T> && /* to suppress warnings */ !std::is_pointer_v<T> && !std::is_reference_v<T>
+#if defined(__SIZEOF_INT128__)
+        // Strict ISO modes do not classify the 128-bit extension as integral, the block helpers handle it either way
+        || std::is_same_v<T, uint128_block>
+#endif
+        ;
     
     /**
      * Check if type is character
@@ -30,1020 +61,2017 @@ namespace woj
         std::is_same_v<T, char16_t> ||
         std::is_same_v<T, char32_t>;
 
-    /**
-     * Fixed-size BitSet class
-     * @tparam BlockType Type of block to use for bit storage (may be one of unsigned integer types)
-     * @tparam Size Size of bitset, in bits
-     */
-    template <unsigned_integer BlockType, std::size_t Size>
-    class bitset
+    namespace detail
     {
-    public:
-        template <unsigned_integer BlockType, std::size_t Size>
-        friend std::ostream& operator<<(std::ostream& os, const bitset<BlockType, Size>& obj)
+        /**
+         * Counts the set bits of a block
+         * std::popcount and friends reject unsigned __int128 in strict ISO modes, so 128-bit blocks are split in halves
+         * @tparam BlockType Type of the block
+         * @param block Block to count the bits of
+         * @return Count of set bits
+         */
+        template <typename BlockType>
+        [[nodiscard]] constexpr int popcount(const BlockType block) noexcept
         {
-            for (size_type i = 0; i < Size; ++i)
-                os << obj.test(i);
-            return os;
+#if defined(__SIZEOF_INT128__)
+            if constexpr (std::is_same_v<BlockType, uint128_block>)
+                return std::popcount(static_cast<std::uint64_t>(block)) + std::popcount(static_cast<std::uint64_t>(block >> 64));
+            else
+#endif
+                return std::popcount(block);
         }
 
-        // Type definitions
-
-        // Reference types
-        class reference;
-        typedef bool const_reference;
-
-        // Iterators
-        class iterator;
-        class const_iterator;
-
-        // Reverse iterators
-        class reverse_iterator;
-        class const_reverse_iterator;
-
-        // Value types
-        typedef bool value_type;
-        typedef bool const_value_type;
+        /**
+         * Counts the zero bits below the lowest set bit of a block
+         * @tparam BlockType Type of the block
+         * @param block Block to scan
+         * @return Count of trailing zero bits, the block size if the block is zero
+         */
+        template <typename BlockType>
+        [[nodiscard]] constexpr int countr_zero(const BlockType block) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            if constexpr (std::is_same_v<BlockType, uint128_block>)
+                return static_cast<std::uint64_t>(block) ? std::countr_zero(static_cast<std::uint64_t>(block)) : 64 + std::countr_zero(static_cast<std::uint64_t>(block >> 64));
+            else
+#endif
+                return std::countr_zero(block);
+        }
 
-        // Other types
-        typedef std::size_t size_type;
-        typedef size_type difference_type;
-    	typedef BlockType block_type;
+        /**
+         * Counts the zero bits above the highest set bit of a block
+         * @tparam BlockType Type of the block
+         * @param block Block to scan
+         * @return Count of leading zero bits, the block size if the block is zero
+         */
+        template <typename BlockType>
+        [[nodiscard]] constexpr int countl_zero(const BlockType block) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            if constexpr (std::is_same_v<BlockType, uint128_block>)
+                return static_cast<std::uint64_t>(block >> 64) ? std::countl_zero(static_cast<std::uint64_t>(block >> 64)) : 64 + std::countl_zero(static_cast<std::uint64_t>(block));
+            else
+#endif
+                return std::countl_zero(block);
+        }
 
-        class reference
+        /**
+         * Multiplies two 64-bit values and folds the 128-bit product into 64 bits
+         * @param a First factor
+         * @param b Second factor
+         * @return Low half of the product XOR high half of the product
+         */
+        [[nodiscard]] constexpr std::uint64_t hash_multiply_fold(const std::uint64_t a, const std::uint64_t b) noexcept
         {
-        public:
-            // Reference types
+#if defined(__SIZEOF_INT128__)
+            const uint128_block product = static_cast<uint128_block>(a) * b;
+            return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+            const std::uint64_t a_lo = a & 0xffffffffu, a_hi = a >> 32;
+            const std::uint64_t b_lo = b & 0xffffffffu, b_hi = b >> 32;
+            const std::uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+            const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffffu) + lo_hi;
+            return (cross << 32 | (lo_lo & 0xffffffffu)) ^ (hi_hi + (hi_lo >> 32) + (cross >> 32));
+#endif
+        }
 
+        /**
+         * Unaligned 64-bit load
+         * @param data Pointer to at least 8 readable bytes
+         * @return Loaded value (native byte order)
+         */
+        [[nodiscard]] constexpr std::uint64_t hash_load(const unsigned char* data) noexcept
+        {
+            if (std::is_constant_evaluated())
+            {
+                std::uint64_t value = 0;
+                for (std::size_t i = 0; i < sizeof(value); ++i)
+                    value |= std::uint64_t{ data[i] } << 8 * (std::endian::native == std::endian::little ? i : sizeof(value) - 1 - i);
+                return value;
+            }
 
-            /**
-             * Empty constructor (only here to allow for some concepts to be executed)
-             */
-            constexpr reference() noexcept : m_bitset(*static_cast<bitset*>(nullptr)), m_index(*static_cast<size_type*>(nullptr)) {}
+            std::uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
 
-            /**
-             * Constructs a new reference instance based on the specified bitset and index
-             * @param bitset The bitset instance to iterate over
-             * @param index Index of the bit to start the iteration from (bit index)
-             */
-            constexpr reference(bitset& bitset, const size_type& index) noexcept : m_bitset(bitset), m_index(index) {}
+        /**
+         * Secret constants of hash_bytes
+         */
+        inline constexpr std::uint64_t hash_secret[8] = {
+            0x9e3779b97f4a7c15ull, 0xc2b2ae3d27d4eb4full, 0x165667b19e3779f9ull, 0xd6e8feb86659fd93ull,
+            0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+        };
 
-            /**
-             * Copy constructor
-             */
-            constexpr reference(const reference&) noexcept = default;
+        /**
+         * Count of 64-byte stripes between two scrambles of the hash_bytes accumulators
+         */
+        inline constexpr std::size_t hash_stripes_per_scramble = 16;
 
-            /**
-             * Destructor
-             */
-            constexpr ~reference() noexcept = default;
+        /**
+         * Portable version of hash_accumulate, also used in constant evaluation
+         * @param accumulator Lane accumulators
+         * @param bytes Pointer to the stripes
+         * @param stripes Count of stripes to consume
+         */
+        constexpr void hash_accumulate_scalar(std::uint64_t (&accumulator)[8], const unsigned char* bytes, const std::size_t stripes) noexcept
+        {
+            std::uint64_t key[8];
+            for (std::size_t lane = 0; lane < 8; ++lane)
+                key[lane] = hash_secret[lane];
 
-            /**
-             * Bool conversion operator
-             * @return Value at current index (bit value)
-             */
-            [[nodiscard]] constexpr operator bool() const noexcept
+            for (std::size_t stripe = 1; stripe <= stripes; ++stripe, bytes += 64)
             {
-                return m_bitset.test(m_index);
+                std::uint64_t value[8];
+                for (std::size_t lane = 0; lane < 8; ++lane)
+                    value[lane] = hash_load(bytes + 8 * lane);
+                for (std::size_t lane = 0; lane < 8; ++lane)
+                {
+                    const std::uint64_t keyed = value[lane] ^ key[lane];
+                    accumulator[lane] += value[lane ^ 1] + (keyed & 0xffffffffu) * (keyed >> 32);
+                    key[lane] += hash_secret[7 - lane];
+                }
+                if (!(stripe % hash_stripes_per_scramble))
+                {
+                    for (std::size_t lane = 0; lane < 8; ++lane)
+                        accumulator[lane] = (accumulator[lane] ^ accumulator[lane] >> 47 ^ hash_secret[7 - lane]) * 0x9e3779b1u;
+                }
             }
+        }
 
-            /**
-             * Assignment operator
-             * @param value Value to set the bit to (bit value)
-             */
-            constexpr reference& operator=(const bool value) noexcept
+        /**
+         * Bulk loop of hash_bytes, consumes 64-byte stripes with eight independent 64-bit lanes
+         * Each lane adds its neighbour's input word and a 32x32->64 bit product of its own keyed word, the keys
+         * advance by a Weyl sequence each stripe, so equal words in different stripes mix differently.
+         * Every lane operation maps to a single SIMD instruction, an SSE2/AVX2 version is used when available.
+         * @param accumulator Lane accumulators
+         * @param bytes Pointer to the stripes
+         * @param stripes Count of stripes to consume
+         */
+        constexpr void hash_accumulate(std::uint64_t (&accumulator)[8], const unsigned char* bytes, const std::size_t stripes) noexcept
+        {
+            if (std::is_constant_evaluated())
             {
-                m_bitset.set(m_index, value);
-                return *this;
+                hash_accumulate_scalar(accumulator, bytes, stripes);
+                return;
             }
-
-            /**
-             * Assignment operator
-             * @param other Other reference instance to copy from
-             */
-        	constexpr reference& operator=(const reference& other) noexcept
+#if defined(__AVX2__)
+            __m256i acc[2], key[2], step[2], scramble[2];
+            for (std::size_t i = 0; i < 2; ++i)
             {
-                m_bitset.set(m_index, other.m_bitset.test(other.m_index));
-                return *this;
+                acc[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulator + 4 * i));
+                key[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hash_secret + 4 * i));
+                step[i] = _mm256_set_epi64x(hash_secret[4 - 4 * i], hash_secret[5 - 4 * i], hash_secret[6 - 4 * i], hash_secret[7 - 4 * i]);
+                scramble[i] = step[i];
             }
-
-            /**
-             * Bitwise AND assignment operator
-             * @param value Value to AND the bit with (bit value)
-             */
-            constexpr reference& operator&=(const bool value) const noexcept
+            const __m256i prime = _mm256_set1_epi64x(0x9e3779b1);
+            for (std::size_t stripe = 1; stripe <= stripes; ++stripe, bytes += 64)
             {
-                m_bitset.set(m_index, m_bitset.test(m_index) & value);
-                return *this;
+                for (std::size_t i = 0; i < 2; ++i)
+                {
+                    const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + 32 * i));
+                    const __m256i keyed = _mm256_xor_si256(value, key[i]);
+                    const __m256i product = _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));
+                    acc[i] = _mm256_add_epi64(acc[i], _mm256_add_epi64(_mm256_shuffle_epi32(value, 0x4e), product));
+                    key[i] = _mm256_add_epi64(key[i], step[i]);
+                }
+                if (!(stripe % hash_stripes_per_scramble))
+                {
+                    for (std::size_t i = 0; i < 2; ++i)
+                    {
+                        const __m256i mixed = _mm256_xor_si256(_mm256_xor_si256(acc[i], _mm256_srli_epi64(acc[i], 47)), scramble[i]);
+                        acc[i] = _mm256_add_epi64(_mm256_mul_epu32(mixed, prime), _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(mixed, 32), prime), 32));
+                    }
+                }
             }
-
-            /**
-             * Bitwise OR assignment operator
-             * @param value Value to OR the bit with (bit value)
-             */
-            constexpr reference& operator|=(const bool value) const noexcept
+            for (std::size_t i = 0; i < 2; ++i)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulator + 4 * i), acc[i]);
+#elif defined(__SSE2__) || defined(_M_X64)
+            __m128i acc[4], key[4], step[4], scramble[4];
+            for (std::size_t i = 0; i < 4; ++i)
             {
-                m_bitset.set(m_index, m_bitset.test(m_index) | value);
-                return *this;
+                acc[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator + 2 * i));
+                key[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hash_secret + 2 * i));
+                step[i] = _mm_set_epi64x(hash_secret[6 - 2 * i], hash_secret[7 - 2 * i]);
+                scramble[i] = step[i];
             }
-
-            /**
-             * Bitwise XOR assignment operator
-             * @param value Value to XOR the bit with (bit value)
-             */
-            constexpr reference& operator^=(const bool value) const noexcept
+            const __m128i prime = _mm_set1_epi64x(0x9e3779b1);
+            for (std::size_t stripe = 1; stripe <= stripes; ++stripe, bytes += 64)
             {
-                m_bitset.set(m_index, m_bitset.test(m_index) ^ value);
-                return *this;
+                for (std::size_t i = 0; i < 4; ++i)
+                {
+                    const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 16 * i));
+                    const __m128i keyed = _mm_xor_si128(value, key[i]);
+                    const __m128i product = _mm_mul_epu32(keyed, _mm_srli_epi64(keyed, 32));
+                    acc[i] = _mm_add_epi64(acc[i], _mm_add_epi64(_mm_shuffle_epi32(value, 0x4e), product));
+                    key[i] = _mm_add_epi64(key[i], step[i]);
+                }
+                if (!(stripe % hash_stripes_per_scramble))
+                {
+                    for (std::size_t i = 0; i < 4; ++i)
+                    {
+                        const __m128i mixed = _mm_xor_si128(_mm_xor_si128(acc[i], _mm_srli_epi64(acc[i], 47)), scramble[i]);
+                        acc[i] = _mm_add_epi64(_mm_mul_epu32(mixed, prime), _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(mixed, 32), prime), 32));
+                    }
+                }
             }
+            for (std::size_t i = 0; i < 4; ++i)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulator + 2 * i), acc[i]);
+#else
+            hash_accumulate_scalar(accumulator, bytes, stripes);
+#endif
+        }
 
-            /**
-             * Flip the bit at the current index
-             */
-            constexpr void flip() const noexcept
+        /**
+         * Hashes a byte stream into a 64-bit value
+         * Inputs of at least 256 bytes go through hash_accumulate, the remainder is mixed 16 bytes at a time with
+         * a 128-bit multiply-fold.
+         * @param bytes Pointer to the bytes to hash
+         * @param length Count of bytes to hash
+         * @param seed Seed of the hash
+         * @return 64-bit hash of the bytes
+         */
+        [[nodiscard]] constexpr std::uint64_t hash_bytes(const unsigned char* bytes, std::size_t length, const std::uint64_t seed) noexcept
+        {
+            const std::uint64_t* const secret = hash_secret;
+            const std::uint64_t total_length = length;
+            std::uint64_t hash = seed ^ hash_multiply_fold(seed ^ secret[0], total_length ^ secret[1]);
+
+            if (length >= 256)
             {
-                m_bitset.flip(m_index);
+                std::uint64_t accumulator[8];
+                for (std::size_t lane = 0; lane < 8; ++lane)
+                    accumulator[lane] = secret[lane] ^ hash;
+
+                const std::size_t stripes = length / 64;
+                hash_accumulate(accumulator, bytes, stripes);
+                bytes += stripes * 64;
+                length -= stripes * 64;
+
+                for (std::size_t lane = 0; lane < 8; lane += 2)
+                    hash += hash_multiply_fold(accumulator[lane] ^ secret[lane + 1], accumulator[lane + 1] ^ secret[lane]);
             }
 
-            /**
-             * Set the bit at the current index to value
-             * @param value Value to set the bit to (bit value)
-             */
-            constexpr void set(const bool value = true) const noexcept
+            while (length >= 16)
             {
-	            m_bitset.set(m_index, value);
-			}
-
-            /**
-             * Reset the bit at the current index to value
-             */
-            constexpr void reset() const noexcept
+                hash = hash_multiply_fold(hash_load(bytes) ^ secret[2] ^ hash, hash_load(bytes + 8) ^ secret[3]);
+                bytes += 16;
+                length -= 16;
+            }
+            if (length)
             {
-                m_bitset.reset(m_index);
+                unsigned char rest[16] = {};
+                std::copy(bytes, bytes + length, rest);
+                hash = hash_multiply_fold(hash_load(rest) ^ secret[4] ^ hash, hash_load(rest + 8) ^ secret[5]);
             }
 
-            bitset& m_bitset;
-            const size_type& m_index;
-        };
+            // Final avalanche
+            hash = hash_multiply_fold(hash ^ secret[6], total_length ^ secret[7]);
+            return hash ^ hash >> 29;
+        }
 
         /**
-         * Base iterator class template.
-         * @tparam BitSetTypeSpecifier Full type of the bitset to iterate over. [bitset&] or [const bitset&]
+         * Hashes the object representation of an object (see the byte overload)
+         * @param data Pointer to the object
+         * @param length Count of bytes to hash
+         * @param seed Seed of the hash
+         * @return 64-bit hash of the bytes
          */
-        template <typename BitSetTypeSpecifier> requires std::is_same_v<bitset, std::remove_cvref_t<BitSetTypeSpecifier>>
-        class iterator_base {
-        public:
-            constexpr iterator_base() noexcept = delete;
-
-            /**
-             * Constructs a new iterator_base instance based on the specified bitset and index.
-             * @param bitset The bitset instance to iterate over.
-             * @param index Index of the bit to start the iteration from (bit index).
-             */
-            explicit constexpr iterator_base(BitSetTypeSpecifier bitset, const size_type& index = 0) noexcept : m_bitset(bitset), m_index(index) {}
-
-            /**
-             * Copy constructor.
-             * @param other Other iterator_base instance to copy from.
-             */
-            constexpr iterator_base(const iterator_base& other) noexcept : m_bitset(other.m_bitset), m_index(other.m_index) {}
-
-            /**
-             * Destructor.
-             */
-            constexpr ~iterator_base() noexcept = default;
+        [[nodiscard]] inline std::uint64_t hash_bytes(const void* data, const std::size_t length, const std::uint64_t seed) noexcept
+        {
+            return hash_bytes(static_cast<const unsigned char*>(data), length, seed);
+        }
 
-            /**
-             * Copy assignment operator.
-             */
-            constexpr iterator_base& operator=(const iterator_base& other) noexcept {
-                m_bitset = other.m_bitset;
-                m_index = other.m_index;
-                return *this;
-            }
+        /**
+         * Hints the processor to load the cache line holding the address
+         * @param address Address to prefetch
+         */
+        inline void prefetch(const void* address) noexcept
+        {
+#if defined(__SSE2__) || defined(_M_X64)
+            _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(address);
+#else
+            (void)address;
+#endif
+        }
 
-            BitSetTypeSpecifier m_bitset;
-            size_type m_index;
+        /**
+         * Odd multipliers deriving the eight probes of a Bloom filter block from one 32-bit hash
+         */
+        inline constexpr std::uint32_t bloom_salt[8] = {
+            0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du, 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
         };
 
         /**
-         * Iterator class.
+         * Builds the probe mask of a 512-bit Bloom filter block, one bit in each of its eight words
+         * @param hash Hash selecting the bits
+         * @param mask Receives the mask
          */
-        class iterator : public iterator_base<bitset&> {
-        public:
-            using iterator_base<bitset&>::iterator_base;
-
-            /**
-             * Conversion constructor to const_iterator.
-             * @param other Other const_iterator instance to convert from.
-             */
-            constexpr iterator(const const_iterator& other) noexcept : iterator_base<bitset&>(other.m_bitset, other.m_index) {}
+        inline void bloom_mask(const std::uint32_t hash, std::uint64_t (&mask)[8]) noexcept
+        {
+            for (std::size_t i = 0; i < 8; ++i)
+                mask[i] = std::uint64_t{ 1 } << (hash * bloom_salt[i] >> 26);
+        }
 
-            /**
-             * Conversion assign operator to const_iterator.
-             * @param other Other const_iterator instance to convert from.
-             */
-            constexpr iterator& operator=(const const_iterator& other) noexcept {
-                this->m_bitset = other.m_bitset;
-                this->m_index = other.m_index;
-                return *this;
-            }
+        /**
+         * Sets the probes of a hash in a 64-byte aligned Bloom filter block
+         * @param block Eight words of the block
+         * @param hash Hash selecting the bits
+         */
+        inline void bloom_insert(std::uint64_t* block, const std::uint32_t hash) noexcept
+        {
+#if defined(__AVX2__)
+            const __m256i shifts = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(hash)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bloom_salt))), 26);
+            const __m256i one = _mm256_set1_epi64x(1);
+            const __m256i low = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(shifts)));
+            const __m256i high = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(shifts, 1)));
+            __m256i* words = reinterpret_cast<__m256i*>(block);
+            _mm256_store_si256(words, _mm256_or_si256(_mm256_load_si256(words), low));
+            _mm256_store_si256(words + 1, _mm256_or_si256(_mm256_load_si256(words + 1), high));
+#else
+            std::uint64_t mask[8];
+            bloom_mask(hash, mask);
+            for (std::size_t i = 0; i < 8; ++i)
+                block[i] |= mask[i];
+#endif
+        }
 
-            /**
-             * Dereference operator (returns the value of the bit at the current bit index).
-             * @return Reference to the bit at the current index.
-             */
-            [[nodiscard]] constexpr reference operator*() noexcept {
-                return reference(this->m_bitset, this->m_index);
-            }
+        /**
+         * Checks the probes of a hash in a 64-byte aligned Bloom filter block
+         * @param block Eight words of the block
+         * @param hash Hash selecting the bits
+         * @return true if all probes are set, false otherwise
+         */
+        [[nodiscard]] inline bool bloom_contains(const std::uint64_t* block, const std::uint32_t hash) noexcept
+        {
+#if defined(__AVX2__)
+            const __m256i shifts = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(hash)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bloom_salt))), 26);
+            const __m256i one = _mm256_set1_epi64x(1);
+            const __m256i low = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(shifts)));
+            const __m256i high = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(shifts, 1)));
+            const __m256i* words = reinterpret_cast<const __m256i*>(block);
+            return _mm256_testc_si256(_mm256_load_si256(words), low) & _mm256_testc_si256(_mm256_load_si256(words + 1), high);
+#else
+            std::uint64_t mask[8];
+            bloom_mask(hash, mask);
+            std::uint64_t missing = 0;
+            for (std::size_t i = 0; i < 8; ++i)
+                missing |= mask[i] & ~block[i];
+            return !missing;
+#endif
+        }
 
-            /**
-             * Increments the iterator to the next bit, pre-increment.
-             */
-            constexpr iterator& operator++() noexcept
-            {
-                ++this->m_index;
-                return *this;
-            }
+        /**
+         * Checks if op(lhs[i], rhs[i]) is non-zero for any block
+         * Blocks are reduced in 256-byte chunks with a single branch per chunk, so the reduction vectorizes while the
+         * scan still stops at the first chunk containing a witness.
+         * @tparam BlockType Type of the blocks
+         * @param lhs Blocks of the left-hand side
+         * @param rhs Blocks of the right-hand side
+         * @param count Count of blocks to check
+         * @param op Block operation returning the witness bits
+         * @return true if any witness bit was found, false otherwise
+         */
+        template <typename BlockType, typename Op>
+        [[nodiscard]] constexpr bool any_of_blocks(const BlockType* lhs, const BlockType* rhs, const std::size_t count, Op op) noexcept
+        {
+            constexpr std::size_t chunk_size = 256 / sizeof(BlockType) ? 256 / sizeof(BlockType) : 1;
 
-            /**
-			 * Increments the iterator to the next bit, post-increment
-			 */
-            constexpr iterator& operator++(int) noexcept
+            std::size_t i = 0;
+            for (; i + chunk_size <= count; i += chunk_size)
             {
-                iterator tmp = *this;
-                ++this->m_index;
-                return tmp;
+                BlockType witness = 0;
+                for (std::size_t j = 0; j < chunk_size; ++j)
+                    witness |= op(lhs[i + j], rhs[i + j]);
+                if (witness)
+                    return true;
             }
-
-            /**
-             * Decrements the iterator to the previous bit, pre-decrement.
-             */
-            constexpr iterator& operator--() noexcept
+            for (; i < count; ++i)
             {
-                --this->m_index;
-                return *this;
+                if (op(lhs[i], rhs[i]))
+                    return true;
             }
+            return false;
+        }
 
-            /**
-			 * Decrements the iterator to the previous bit, post-decrement.
-			 */
-            constexpr iterator& operator--(int) noexcept
-            {
-                iterator tmp = *this;
-                --this->m_index;
-                return tmp;
-            }
+        /**
+         * Checks if op(data[i]) is non-zero for any block (see the binary overload)
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks to check
+         * @param count Count of blocks to check
+         * @param op Block operation returning the witness bits
+         * @return true if any witness bit was found, false otherwise
+         */
+        template <typename BlockType, typename Op>
+        [[nodiscard]] constexpr bool any_of_blocks(const BlockType* data, const std::size_t count, Op op) noexcept
+        {
+            return any_of_blocks(data, data, count, [op](const BlockType block, const BlockType) noexcept { return op(block); });
+        }
 
-            /**
-             * Returns the iterator with the specified amount added to it
-             * @param amount Amount to add to the iterator (bit count)
-             * @return New iterator instance with the specified amount added to it
-             */
-            [[nodiscard]] constexpr iterator operator+(const size_type& amount) const noexcept
-            {
-                return iterator(this->m_bitset, this->m_index + amount);
-            }
+        /**
+         * Counts the set bits of a 64-bit word without relying on a popcount instruction
+         * The shifts and masks vectorize, which makes it faster than scalar popcnt over whole arrays.
+         * @param word Word to count the bits of
+         * @return Count of set bits
+         */
+        [[nodiscard]] constexpr std::uint64_t popcount_word(std::uint64_t word) noexcept
+        {
+            word -= word >> 1 & 0x5555555555555555ull;
+            word = (word & 0x3333333333333333ull) + (word >> 2 & 0x3333333333333333ull);
+            word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+            return word * 0x0101010101010101ull >> 56;
+        }
 
-            /**
-             * Returns the iterator with the specified amount subtracted from it
-             * @param amount Amount to subtract from the iterator (bit count)
-             * @return New iterator instance with the specified amount subtracted from it
-             */
-            [[nodiscard]] constexpr iterator operator-(const size_type& amount) const noexcept
+        /**
+         * Counts the set bits of consecutive blocks
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks to count the bits of
+         * @param count Count of blocks
+         * @return Count of set bits
+         */
+        template <typename BlockType>
+        [[nodiscard]] constexpr std::size_t count_blocks(const BlockType* data, const std::size_t count) noexcept
+        {
+            std::size_t result = 0;
+            if (std::is_constant_evaluated())
             {
-                return iterator(this->m_bitset, this->m_index - amount);
+                for (std::size_t i = 0; i < count; ++i)
+                    result += static_cast<std::size_t>(detail::popcount(data[i]));
+                return result;
             }
 
-            /**
-             * Returns difference between two iterators
-             * @param other Other iterator instance subtract with
-             * @return Difference between two iterators
-             */
-            [[nodiscard]] constexpr difference_type operator-(const iterator& other) const noexcept
+            // The count does not depend on the block boundaries, so go through the storage 64 bits at a time
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+            const std::size_t length = count * sizeof(BlockType);
+            std::size_t i = 0;
+            for (; i + sizeof(std::uint64_t) <= length; i += sizeof(std::uint64_t))
             {
-                return this->m_index - other.m_index;
+                std::uint64_t word;
+                std::memcpy(&word, bytes + i, sizeof(word));
+                result += static_cast<std::size_t>(popcount_word(word));
             }
+            for (; i < length; ++i)
+                result += static_cast<std::size_t>(detail::popcount(bytes[i]));
+            return result;
+        }
 
-            /**
-			 * Returns difference between two iterators
-			 * @param other Other iterator instance subtract with
-			 * @return Difference between two iterators
-			 */
-            [[nodiscard]] constexpr difference_type operator-(const const_iterator& other) const noexcept
+        /**
+         * Block operation of the set difference, lhs & ~rhs
+         */
+        struct bit_and_not
+        {
+            template <typename T>
+            [[nodiscard]] constexpr T operator()(const T& lhs, const T& rhs) const noexcept
             {
-                return this->m_index - other.m_index;
+                return static_cast<T>(lhs & ~rhs);
             }
+        };
 
-            /**
-             * Returns the iterator multiplied by the specified amount
-             * @param amount Amount to multiply the iterator by (bit count ?)
-             * @return New iterator instance multiplied by the specified amount
-             */
-            [[nodiscard]] constexpr iterator operator*(const size_type& amount) const noexcept
+        /**
+         * Block operation of the complement, ~lhs (rhs is ignored)
+         */
+        struct bit_invert
+        {
+            template <typename T>
+            [[nodiscard]] constexpr T operator()(const T& lhs, const T&) const noexcept
             {
-                return iterator(this->m_bitset, this->m_index * amount);
+                return static_cast<T>(~lhs);
             }
+        };
 
-
-            /**
-             * Returns the iterator divided by the specified amount
-             * @param amount Amount to multiply the iterator by (bit count ?)
-             * @return New iterator instance divided by the specified amount
-             */
-            [[nodiscard]] constexpr iterator operator/(const size_type& amount) const noexcept
-            {
-                return iterator(this->m_bitset, this->m_index / amount);
+#if defined(__AVX512F__)
+        /**
+         * Applies a block operation to 512-bit vectors
+         * @tparam Op One of std::bit_and<>, std::bit_or<>, std::bit_xor<>, bit_and_not and bit_invert
+         * @param lhs Left-hand side
+         * @param rhs Right-hand side
+         * @return op(lhs, rhs)
+         */
+        template <typename Op>
+        [[nodiscard]] inline __m512i combine_vectors(Op, const __m512i lhs, const __m512i rhs) noexcept
+        {
+            if constexpr (std::is_same_v<Op, std::bit_and<>>)
+                return _mm512_and_si512(lhs, rhs);
+            else if constexpr (std::is_same_v<Op, std::bit_or<>>)
+                return _mm512_or_si512(lhs, rhs);
+            else if constexpr (std::is_same_v<Op, std::bit_xor<>>)
+                return _mm512_xor_si512(lhs, rhs);
+            else if constexpr (std::is_same_v<Op, bit_and_not>)
+                return _mm512_andnot_si512(rhs, lhs);
+            else
+                return _mm512_xor_si512(lhs, _mm512_set1_epi64(-1));
+        }
+#elif defined(__AVX2__)
+        /**
+         * Applies a block operation to 256-bit vectors
+         * @tparam Op One of std::bit_and<>, std::bit_or<>, std::bit_xor<>, bit_and_not and bit_invert
+         * @param lhs Left-hand side
+         * @param rhs Right-hand side
+         * @return op(lhs, rhs)
+         */
+        template <typename Op>
+        [[nodiscard]] inline __m256i combine_vectors(Op, const __m256i lhs, const __m256i rhs) noexcept
+        {
+            if constexpr (std::is_same_v<Op, std::bit_and<>>)
+                return _mm256_and_si256(lhs, rhs);
+            else if constexpr (std::is_same_v<Op, std::bit_or<>>)
+                return _mm256_or_si256(lhs, rhs);
+            else if constexpr (std::is_same_v<Op, std::bit_xor<>>)
+                return _mm256_xor_si256(lhs, rhs);
+            else if constexpr (std::is_same_v<Op, bit_and_not>)
+                return _mm256_andnot_si256(rhs, lhs);
+            else
+                return _mm256_xor_si256(lhs, _mm256_set1_epi64x(-1));
+        }
+#elif defined(__SSE2__) || defined(_M_X64)
+        /**
+         * Applies a block operation to 128-bit vectors
+         * @tparam Op One of std::bit_and<>, std::bit_or<>, std::bit_xor<>, bit_and_not and bit_invert
+         * @param lhs Left-hand side
+         * @param rhs Right-hand side
+         * @return op(lhs, rhs)
+         */
+        template <typename Op>
+        [[nodiscard]] inline __m128i combine_vectors(Op, const __m128i lhs, const __m128i rhs) noexcept
+        {
+            if constexpr (std::is_same_v<Op, std::bit_and<>>)
+                return _mm_and_si128(lhs, rhs);
+            else if constexpr (std::is_same_v<Op, std::bit_or<>>)
+                return _mm_or_si128(lhs, rhs);
+            else if constexpr (std::is_same_v<Op, std::bit_xor<>>)
+                return _mm_xor_si128(lhs, rhs);
+            else if constexpr (std::is_same_v<Op, bit_and_not>)
+                return _mm_andnot_si128(rhs, lhs);
+            else
+                return _mm_xor_si128(lhs, _mm_set1_epi32(-1));
+        }
+#endif
+
+        /**
+         * Applies a block operation to consecutive blocks, result[i] = op(lhs[i], rhs[i])
+         * The operations are bitwise, so the storage is processed as bytes a full vector register at a time (AVX-512,
+         * AVX2 or SSE2, whichever the build targets) and the block type does not change the iteration count.
+         * @tparam BlockType Type of the blocks
+         * @tparam Op One of std::bit_and<>, std::bit_or<>, std::bit_xor<>, bit_and_not and bit_invert
+         * @param lhs Blocks of the left-hand side
+         * @param rhs Blocks of the right-hand side
+         * @param result Blocks receiving the result (may be lhs or rhs)
+         * @param count Count of blocks
+         * @param op Block operation
+         */
+        template <typename BlockType, typename Op>
+        constexpr void combine_blocks(const BlockType* lhs, const BlockType* rhs, BlockType* result, const std::size_t count, Op op) noexcept
+        {
+            std::size_t i = 0;
+            if (!std::is_constant_evaluated())
+            {
+                const unsigned char* left = reinterpret_cast<const unsigned char*>(lhs);
+                const unsigned char* right = reinterpret_cast<const unsigned char*>(rhs);
+                unsigned char* out = reinterpret_cast<unsigned char*>(result);
+                const std::size_t length = count * sizeof(BlockType);
+                std::size_t byte = 0;
+#if defined(__AVX512F__)
+                for (; byte + sizeof(__m512i) <= length; byte += sizeof(__m512i))
+                    _mm512_storeu_si512(out + byte, combine_vectors(op, _mm512_loadu_si512(left + byte), _mm512_loadu_si512(right + byte)));
+#elif defined(__AVX2__)
+                for (; byte + sizeof(__m256i) <= length; byte += sizeof(__m256i))
+                {
+                    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + byte));
+                    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + byte));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + byte), combine_vectors(op, a, b));
+                }
+#elif defined(__SSE2__) || defined(_M_X64)
+                for (; byte + sizeof(__m128i) <= length; byte += sizeof(__m128i))
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left + byte));
+                    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + byte));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + byte), combine_vectors(op, a, b));
+                }
+#endif
+                // Remainder (or everything without vector support) 64 bits at a time, then block by block
+                for (; byte + sizeof(std::uint64_t) <= length; byte += sizeof(std::uint64_t))
+                {
+                    std::uint64_t a, b;
+                    std::memcpy(&a, left + byte, sizeof(a));
+                    std::memcpy(&b, right + byte, sizeof(b));
+                    a = op(a, b);
+                    std::memcpy(out + byte, &a, sizeof(a));
+                }
+                i = byte / sizeof(BlockType);
             }
+            for (; i < count; ++i)
+                result[i] = static_cast<BlockType>(op(lhs[i], rhs[i]));
+        }
 
-            /**
-             * Adds the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
-             */
-            constexpr iterator& operator+=(const size_type& amount) noexcept
-            {
-                this->m_index += amount;
-                return *this;
-            }
+        /**
+         * Mask of the bits of a block at or after the specified bit
+         * @tparam BlockType Type of the block
+         * @param begin Begin of a range (bit index, only the position within the block matters)
+         * @return Mask of the bits of the block that belong to [begin, ...)
+         */
+        template <typename BlockType>
+        [[nodiscard]] constexpr BlockType mask_from(const std::size_t begin) noexcept
+        {
+            return static_cast<BlockType>((std::numeric_limits<BlockType>::max)() << begin % (sizeof(BlockType) * CHAR_BIT));
+        }
 
-            /**
-             * Subtracts the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
-             */
-            constexpr iterator& operator-=(const size_type& amount) noexcept
+        /**
+         * Mask of the bits of a block before the specified bit
+         * @tparam BlockType Type of the block
+         * @param end End of a non-empty range (bit index, only the position of end - 1 within the block matters)
+         * @return Mask of the bits of the block that belong to [..., end)
+         */
+        template <typename BlockType>
+        [[nodiscard]] constexpr BlockType mask_until(const std::size_t end) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+            return static_cast<BlockType>((std::numeric_limits<BlockType>::max)() >> (block_size - 1 - (end - 1) % block_size));
+        }
+
+        /**
+         * Copies the low bits of blocks of one type into blocks of another, the remaining destination bits are reset
+         * On little-endian targets byte k of the storage holds bits 8k to 8k + 7 whatever the block type, so the
+         * conversion is a copy of bytes. Big-endian targets and constant evaluation re-pack the blocks with shifts.
+         * @tparam From Type of the source blocks
+         * @tparam To Type of the destination blocks
+         * @param from Source blocks
+         * @param to Destination blocks
+         * @param to_count Count of destination blocks
+         * @param bits Count of bits to copy (at most the bit count of both the source and the destination)
+         */
+        template <typename From, typename To>
+        constexpr void convert_blocks(const From* from, To* to, const std::size_t to_count, const std::size_t bits) noexcept
+        {
+            constexpr std::size_t from_size = sizeof(From) * CHAR_BIT;
+            constexpr std::size_t to_size = sizeof(To) * CHAR_BIT;
+
+            if (!to_count)
+                return;
+
+            if (std::endian::native == std::endian::little && !std::is_constant_evaluated())
             {
-                this->m_index -= amount;
-                return *this;
+                const std::size_t bytes = (bits + CHAR_BIT - 1) / CHAR_BIT;
+                if (bytes)
+                    std::memcpy(to, from, bytes);
+                std::memset(reinterpret_cast<unsigned char*>(to) + bytes, 0, to_count * sizeof(To) - bytes);
             }
-
-            /**
-             * Adds the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
-             */
-            constexpr iterator& operator*=(const size_type& amount) noexcept
+            else if constexpr (to_size >= from_size)
             {
-                this->m_index *= amount;
-                return *this;
+                const std::size_t from_count = (bits + from_size - 1) / from_size;
+                for (std::size_t i = 0; i < to_count; ++i)
+                {
+                    To block = 0;
+                    for (std::size_t j = 0; j < to_size / from_size && i * (to_size / from_size) + j < from_count; ++j)
+                        block |= static_cast<To>(static_cast<To>(from[i * (to_size / from_size) + j]) << j * from_size);
+                    to[i] = block;
+                }
             }
-
-            /**
-             * Subtracts the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
-             */
-            constexpr iterator& operator/=(const size_type& amount) noexcept
+            else
             {
-                this->m_index /= amount;
-                return *this;
+                const std::size_t used_count = (bits + to_size - 1) / to_size;
+                for (std::size_t i = 0; i < to_count; ++i)
+                    to[i] = i < used_count ? static_cast<To>(from[i / (from_size / to_size)] >> i % (from_size / to_size) * to_size) : To{ 0 };
             }
 
-            /**
-             * Inequality operator
-             * @param other Other iterator instance to compare with
-             * @return true if the iterators are not equal, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator!=(const iterator& other) const noexcept
+            // The last copied block may carry bits of the unspecified tail of the source
+            if (bits % to_size)
+                to[bits / to_size] &= mask_until<To>(bits);
+        }
+
+        /**
+         * Reverses the order of the bits of a block by swapping adjacent groups of Width bits, then of twice as many
+         * @tparam BlockType Type of the block
+         * @tparam Width Width of the groups swapped by this step (bit count)
+         * @param block Block to reverse
+         * @return Block with bit i moved to bit (block size - 1 - i)
+         */
+        template <typename BlockType, std::size_t Width = 1>
+        [[nodiscard]] constexpr BlockType reverse_bits(const BlockType block) noexcept
+        {
+            if constexpr (Width >= sizeof(BlockType) * CHAR_BIT)
+                return block;
+            else
             {
-                return this->m_index != other.m_index;
+                // Mask of the lower group of every pair, 0x55.. for single bits, 0x33.. for pairs and so on
+                constexpr BlockType mask = static_cast<BlockType>((std::numeric_limits<BlockType>::max)() / ((BlockType{ 1 } << Width) + 1));
+                return reverse_bits<BlockType, Width * 2>(static_cast<BlockType>((block >> Width & mask) | (block & mask) << Width));
             }
+        }
 
-            /**
-             *  Less than operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is less than the other iterator, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator<(const iterator& other) const noexcept
+        /**
+         * Mask of the lowest bits of a value
+         * @tparam T Type of the value
+         * @param bits Count of bits to keep (may be the full width of T)
+         * @return Mask with the lowest bits set
+         */
+        template <typename T>
+        [[nodiscard]] constexpr T low_mask(const std::size_t bits) noexcept
+        {
+            return bits >= sizeof(T) * CHAR_BIT ? (std::numeric_limits<T>::max)() : static_cast<T>((T{ 1 } << bits) - 1);
+        }
+
+        /**
+         * Checks if a field can be accessed through a single unaligned 64-bit word of the storage bytes
+         * On little-endian targets the bytes of blocks narrower than 64 bits are laid out in bit order.
+         * @tparam T Type of the field
+         * @tparam BlockType Type of the blocks
+         * @param pos Index of the first bit of the field (bit index)
+         * @param storage_size Count of blocks of the storage
+         * @return true if the word and the byte following it lie within the storage
+         */
+        template <typename T, typename BlockType>
+        [[nodiscard]] constexpr bool is_word_accessible(const std::size_t pos, const std::size_t storage_size) noexcept
+        {
+            if constexpr (sizeof(BlockType) < sizeof(std::uint64_t) && sizeof(T) <= sizeof(std::uint64_t) && std::endian::native == std::endian::little)
+                return !std::is_constant_evaluated() && pos / CHAR_BIT + sizeof(std::uint64_t) < storage_size * sizeof(BlockType);
+            else
+                return false;
+        }
+
+        /**
+         * Reads a field of at most one block of bits with two unconditional block loads and a funnel shift
+         * @tparam T Type of the field
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks to read from
+         * @param storage_size Count of blocks
+         * @param pos Index of the first bit of the field (bit index, must lie within the storage)
+         * @param len Length of the field (bit count, at most the width of T and of BlockType)
+         * @return Value of the field
+         */
+        template <typename T, typename BlockType>
+        [[nodiscard]] constexpr T read_bits_straddling(const BlockType* data, const std::size_t storage_size, const std::size_t pos, const std::size_t len) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+            const std::size_t block = pos / block_size, offset = pos % block_size;
+
+            // In the last block the field cannot straddle, the bits shifted in from the same block are masked out
+            const std::size_t next = block + 1 < storage_size ? block + 1 : block;
+            const BlockType low = static_cast<BlockType>(data[block] >> offset);
+            const BlockType high = static_cast<BlockType>(static_cast<BlockType>(data[next] << 1) << (block_size - 1 - offset));
+            return static_cast<T>((low | high) & low_mask<BlockType>(len));
+        }
+
+        /**
+         * Reads a field of bits, bit pos becomes the least significant bit of the result
+         * Blocks at least as wide as T take two block loads and a funnel shift, narrower blocks are read as one
+         * unaligned 64-bit word (plus one byte when the field straddles it).
+         * @tparam T Type of the field
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks to read from
+         * @param storage_size Count of blocks
+         * @param pos Index of the first bit of the field (bit index)
+         * @param len Length of the field (bit count, at most the width of T)
+         * @return Value of the field
+         */
+        template <typename T, typename BlockType>
+        [[nodiscard]] constexpr T read_bits(const BlockType* data, const std::size_t storage_size, const std::size_t pos, const std::size_t len) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+            if constexpr (sizeof(T) <= sizeof(BlockType))
+                return len ? read_bits_straddling<T>(data, storage_size, pos, len) : T{ 0 };
+
+            if (is_word_accessible<T, BlockType>(pos, storage_size))
             {
-                return this->m_index < other.m_index;
+                const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data) + pos / CHAR_BIT;
+                const std::size_t shift = pos % CHAR_BIT;
+                std::uint64_t word;
+                std::memcpy(&word, bytes, sizeof(word));
+                word >>= shift;
+                if (shift + len > 64)
+                    word |= static_cast<std::uint64_t>(bytes[sizeof(word)]) << (64 - shift);
+                return static_cast<T>(word & low_mask<std::uint64_t>(len));
             }
 
-            /**
-             *  Less than or equal operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is less than or equal to the other iterator, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator<=(const iterator& other) const noexcept
+            T result = 0;
+            std::size_t block = pos / block_size, offset = pos % block_size;
+            for (std::size_t done = 0; done < len; offset = 0, ++block)
             {
-                return this->m_index <= other.m_index;
+                const std::size_t take = (std::min)(block_size - offset, len - done);
+                result |= static_cast<T>(static_cast<T>(data[block] >> offset & low_mask<BlockType>(take)) << done);
+                done += take;
             }
+            return result;
+        }
 
-            /**
-             *  Equality operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the iterators are equal, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator==(const iterator& other) const noexcept
+        /**
+         * Writes a field of bits, the least significant bit of value goes to bit pos
+         * @tparam T Type of the field
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks to write to
+         * @param storage_size Count of blocks
+         * @param pos Index of the first bit of the field (bit index)
+         * @param len Length of the field (bit count, at most the width of T)
+         * @param value Value of the field (bits above len are ignored)
+         */
+        template <typename T, typename BlockType>
+        constexpr void write_bits(BlockType* data, const std::size_t storage_size, const std::size_t pos, const std::size_t len, T value) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+            value = static_cast<T>(value & low_mask<T>(len));
+
+            // The field spans at most two blocks, the second mask is empty when it does not straddle
+            if constexpr (sizeof(T) <= sizeof(BlockType))
             {
-                return this->m_index == other.m_index;
+                if (!len)
+                    return;
+                const std::size_t block = pos / block_size, offset = pos % block_size;
+                const std::size_t next = block + 1 < storage_size ? block + 1 : block;
+                const BlockType field_mask = low_mask<BlockType>(len);
+                const BlockType field = static_cast<BlockType>(value);
+                data[block] = static_cast<BlockType>((data[block] & ~static_cast<BlockType>(field_mask << offset)) | static_cast<BlockType>(field << offset));
+                const BlockType high_mask = static_cast<BlockType>(static_cast<BlockType>(field_mask >> 1) >> (block_size - 1 - offset));
+                data[next] = static_cast<BlockType>((data[next] & ~high_mask) | static_cast<BlockType>(static_cast<BlockType>(field >> 1) >> (block_size - 1 - offset)));
+                return;
             }
 
-            /**
-             *  Bigger than or equal operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is bigger than or equal to the other iterator, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator>=(const iterator& other) const noexcept
+            if (is_word_accessible<T, BlockType>(pos, storage_size))
             {
-                return this->m_index >= other.m_index;
+                unsigned char* bytes = reinterpret_cast<unsigned char*>(data) + pos / CHAR_BIT;
+                const std::size_t shift = pos % CHAR_BIT;
+                const std::uint64_t mask = low_mask<std::uint64_t>(len) << shift;
+                std::uint64_t word;
+                std::memcpy(&word, bytes, sizeof(word));
+                word = (word & ~mask) | (static_cast<std::uint64_t>(value) << shift & mask);
+                std::memcpy(bytes, &word, sizeof(word));
+                if (shift + len > 64)
+                {
+                    const unsigned char high_mask = low_mask<unsigned char>(shift + len - 64);
+                    bytes[sizeof(word)] = static_cast<unsigned char>((bytes[sizeof(word)] & ~high_mask) | (static_cast<std::uint64_t>(value) >> (64 - shift) & high_mask));
+                }
+                return;
             }
 
-            /**
-             *  Bigger than operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is bigger than the other iterator, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator>(const iterator& other) const noexcept
+            std::size_t block = pos / block_size, offset = pos % block_size;
+            for (std::size_t done = 0; done < len; offset = 0, ++block)
             {
-                return this->m_index > other.m_index;
+                const std::size_t take = (std::min)(block_size - offset, len - done);
+                const BlockType mask = static_cast<BlockType>(low_mask<BlockType>(take) << offset);
+                data[block] = static_cast<BlockType>((data[block] & ~mask) | (static_cast<BlockType>(value >> done) << offset & mask));
+                done += take;
             }
-        };
+        }
 
         /**
-         * Const iterator class
+         * Finds the first set bit at or after the specified position
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks to search
+         * @param size Count of valid bits (bits past it are ignored)
+         * @param pos Position to start the search at (bit index)
+         * @return Index of the found bit, size if there is none
          */
-        class const_iterator : public iterator_base<const bitset&>
+        template <typename BlockType>
+        [[nodiscard]] constexpr std::size_t find_next(const BlockType* data, const std::size_t size, const std::size_t pos) noexcept
         {
-        public:
-            using iterator_base<const bitset&>::iterator_base;
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
 
-            /**
-             * Dereference operator (returns the value of the bit at the current bit index)
-             * @return Reference to the bit at the current index
-             */
-            [[nodiscard]] constexpr const_reference operator*() const noexcept
+            if (pos >= size)
+                return size;
+
+            const std::size_t last_block = (size - 1) / block_size;
+            std::size_t block = pos / block_size;
+            BlockType bits = static_cast<BlockType>(data[block] & mask_from<BlockType>(pos));
+            while (!bits)
             {
-                return this->m_bitset.test(this->m_index);
+                if (++block > last_block)
+                    return size;
+                bits = data[block];
             }
+            return (std::min)(block * block_size + static_cast<std::size_t>(detail::countr_zero(bits)), size);
+        }
 
-            /**
-             * Increments the iterator to the next bit, pre-increment
-             */
-             constexpr const_iterator& operator++() noexcept
+        /**
+         * Finds the first bit of the specified value in a range
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks holding the range
+         * @param begin Begin of the range (bit index)
+         * @param end End of the range (bit index)
+         * @param value Value of the bit to find (bit value)
+         * @return Index of the found bit, end if there is none
+         */
+        template <typename BlockType>
+        [[nodiscard]] constexpr std::size_t find_bit(const BlockType* data, const std::size_t begin, const std::size_t end, const bool value) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+            if (begin >= end)
+                return end;
+
+            // An unset bit is a set bit of the complemented block
+            const BlockType invert = value ? BlockType{ 0 } : static_cast<BlockType>(~BlockType{ 0 });
+            const std::size_t last_block = (end - 1) / block_size;
+            std::size_t block = begin / block_size;
+            BlockType bits = static_cast<BlockType>((data[block] ^ invert) & mask_from<BlockType>(begin));
+            while (!bits)
             {
-                ++this->m_index;
-                return *this;
+                if (++block > last_block)
+                    return end;
+                bits = static_cast<BlockType>(data[block] ^ invert);
             }
+            return (std::min)(block * block_size + static_cast<std::size_t>(detail::countr_zero(bits)), end);
+        }
 
-            /**
-             * Increments the iterator to the next bit, post-increment
-             */
-             constexpr const_iterator& operator++(int) noexcept
+        /**
+         * Counts the set bits in a range
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks holding the range
+         * @param begin Begin of the range (bit index)
+         * @param end End of the range (bit index)
+         * @return Count of set bits in the range
+         */
+        template <typename BlockType>
+        [[nodiscard]] constexpr std::size_t count_range(const BlockType* data, const std::size_t begin, const std::size_t end) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+            if (begin >= end)
+                return 0;
+
+            const std::size_t first_block = begin / block_size;
+            const std::size_t last_block = (end - 1) / block_size;
+            const BlockType first_mask = mask_from<BlockType>(begin);
+            const BlockType last_mask = mask_until<BlockType>(end);
+
+            if (first_block == last_block)
+                return static_cast<std::size_t>(detail::popcount(static_cast<BlockType>(data[first_block] & first_mask & last_mask)));
+            return static_cast<std::size_t>(detail::popcount(static_cast<BlockType>(data[first_block] & first_mask)))
+                + count_blocks(data + first_block + 1, last_block - first_block - 1)
+                + static_cast<std::size_t>(detail::popcount(static_cast<BlockType>(data[last_block] & last_mask)));
+        }
+
+        /**
+         * Fills the bits in a range with the specified value
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks holding the range
+         * @param begin Begin of the range (bit index)
+         * @param end End of the range (bit index)
+         * @param value Value to fill the bits with (bit value)
+         */
+        template <typename BlockType>
+        constexpr void fill_range(BlockType* data, const std::size_t begin, const std::size_t end, const bool value) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+            if (begin >= end)
+                return;
+
+            const std::size_t first_block = begin / block_size;
+            const std::size_t last_block = (end - 1) / block_size;
+
+            // Masks of the bits that belong to the range within the first and the last block
+            const BlockType first_mask = mask_from<BlockType>(begin);
+            const BlockType last_mask = mask_until<BlockType>(end);
+
+            if (first_block == last_block)
             {
-                 const_iterator tmp = *this;
-                ++this->m_index;
-                return tmp;
+                if (value)
+                    data[first_block] |= first_mask & last_mask;
+                else
+                    data[first_block] &= static_cast<BlockType>(~(first_mask & last_mask));
+                return;
             }
 
-            /**
-             * Decrements the iterator to the previous bit, pre-decrement
-             */
-             constexpr const_iterator& operator--() noexcept
+            if (value)
             {
-                --this->m_index;
-                return *this;
+                data[first_block] |= first_mask;
+                data[last_block] |= last_mask;
             }
-
-            /**
-             * Decrements the iterator to the previous bit, post-decrement
-             */
-             constexpr const_iterator& operator--(int) noexcept
+            else
             {
-                 const_iterator tmp = *this;
-                --this->m_index;
-                return tmp;
+                data[first_block] &= static_cast<BlockType>(~first_mask);
+                data[last_block] &= static_cast<BlockType>(~last_mask);
             }
 
-            /**
-             * Returns the iterator with the specified amount added to it
-             * @param amount Amount to add to the iterator (bit count)
-             * @return New iterator instance with the specified amount added to it
-             */
-            [[nodiscard]]  constexpr const_iterator operator+(const size_type& amount) const noexcept
+            // Blocks fully covered by the range
+            if (std::is_constant_evaluated())
             {
-                return const_iterator(this->m_bitset, this->m_index + amount);
+                for (std::size_t i = first_block + 1; i < last_block; ++i)
+                    data[i] = value ? static_cast<BlockType>(~BlockType{ 0 }) : BlockType{ 0 };
             }
+            else
+                ::memset(data + first_block + 1, value ? 255u : 0, (last_block - first_block - 1) * sizeof(BlockType));
+        }
 
+        /**
+         * Reference to a single bit, holds the block of the bit and the mask of the bit within it
+         * @tparam BlockType Type of the blocks
+         */
+        template <typename BlockType>
+        class bit_reference
+        {
+        public:
             /**
-             * Returns the iterator with the specified amount subtracted from it
-             * @param amount Amount to subtract from the iterator (bit count)
-             * @return New iterator instance with the specified amount subtracted from it
+             * Empty constructor (only here to allow for some concepts to be executed)
              */
-            [[nodiscard]]  constexpr const_iterator operator-(const size_type& amount) const noexcept
-            {
-                return const_iterator(this->m_bitset, this->m_index - amount);
-            }
+            constexpr bit_reference() noexcept = default;
 
             /**
-             * Returns difference between two iterators
-             * @param other Other iterator instance subtract with
-             * @return Difference between two iterators
+             * Constructs a new reference to the bit of the block selected by the mask
+             * @param block Block holding the bit
+             * @param mask Mask of the bit within the block (single set bit)
              */
-            [[nodiscard]] constexpr difference_type operator-(const const_iterator& other) const noexcept
-            {
-                return this->m_index - other.m_index;
-            }
+            constexpr bit_reference(BlockType* block, const BlockType mask) noexcept : m_block(block), m_mask(mask) {}
 
             /**
-			 * Returns difference between two iterators
-			 * @param other Other iterator instance subtract with
-			 * @return Difference between two iterators
-			 */
-            [[nodiscard]] constexpr difference_type operator-(const iterator& other) const noexcept
-            {
-                return this->m_index - other.m_index;
-            }
+             * Copy constructor
+             */
+            constexpr bit_reference(const bit_reference&) noexcept = default;
 
             /**
-             * Returns the iterator multiplied by the specified amount
-             * @param amount Amount to multiply the iterator by (bit count ?)
-             * @return New iterator instance multiplied by the specified amount
+             * Destructor
              */
-            [[nodiscard]]  constexpr const_iterator operator*(const size_type& amount) const noexcept
-            {
-                return const_iterator(this->m_bitset, this->m_index * amount);
-            }
-
+            constexpr ~bit_reference() noexcept = default;
 
             /**
-             * Returns the iterator divided by the specified amount
-             * @param amount Amount to multiply the iterator by (bit count ?)
-             * @return New iterator instance divided by the specified amount
+             * Bool conversion operator
+             * @return Value of the bit (bit value)
              */
-            [[nodiscard]]  constexpr const_iterator operator/(const size_type& amount) const noexcept
+            [[nodiscard]] constexpr operator bool() const noexcept
             {
-                return const_iterator(this->m_bitset, this->m_index / amount);
+                return *m_block & m_mask;
             }
 
             /**
-             * Adds the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
+             * Assignment operator
+             * @param value Value to set the bit to (bit value)
              */
-             constexpr const_iterator& operator+=(const size_type& amount) noexcept
+            constexpr bit_reference& operator=(const bool value) noexcept
             {
-                this->m_index += amount;
+                set(value);
                 return *this;
             }
 
             /**
-             * Subtracts the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
+             * Assignment operator through a const reference, writes to the bit like the non-const one (makes the
+             * references returned by iterators writable as required by std::indirectly_writable)
+             * @param value Value to set the bit to (bit value)
              */
-             constexpr const_iterator& operator-=(const size_type& amount) noexcept
+            constexpr const bit_reference& operator=(const bool value) const noexcept
             {
-                this->m_index -= amount;
+                set(value);
                 return *this;
             }
 
             /**
-             * Adds the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
+             * Assignment operator, copies the value of the bit and not the reference
+             * @param other Other reference instance to copy from
              */
-             constexpr const_iterator& operator*=(const size_type& amount) noexcept
+            constexpr bit_reference& operator=(const bit_reference& other) noexcept
             {
-                this->m_index *= amount;
+                set(static_cast<bool>(other));
                 return *this;
             }
 
             /**
-             * Subtracts the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
+             * Bitwise AND assignment operator
+             * @param value Value to AND the bit with (bit value)
              */
-             constexpr const_iterator& operator/=(const size_type& amount) noexcept
+            constexpr bit_reference& operator&=(const bool value) noexcept
             {
-                this->m_index /= amount;
+                if (!value)
+                    reset();
                 return *this;
             }
 
             /**
-             * Inequality operator
-             * @param other Other iterator instance to compare with
-             * @return true if the iterators are not equal, false otherwise
+             * Bitwise OR assignment operator
+             * @param value Value to OR the bit with (bit value)
              */
-            [[nodiscard]] constexpr bool operator!=(const const_iterator& other) const noexcept
+            constexpr bit_reference& operator|=(const bool value) noexcept
             {
-                return this->m_index != other.m_index;
+                if (value)
+                    set();
+                return *this;
             }
 
             /**
-             *  Less than operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is less than the other iterator, false otherwise
+             * Bitwise XOR assignment operator
+             * @param value Value to XOR the bit with (bit value)
              */
-            [[nodiscard]] constexpr bool operator<(const const_iterator& other) const noexcept
+            constexpr bit_reference& operator^=(const bool value) noexcept
             {
-                return this->m_index < other.m_index;
+                if (value)
+                    flip();
+                return *this;
             }
 
             /**
-             *  Less than or equal operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is less than or equal to the other iterator, false otherwise
+             * Flip the bit
              */
-            [[nodiscard]] constexpr bool operator<=(const const_iterator& other) const noexcept
+            constexpr void flip() const noexcept
             {
-                return this->m_index <= other.m_index;
+                *m_block ^= m_mask;
             }
 
             /**
-             *  Equality operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the iterators are equal, false otherwise
+             * Set the bit to value
+             * @param value Value to set the bit to (bit value)
              */
-            [[nodiscard]] constexpr bool operator==(const const_iterator& other) const noexcept
+            constexpr void set(const bool value = true) const noexcept
             {
-                return this->m_index == other.m_index;
+                if (value)
+                    *m_block |= m_mask;
+                else
+                    *m_block &= static_cast<BlockType>(~m_mask);
             }
 
             /**
-             *  Bigger than or equal operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is bigger than or equal to the other iterator, false otherwise
+             * Reset the bit to 0 (false)
              */
-            [[nodiscard]] constexpr bool operator>=(const const_iterator& other) const noexcept
+            constexpr void reset() const noexcept
             {
-                return this->m_index >= other.m_index;
+                *m_block &= static_cast<BlockType>(~m_mask);
             }
 
             /**
-             *  Bigger than operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is bigger than the other iterator, false otherwise
+             * Swaps the values of two bits
+             * @param lhs Reference to the first bit
+             * @param rhs Reference to the second bit
              */
-            [[nodiscard]] constexpr bool operator>(const const_iterator& other) const noexcept
+            friend constexpr void swap(const bit_reference lhs, const bit_reference rhs) noexcept
             {
-                return this->m_index > other.m_index;
+                const bool value = lhs;
+                lhs.set(rhs);
+                rhs.set(value);
             }
+
+            BlockType* m_block = nullptr;
+            BlockType m_mask = 0;
         };
 
         /**
-         * Reverse iterator class
+         * Random access iterator over bits, holds the block of the current bit and the offset of the bit within it
+         * @tparam BlockType Type of the blocks
+         * @tparam Const Whether the iterator only reads the bits
          */
-        class reverse_iterator : public iterator_base<bitset&>
+        template <typename BlockType, bool Const>
+        class bit_iterator
         {
         public:
-            using iterator_base<bitset&>::iterator_base;
+            // Type definitions
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef std::random_access_iterator_tag iterator_concept;
+            typedef bool value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef void pointer;
+            typedef std::conditional_t<Const, bool, bit_reference<BlockType>> reference;
+            typedef std::conditional_t<Const, const BlockType, BlockType> block_type;
+
+            /**
+             * Empty constructor
+             */
+            constexpr bit_iterator() noexcept = default;
+
+            /**
+             * Constructs a new iterator pointing at the specified bit of the blocks
+             * @param data Blocks to iterate over
+             * @param index Index of the bit to point at (bit index)
+             */
+            constexpr bit_iterator(block_type* data, const std::size_t index) noexcept : m_block(data + index / m_block_size), m_offset(index % m_block_size) {}
 
             /**
-             * Conversion constructor to const_reverse_iterator
-             * @param other Other const_reverse_iterator instance to convert from
+             * Conversion constructor from a mutable iterator
+             * @tparam OtherConst Whether the other iterator only reads the bits (false)
+             * @param other Other iterator instance to convert from
              */
-            constexpr reverse_iterator(const const_reverse_iterator& other) noexcept : iterator_base<bitset&>(other.m_bitset, other.m_index) {}
+            template <bool OtherConst> requires (Const && !OtherConst)
+            constexpr bit_iterator(const bit_iterator<BlockType, OtherConst>& other) noexcept : m_block(other.m_block), m_offset(other.m_offset) {}
 
             /**
-             * Conversion assign operator to const_reverse_iterator
-             * @param other Other const_reverse_iterator instance to convert from
+             * Dereference operator
+             * @return Reference to the bit at the current position (bit value for a const iterator)
              */
-            constexpr reverse_iterator& operator=(const const_reverse_iterator& other) noexcept
+            [[nodiscard]] constexpr reference operator*() const noexcept
             {
-                this->m_bitset = other.m_bitset;
-                this->m_index = other.m_index;
-                return *this;
+                if constexpr (Const)
+                    return static_cast<bool>(*m_block >> m_offset & 1u);
+                else
+                    return reference(m_block, static_cast<BlockType>(BlockType{ 1 } << m_offset));
             }
 
             /**
-             * Dereference operator (returns the value of the bit at the current bit index)
-             * @return Reference to the bit at the current index
+             * Subscript operator
+             * @param amount Distance of the bit from the current position (bit count)
+             * @return Reference to the bit at the specified distance (bit value for a const iterator)
              */
-            [[nodiscard]] reference operator*() noexcept
+            [[nodiscard]] constexpr reference operator[](const difference_type amount) const noexcept
             {
-                return reference(this->m_bitset, this->m_index);
+                return *(*this + amount);
             }
 
-
             /**
-             * Increments the reverse_iterator to the next bit
+             * Increments the iterator to the next bit, pre-increment
              */
-            constexpr reverse_iterator& operator++() noexcept
+            constexpr bit_iterator& operator++() noexcept
             {
-                --this->m_index;
+                if (++m_offset == m_block_size)
+                {
+                    m_offset = 0;
+                    ++m_block;
+                }
                 return *this;
             }
 
             /**
-			 * Increments the reverse_iterator to the next bit, post-increment
-			 */
-            constexpr reverse_iterator& operator++(int) noexcept
+             * Increments the iterator to the next bit, post-increment
+             */
+            constexpr bit_iterator operator++(int) noexcept
             {
-                reverse_iterator tmp = *this;
-                --this->m_index;
+                const bit_iterator tmp = *this;
+                ++*this;
                 return tmp;
             }
 
             /**
-             * Decrements the reverse_iterator to the previous bit
+             * Decrements the iterator to the previous bit, pre-decrement
              */
-            constexpr reverse_iterator& operator--() noexcept
+            constexpr bit_iterator& operator--() noexcept
             {
-                ++this->m_index;
+                if (m_offset-- == 0)
+                {
+                    m_offset = m_block_size - 1;
+                    --m_block;
+                }
                 return *this;
             }
 
-
-
             /**
-             * Decrements the reverse_iterator to the previous bit, post-decrement
+             * Decrements the iterator to the previous bit, post-decrement
              */
-            constexpr reverse_iterator& operator--(int) noexcept
+            constexpr bit_iterator operator--(int) noexcept
             {
-                reverse_iterator tmp = *this;
-                ++this->m_index;
+                const bit_iterator tmp = *this;
+                --*this;
                 return tmp;
             }
 
             /**
-             * Returns the reverse_iterator with the specified amount added to it
-             * @param amount Amount to add to the reverse_iterator (bit count)
-             * @return New reverse_iterator instance with the specified amount added to it
+             * Adds the specified amount to the iterator
+             * @param amount Amount to add to the iterator (bit count, may be negative)
              */
-            [[nodiscard]] constexpr reverse_iterator&& operator+(const size_type& amount) const noexcept
+            constexpr bit_iterator& operator+=(const difference_type amount) noexcept
             {
-                return reverse_iterator(this->m_bitset, this->m_index - amount);
+                const difference_type index = static_cast<difference_type>(m_offset) + amount;
+                difference_type blocks = index / static_cast<difference_type>(m_block_size);
+                difference_type offset = index % static_cast<difference_type>(m_block_size);
+                if (offset < 0)
+                {
+                    offset += static_cast<difference_type>(m_block_size);
+                    --blocks;
+                }
+                m_block += blocks;
+                m_offset = static_cast<std::size_t>(offset);
+                return *this;
             }
+
             /**
-             * Returns the reverse_iterator with the specified amount subtracted from it
-             * @param amount Amount to subtract from the reverse_iterator (bit count)
-             * @return New reverse_iterator instance with the specified amount subtracted from it
+             * Subtracts the specified amount from the iterator
+             * @param amount Amount to subtract from the iterator (bit count, may be negative)
              */
-            [[nodiscard]] constexpr reverse_iterator&& operator-(const size_type& amount) const noexcept
+            constexpr bit_iterator& operator-=(const difference_type amount) noexcept
             {
-                return reverse_iterator(this->m_bitset, this->m_index + amount);
+                return *this += -amount;
             }
 
             /**
-			 * Returns difference between two iterators
-			 * @param other Other iterator instance subtract with
-			 * @return Difference between two iterators
-			 */
-            [[nodiscard]] constexpr difference_type operator-(const reverse_iterator& other) const noexcept
+             * Returns the iterator with the specified amount added to it
+             * @param it Iterator to add to
+             * @param amount Amount to add to the iterator (bit count)
+             * @return New iterator instance with the specified amount added to it
+             */
+            [[nodiscard]] friend constexpr bit_iterator operator+(bit_iterator it, const difference_type amount) noexcept
             {
-                return this->m_index + other.m_index;
+                return it += amount;
             }
 
             /**
-             * Returns difference between two iterators
-             * @param other Other iterator instance subtract with
-             * @return Difference between two iterators
+             * Returns the iterator with the specified amount added to it
+             * @param amount Amount to add to the iterator (bit count)
+             * @param it Iterator to add to
+             * @return New iterator instance with the specified amount added to it
              */
-            [[nodiscard]] constexpr difference_type operator-(const const_reverse_iterator& other) const noexcept
+            [[nodiscard]] friend constexpr bit_iterator operator+(const difference_type amount, bit_iterator it) noexcept
             {
-                return this->m_index + other.m_index;
+                return it += amount;
             }
 
             /**
-             * Adds the specified amount to the reverse_iterator
-             * @param amount Amount to add to the reverse_iterator (bit count)
+             * Returns the iterator with the specified amount subtracted from it
+             * @param it Iterator to subtract from
+             * @param amount Amount to subtract from the iterator (bit count)
+             * @return New iterator instance with the specified amount subtracted from it
              */
-            constexpr reverse_iterator& operator+=(const size_type& amount) const noexcept
+            [[nodiscard]] friend constexpr bit_iterator operator-(bit_iterator it, const difference_type amount) noexcept
             {
-                this->m_index -= amount;
-                return *this;
+                return it -= amount;
             }
 
             /**
-             * Subtracts the specified amount to the reverse_iterator
-             * @param amount Amount to add to the reverse_iterator (bit count)
+             * Returns difference between two iterators
+             * @param lhs Iterator to subtract from
+             * @param rhs Iterator to subtract
+             * @return Count of bits from rhs to lhs
              */
-            constexpr reverse_iterator& operator-=(const size_type& amount) const noexcept
+            [[nodiscard]] friend constexpr difference_type operator-(const bit_iterator& lhs, const bit_iterator& rhs) noexcept
             {
-                this->m_index += amount;
-                return *this;
+                return (lhs.m_block - rhs.m_block) * static_cast<difference_type>(m_block_size) + static_cast<difference_type>(lhs.m_offset) - static_cast<difference_type>(rhs.m_offset);
             }
 
             /**
-             * Inequality operator
-             * @param other Other reverse_iterator instance to compare against
-             * @return True if the instances are not equal, false otherwise
+             * Equality operator
+             * @return true if the iterators point at the same bit, false otherwise
              */
-            [[nodiscard]] constexpr bool operator!=(const reverse_iterator& other) const noexcept
-            {
-                return this->m_index != other.m_index;
-            }
+            [[nodiscard]] friend constexpr bool operator==(const bit_iterator&, const bit_iterator&) noexcept = default;
 
             /**
-             *  Less than operator
-             *  @param other Other reverse_iterator instance to compare against
-             *  @return True if the current instance is less than the other instance, false otherwise
+             * Three-way comparison operator, orders the iterators by the position of their bits
              */
-            [[nodiscard]] constexpr bool operator<(const reverse_iterator& other) const noexcept
-            {
-                return this->m_index > other.m_index;
-            }
+            [[nodiscard]] friend constexpr std::strong_ordering operator<=>(const bit_iterator&, const bit_iterator&) noexcept = default;
 
             /**
-             *  Less than or equal operator
-             *  @param other Other reverse_iterator instance to compare against
-             *  @return True if the current instance is less than or equal to the other instance, false otherwise
+             * Size of a block (bit count)
              */
-            [[nodiscard]] constexpr bool operator<=(const reverse_iterator& other) const noexcept
+            static constexpr std::size_t m_block_size = sizeof(BlockType) * CHAR_BIT;
+
+            block_type* m_block = nullptr;
+            std::size_t m_offset = 0;
+        };
+
+        // Word-level overloads of the bit algorithms for the bit iterators, like the ones of std::vector<bool>
+        // Found by argument-dependent lookup for unqualified find, count and fill calls
+
+        /**
+         * Finds the first bit equal to value, a block at a time
+         * @tparam BlockType Type of the blocks
+         * @tparam Const Whether the iterators only read the bits
+         * @tparam T Type of the value
+         * @param first Begin of the range to search
+         * @param last End of the range to search
+         * @param value Value to compare the bits with
+         * @return Iterator to the found bit, last if there is none
+         */
+        template <unsigned_integer BlockType, bool Const, typename T>
+        [[nodiscard]] constexpr bit_iterator<BlockType, Const> find(const bit_iterator<BlockType, Const> first, const bit_iterator<BlockType, Const> last, const T& value)
+        {
+            // The bits compare as bools, a value equal to neither true nor false matches no bit
+            const bool matches_true = true == value, matches_false = false == value;
+            if (matches_true == matches_false)
+                return matches_true ? first : last;
+            const std::size_t end = static_cast<std::size_t>(last - first) + first.m_offset;
+            return bit_iterator<BlockType, Const>(first.m_block, find_bit(first.m_block, first.m_offset, end, matches_true));
+        }
+
+        /**
+         * Counts the bits equal to value, a block at a time
+         * @tparam BlockType Type of the blocks
+         * @tparam Const Whether the iterators only read the bits
+         * @tparam T Type of the value
+         * @param first Begin of the range to count
+         * @param last End of the range to count
+         * @param value Value to compare the bits with
+         * @return Count of bits equal to value
+         */
+        template <unsigned_integer BlockType, bool Const, typename T>
+        [[nodiscard]] constexpr std::ptrdiff_t count(const bit_iterator<BlockType, Const> first, const bit_iterator<BlockType, Const> last, const T& value)
+        {
+            const bool matches_true = true == value, matches_false = false == value;
+            const std::ptrdiff_t size = last - first;
+            if (matches_true == matches_false)
+                return matches_true ? size : 0;
+            const std::ptrdiff_t set = static_cast<std::ptrdiff_t>(count_range(first.m_block, first.m_offset, static_cast<std::size_t>(size) + first.m_offset));
+            return matches_true ? set : size - set;
+        }
+
+        /**
+         * Fills the bits with value, a block at a time
+         * @tparam BlockType Type of the blocks
+         * @tparam T Type of the value
+         * @param first Begin of the range to fill
+         * @param last End of the range to fill
+         * @param value Value to fill the bits with (converted to bool)
+         */
+        template <unsigned_integer BlockType, typename T>
+        constexpr void fill(const bit_iterator<BlockType, false> first, const bit_iterator<BlockType, false> last, const T& value)
+        {
+            fill_range(first.m_block, first.m_offset, static_cast<std::size_t>(last - first) + first.m_offset, static_cast<bool>(value));
+        }
+
+        /**
+         * Count of indices whose blocks are prefetched ahead of the one being accessed
+         */
+        inline constexpr std::size_t index_prefetch_distance = 16;
+
+        /**
+         * Log2 of the bit count covered by one partition of the indices (256 KiB of blocks)
+         */
+        inline constexpr std::size_t index_partition_shift = 21;
+
+        /**
+         * Radix-partitions indices by the 256 KiB region of the bits they fall into, keeping their order within a region
+         * @tparam Index Type of the indices
+         * @param indices Indices to partition
+         * @param count Count of indices
+         * @param size Count of bits the indices point into
+         * @param partitioned Partitioned indices (count elements)
+         * @return Offset of the first index of every region in partitioned
+         */
+        template <typename Index>
+        constexpr std::vector<std::size_t> partition_indices(const Index* indices, const std::size_t count, const std::size_t size, Index* partitioned) noexcept
+        {
+            std::vector<std::size_t> offsets((size >> index_partition_shift) + 2);
+            for (std::size_t i = 0; i < count; ++i)
+                ++offsets[(indices[i] >> index_partition_shift) + 1];
+            for (std::size_t i = 1; i < offsets.size(); ++i)
+                offsets[i] += offsets[i - 1];
+
+            std::vector<std::size_t> next(offsets);
+            for (std::size_t i = 0; i < count; ++i)
+                partitioned[next[indices[i] >> index_partition_shift]++] = indices[i];
+            return offsets;
+        }
+
+        /**
+         * Checks if partitioning the indices pays off, the bits must span several partitions and every partition must
+         * receive enough indices (one per 4096 bits) to make up for the two extra passes
+         * @param size Count of bits the indices point into
+         * @param count Count of indices
+         * @return true if the indices should be partitioned, false otherwise
+         */
+        [[nodiscard]] constexpr bool should_partition(const std::size_t size, const std::size_t count) noexcept
+        {
+            return size >> index_partition_shift > 1 && count >= size >> 12;
+        }
+
+        /**
+         * Applies op to the block and mask of every index, prefetching the blocks of the indices a window ahead
+         * Partitioning turns the random accesses into one pass per 256 KiB region, which stays in the L2 cache.
+         * @tparam BlockType Type of the blocks
+         * @tparam Index Type of the indices
+         * @param data Blocks to modify
+         * @param size Count of bits (all indices must be less)
+         * @param indices Indices of the bits
+         * @param count Count of indices
+         * @param partition Whether to partition the indices first (only done if the bits span several partitions)
+         * @param op Operation applied as op(block, mask)
+         */
+        template <typename BlockType, typename Index, typename Op>
+        constexpr void apply_indices(BlockType* data, const std::size_t size, const Index* indices, const std::size_t count, const bool partition, Op op) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+            std::vector<Index> partitioned;
+            if (partition && should_partition(size, count))
             {
-                return this->m_index >= other.m_index;
+                partitioned.resize(count);
+                partition_indices(indices, count, size, partitioned.data());
+                indices = partitioned.data();
             }
 
-            /**
-             *  Equality operator
-             *  @param other Other reverse_iterator instance to compare against
-             *  @return True if the instances are equal, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator==(const reverse_iterator& other) const noexcept
+            for (std::size_t i = 0; i < count; ++i)
             {
-                return this->m_index == other.m_index;
+                if (!std::is_constant_evaluated() && i + index_prefetch_distance < count)
+                    prefetch(data + indices[i + index_prefetch_distance] / block_size);
+                op(data[indices[i] / block_size], static_cast<BlockType>(BlockType{ 1 } << indices[i] % block_size));
             }
+        }
 
-            /**
-             *  Bigger than or equal operator
-             *  @param other Other reverse_iterator instance to compare against
-             *  @return True if the current instance is bigger than or equal to the other instance, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator>=(const reverse_iterator& other) const noexcept
+        /**
+         * Tests the bit of every index, prefetching the blocks of the indices a window ahead
+         * Partitioned tests are written in partition order, then handed out in the order of the indices by replaying
+         * the partition offsets, so neither pass writes to random positions.
+         * @tparam BlockType Type of the blocks
+         * @tparam Index Type of the indices
+         * @tparam Out Type of the result function
+         * @param data Blocks to test
+         * @param size Count of bits (all indices must be less)
+         * @param indices Indices of the bits
+         * @param count Count of indices
+         * @param partition Whether to partition the indices first (only done if the bits span several partitions)
+         * @param out Function called as out(position, value) for every index, in the order of the indices
+         */
+        template <typename BlockType, typename Index, typename Out>
+        constexpr void test_indices(const BlockType* data, const std::size_t size, const Index* indices, const std::size_t count, const bool partition, Out out) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+            const auto test = [data](const Index index) noexcept { return static_cast<bool>(data[index / block_size] >> index % block_size & 1); };
+            if (!partition || !should_partition(size, count))
             {
-                return this->m_index >= other.m_index;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (!std::is_constant_evaluated() && i + index_prefetch_distance < count)
+                        prefetch(data + indices[i + index_prefetch_distance] / block_size);
+                    out(i, test(indices[i]));
+                }
+                return;
             }
 
-            /**
-             *  Bigger than operator
-             *  @param other Other reverse_iterator instance to compare against
-             *  @return True if the current instance is bigger than the other instance, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator>(const reverse_iterator& other) const noexcept
+            std::vector<Index> partitioned(count);
+            std::vector<std::size_t> offsets = partition_indices(indices, count, size, partitioned.data());
+            std::vector<unsigned char> values(count);
+            for (std::size_t i = 0; i < count; ++i)
+                values[i] = test(partitioned[i]);
+            for (std::size_t i = 0; i < count; ++i)
+                out(i, static_cast<bool>(values[offsets[indices[i] >> index_partition_shift]++]));
+        }
+
+        /**
+         * Prefix XOR of a value, bit i of the result is the parity of bits 0 to i
+         * @tparam BlockType Type of the value
+         * @param value Value to scan
+         * @return Prefix XOR of the value
+         */
+        template <typename BlockType>
+        [[nodiscard]] constexpr BlockType prefix_xor(BlockType value) noexcept
+        {
+            for (std::size_t shift = 1; shift < sizeof(BlockType) * CHAR_BIT; shift <<= 1)
+                value = static_cast<BlockType>(value ^ value << shift);
+            return value;
+        }
+
+        /**
+         * Gathers the bits of value selected by mask into the low bits of the result (parallel bit extract)
+         * Uses pext when BMI2 is enabled, otherwise the log-step compress of Hacker's Delight, which does not
+         * depend on the density of the mask.
+         * @tparam BlockType Type of the blocks
+         * @param value Block to gather from
+         * @param mask Bits to gather
+         * @return Gathered bits, packed from bit 0
+         */
+        template <typename BlockType>
+        [[nodiscard]] constexpr BlockType extract_bits(BlockType value, BlockType mask) noexcept
+        {
+#if defined(__BMI2__) && defined(__x86_64__)
+            if constexpr (sizeof(BlockType) <= sizeof(std::uint64_t))
             {
-                return this->m_index < other.m_index;
+                if (!std::is_constant_evaluated())
+                    return static_cast<BlockType>(_pext_u64(value, mask));
             }
-        };
+#endif
+            value &= mask;
+            // Bits of mk count the zeros of mask to the right of every bit
+            BlockType mk = static_cast<BlockType>(~mask << 1);
+            for (std::size_t shift = 1; shift < sizeof(BlockType) * CHAR_BIT; shift <<= 1)
+            {
+                const BlockType mp = prefix_xor(mk);
+                const BlockType mv = mp & mask;
+                mask = static_cast<BlockType>((mask ^ mv) | mv >> shift);
+                const BlockType moved = value & mv;
+                value = static_cast<BlockType>((value ^ moved) | moved >> shift);
+                mk &= static_cast<BlockType>(~mp);
+            }
+            return value;
+        }
 
         /**
-         * Reverse iterator class
+         * Scatters the low bits of value to the bits selected by mask (parallel bit deposit)
+         * Uses pdep when BMI2 is enabled, otherwise the log-step expand of Hacker's Delight.
+         * @tparam BlockType Type of the blocks
+         * @param value Block whose low bits are scattered
+         * @param mask Bits to scatter to
+         * @return Scattered bits, zero outside of mask
          */
-        class const_reverse_iterator : public iterator_base<const bitset&>
+        template <typename BlockType>
+        [[nodiscard]] constexpr BlockType deposit_bits(BlockType value, const BlockType mask) noexcept
         {
-        public:
-            using iterator_base<const bitset&>::iterator_base;
+#if defined(__BMI2__) && defined(__x86_64__)
+            if constexpr (sizeof(BlockType) <= sizeof(std::uint64_t))
+            {
+                if (!std::is_constant_evaluated())
+                    return static_cast<BlockType>(_pdep_u64(value, mask));
+            }
+#endif
+            constexpr std::size_t rounds = std::bit_width(sizeof(BlockType) * CHAR_BIT) - 1;
 
-            /**
-             * Dereference operator (returns the value of the bit at the current bit index)
-             * @return Value of the bit at the current index (bit value)
-             */
-            [[nodiscard]] const_reference operator*() const noexcept
+            // Record the moves of the compress, then undo them in reverse order
+            BlockType moves[rounds];
+            BlockType m = mask;
+            BlockType mk = static_cast<BlockType>(~mask << 1);
+            for (std::size_t i = 0; i < rounds; ++i)
             {
-                return this->m_bitset.test(this->m_index);
+                const BlockType mp = prefix_xor(mk);
+                moves[i] = mp & m;
+                m = static_cast<BlockType>((m ^ moves[i]) | moves[i] >> (std::size_t{ 1 } << i));
+                mk &= static_cast<BlockType>(~mp);
             }
+            for (std::size_t i = rounds; i-- > 0;)
+                value = static_cast<BlockType>((value & ~moves[i]) | (value << (std::size_t{ 1 } << i) & moves[i]));
+            return value & mask;
+        }
 
+        /**
+         * Packs the bits of data selected by mask densely into result
+         * Output offsets are the running popcount of the mask, so the per-block extracts do not depend on each other.
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks to gather from
+         * @param mask Blocks selecting the bits
+         * @param result Zeroed blocks receiving the packed bits
+         * @param storage_size Count of blocks of all three arrays
+         * @param last_mask Valid bits of the last block
+         */
+        template <typename BlockType>
+        constexpr void compress_blocks(const BlockType* data, const BlockType* mask, BlockType* result, const std::size_t storage_size, const BlockType last_mask) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
 
-            /**
-             * Increments the reverse_iterator to the next bit
-             */
-            constexpr const_reverse_iterator& operator++() noexcept
+            std::size_t offset = 0;
+            for (std::size_t i = 0; i < storage_size; ++i)
             {
-                --this->m_index;
-                return *this;
+                const BlockType selected = i + 1 == storage_size ? static_cast<BlockType>(mask[i] & last_mask) : mask[i];
+                const BlockType packed = extract_bits(data[i], selected);
+                const std::size_t block = offset / block_size, shift = offset % block_size;
+                result[block] |= static_cast<BlockType>(packed << shift);
+                if (shift && block + 1 < storage_size)
+                    result[block + 1] |= static_cast<BlockType>(packed >> (block_size - shift));
+                offset += static_cast<std::size_t>(detail::popcount(selected));
             }
+        }
 
-            /**
-			 * Increments the reverse_iterator to the next bit, post-increment
-			 */
-            constexpr const_reverse_iterator& operator++(int) noexcept
+        /**
+         * Scatters the low bits of data to the bits selected by mask
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks whose low bits are scattered
+         * @param mask Blocks selecting the destination bits
+         * @param result Blocks receiving the scattered bits (bits outside of mask are cleared)
+         * @param storage_size Count of blocks of all three arrays
+         * @param last_mask Valid bits of the last block
+         */
+        template <typename BlockType>
+        constexpr void expand_blocks(const BlockType* data, const BlockType* mask, BlockType* result, const std::size_t storage_size, const BlockType last_mask) noexcept
+        {
+            std::size_t offset = 0;
+            for (std::size_t i = 0; i < storage_size; ++i)
             {
-                const_reverse_iterator tmp = *this;
-                --this->m_index;
-                return tmp;
+                const BlockType selected = i + 1 == storage_size ? static_cast<BlockType>(mask[i] & last_mask) : mask[i];
+                const std::size_t count = static_cast<std::size_t>(detail::popcount(selected));
+                result[i] = deposit_bits(read_bits<BlockType>(data, storage_size, offset, count), selected);
+                offset += count;
             }
+        }
 
-            /**
-             * Decrements the reverse_iterator to the previous bit
-             */
-            constexpr const_reverse_iterator& operator--() noexcept
+        /**
+         * Transposes a square bit matrix of one word per row in place by recursively swapping its off-diagonal blocks
+         * Bit j of rows[i] is the element at row i and column j.
+         * @tparam Word Type of the rows (the matrix has as many rows as Word has bits)
+         * @param rows Rows of the matrix
+         */
+        template <typename Word>
+        constexpr void transpose_square(Word* rows) noexcept
+        {
+            constexpr std::size_t size = sizeof(Word) * CHAR_BIT;
+
+            // Columns of the left half of every block of the current width
+            Word mask = (std::numeric_limits<Word>::max)();
+            for (std::size_t width = size / 2; width; width >>= 1)
             {
-                ++this->m_index;
-                return *this;
+                mask = static_cast<Word>(mask ^ mask << width);
+                for (std::size_t i = 0; i < size; i = (i + width + 1) & ~width)
+                {
+                    const Word swapped = static_cast<Word>((rows[i] >> width ^ rows[i + width]) & mask);
+                    rows[i + width] ^= swapped;
+                    rows[i] ^= static_cast<Word>(swapped << width);
+                }
             }
+        }
+
+        /**
+         * One period of the block masks of a strided bit pattern (every step-th bit, starting at bit 0 of block 0)
+         * The pattern repeats every lcm(step, block bits) bits, the period is replicated up to the mask capacity
+         * so loops applying it run long enough to vectorize.
+         * @tparam BlockType Type of the blocks
+         */
+        template <typename BlockType>
+        struct periodic_masks
+        {
+            static constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
 
             /**
-             * Decrements the reverse_iterator to the previous bit, post-decrement
+             * Maximal count of masks, at least 64 so that narrow blocks still get long loops
              */
-            constexpr const_reverse_iterator& operator--(int) noexcept
-            {
-                const_reverse_iterator tmp = *this;
-                ++this->m_index;
-                return tmp;
-            }
+            static constexpr std::size_t capacity = block_size > 64 ? block_size : 64;
 
             /**
-             * Returns the reverse_iterator with the specified amount added to it
-             * @param amount Amount to add to the reverse_iterator (bit count)
-             * @return New reverse_iterator instance with the specified amount added to it
+             * Constructs the masks of the specified step
+             * @param step Step between the set bits (must be between 1 and block_size - 1)
              */
-            [[nodiscard]] constexpr const_reverse_iterator&& operator+(const size_type& amount) const noexcept
+            constexpr explicit periodic_masks(const std::size_t step) noexcept
             {
-                return const_reverse_iterator(this->m_index, this->m_index - amount);
+                const std::size_t period = step / std::gcd(step, block_size);
+                length = capacity / period * period;
+
+                // Build a single period, then replicate it
+                for (std::size_t i = 0; i < period * block_size; i += step)
+                    masks[i / block_size] |= static_cast<BlockType>(BlockType{ 1 } << i % block_size);
+                for (std::size_t i = period; i < length; ++i)
+                    masks[i] = masks[i - period];
             }
+
             /**
-             * Returns the reverse_iterator with the specified amount subtracted from it
-             * @param amount Amount to subtract from the reverse_iterator (bit count)
-             * @return New reverse_iterator instance with the specified amount subtracted from it
+             * Masks of consecutive blocks, block i of the pattern uses masks[i % length]
              */
-            [[nodiscard]] constexpr const_reverse_iterator&& operator-(const size_type& amount) const noexcept
-            {
-                return const_reverse_iterator(this->m_index, this->m_index + amount);
-            }
+            BlockType masks[capacity] = {};
 
             /**
-			 * Returns difference between two iterators
-			 * @param other Other iterator instance subtract with
-			 * @return Difference between two iterators
-			 */
-            [[nodiscard]] constexpr difference_type operator-(const const_reverse_iterator& other) const noexcept
+             * Count of masks used (a multiple of the period in blocks)
+             */
+            std::size_t length = 0;
+        };
+
+        /**
+         * Periodic masks computed at compile time
+         * @tparam BlockType Type of the blocks
+         * @tparam Step Step between the set bits (must be between 1 and block bit count - 1)
+         */
+        template <typename BlockType, std::size_t Step>
+        inline constexpr periodic_masks<BlockType> periodic_masks_v{ Step };
+
+        /**
+         * Applies op to every step-th bit of the range [begin, end), one bit at a time
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks to modify
+         * @param begin Begin of the range (bit index)
+         * @param end End of the range (bit index)
+         * @param step Step between the modified bits (bit step)
+         * @param op Operation applied as op(block, mask)
+         */
+        template <typename BlockType, typename Op>
+        constexpr void apply_each(BlockType* data, const std::size_t begin, const std::size_t end, const std::size_t step, Op op) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+            for (std::size_t i = begin; i < end; i += step)
+                op(data[i / block_size], static_cast<BlockType>(BlockType{ 1 } << i % block_size));
+        }
+
+        /**
+         * Applies op to every step-th bit of the range [begin, end) using the periodic masks of the step
+         * The masks are shifted to the phase of begin and applied a block at a time.
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks to modify
+         * @param begin Begin of the range (bit index)
+         * @param end End of the range (bit index)
+         * @param step Step between the modified bits (bit step, shorter than a block)
+         * @param base Periodic masks of the step
+         * @param op Operation applied as op(block, mask)
+         */
+        template <typename BlockType, typename Op>
+        constexpr void apply_periodic(BlockType* data, const std::size_t begin, const std::size_t end, const std::size_t step, const periodic_masks<BlockType>& base, Op op) noexcept
+        {
+            constexpr std::size_t block_size = periodic_masks<BlockType>::block_size;
+
+            if (begin >= end)
+                return;
+
+            // Too few bits to pay for shifting the masks
+            if ((end - begin) / step < block_size)
             {
-                return this->m_index - other.m_index;
+                apply_each(data, begin, end, step, op);
+                return;
             }
 
-            /**
-             * Returns difference between two iterators
-             * @param other Other iterator instance subtract with
-             * @return Difference between two iterators
-             */
-            [[nodiscard]] constexpr difference_type operator-(const reverse_iterator& other) const noexcept
+            const std::size_t first_block = begin / block_size;
+            const std::size_t last_block = (end - 1) / block_size;
+            const std::size_t length = base.length;
+
+            // Shift the pattern so that it hits begin, the pattern is periodic so the shift wraps around
+            BlockType masks[periodic_masks<BlockType>::capacity];
+            const std::size_t phase = begin % step;
+            for (std::size_t i = 0; i < length; ++i)
             {
-                return this->m_index - other.m_index;
+                masks[i] = phase ? static_cast<BlockType>(base.masks[i] << phase | base.masks[i ? i - 1 : length - 1] >> (block_size - phase)) : base.masks[i];
             }
 
-            /**
-             * Adds the specified amount to the reverse_iterator
-             * @param amount Amount to add to the reverse_iterator (bit count)
-             */
-            constexpr const_reverse_iterator& operator+=(const size_type& amount) noexcept
+            const BlockType first_mask = mask_from<BlockType>(begin);
+            const BlockType last_mask = mask_until<BlockType>(end);
+
+            // A range within one block takes a single mask, the loops below would apply op to it twice
+            if (first_block == last_block)
             {
-                this->m_index -= amount;
-                return *this;
+                op(data[first_block], static_cast<BlockType>(masks[first_block % length] & first_mask & last_mask));
+                return;
             }
 
-            /**
-             * Subtracts the specified amount to the reverse_iterator
-             * @param amount Amount to add to the reverse_iterator (bit count)
-             */
-            constexpr const_reverse_iterator& operator-=(const size_type& amount) noexcept
+            std::size_t index = first_block % length;
+            op(data[first_block], static_cast<BlockType>(masks[index] & first_mask));
+
+            // Reach the start of a period, then apply whole periods
+            std::size_t block = first_block + 1;
+            for (index = (index + 1) % length; index && block < last_block; ++block, index = (index + 1) % length)
+                op(data[block], masks[index]);
+            for (; block + length <= last_block; block += length)
             {
-                this->m_index += amount;
-                return *this;
+                for (std::size_t i = 0; i < length; ++i)
+                    op(data[block + i], masks[i]);
             }
+            for (index = 0; block < last_block; ++block, ++index)
+                op(data[block], masks[index]);
 
-            /**
-             * Inequality operator
-             * @param other Other const_reverse_iterator instance to compare against
-             * @return true if instances are not equal, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator!=(const const_reverse_iterator& other) const noexcept
+            op(data[last_block], static_cast<BlockType>(masks[last_block % length] & last_mask));
+        }
+
+        /**
+         * Applies op to every step-th bit of the range [begin, end)
+         * Steps shorter than a block go through apply_periodic, longer steps touch at most one bit per block and are
+         * applied bit by bit.
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks to modify
+         * @param begin Begin of the range (bit index)
+         * @param end End of the range (bit index)
+         * @param step Step between the modified bits (bit step)
+         * @param op Operation applied as op(block, mask)
+         */
+        template <typename BlockType, typename Op>
+        constexpr void apply_strided(BlockType* data, const std::size_t begin, const std::size_t end, const std::size_t step, Op op) noexcept
+        {
+            constexpr std::size_t block_size = periodic_masks<BlockType>::block_size;
+
+            if (begin >= end || !step)
+                return;
+
+            // Sparse patterns, or too few bits to pay for building the masks
+            if (step >= block_size || (end - begin) / step < 4 * block_size)
+                apply_each(data, begin, end, step, op);
+            else
+                apply_periodic(data, begin, end, step, periodic_masks<BlockType>{ step }, op);
+        }
+
+        /**
+         * Whether std::bitset of the standard library in use is an array of unsigned words holding bit i at bit
+         * i % w of word i / w (true of libstdc++, libc++ and the MSVC STL). On little-endian targets its bytes then
+         * hold the bits in the same order as the blocks of any type, and the conversions copy memory directly.
+         */
+        inline constexpr bool std_bitset_is_word_array =
+#if defined(__GLIBCXX__) || defined(_LIBCPP_VERSION) || defined(_MSVC_STL_VERSION)
+            std::endian::native == std::endian::little;
+#else
+            false;
+#endif
+
+        /**
+         * Whether std::vector<bool> exposes its words, libstdc++ bit iterators hold a public pointer to the word
+         */
+        inline constexpr bool std_vector_bool_is_word_array =
+#if defined(__GLIBCXX__)
+            std::endian::native == std::endian::little;
+#else
+            false;
+#endif
+
+        /**
+         * Copies the low bits of a std::bitset into blocks
+         * @tparam N Size of the std::bitset
+         * @tparam BlockType Type of the blocks
+         * @param bits Bits to copy
+         * @param data Zeroed blocks receiving the bits, bits past count in the last touched byte are unspecified
+         * @param count Count of bits to copy (at most N)
+         */
+        template <std::size_t N, typename BlockType>
+        constexpr void from_std_bitset(const std::bitset<N>& bits, BlockType* data, const std::size_t count) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+            if constexpr (std_bitset_is_word_array)
             {
-                return this->m_index != other.m_index;
+                if (!std::is_constant_evaluated())
+                {
+                    std::memcpy(data, &bits, (count + CHAR_BIT - 1) / CHAR_BIT);
+                    return;
+                }
             }
+            for (std::size_t i = 0; i < count; ++i)
+                data[i / block_size] |= static_cast<BlockType>(static_cast<BlockType>(bits[i]) << i % block_size);
+        }
 
-            /**
-             *  Less than operator
-             *  @param other Other const_reverse_iterator instance to compare against
-             *  @return true if the current instance is less than the other instance, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator<(const const_reverse_iterator& other) const noexcept
+        /**
+         * Copies the low bits of blocks into a std::bitset
+         * @tparam N Size of the std::bitset
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks to copy
+         * @param count Count of bits to copy (at most N)
+         * @param bits Reset std::bitset receiving the bits
+         */
+        template <std::size_t N, typename BlockType>
+        void to_std_bitset(const BlockType* data, const std::size_t count, std::bitset<N>& bits) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+            if constexpr (std_bitset_is_word_array)
             {
-                return this->m_index > other.m_index;
+                // Whole bytes, then the bits before count of a partial last byte, std::bitset needs the rest reset
+                std::memcpy(static_cast<void*>(&bits), data, count / CHAR_BIT);
+                for (std::size_t i = count / CHAR_BIT * CHAR_BIT; i < count; ++i)
+                    bits[i] = data[i / block_size] >> i % block_size & 1;
             }
-
-            /**
-             *  Less than or equal operator
-             *  @param other Other const_reverse_iterator instance to compare against
-             *  @return true if the current instance is less than or equal to the other instance, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator<=(const const_reverse_iterator& other) const noexcept
+            else
             {
-                return this->m_index >= other.m_index;
+                for (std::size_t i = 0; i < count; ++i)
+                    bits[i] = data[i / block_size] >> i % block_size & 1;
             }
+        }
 
-            /**
-             *  Equality operator
-             *  @param other Other const_reverse_iterator instance to compare against
-             *  @return true if instances are equal, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator==(const const_reverse_iterator& other) const noexcept
+        /**
+         * Copies the bits of a std::vector<bool> into blocks
+         * @tparam BlockType Type of the blocks
+         * @param bits Bits to copy
+         * @param data Zeroed blocks receiving the bits, bits past bits.size() in the last touched byte are unspecified
+         */
+        template <typename BlockType>
+        void from_std_vector(const std::vector<bool>& bits, BlockType* data) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+            if (bits.empty())
+                return;
+#if defined(__GLIBCXX__)
+            if constexpr (std_vector_bool_is_word_array)
             {
-                return this->m_index == other.m_index;
+                std::memcpy(data, bits.begin()._M_p, (bits.size() + CHAR_BIT - 1) / CHAR_BIT);
+                return;
             }
-
-            /**
-             *  Bigger than or equal operator
-             *  @param other Other const_reverse_iterator instance to compare against
-             *  @return true if the current instance is bigger than or equal to the other instance, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator>=(const const_reverse_iterator& other) const noexcept
+#endif
+            std::size_t i = 0;
+            for (const bool bit : bits)
             {
-                return this->m_index >= other.m_index;
+                data[i / block_size] |= static_cast<BlockType>(static_cast<BlockType>(bit) << i % block_size);
+                ++i;
             }
+        }
 
-            /**
-             *  Bigger than operator
-             *  @param other Other const_reverse_iterator instance to compare against
-             *  @return true if the current instance is bigger than the other instance, false otherwise
-             */
-            [[nodiscard]] constexpr bool operator>(const const_reverse_iterator& other) const noexcept
+        /**
+         * Copies the low bits of blocks into a std::vector<bool>
+         * @tparam BlockType Type of the blocks
+         * @param data Blocks to copy
+         * @param bits Reset std::vector<bool> receiving the bits, its size is the count of bits copied
+         */
+        template <typename BlockType>
+        void to_std_vector(const BlockType* data, std::vector<bool>& bits) noexcept
+        {
+            constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+            if (bits.empty())
+                return;
+#if defined(__GLIBCXX__)
+            if constexpr (std_vector_bool_is_word_array)
+            {
+                // The bits past size() share the last byte, clear them like the vector itself would leave them
+                unsigned char* bytes = reinterpret_cast<unsigned char*>(bits.begin()._M_p);
+                std::memcpy(bytes, data, (bits.size() + CHAR_BIT - 1) / CHAR_BIT);
+                if (bits.size() % CHAR_BIT)
+                    bytes[bits.size() / CHAR_BIT] &= static_cast<unsigned char>((1u << bits.size() % CHAR_BIT) - 1);
+                return;
+            }
+#endif
+            std::size_t i = 0;
+            for (auto bit : bits)
             {
-                return this->m_index < other.m_index;
+                bit = data[i / block_size] >> i % block_size & 1;
+                ++i;
             }
-        };
+        }
+    }
+
+    /**
+     * Fixed-size BitSet class
+     * @tparam BlockType Type of block to use for bit storage (may be one of unsigned integer types)
+     * @tparam Size Size of bitset, in bits
+     */
+    template <unsigned_integer BlockType, std::size_t Size>
+    class bitset
+    {
+    public:
+        friend std::ostream& operator<<(std::ostream& os, const bitset& obj)
+        {
+            for (size_type i = 0; i < Size; ++i)
+                os << obj.test(i);
+            return os;
+        }
+
+        // Type definitions
+
+        // Reference types
+        typedef detail::bit_reference<BlockType> reference;
+        typedef bool const_reference;
+
+        // Iterators
+        typedef detail::bit_iterator<BlockType, false> iterator;
+        typedef detail::bit_iterator<BlockType, true> const_iterator;
+
+        // Reverse iterators
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        // Value types
+        typedef bool value_type;
+        typedef bool const_value_type;
+
+        // Other types
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+    	typedef BlockType block_type;
 
         /**
          * Empty constructor
@@ -1123,7 +2151,7 @@ namespace woj
          * @param set_chr Character that represents set bits
 		 */
         template <typename PtrArr = const char*, char_type Elem = std::remove_cvref_t<std::remove_pointer_t<std::remove_cvref_t<PtrArr>>>> requires (std::is_pointer_v<PtrArr> && !std::is_array_v<PtrArr>)
-        bitset(PtrArr c_str, const Elem& set_chr = '1') noexcept : m_data{ 0 }
+        constexpr bitset(PtrArr c_str, const Elem& set_chr = '1') noexcept : m_data{ 0 }
         {
             _from_c_string<PtrArr, Elem>(c_str, set_chr);
         }
@@ -1140,6 +2168,17 @@ namespace woj
             _from_string<Elem>(str, set_chr);
         }
 
+        /**
+         * std::bitset conversion constructor, copies whole words where the layout of std::bitset is known
+         * @tparam OtherSize Size of the std::bitset to convert from
+         * @param other std::bitset to convert from, bits past Size are dropped and bits past OtherSize are reset
+         */
+        template <size_type OtherSize>
+        explicit constexpr bitset(const std::bitset<OtherSize>& other) noexcept : m_data{ 0 }
+        {
+            detail::from_std_bitset(other, m_data, (std::min)(Size, OtherSize));
+        }
+
         /**
          * Destructor
          */
@@ -1150,7 +2189,7 @@ namespace woj
          * @param index Index of the bit to retrieve (bit index)
          * @return Value of the bit at the specified index (bit value)
          */
-        [[nodiscard]] const_reference operator[](const size_type& index) const noexcept
+        [[nodiscard]] constexpr const_reference operator[](const size_type& index) const noexcept
         {
             return m_data[index / m_block_size] & BlockType{1} << index % m_block_size;
         }
@@ -1160,9 +2199,9 @@ namespace woj
          * @param index Index of the bit to retrieve (bit index)
          * @return Reference to the value of the bit at the specified index
          */
-        [[nodiscard]] reference operator[](const size_type& index) noexcept
+        [[nodiscard]] constexpr reference operator[](const size_type& index) noexcept
         {
-            return reference(*this, index);
+            return reference(m_data + index / m_block_size, static_cast<BlockType>(BlockType{ 1 } << index % m_block_size));
         }
 
         // assignment operator
@@ -1224,7 +2263,7 @@ namespace woj
          * @param c_str Pointer to c string to convert from (must be null-terminated)
          */
         template <typename PtrArr = const char*, char_type Elem = std::remove_cvref_t<std::remove_pointer_t<std::remove_cvref_t<PtrArr>>>> requires (std::is_pointer_v<PtrArr> && !std::is_array_v<PtrArr>)
-        bitset& operator=(PtrArr c_str) noexcept
+        constexpr bitset& operator=(PtrArr c_str) noexcept
         {
             reset();
             _from_c_string<PtrArr, Elem>(c_str, '1');
@@ -1273,7 +2312,7 @@ namespace woj
             }
             if (m_partial_size)
             {
-                const BlockType mask = (1 << m_partial_size) - 1;
+                const BlockType mask = (BlockType{ 1 } << m_partial_size) - 1;
                 if ((m_data[m_storage_size - 1] & mask) != (other.m_data[m_storage_size - 1] & mask))
                     return false;
             }
@@ -1299,21 +2338,210 @@ namespace woj
          */
         [[nodiscard]] constexpr bool operator!=(const bitset& other) const noexcept
         {
-            for (size_type i = 0; i < m_full_storage_size; ++i)
-            {
-                if (m_data[i] == other.m_data[i])
-                    return false;
-            }
-            if (m_partial_size)
-            {
-                const BlockType mask = (1 << m_partial_size) - 1;
-                if ((m_data[m_storage_size - 1] & mask) == (other.m_data[m_storage_size - 1] & mask))
-                    return false;
-            }
-            return true;
-		}
+            return !(*this == other);
+        }
 
-        // Bitwise operators
+    private:
+
+        /**
+         * Orders two differing blocks by the lowest bit index they differ at
+         * @param lhs Block of the left-hand side
+         * @param rhs Block of the right-hand side (must differ from lhs)
+         * @return greater if lhs has the differing bit set, less otherwise
+         */
+        [[nodiscard]] static constexpr std::strong_ordering _lexicographic_order(const BlockType lhs, const BlockType rhs) noexcept
+        {
+            return lhs >> detail::countr_zero(static_cast<BlockType>(lhs ^ rhs)) & 1 ? std::strong_ordering::greater : std::strong_ordering::less;
+        }
+
+    public:
+
+        /**
+         * Numeric three-way comparison, the bitset is compared as an unsigned integer whose most significant bit is bit Size - 1
+         * @param other Other bitset instance to compare with
+         * @return Ordering of the two instances
+         */
+        [[nodiscard]] constexpr std::strong_ordering compare_numeric(const bitset& other) const noexcept
+        {
+            if constexpr (m_partial_size != 0)
+            {
+                const BlockType mask = (BlockType{ 1 } << m_partial_size) - 1;
+                const BlockType lhs = m_data[m_storage_size - 1] & mask, rhs = other.m_data[m_storage_size - 1] & mask;
+                if (lhs != rhs)
+                    return lhs <=> rhs;
+            }
+            for (size_type i = m_full_storage_size; i-- > 0;)
+            {
+                if (m_data[i] != other.m_data[i])
+                    return m_data[i] <=> other.m_data[i];
+            }
+            return std::strong_ordering::equal;
+        }
+
+        /**
+         * Lexicographic three-way comparison by bit index (bit 0 first), the same order as comparing the results of to_string()
+         * @param other Other bitset instance to compare with
+         * @return Ordering of the two instances
+         */
+        [[nodiscard]] constexpr std::strong_ordering compare_lexicographic(const bitset& other) const noexcept
+        {
+            for (size_type i = 0; i < m_full_storage_size; ++i)
+            {
+                if (m_data[i] != other.m_data[i])
+                    return _lexicographic_order(m_data[i], other.m_data[i]);
+            }
+            if constexpr (m_partial_size != 0)
+            {
+                const BlockType mask = (BlockType{ 1 } << m_partial_size) - 1;
+                const BlockType lhs = m_data[m_storage_size - 1] & mask, rhs = other.m_data[m_storage_size - 1] & mask;
+                if (lhs != rhs)
+                    return _lexicographic_order(lhs, rhs);
+            }
+            return std::strong_ordering::equal;
+        }
+
+        /**
+         * Three-way comparison operator (numeric order, see compare_numeric)
+         * @param other Other bitset instance to compare with
+         * @return Ordering of the two instances
+         */
+        [[nodiscard]] constexpr std::strong_ordering operator<=>(const bitset& other) const noexcept
+        {
+            return compare_numeric(other);
+        }
+
+        // Set predicates
+
+    private:
+
+        /**
+         * Bits set in lhs but not in rhs
+         */
+        static constexpr auto _difference_block = [](const BlockType lhs, const BlockType rhs) noexcept { return static_cast<BlockType>(lhs & ~rhs); };
+
+        /**
+         * Bits set in both lhs and rhs
+         */
+        static constexpr auto _intersection_block = [](const BlockType lhs, const BlockType rhs) noexcept { return static_cast<BlockType>(lhs & rhs); };
+
+    public:
+
+        /**
+         * Checks if every bit set in this bitset is also set in the other bitset
+         * @param other Other bitset instance to compare with
+         * @return true if this bitset is a subset of the other bitset, false otherwise
+         */
+        [[nodiscard]] constexpr bool is_subset_of(const bitset& other) const noexcept
+        {
+            if (detail::any_of_blocks(m_data, other.m_data, m_full_storage_size, _difference_block))
+                return false;
+            if constexpr (m_partial_size != 0)
+                return !(_difference_block(m_data[m_storage_size - 1], other.m_data[m_storage_size - 1]) & ((BlockType{ 1 } << m_partial_size) - 1));
+            return true;
+        }
+
+        /**
+         * Checks if this bitset is a subset of the other bitset and the two are not equal
+         * @param other Other bitset instance to compare with
+         * @return true if this bitset is a proper subset of the other bitset, false otherwise
+         */
+        [[nodiscard]] constexpr bool is_proper_subset_of(const bitset& other) const noexcept
+        {
+            return is_subset_of(other) && !other.is_subset_of(*this);
+        }
+
+        /**
+         * Checks if every bit set in the other bitset is also set in this bitset
+         * @param other Other bitset instance to compare with
+         * @return true if this bitset is a superset of the other bitset, false otherwise
+         */
+        [[nodiscard]] constexpr bool is_superset_of(const bitset& other) const noexcept
+        {
+            return other.is_subset_of(*this);
+        }
+
+        /**
+         * Checks if this bitset is a superset of the other bitset and the two are not equal
+         * @param other Other bitset instance to compare with
+         * @return true if this bitset is a proper superset of the other bitset, false otherwise
+         */
+        [[nodiscard]] constexpr bool is_proper_superset_of(const bitset& other) const noexcept
+        {
+            return other.is_proper_subset_of(*this);
+        }
+
+        /**
+         * Checks if any bit is set in both bitsets
+         * @param other Other bitset instance to compare with
+         * @return true if the bitsets share a set bit, false otherwise
+         */
+        [[nodiscard]] constexpr bool intersects(const bitset& other) const noexcept
+        {
+            if (detail::any_of_blocks(m_data, other.m_data, m_full_storage_size, _intersection_block))
+                return true;
+            if constexpr (m_partial_size != 0)
+                return (_intersection_block(m_data[m_storage_size - 1], other.m_data[m_storage_size - 1]) & ((BlockType{ 1 } << m_partial_size) - 1)) != 0;
+            return false;
+        }
+
+        /**
+         * Checks if no bit is set in both bitsets
+         * @param other Other bitset instance to compare with
+         * @return true if the bitsets share no set bit, false otherwise
+         */
+        [[nodiscard]] constexpr bool is_disjoint(const bitset& other) const noexcept
+        {
+            return !intersects(other);
+        }
+
+        /**
+         * Hashes the bits of the bitset (bits past Size are ignored)
+         * @return 64-bit hash of the bitset (truncated to size_t)
+         */
+        [[nodiscard]] constexpr std::size_t hash() const noexcept
+        {
+            std::uint64_t hash;
+            if (std::is_constant_evaluated())
+            {
+                // Same bytes as the runtime path, the object representation is only reachable through bit_cast
+                const auto bytes = std::bit_cast<std::array<unsigned char, sizeof(m_data)>>(m_data);
+                hash = detail::hash_bytes(bytes.data(), m_full_storage_size * sizeof(BlockType), Size);
+            }
+            else
+                hash = detail::hash_bytes(m_data, m_full_storage_size * sizeof(BlockType), Size);
+            if constexpr (m_partial_size != 0)
+            {
+                const BlockType tail = m_data[m_storage_size - 1] & ((BlockType{ 1 } << m_partial_size) - 1);
+                hash = detail::hash_bytes(std::bit_cast<std::array<unsigned char, sizeof(tail)>>(tail).data(), sizeof(tail), hash);
+            }
+            return static_cast<std::size_t>(hash);
+        }
+
+        // Bitwise operators
+
+    private:
+
+        /**
+         * Applies a block operation to the blocks of this and another bitset
+         * @tparam Op Block operation (see detail::combine_blocks)
+         * @param other Right-hand side of the operation
+         * @param result Bitset receiving the result (may be this or other)
+         * @param op Block operation
+         */
+        template <typename Op>
+        constexpr void _combine(const bitset& other, bitset& result, Op op) const noexcept
+        {
+            // One or two blocks stay in registers, the vector kernel would go through memory
+            if constexpr (m_word_sized)
+            {
+                for (size_type i = 0; i < m_storage_size; ++i)
+                    result.m_data[i] = static_cast<BlockType>(op(m_data[i], other.m_data[i]));
+            }
+            else
+                detail::combine_blocks(m_data, other.m_data, result.m_data, m_storage_size, op);
+        }
+
+    public:
 
         /**
          * Bitwise AND operator
@@ -1323,8 +2551,7 @@ namespace woj
         [[nodiscard]] constexpr bitset operator&(const bitset& other) const noexcept
         {
             bitset result;
-            for (size_type i = 0; i < result.m_storage_size; ++i)
-                result.m_data[i] = m_data[i] & other.m_data[i];
+            _combine(other, result, std::bit_and<>{});
             return result;
         }
 
@@ -1334,8 +2561,7 @@ namespace woj
          */
     	constexpr bitset& operator&=(const bitset& other) noexcept
         {
-            for (size_type i = 0; i < m_storage_size; ++i)
-                m_data[i] &= other.m_data[i];
+            _combine(other, *this, std::bit_and<>{});
             return *this;
         }
 
@@ -1347,8 +2573,7 @@ namespace woj
         [[nodiscard]] constexpr bitset operator|(const bitset& other) const noexcept
         {
             bitset result;
-            for (size_type i = 0; i < result.m_storage_size; ++i)
-                result.m_data[i] = m_data[i] | other.m_data[i];
+            _combine(other, result, std::bit_or<>{});
             return result;
         }
 
@@ -1358,8 +2583,7 @@ namespace woj
          */
         constexpr bitset& operator|=(const bitset& other) noexcept
         {
-            for (size_type i = 0; i < m_storage_size; ++i)
-                *m_data[i] |= other.m_data[i];
+            _combine(other, *this, std::bit_or<>{});
             return *this;
         }
 
@@ -1371,8 +2595,7 @@ namespace woj
         [[nodiscard]] constexpr bitset operator^(const bitset& other) const noexcept
         {
             bitset result;
-            for (size_type i = 0; i < result.m_storage_size; ++i)
-                result.m_data[i] = m_data[i] ^ other.m_data[i];
+            _combine(other, result, std::bit_xor<>{});
             return result;
         }
 
@@ -1382,8 +2605,7 @@ namespace woj
          */
         constexpr bitset& operator^=(const bitset& other) noexcept
         {
-            for (size_type i = 0; i < m_storage_size; ++i)
-                m_data[i] ^= other.m_data[i];
+            _combine(other, *this, std::bit_xor<>{});
             return *this;
         }
 
@@ -1394,8 +2616,31 @@ namespace woj
         [[nodiscard]] constexpr bitset operator~() const noexcept
         {
             bitset result;
-            for (size_type i = 0; i < m_storage_size; ++i)
-                result.m_data[i] = ~m_data[i];
+            _combine(*this, result, detail::bit_invert{});
+            return result;
+        }
+
+        /**
+         * Packs the bits selected by a mask densely into the low bits of a new bitset (parallel bit extract)
+         * @param mask Bits to take
+         * @return New bitset instance holding the selected bits from bit 0, the remaining bits are reset
+         */
+        [[nodiscard]] constexpr bitset compress(const bitset& mask) const noexcept
+        {
+            bitset result;
+            detail::compress_blocks(m_data, mask.m_data, result.m_data, m_storage_size, detail::mask_until<BlockType>(Size));
+            return result;
+        }
+
+        /**
+         * Scatters the low bits into the positions selected by a mask (parallel bit deposit), the inverse of compress
+         * @param mask Bits to fill
+         * @return New bitset instance holding the low bits at the positions of the set bits of the mask, the remaining bits are reset
+         */
+        [[nodiscard]] constexpr bitset expand(const bitset& mask) const noexcept
+        {
+            bitset result;
+            detail::expand_blocks(m_data, mask.m_data, result.m_data, m_storage_size, detail::mask_until<BlockType>(Size));
             return result;
         }
 
@@ -1406,29 +2651,8 @@ namespace woj
 		 */
         [[nodiscard]] constexpr bitset operator>>(const size_type& shift) const noexcept
         {
-            bitset result;
-
-            // Number of blocks to shift
-            const size_type block_shift = shift / m_block_size;
-
-            // Number of bits to shift within a block
-            const size_type bit_shift = shift % m_block_size;
-
-            // Shift across multiple blocks
-            for (size_type i = 0; i < m_storage_size; ++i)
-            {
-                // Handle shifting within a block
-                result.m_data[i] = (i + block_shift < m_storage_size) ?
-                    (m_data[i + block_shift] >> bit_shift) :
-                    0; // If shifting exceeds block boundaries, fill with zeros
-                // If there are remaining bits to shift to the next block
-                if (bit_shift > 0 && i + block_shift + 1 < m_storage_size)
-                {
-                    // Shift the remaining bits to the next block
-                    result.m_data[i] |= (m_data[i + block_shift + 1] << (m_block_size - bit_shift));
-                }
-            }
-
+            bitset result(*this);
+            result >>= shift;
             return result;
         }
 
@@ -1438,42 +2662,36 @@ namespace woj
         */
         constexpr bitset& operator>>=(const size_type& shift) noexcept
         {
-            if (shift > m_block_size)
-                reset();
-            else
+            if (shift >= Size)
             {
-                // Number of blocks to shift
-                const size_type block_shift = shift / m_block_size;
+                reset();
+                return *this;
+            }
 
-                // Number of bits to shift within a block
-                const size_type bit_shift = shift % m_block_size;
+            // Bits past Size are unspecified, clear them so they are not shifted into the valid range
+            if constexpr (m_partial_size != 0)
+                m_data[m_storage_size - 1] &= static_cast<BlockType>((BlockType{ 1 } << m_partial_size) - 1);
 
-                // Shift across multiple blocks
-                for (size_type i = 0; i < m_storage_size; ++i)
+            if constexpr (m_storage_size == 1)
+            {
+                m_data[0] = static_cast<BlockType>(m_data[0] >> shift);
+                return *this;
+            }
+            else if constexpr (m_storage_size == 2)
+            {
+                // Double block shift, the shift either moves the high block down or spills bits across the boundary
+                if (shift >= m_block_size)
                 {
-                    // Handle shifting within a block
-                    m_data[i] = i + block_shift < m_storage_size ?
-                        m_data[i + block_shift] >> bit_shift :
-                        0; // If shifting exceeds block boundaries, fill with zeros
-                    // If there are remaining bits to shift to the next block
-                    if (bit_shift > 0 && i + block_shift + 1 < m_storage_size)
-                    {
-                        // Shift the remaining bits to the next block
-                        m_data[i] |= m_data[i + block_shift + 1] << m_block_size - bit_shift;
-                    }
+                    m_data[0] = static_cast<BlockType>(m_data[1] >> (shift - m_block_size));
+                    m_data[1] = 0;
+                }
+                else if (shift)
+                {
+                    m_data[0] = static_cast<BlockType>(m_data[0] >> shift | m_data[1] << (m_block_size - shift));
+                    m_data[1] = static_cast<BlockType>(m_data[1] >> shift);
                 }
+                return *this;
             }
-            return *this;
-        }
-
-        /**
-		 * Bitwise left shift operator
-		 * @param shift Amount of bits to shift to the left
-		 * @return New bitset instance containing the result of the operation
-		 */
-        [[nodiscard]] constexpr bitset operator<<(const size_type& shift) const noexcept
-        {
-            bitset result;
 
             // Number of blocks to shift
             const size_type block_shift = shift / m_block_size;
@@ -1481,21 +2699,32 @@ namespace woj
             // Number of bits to shift within a block
             const size_type bit_shift = shift % m_block_size;
 
-            // Shift across multiple blocks
+            // Shift across multiple blocks, lower blocks only read from higher ones
             for (size_type i = 0; i < m_storage_size; ++i)
             {
                 // Handle shifting within a block
-                result.m_data[i] = i >= block_shift ?
-                    m_data[i - block_shift] << bit_shift :
-                    0; // If shifting exceeds block boundaries, fill with zeros
-                // If there are remaining bits to shift to the previous block
-                if (bit_shift > 0 && i >= block_shift + 1)
+                m_data[i] = i + block_shift < m_storage_size ?
+                    static_cast<BlockType>(m_data[i + block_shift] >> bit_shift) :
+                    BlockType{ 0 }; // If shifting exceeds block boundaries, fill with zeros
+                // If there are remaining bits to shift to the next block
+                if (bit_shift > 0 && i + block_shift + 1 < m_storage_size)
                 {
-                    // Shift the remaining bits to the previous block
-                    result.m_data[i] |= m_data[i - block_shift - 1] >> m_block_size - bit_shift;
+                    // Shift the remaining bits to the next block
+                    m_data[i] |= static_cast<BlockType>(m_data[i + block_shift + 1] << (m_block_size - bit_shift));
                 }
             }
+            return *this;
+        }
 
+        /**
+		 * Bitwise left shift operator
+		 * @param shift Amount of bits to shift to the left
+		 * @return New bitset instance containing the result of the operation
+		 */
+        [[nodiscard]] constexpr bitset operator<<(const size_type& shift) const noexcept
+        {
+            bitset result(*this);
+            result <<= shift;
             return result;
         }
 
@@ -1505,24 +2734,50 @@ namespace woj
          */
         constexpr bitset& operator<<=(const size_type& shift) noexcept
         {
+            if (shift >= Size)
+            {
+                reset();
+                return *this;
+            }
+
+            if constexpr (m_storage_size == 1)
+            {
+                m_data[0] = static_cast<BlockType>(m_data[0] << shift);
+                return *this;
+            }
+            else if constexpr (m_storage_size == 2)
+            {
+                if (shift >= m_block_size)
+                {
+                    m_data[1] = static_cast<BlockType>(m_data[0] << (shift - m_block_size));
+                    m_data[0] = 0;
+                }
+                else if (shift)
+                {
+                    m_data[1] = static_cast<BlockType>(m_data[1] << shift | m_data[0] >> (m_block_size - shift));
+                    m_data[0] = static_cast<BlockType>(m_data[0] << shift);
+                }
+                return *this;
+            }
+
             // Number of blocks to shift
             const size_type block_shift = shift / m_block_size;
 
             // Number of bits to shift within a block
             const size_type bit_shift = shift % m_block_size;
 
-            // Shift across multiple blocks
-            for (size_type i = 0; i < m_storage_size; ++i)
+            // Shift across multiple blocks, walk downwards so higher blocks only read from lower ones
+            for (size_type i = m_storage_size; i-- > 0;)
             {
                 // Handle shifting within a block
                 m_data[i] = i >= block_shift ?
-                    m_data[i - block_shift] << bit_shift :
-                    0; // If shifting exceeds block boundaries, fill with zeros
+                    static_cast<BlockType>(m_data[i - block_shift] << bit_shift) :
+                    BlockType{ 0 }; // If shifting exceeds block boundaries, fill with zeros
                 // If there are remaining bits to shift to the previous block
                 if (bit_shift > 0 && i >= block_shift + 1)
                 {
                     // Shift the remaining bits to the previous block
-                    m_data[i] |= m_data[i - block_shift - 1] >> m_block_size - bit_shift;
+                    m_data[i] |= static_cast<BlockType>(m_data[i - block_shift - 1] >> (m_block_size - bit_shift));
                 }
             }
 
@@ -1537,8 +2792,7 @@ namespace woj
         [[nodiscard]] constexpr bitset operator-(const bitset& other) const noexcept
         {
             bitset result;
-            for (size_type i = 0; i < result.m_storage_size; ++i)
-                result.m_data[i] = m_data[i] & ~other.m_data[i];
+            _combine(other, result, detail::bit_and_not{});
             return result;
         }
 
@@ -1548,8 +2802,7 @@ namespace woj
          */
         constexpr bitset& operator-=(const bitset& other) noexcept
         {
-            for (size_type i = 0; i < m_storage_size; ++i)
-                m_data[i] &= ~other.m_data[i];
+            _combine(other, *this, detail::bit_and_not{});
             return *this;
         }
 
@@ -1568,7 +2821,15 @@ namespace woj
          */
         constexpr void _from_other(const bitset& other) noexcept
         {
-            if (this != &other)
+            if (this == &other)
+                return;
+            // std::copy of one or two blocks becomes a memmove call, plain moves keep small bitsets in registers
+            if constexpr (m_word_sized)
+            {
+                for (size_type i = 0; i < m_storage_size; ++i)
+                    m_data[i] = other.m_data[i];
+            }
+            else
                 std::copy(other.m_data, other.m_data + other.m_storage_size, m_data);
         }
 
@@ -1595,38 +2856,7 @@ namespace woj
         template <unsigned_integer OtherBlockType, size_type OtherSize> requires (std::convertible_to<OtherBlockType, BlockType> && !std::is_same_v<BlockType, OtherBlockType>)
         constexpr void _from_other(const bitset<OtherBlockType, OtherSize>& other) noexcept
         {
-            if constexpr (sizeof(BlockType) > sizeof(OtherBlockType))
-            {
-                constexpr uint16_t diff = sizeof(BlockType) / sizeof(OtherBlockType);
-
-                for (size_type i = 0; i < m_storage_size; ++i)
-                {
-                    for (size_type j = 0; j < diff; ++j)
-                    {
-                        if (i * diff + j >= other.m_storage_size)
-                        {
-                            return;
-                        }
-                        m_data[i] |= static_cast<BlockType>(other.m_data[i * diff + j]) << j * other.m_block_size;
-                    }
-                }
-            }
-            else
-            {
-                constexpr uint16_t diff = sizeof(OtherBlockType) / sizeof(BlockType);
-
-                for (size_type i = 0; i < other.m_storage_size; ++i)
-                {
-                    for (uint16_t j = 0; j < diff; ++j)
-                    {
-                        if (i * diff + j >= m_storage_size)
-                        {
-                            return;
-                        }
-                        m_data[i * diff + j] = other.m_data[i] >> j % diff * m_block_size;
-                    }
-                }
-            }
+            detail::convert_blocks(other.m_data, m_data, m_storage_size, (std::min)(Size, OtherSize));
         }
 
         /**
@@ -1663,17 +2893,17 @@ namespace woj
         template <char_type Elem = char>
         [[nodiscard]] constexpr std::basic_string<Elem> to_string(const Elem& set_chr = '1', const Elem& rst_chr = '0') const /* can't use noexcept - std::basic_string */
         {
-            std::basic_string<Elem> result(Size + 1, 0);
+            std::basic_string<Elem> result(Size, 0);
 
             for (size_type i = 0; i < m_storage_size - !!m_partial_size; ++i)
             {
                 for (uint16_t j = 0; j < m_block_size; ++j)
                     result[i * m_block_size + j] = m_data[i] & BlockType{ 1 } << j ? set_chr : rst_chr;
             }
-            if (m_storage_size)
+            if (m_partial_size)
             {
                 for (size_type i = 0; i < m_partial_size; ++i)
-                    result[(m_storage_size - 1) * m_block_size + i] = m_data[i] & BlockType{ 1 } << i ? set_chr : rst_chr;
+                    result[(m_storage_size - 1) * m_block_size + i] = m_data[m_storage_size - 1] & BlockType{ 1 } << i ? set_chr : rst_chr;
             }
             return result;
         }
@@ -1711,7 +2941,7 @@ namespace woj
          * @param set_chr Character that represents set bits
          */
         template <typename PtrArr = const char*, char_type Elem = std::remove_cvref_t<std::remove_pointer_t<std::remove_cvref_t<PtrArr>>>> requires (std::is_pointer_v<PtrArr> && !std::is_array_v<PtrArr>)
-        void _from_c_string(PtrArr c_str, const Elem& set_chr = '1') noexcept
+        constexpr void _from_c_string(PtrArr c_str, const Elem& set_chr = '1') noexcept
         {
             for (size_type i = 0; i < m_storage_size; ++i)
             {
@@ -1730,13 +2960,14 @@ namespace woj
 
         /**
          * bitset to C string conversion function
+         * In constant evaluation the result must be deleted before the evaluation ends.
          * @param set_chr Character to represent set bits
          * @param rst_chr Character to represent reset bits
          * @tparam Elem Type of character in the array
-         * @return C string representation of the bitset
+         * @return C string representation of the bitset (allocated with new[])
          */
         template <char_type Elem = char>
-        [[nodiscard]] Elem* to_c_string(const Elem& set_chr = '1', const Elem& rst_chr = '0') const noexcept
+        [[nodiscard]] constexpr Elem* to_c_string(const Elem& set_chr = '1', const Elem& rst_chr = '0') const noexcept
         {
             Elem* result = new Elem[Size + 1];
             for (size_type i = 0; i < m_storage_size - !!m_partial_size; ++i)
@@ -1747,12 +2978,23 @@ namespace woj
             if (m_partial_size)
             {
                 for (size_type i = 0; i < m_partial_size; ++i)
-                    *(result + (m_storage_size - 1) * m_block_size + i) = m_data[i] & BlockType{ 1 } << i ? set_chr : rst_chr;
+                    *(result + (m_storage_size - 1) * m_block_size + i) = m_data[m_storage_size - 1] & BlockType{ 1 } << i ? set_chr : rst_chr;
             }
             *(result + Size) = '\0';
             return result;
         }
 
+        /**
+         * bitset to std::bitset conversion function, copies whole words where the layout of std::bitset is known
+         * @return std::bitset holding the same bits
+         */
+        [[nodiscard]] std::bitset<Size> to_std() const noexcept
+        {
+            std::bitset<Size> result;
+            detail::to_std_bitset(m_data, Size, result);
+            return result;
+        }
+
         /**
 		 * integral value to bitset conversion function
 		 * @tparam T Type of the integral value to convert from
@@ -1771,11 +3013,12 @@ namespace woj
                 return;
             }
 
-            constexpr uint16_t diff = sizeof(T) / sizeof(BlockType);
+            // Blocks of the value that fit in the bitset
+            constexpr uint16_t diff = (std::min)(sizeof(T) / sizeof(BlockType), m_storage_size);
 
             for (uint16_t i = 0; i < diff; ++i)
             {
-                m_data[i] = value >> i * m_block_size;
+                m_data[i] = static_cast<BlockType>(value >> i * m_block_size);
             }
         }
 
@@ -1790,7 +3033,8 @@ namespace woj
             if constexpr (sizeof(T) <= sizeof(BlockType))
                 return static_cast<T>(m_data[0]);
 
-            constexpr uint16_t diff = sizeof(T) / sizeof(BlockType);
+            // Blocks of the value that fit in the bitset
+            constexpr uint16_t diff = (std::min)(sizeof(T) / sizeof(BlockType), m_storage_size);
             T result = 0;
             for (int16_t i = 0; i < diff; ++i)
                 result |= static_cast<T>(m_data[i]) << i * m_block_size;
@@ -1825,21 +3069,43 @@ namespace woj
          */
         constexpr void reverse() noexcept
         {
-            for (size_type i = 0; i < Size / 2; ++i)
+            // Reversing whole blocks moves the valid bits to the top, the unspecified tail bits are shifted out at the bottom
+            if constexpr (m_storage_size == 1)
+                m_data[0] = static_cast<BlockType>(detail::reverse_bits(m_data[0]) >> (m_block_size - Size));
+            else if constexpr (m_storage_size == 2)
             {
-                swap(i, Size - i - 1);
+                constexpr size_type pad = 2 * m_block_size - Size;
+                const BlockType low = detail::reverse_bits(m_data[1]), high = detail::reverse_bits(m_data[0]);
+                if constexpr (pad != 0)
+                {
+                    m_data[0] = static_cast<BlockType>(low >> pad | high << (m_block_size - pad));
+                    m_data[1] = static_cast<BlockType>(high >> pad);
+                }
+                else
+                {
+                    m_data[0] = low;
+                    m_data[1] = high;
+                }
             }
-		}
-
+            else
+            {
+                for (size_type i = 0; i < Size / 2; ++i)
+                {
+                    swap(i, Size - i - 1);
+                }
+            }
+		}
+
         /**
          * Rotates each bit to the left by the specified amount
          * @param shift Amount of bits to rotate to the left
          */
         constexpr void rotate(const size_type& shift) noexcept
         {
-        	const bitset tmp_cpy = *this;
-            for (size_type i = 0; i < Size; ++i)
-                set(i, tmp_cpy.test((i + shift) % Size));
+            // Bit i takes the value of bit (i + shift) % Size
+            const size_type amount = shift % Size;
+            if (amount)
+                *this = *this >> amount | *this << (Size - amount);
         }
 
         /**
@@ -1865,73 +3131,73 @@ namespace woj
         /**
          * @return Pointer to the underlying array
          */
-        [[nodiscard]] constexpr BlockType*& data() noexcept { return m_data; }
+        [[nodiscard]] constexpr BlockType* data() noexcept { return m_data; }
 
         /**
          * @return Const pointer to the underlying array
          */
-        [[nodiscard]] constexpr const BlockType* const& data() const noexcept { return m_data; }
+        [[nodiscard]] constexpr const BlockType* data() const noexcept { return m_data; }
 
         // Iteration functions
 
         [[nodiscard]] constexpr iterator begin() noexcept
         {
-            return iterator(*this);
+            return iterator(m_data, 0);
         }
 
         [[nodiscard]] constexpr iterator end() noexcept
         {
-            return iterator(*this, Size);
+            return iterator(m_data, Size);
         }
 
         [[nodiscard]] constexpr const_iterator begin() const noexcept
         {
-            return const_iterator(*this);
+            return const_iterator(m_data, 0);
         }
 
         [[nodiscard]] constexpr const_iterator end() const noexcept
         {
-            return const_iterator(*this, Size);
+            return const_iterator(m_data, Size);
         }
 
         [[nodiscard]] constexpr const_iterator cbegin() const noexcept
         {
-            return const_iterator(*this);
+            return begin();
         }
 
         [[nodiscard]] constexpr const_iterator cend() const noexcept
         {
-            return const_iterator(*this, Size);
+            return end();
         }
 
         [[nodiscard]] constexpr reverse_iterator rbegin() noexcept
         {
-            return reverse_iterator(*this, Size - 1);
+            return reverse_iterator(end());
         }
 
         [[nodiscard]] constexpr reverse_iterator rend() noexcept
         {
-            return reverse_iterator(*this, -1);
+            return reverse_iterator(begin());
         }
 
         [[nodiscard]] constexpr const_reverse_iterator crbegin() const noexcept
         {
-            return const_reverse_iterator(*this);
+            return rbegin();
         }
 
         [[nodiscard]] constexpr const_reverse_iterator crend() const noexcept
         {
-            return const_reverse_iterator(*this, -1);
+            return rend();
         }
 
         [[nodiscard]] constexpr const_reverse_iterator rbegin() const noexcept
         {
-            return const_reverse_iterator(*this);
+            return const_reverse_iterator(end());
         }
 
         [[nodiscard]] constexpr const_reverse_iterator rend() const noexcept
         {
-            return const_reverse_iterator(*this, -1);
+            return const_reverse_iterator(begin());
         }
 
         // bitset operations
@@ -1967,6 +3233,57 @@ namespace woj
             m_data[index / m_block_size] &= ~(BlockType{1} << index % m_block_size);
         }
 
+        /**
+         * Constructs a bitset with the bits at the specified indices set
+         * @tparam Indices Type of the contiguous range of unsigned indices
+         * @param indices Indices of the bits to set (bit indices)
+         * @param partition Whether to radix-partition the indices by 256 KiB region first, for many indices into large bitsets
+         * @return New bitset instance
+         */
+        template <std::ranges::contiguous_range Indices> requires std::unsigned_integral<std::ranges::range_value_t<Indices>>
+        [[nodiscard]] static constexpr bitset from_indices(const Indices& indices, const bool partition = false) noexcept
+        {
+            bitset result;
+            result.set_many(indices, partition);
+            return result;
+        }
+
+        /**
+         * Sets the bits at the specified indices, prefetching their blocks a window ahead
+         * @tparam Indices Type of the contiguous range of unsigned indices
+         * @param indices Indices of the bits to set (bit indices)
+         * @param partition Whether to radix-partition the indices by 256 KiB region first, for many indices into large bitsets
+         */
+        template <std::ranges::contiguous_range Indices> requires std::unsigned_integral<std::ranges::range_value_t<Indices>>
+        constexpr void set_many(const Indices& indices, const bool partition = false) noexcept
+        {
+            detail::apply_indices(m_data, Size, std::ranges::data(indices), std::ranges::size(indices), partition, [](BlockType& block, const BlockType mask) noexcept { block |= mask; });
+        }
+
+        /**
+         * Resets the bits at the specified indices, prefetching their blocks a window ahead
+         * @tparam Indices Type of the contiguous range of unsigned indices
+         * @param indices Indices of the bits to reset (bit indices)
+         * @param partition Whether to radix-partition the indices by 256 KiB region first, for many indices into large bitsets
+         */
+        template <std::ranges::contiguous_range Indices> requires std::unsigned_integral<std::ranges::range_value_t<Indices>>
+        constexpr void reset_many(const Indices& indices, const bool partition = false) noexcept
+        {
+            detail::apply_indices(m_data, Size, std::ranges::data(indices), std::ranges::size(indices), partition, [](BlockType& block, const BlockType mask) noexcept { block &= static_cast<BlockType>(~mask); });
+        }
+
+        /**
+         * Flips the bits at the specified indices, prefetching their blocks a window ahead
+         * @tparam Indices Type of the contiguous range of unsigned indices
+         * @param indices Indices of the bits to flip (bit indices, a repeated index flips its bit again)
+         * @param partition Whether to radix-partition the indices by 256 KiB region first, for many indices into large bitsets
+         */
+        template <std::ranges::contiguous_range Indices> requires std::unsigned_integral<std::ranges::range_value_t<Indices>>
+        constexpr void flip_many(const Indices& indices, const bool partition = false) noexcept
+        {
+            detail::apply_indices(m_data, Size, std::ranges::data(indices), std::ranges::size(indices), partition, [](BlockType& block, const BlockType mask) noexcept { block ^= mask; });
+        }
+
         /**
          * Fills all the bits with the specified value
          * @param value Value to fill the bits with (bit value)
@@ -2017,27 +3334,7 @@ namespace woj
          */
         constexpr void fill_range(const size_type& end, const bool value) noexcept
         {
-            if (std::is_constant_evaluated()) 
-            {
-                for (size_type i = 0; i < end / m_block_size * sizeof(BlockType); ++i)
-                    m_data[i] = value ? (std::numeric_limits<BlockType>::max)() : 0;
-            }
-            else 
-                ::memset(m_data, value ? 255u : 0, end / m_block_size * sizeof(BlockType));
-            
-            if (end % m_block_size) [[likely]]
-            {
-                if (value)
-                {
-                    for (uint16_t i = 0; i < end % m_block_size; ++i)
-                        m_data[end / m_block_size] |= BlockType{1} << i;
-                }
-                else if (!value)
-                {
-                    for (uint16_t i = 0; i < end % m_block_size; ++i)
-                        m_data[end / m_block_size] &= ~(BlockType{1} << i);
-                }
-            }
+            fill_range(0, end, value);
         }
 
         /**
@@ -2046,19 +3343,7 @@ namespace woj
          */
         constexpr void set_range(const size_type& end) noexcept
         {
-            if (std::is_constant_evaluated())
-			{
-				for (size_type i = 0; i < end / m_block_size * sizeof(BlockType); ++i)
-					m_data[i] = (std::numeric_limits<BlockType>::max)();
-			}
-			else
-				::memset(m_data, 255u, end / m_block_size * sizeof(BlockType));
-
-        	if (end % m_block_size) [[likely]]
-            {
-                for (uint16_t i = 0; i < end % m_block_size; ++i)
-                    m_data[end / m_block_size] |= BlockType{1} << i;
-            }
+            fill_range(0, end, true);
         }
 
         /**
@@ -2067,19 +3352,7 @@ namespace woj
          */
         constexpr void reset_range(const size_type& end) noexcept
         {
-            if (std::is_constant_evaluated())
-            {
-	            for (size_type i = 0; i < end / m_block_size * sizeof(BlockType); ++i)
-					m_data[i] = 0;
-			}
-			else
-				::memset(m_data, 0, end / m_block_size * sizeof(BlockType));
-
-        	if (end % m_block_size) [[likely]]
-            {
-                for (uint16_t i = 0; i < end % m_block_size; ++i)
-                    m_data[end / m_block_size] &= ~(BlockType{1} << i);
-            }
+            fill_range(0, end, false);
         }
 
         /**
@@ -2090,49 +3363,19 @@ namespace woj
          */
         constexpr void fill_range(const size_type& begin, const size_type& end, const bool value) noexcept
         {
-            uint8_t to_add = 1, to_sub = 1;
-            // create begin_block and fill the first byte with it
-            if (begin % m_block_size) [[likely]]
-            {
-                const uint16_t end_bit = (begin / m_block_size == end / m_block_size) ? end % m_block_size : m_block_size;
-                if (value)
-                {
-                    for (uint16_t i = begin % m_block_size; i < end_bit; ++i)
-                        m_data[begin / m_block_size] |= BlockType{1} << i;
-                }
-                else
-                {
-                    for (uint16_t i = begin % m_block_size; i < end_bit; ++i)
-                        m_data[begin / m_block_size] &= ~(BlockType{1} << i);
-                }
-            }
-            else
-                to_add = 0;
-
-            // set the end block if the end is not aligned with the block size
-            if (end % m_block_size && begin / m_block_size != end / m_block_size) [[likely]]
+            if constexpr (m_word_sized)
             {
-                if (value)
-                {
-                    for (uint16_t i = 0; i < end % m_block_size; ++i)
-                        m_data[end / m_block_size] |= BlockType{1} << i;
-                }
-                else
+                for (size_type i = 0; i < m_storage_size; ++i)
                 {
-                    for (uint16_t i = 0; i < end % m_block_size; ++i)
-                        m_data[end / m_block_size] &= ~(BlockType{1} << i);
+                    if (value)
+                        m_data[i] |= _range_mask(i, begin, end);
+                    else
+                        m_data[i] &= static_cast<BlockType>(~_range_mask(i, begin, end));
                 }
+                return;
             }
-            else
-                to_sub = 0;
 
-            if (std::is_constant_evaluated())
-			{
-				for (size_type i = begin / m_block_size + to_add; i < end / m_block_size; ++i)
-					m_data[i] = value ? (std::numeric_limits<BlockType>::max)() : 0;
-			}
-			else
-				::memset(m_data + begin / m_block_size + to_add, value ? 255u : 0, (end - begin) / m_block_size * sizeof(BlockType) - to_sub);
+            detail::fill_range(m_data, begin, end, value);
         }
 
         /**
@@ -2142,32 +3385,7 @@ namespace woj
          */
         constexpr void set_range(const size_type& begin, const size_type& end) noexcept
         {
-            uint8_t to_add = 1, to_sub = 1;
-            // create begin_block and fill the first byte with it
-            if (begin % m_block_size) [[likely]]
-            {
-                const uint16_t end_bit = begin / m_block_size == end / m_block_size ? end % m_block_size : m_block_size;
-                for (uint16_t i = begin % m_block_size; i < end_bit; ++i)
-                    m_data[begin / m_block_size] |= BlockType{1} << i;
-            }
-            else
-                to_add = 0;
-
-            // set the end block if the end is not aligned with the block size
-            if (end % m_block_size && begin / m_block_size != end / m_block_size) [[likely]]
-            {
-                for (uint16_t i = 0; i < end % m_block_size; ++i)
-                    m_data[end / m_block_size] |= BlockType{1} << i;
-            }
-            else
-                to_sub = 0;
-            if (std::is_constant_evaluated())
-            {
-	            for (size_type i = begin / m_block_size + to_add; i < end / m_block_size; ++i)
-					m_data[i] = (std::numeric_limits<BlockType>::max)();
-			}
-			else
-				::memset(m_data + begin / m_block_size + to_add, 255u, (end - begin) / m_block_size * sizeof(BlockType) - to_sub);
+            fill_range(begin, end, true);
         }
 
         /**
@@ -2177,35 +3395,76 @@ namespace woj
          */
         constexpr void reset_range(const size_type& begin, const size_type& end) noexcept
         {
-            uint8_t to_add = 1, to_sub = 1;
-            // create begin_block and fill the first byte with it
-            if (begin % m_block_size) [[likely]]
+            fill_range(begin, end, false);
+        }
+
+    private:
+
+        /**
+         * Block operations applied by the strided range functions
+         */
+        static constexpr auto _set_bits = [](BlockType& block, const BlockType mask) noexcept { block |= mask; };
+        static constexpr auto _reset_bits = [](BlockType& block, const BlockType mask) noexcept { block &= static_cast<BlockType>(~mask); };
+        static constexpr auto _flip_bits = [](BlockType& block, const BlockType mask) noexcept { block ^= mask; };
+
+        /**
+         * Applies op to every step-th bit of the range, bit by bit if the bitset is too small for the periodic masks
+         * detail::apply_strided only takes the periodic masks for at least 4 blocks worth of steps of at least 2 bits,
+         * skipping them at compile time keeps their block loops out of small bitsets.
+         * @tparam Op Type of the operation
+         * @param begin Begin of the range (bit index)
+         * @param end End of the range (bit index)
+         * @param step Step between the modified bits (bit step)
+         * @param op Operation applied as op(block, mask)
+         */
+        template <typename Op>
+        constexpr void _apply_strided(const size_type& begin, const size_type& end, const size_type& step, Op op) noexcept
+        {
+            if constexpr (Size < 8 * m_block_size)
             {
-                const uint16_t end_bit = begin / m_block_size == end / m_block_size ? end % m_block_size : m_block_size;
-                for (uint16_t i = begin % m_block_size; i < end_bit; ++i)
-                    m_data[begin / m_block_size] &= ~(BlockType{1} << i);
+                if (step)
+                    detail::apply_each(m_data, begin, end, step, op);
             }
             else
-                to_add = 0;
+                detail::apply_strided(m_data, begin, end, step, op);
+        }
 
-            // set the end block if the end is not aligned with the block size
-            if (end % m_block_size && begin / m_block_size != end / m_block_size) [[likely]]
-            {
-                for (uint16_t i = 0; i < end % m_block_size; ++i)
-                    m_data[end / m_block_size] &= ~(BlockType{1} << i);
-            }
+        /**
+         * Applies op to every Step-th bit of the range through the compile-time periodic masks of Step
+         * detail::apply_periodic goes bit by bit for fewer than a block worth of steps, so bitsets shorter than that skip the masks.
+         * @tparam Step Step between the modified bits (bit step, shorter than a block)
+         * @tparam Op Type of the operation
+         * @param begin Begin of the range (bit index)
+         * @param end End of the range (bit index)
+         * @param op Operation applied as op(block, mask)
+         */
+        template <size_type Step, typename Op>
+        constexpr void _apply_periodic(const size_type& begin, const size_type& end, Op op) noexcept
+        {
+            if constexpr (Size < Step * m_block_size)
+                detail::apply_each(m_data, begin, end, Step, op);
             else
-                to_sub = 0;
+                detail::apply_periodic(m_data, begin, end, Step, detail::periodic_masks_v<BlockType, Step>, op);
+        }
 
-            if (std::is_constant_evaluated())
-			{
-				for (size_type i = begin / m_block_size + to_add; i < end / m_block_size; ++i)
-					m_data[i] = 0;
-			}
-			else
-				::memset(m_data + begin / m_block_size + to_add, 0, (end - begin) / m_block_size * sizeof(BlockType) - to_sub);
+        /**
+         * Mask of the bits of a block that belong to the specified range, used by the loop-free paths of small bitsets
+         * @param block Index of the block
+         * @param begin Begin of the range (bit index)
+         * @param end End of the range (bit index)
+         * @return Mask of the bits of the block within [begin, end), 0 if the block and the range do not overlap
+         */
+        [[nodiscard]] static constexpr BlockType _range_mask(const size_type& block, const size_type& begin, const size_type& end) noexcept
+        {
+            const size_type low = block * m_block_size;
+            if (begin >= low + m_block_size || end <= low)
+                return 0;
+            return static_cast<BlockType>((begin > low ? detail::mask_from<BlockType>(begin) : (std::numeric_limits<BlockType>::max)())
+                & (end < low + m_block_size ? detail::mask_until<BlockType>(end) : (std::numeric_limits<BlockType>::max)()));
         }
 
+    public:
+
         /**
          * Fills all the bits in the specified range with the specified value
          * @param value Value to fill the bits with (bit value)
@@ -2215,25 +3474,33 @@ namespace woj
          */
         constexpr void fill_range(const size_type& begin, const size_type& end, const size_type& step, const bool value) noexcept
         {
-            for (size_type i = begin; i < end; i += step)
-            {
-                if (value)
-                    m_data[i / m_block_size] |= BlockType{1} << i % m_block_size;
-                else
-                    m_data[i / m_block_size] &= ~(BlockType{1} << i % m_block_size);
-            }
+            if (step == 1)
+                fill_range(begin, end, value);
+            else if (value)
+                _apply_strided(begin, end, step, _set_bits);
+            else
+                _apply_strided(begin, end, step, _reset_bits);
+        }
+
+        /**
+         * Fills every step-th bit in the specified range with the specified value
+         * @deprecated Kept for source compatibility, same as fill_range(begin, end, step, value)
+         */
+        [[deprecated("use fill_range(begin, end, step, value)")]]
+        constexpr void fill_range_optimized(const size_type& begin, const size_type& end, const size_type& step, const bool value) noexcept
+        {
+            fill_range(begin, end, step, value);
         }
 
         /**
-         * Sets all the bits in the specified range to 1 (false)
+         * Sets all the bits in the specified range to 1 (true)
          * @param begin Begin of the range to fill (bit index)
          * @param end End of the range to fill (bit index)
          * @param step Step size between the bits to fill (bit step)
          */
         constexpr void set_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
         {
-            for (size_type i = begin; i < end; i += step)
-                m_data[i / m_block_size] |= BlockType{1} << i % m_block_size;
+            fill_range(begin, end, step, true);
         }
 
         /**
@@ -2244,113 +3511,51 @@ namespace woj
          */
         constexpr void reset_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
         {
-            for (size_type i = begin; i < end; i += step)
-                m_data[i / m_block_size] &= ~(BlockType{1} << i % m_block_size);
+            fill_range(begin, end, step, false);
         }
 
         /**
-         * !!! W.I.P. - Does not function correctly at the moment !!!\n
-		 */
-        constexpr void fill_range_optimized(const size_type& begin, const size_type& end, const size_type& step, const bool value) noexcept
+         * Fills every Step-th bit in the specified range with the specified value, the block masks of Step are computed at compile time
+         * @tparam Step Step size between the bits to fill (bit step)
+         * @param begin Begin of the range to fill (bit index)
+         * @param end End of the range to fill (bit index)
+         * @param value Value to fill the bits with (bit value)
+         */
+        template <size_type Step> requires (Step != 0)
+        constexpr void fill_range(const size_type& begin, const size_type& end, const bool value) noexcept
         {
-            // Initialize variables
-            size_type blocks_size, current_block = begin / m_block_size + 1 + step / m_block_size, current_offset = 0;
-
-        	const size_type end_block = end / m_block_size + (end % m_block_size ? 1 : 0);
-
-            // Determine the size of blocks based on step and block size
-            if ((step % 2 || step <= m_block_size) && m_block_size % step) {
-                blocks_size = (std::min)(m_storage_size, step);
-            }
-            else if (!(m_block_size % step))
-                blocks_size = 1;
-            else if (!(step % m_block_size))
-                blocks_size = step / m_block_size;
+            if constexpr (Step == 1)
+                fill_range(begin, end, value);
+            else if constexpr (Step >= m_block_size)
+                fill_range(begin, end, Step, value);
+            else if (value)
+                _apply_periodic<Step>(begin, end, _set_bits);
             else
-            {
-                // GCD of step and m_block_size
-                if (step % m_block_size)
-                {
-                    size_type a = step, b = m_block_size, t = m_block_size;
-                    while (b) {
-                        t = b;
-                        b = a % b;
-                        a = t;
-                    }
-                    blocks_size = a;
-                }
-                else
-                    blocks_size = 1;
-            }
-
-
-
-            // Calculate the offset
-            uint16_t offset = (step - (m_block_size - begin % m_block_size) % step) % step;
-
-            // Create and apply the beginning block
-            {
-                const uint16_t end_bit = (begin / m_block_size == end / m_block_size) ? end % m_block_size : m_block_size;
-                if (value)
-                {
-                    for (uint16_t i = begin % m_block_size; i < end_bit; i += step)
-                        m_data[begin / m_block_size] |= BlockType{ 1 } << i;
-                }
-                else
-                {
-                    for (uint16_t i = begin % m_block_size; i < end_bit; i += step)
-                        m_data[begin / m_block_size] &= ~(BlockType{ 1 } << i);
-                }
-            }
-
-
-            // Fill with appropriate block
-            std::cout << blocks_size << " blocks\n";
-            std::cout << (std::min)(blocks_size, m_storage_size) << " blocks\n";
-            for (size_type i = 0; i < (std::min)(blocks_size, m_storage_size); ++i)
-            {
-                std::cout << "offset: " << offset << '\n';
-
-                // Generate block for the current iteration
-                BlockType block = 0;
-
-                if (value)
-                {
-                    for (uint16_t j = !i ? offset : 0; j < m_block_size; ++j)
-                    {
-                        //std::cout << current_block * m_block_size + j - offset << '\n';
-                        if (!((i * m_block_size + j - offset) % step))
-                            block |= BlockType{ 1 } << j;
-                    }
-                }
-                else
-                {
-                    block = (std::numeric_limits<BlockType>::max)();
-                    for (uint16_t j = !i ? offset : 0; j < m_block_size; ++j)
-                    {
-                        if (!((i * m_block_size + j - offset) % step))
-                            block &= ~(BlockType{ 1 } << j);
-                    }
-                }
-
-                // print the block
-                for (uint16_t j = 0; j < m_block_size; ++j)
-                {
-                    std::cout << ((block & BlockType{ 1 } << j) >> j);
-                }
+                _apply_periodic<Step>(begin, end, _reset_bits);
+        }
 
-                std::cout << '\n';
+        /**
+         * Sets every Step-th bit in the specified range to 1 (true), the block masks of Step are computed at compile time
+         * @tparam Step Step size between the bits to set (bit step)
+         * @param begin Begin of the range to fill (bit index)
+         * @param end End of the range to fill (bit index)
+         */
+        template <size_type Step> requires (Step != 0)
+        constexpr void set_range(const size_type& begin, const size_type& end) noexcept
+        {
+            fill_range<Step>(begin, end, true);
+        }
 
-                // Apply the block
-                for (size_type j = current_block++; j < m_storage_size; j += blocks_size)
-                {
-                    if (value)
-                        *(m_data + j) |= block;
-                    else
-                        *(m_data + j) &= block;
-                }
-                offset = (step - (m_block_size - offset % m_block_size) % step) % step;
-            }
+        /**
+         * Sets every Step-th bit in the specified range to 0 (false), the block masks of Step are computed at compile time
+         * @tparam Step Step size between the bits to reset (bit step)
+         * @param begin Begin of the range to fill (bit index)
+         * @param end End of the range to fill (bit index)
+         */
+        template <size_type Step> requires (Step != 0)
+        constexpr void reset_range(const size_type& begin, const size_type& end) noexcept
+        {
+            fill_range<Step>(begin, end, false);
         }
 
         /**
@@ -2498,8 +3703,7 @@ namespace woj
          */
         constexpr void flip() noexcept
         {
-            for (size_type i = 0; i < m_storage_size; ++i)
-                m_data[i] = ~m_data[i];
+            _combine(*this, *this, detail::bit_invert{});
         }
 
         /**
@@ -2508,11 +3712,7 @@ namespace woj
          */
         constexpr void flip_range(const size_type& end) noexcept
         {
-            // flip blocks that are in range by bulk, rest flip normally
-            for (size_type i = 0; i < end / m_block_size; ++i)
-                m_data[i] = ~m_data[i];
-            for (uint16_t i = 0; i < end % m_block_size; ++i)
-                m_data[end / m_block_size] ^= BlockType{1} << i;
+            flip_range(0, end);
         }
 
         /**
@@ -2522,23 +3722,33 @@ namespace woj
          */
         constexpr void flip_range(const size_type& begin, const size_type& end) noexcept
         {
-            size_type to_add = 1;
-            if (begin % m_block_size) [[likely]]
+            if constexpr (m_word_sized)
             {
-                for (uint16_t i = begin % m_block_size; i < m_block_size; ++i)
-                    m_data[begin / m_block_size] ^= BlockType{1} << i;
+                for (size_type i = 0; i < m_storage_size; ++i)
+                    m_data[i] ^= _range_mask(i, begin, end);
+                return;
             }
-            else
-                to_add = 0;
 
-            for (size_type i = begin / m_block_size + to_add; i < end / m_block_size; ++i)
-                m_data[i] = ~m_data[i];
+            if (begin >= end)
+                return;
+
+            const size_type first_block = begin / m_block_size;
+            const size_type last_block = (end - 1) / m_block_size;
+
+            // Masks of the bits that belong to the range within the first and the last block
+            const BlockType first_mask = detail::mask_from<BlockType>(begin);
+            const BlockType last_mask = detail::mask_until<BlockType>(end);
 
-            if (end % m_block_size) [[likely]]
+            if (first_block == last_block)
             {
-                for (uint16_t i = 0; i < end % m_block_size; ++i)
-                    m_data[end / m_block_size] ^= BlockType{1} << i;
+                m_data[first_block] ^= first_mask & last_mask;
+                return;
             }
+
+            m_data[first_block] ^= first_mask;
+            for (size_type i = first_block + 1; i < last_block; ++i)
+                m_data[i] = ~m_data[i];
+            m_data[last_block] ^= last_mask;
         }
 
         /**
@@ -2549,10 +3759,27 @@ namespace woj
          */
         constexpr void flip_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
         {
-            for (size_type i = begin; i < end; i += step)
-            {
-                m_data[i / m_block_size] ^= BlockType{1} << i % m_block_size;
-            }
+            if (step == 1)
+                flip_range(begin, end);
+            else
+                _apply_strided(begin, end, step, _flip_bits);
+        }
+
+        /**
+         * Flips every Step-th bit in the specified range, the block masks of Step are computed at compile time
+         * @tparam Step Step size between the bits to flip (bit step)
+         * @param begin Begin of the range to flip (bit index)
+         * @param end End of the range to flip (bit index)
+         */
+        template <size_type Step> requires (Step != 0)
+        constexpr void flip_range(const size_type& begin, const size_type& end) noexcept
+        {
+            if constexpr (Step == 1)
+                flip_range(begin, end);
+            else if constexpr (Step >= m_block_size)
+                flip_range(begin, end, Step);
+            else
+                _apply_periodic<Step>(begin, end, _flip_bits);
         }
 
         /**
@@ -2607,6 +3834,33 @@ namespace woj
             return m_data[index / m_block_size] & BlockType{1} << index % m_block_size;
         }
 
+        /**
+         * Tests the bits at the specified indices, prefetching their blocks a window ahead
+         * @tparam Indices Type of the contiguous range of unsigned indices
+         * @param indices Indices of the bits to test (bit indices)
+         * @param results Values of the bits, results[i] for indices[i] (indices.size() elements)
+         * @param partition Whether to radix-partition the indices by 256 KiB region first, for many indices into large bitsets
+         */
+        template <std::ranges::contiguous_range Indices> requires std::unsigned_integral<std::ranges::range_value_t<Indices>>
+        constexpr void test_many(const Indices& indices, bool* results, const bool partition = false) const noexcept
+        {
+            detail::test_indices(m_data, Size, std::ranges::data(indices), std::ranges::size(indices), partition, [results](const std::size_t position, const bool value) noexcept { results[position] = value; });
+        }
+
+        /**
+         * Tests the bits at the specified indices, prefetching their blocks a window ahead
+         * @tparam Indices Type of the contiguous range of unsigned indices
+         * @tparam Results Type of the bitset receiving the results
+         * @param indices Indices of the bits to test (bit indices)
+         * @param results Bitset of at least indices.size() bits, bit i receives the value of the bit at indices[i]
+         * @param partition Whether to radix-partition the indices by 256 KiB region first, for many indices into large bitsets
+         */
+        template <std::ranges::contiguous_range Indices, typename Results> requires std::unsigned_integral<std::ranges::range_value_t<Indices>> && requires (Results& results) { results.set(std::size_t{}, bool{}); }
+        constexpr void test_many(const Indices& indices, Results& results, const bool partition = false) const noexcept
+        {
+            detail::test_indices(m_data, Size, std::ranges::data(indices), std::ranges::size(indices), partition, [&results](const std::size_t position, const bool value) noexcept { results.set(position, value); });
+        }
+
         /**
          * Retrieves the block at the specified index
          * @param index Index of the block to retrieve (block index)
@@ -2627,6 +3881,44 @@ namespace woj
             return m_data[index];
         }
 
+        /**
+         * Reads a field of bits, bit pos becomes the least significant bit of the result
+         * @tparam T Type of the field
+         * @param pos Index of the first bit of the field (bit index)
+         * @param len Length of the field (bit count, at most the width of T, pos + len must not exceed Size)
+         * @return Value of the field
+         */
+        template <unsigned_integer T = std::uint64_t>
+        [[nodiscard]] constexpr T get_bits(const size_type& pos, const size_type& len) const noexcept
+        {
+            return detail::read_bits<T>(m_data, m_storage_size, pos, len);
+        }
+
+        /**
+         * Reads a field of at most one block of bits without branching on whether it straddles two blocks
+         * @tparam T Type of the field
+         * @param pos Index of the first bit of the field (bit index, must be less than Size)
+         * @param len Length of the field (bit count, at most the width of T and of BlockType, pos + len must not exceed Size)
+         * @return Value of the field
+         */
+        template <unsigned_integer T = BlockType>
+        [[nodiscard]] constexpr T get_bits_straddling(const size_type& pos, const size_type& len) const noexcept
+        {
+            return detail::read_bits_straddling<T>(m_data, m_storage_size, pos, len);
+        }
+
+        /**
+         * Writes a field of bits, the least significant bit of value goes to bit pos
+         * @tparam T Type of the field
+         * @param pos Index of the first bit of the field (bit index)
+         * @param len Length of the field (bit count, at most the width of T, pos + len must not exceed Size)
+         * @param value Value of the field (bits above len are ignored)
+         */
+        template <unsigned_integer T>
+        constexpr void set_bits(const size_type& pos, const size_type& len, const T value) noexcept
+        {
+            detail::write_bits(m_data, m_storage_size, pos, len, value);
+        }
 
         /**
          * Checks if all bits are set
@@ -2634,21 +3926,38 @@ namespace woj
          */
         [[nodiscard]] constexpr bool all() const noexcept
         {
-            // check all except the last one if the size is not divisible by m_block_size
-            for (size_type i = 0; i < m_storage_size - !!m_partial_size; ++i)
-            {
-                if (m_data[i] != (std::numeric_limits<BlockType>::max)())
-                    return false;
-            }
-            if (m_partial_size)
+            return all(0, Size);
+        }
+
+        /**
+         * Checks if all bits in the specified range are set
+         * @param begin Begin of the range to check (bit index)
+         * @param end End of the range to check (bit index)
+         * @return true if all bits in the range are set (or the range is empty), false otherwise
+         */
+        [[nodiscard]] constexpr bool all(const size_type& begin, const size_type& end) const noexcept
+        {
+            if constexpr (m_word_sized)
             {
-                for (uint16_t i = 0; i < m_partial_size; ++i)
-                {
-                    if (!(m_data[Size / m_block_size] & BlockType{1} << i))
-                        return false;
-                }
+                BlockType missing = 0;
+                for (size_type i = 0; i < m_storage_size; ++i)
+                    missing |= static_cast<BlockType>(_range_mask(i, begin, end) & ~m_data[i]);
+                return !missing;
             }
-            return true;
+
+            if (begin >= end)
+                return true;
+
+            const size_type first_block = begin / m_block_size;
+            const size_type last_block = (end - 1) / m_block_size;
+            const BlockType first_mask = detail::mask_from<BlockType>(begin);
+            const BlockType last_mask = detail::mask_until<BlockType>(end);
+
+            if (first_block == last_block)
+                return (m_data[first_block] & first_mask & last_mask) == (first_mask & last_mask);
+            if ((m_data[first_block] & first_mask) != first_mask || (m_data[last_block] & last_mask) != last_mask)
+                return false;
+            return !detail::any_of_blocks(m_data + first_block + 1, last_block - first_block - 1, [](const BlockType block) noexcept { return static_cast<BlockType>(~block); });
         }
 
         /**
@@ -2657,20 +3966,38 @@ namespace woj
          */
         [[nodiscard]] constexpr bool any() const noexcept
         {
-            for (size_type i = 0; i < m_storage_size - !!m_partial_size; ++i)
+            return any(0, Size);
+        }
+
+        /**
+         * Checks if any bit in the specified range is set
+         * @param begin Begin of the range to check (bit index)
+         * @param end End of the range to check (bit index)
+         * @return true if any bit in the range is set, false otherwise
+         */
+        [[nodiscard]] constexpr bool any(const size_type& begin, const size_type& end) const noexcept
+        {
+            if constexpr (m_word_sized)
             {
-                if (m_data[i])
-                    return true;
-            }
-            if (m_partial_size)
-            {
-                for (uint16_t i = 0; i < m_partial_size; ++i)
-                {
-                    if (m_data[Size / m_block_size] & BlockType{1} << i)
-                        return true;
-                }
+                BlockType found = 0;
+                for (size_type i = 0; i < m_storage_size; ++i)
+                    found |= static_cast<BlockType>(m_data[i] & _range_mask(i, begin, end));
+                return found;
             }
-            return false;
+
+            if (begin >= end)
+                return false;
+
+            const size_type first_block = begin / m_block_size;
+            const size_type last_block = (end - 1) / m_block_size;
+            const BlockType first_mask = detail::mask_from<BlockType>(begin);
+            const BlockType last_mask = detail::mask_until<BlockType>(end);
+
+            if (first_block == last_block)
+                return (m_data[first_block] & first_mask & last_mask) != 0;
+            if (m_data[first_block] & first_mask || m_data[last_block] & last_mask)
+                return true;
+            return detail::any_of_blocks(m_data + first_block + 1, last_block - first_block - 1, [](const BlockType block) noexcept { return block; });
         }
 
         /**
@@ -2679,20 +4006,18 @@ namespace woj
          */
         [[nodiscard]] constexpr bool none() const noexcept
         {
-            for (size_type i = 0; i < m_storage_size - !!m_partial_size; ++i)
-            {
-                if (m_data[i])
-                    return false;
-            }
-            if (m_partial_size)
-            {
-                for (uint16_t i = 0; i < m_partial_size; ++i)
-                {
-                    if (m_data[Size / m_block_size] & BlockType{1} << i)
-                        return false;
-                }
-            }
-            return true;
+            return !any(0, Size);
+        }
+
+        /**
+         * Checks if none of the bits in the specified range are set
+         * @param begin Begin of the range to check (bit index)
+         * @param end End of the range to check (bit index)
+         * @return true if none of the bits in the range are set, false otherwise
+         */
+        [[nodiscard]] constexpr bool none(const size_type& begin, const size_type& end) const noexcept
+        {
+            return !any(begin, end);
         }
 
         /**
@@ -2700,17 +4025,55 @@ namespace woj
          */
         [[nodiscard]] constexpr size_type count() const noexcept
         {
-            size_type count = 0;
-            for (size_type i = 0; i < m_storage_size; ++i)
+            return count(0, Size);
+        }
+
+        /**
+         * Counts the set bits in the specified range
+         * @param begin Begin of the range to count (bit index)
+         * @param end End of the range to count (bit index)
+         * @return The number of set bits in the range
+         */
+        [[nodiscard]] constexpr size_type count(const size_type& begin, const size_type& end) const noexcept
+        {
+            if constexpr (m_word_sized)
+            {
+                size_type result = 0;
+                for (size_type i = 0; i < m_storage_size; ++i)
+                    result += static_cast<size_type>(detail::popcount(static_cast<BlockType>(m_data[i] & _range_mask(i, begin, end))));
+                return result;
+            }
+
+            return detail::count_range(m_data, begin, end);
+        }
+
+        /**
+         * Finds the first set bit
+         * @return Index of the first set bit, size() if there is none
+         */
+        [[nodiscard]] constexpr size_type find_first() const noexcept
+        {
+            return find_next(0);
+        }
+
+        /**
+         * Finds the first set bit at or after the specified position
+         * @param pos Position to start the search at (bit index)
+         * @return Index of the found bit, size() if there is none
+         */
+        [[nodiscard]] constexpr size_type find_next(const size_type& pos) const noexcept
+        {
+            if constexpr (m_word_sized)
             {
-                BlockType j = m_data[i];
-                while (j)
+                for (size_type i = 0; i < m_storage_size; ++i)
                 {
-                    j &= j - 1;
-                    ++count;
+                    if (const BlockType bits = static_cast<BlockType>(m_data[i] & _range_mask(i, pos, Size)))
+                        return i * m_block_size + static_cast<size_type>(detail::countr_zero(bits));
                 }
+                return Size;
             }
-            return count;
+            else
+                return detail::find_next(m_data, Size, pos);
         }
 
         /**
@@ -2742,6 +4105,12 @@ namespace woj
          */
         static constexpr size_type m_storage_size = Size / m_block_size + !!m_partial_size;
 
+        /**
+         * Whether the bitset fits in one or two blocks, range queries and updates then work on the blocks directly
+         * instead of looping with partial block handling
+         */
+        static constexpr bool m_word_sized = m_storage_size <= 2;
+
         /**
 		 * Underlying array of blocks containing the bits
 		 */
@@ -2765,16 +4134,16 @@ namespace woj
         // Type definitions
 
         // Reference types
-        class reference;
+        typedef detail::bit_reference<BlockType> reference;
         typedef bool const_reference;
 
         // Iterators
-        class iterator;
-        class const_iterator;
+        typedef detail::bit_iterator<BlockType, false> iterator;
+        typedef detail::bit_iterator<BlockType, true> const_iterator;
 
         // Reverse iterators
-        class reverse_iterator;
-        class const_reverse_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
         // Value types
         typedef bool value_type;
@@ -2782,2985 +4151,5642 @@ namespace woj
 
         // Other types
         typedef std::size_t size_type;
-        typedef size_type difference_type;
+        typedef std::ptrdiff_t difference_type;
         typedef BlockType block_type;
 
-        class reference
-        {
-        public:
-            /**
-             * Constructs a new reference instance based on the specified bitset and index
-             * @param bitset The bitset instance to iterate over
-             * @param index Index of the bit to start the iteration from (bit index)
-             */
-            reference(dynamic_bitset& bitset, const size_type& index) noexcept : m_bitset(bitset), m_index(index) {}
-
-            /**
-             * Copy constructor
-             */
-            reference(const reference&) noexcept = default;
-
-            /**
-             * Destructor
-             */
-            ~reference() noexcept = default;
-
-            /**
-             * Bool conversion operator
-             * @return Value at current index (bit value)
-             */
-            [[nodiscard]] operator bool() const noexcept
-            {
-                return m_bitset.test(m_index);
-            }
-
-            /**
-             * Assignment operator
-             * @param value Value to set the bit to (bit value)
-             */
-            reference& operator=(const bool value) noexcept
-            {
-                m_bitset.set(m_index, value);
-                return *this;
-            }
-
-            /**
-             * Assignment operator
-             * @param other Other reference instance to copy from
-             */
-            reference& operator=(const reference& other) noexcept
-            {
-                m_bitset.set(m_index, other.m_bitset.test(other.m_index));
-                return *this;
-            }
-
-            /**
-             * Bitwise AND assignment operator
-             * @param value Value to AND the bit with (bit value)
-             */
-            reference& operator&=(const bool value) const noexcept
-            {
-                m_bitset.set(m_index, m_bitset.test(m_index) & value);
-                return *this;
-            }
-
-            /**
-             * Bitwise OR assignment operator
-             * @param value Value to OR the bit with (bit value)
-             */
-            reference& operator|=(const bool value) const noexcept
-            {
-                m_bitset.set(m_index, m_bitset.test(m_index) | value);
-                return *this;
-            }
-
-            /**
-             * Bitwise XOR assignment operator
-             * @param value Value to XOR the bit with (bit value)
-             */
-            reference& operator^=(const bool value) const noexcept
-            {
-                m_bitset.set(m_index, m_bitset.test(m_index) ^ value);
-                return *this;
-            }
+        /**
+         * Empty constructor
+         */
+        dynamic_bitset() noexcept : m_partial_size(0), m_storage_size(0), m_size(0), m_data(nullptr) {}
 
-            /**
-             * Flip the bit at the current index
-             */
-            void flip() const noexcept
-            {
-                m_bitset.flip(m_index);
-            }
+        /**
+		 * Size constructor
+		 * @param size Size of the bitset to create (bit count)
+		 */
+        explicit dynamic_bitset(const size_type& size) noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+        {
+            reset();
+        }
 
-            /**
-             * Set the bit at the current index to value
-             * @param value Value to set the bit to (bit value)
-             */
-            void set(const bool value = true) const noexcept
-            {
-                m_bitset.set(m_index, value);
-            }
+        /**
+         * Size and bool value constructor
+         * @tparam U Used to constrain type to bool. [don't use]
+         * @param size Size of the bitset to create (bit count)
+         * @param val Bool value to fill the bitset with (bit value)
+         */
+        template <unsigned_integer U = std::remove_cvref_t<BlockType>> requires (!std::is_same_v<bool, U> && !std::is_pointer_v<U> && !std::is_array_v<U>)
+        explicit dynamic_bitset(const size_type& size, const bool val) noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+        {
+	        fill(val);
+		}
 
-            /**
-             * Reset the bit at the current index to value
-             */
-            void reset() const noexcept
-            {
-                m_bitset.reset(m_index);
-            }
+        /**
+         * Size and block value constructor
+         * @param size Size of the bitset to create (bit count)
+         * @param block Block to fill the bitset with (block value)
+         */
+        explicit dynamic_bitset(const size_type& size, const BlockType& block) noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+        {
+            fill_block(block);
+        }
 
-            dynamic_bitset& m_bitset;
-            const size_type& m_index;
-        };
+        /**
+         * Copy constructor
+         * @param other Other dynamic_bitset instance to copy from
+         */
+        dynamic_bitset(const dynamic_bitset& other) noexcept : m_partial_size(other.m_partial_size), m_storage_size(other.m_storage_size), m_size(other.m_size), m_data(new BlockType[other.m_storage_size])
+        {
+            //std::copy(other.m_data, other.m_data + other.m_storage_size, m_data);
+            _from_other(other);
+        }
 
         /**
-         * Base iterator class template.
-         * @tparam BitSetTypeSpecifier Full type of the bitset to iterate over. [bitset&] or [const bitset&]
+         * Size copy constructor
+         * @param size Size of the bitset to create (bit count)
+		 * @param other Other dynamic_bitset instance to copy from
          */
-        template <typename BitSetTypeSpecifier> requires std::is_same_v<dynamic_bitset, std::remove_cvref_t<BitSetTypeSpecifier>>
-        class iterator_base {
-        public:
-            iterator_base() noexcept = delete;
+    	dynamic_bitset(const size_type& size, const dynamic_bitset& other) noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+        {
+            //::memset(m_data, 0, m_storage_size * sizeof(BlockType));;
+            //std::copy(other.m_data, other.m_data + (std::min)(m_storage_size, other.m_storage_size), m_data);
+            _from_other(other);
+        }
 
-            /**
-             * Constructs a new iterator_base instance based on the specified bitset and index.
-             * @param bitset The bitset instance to iterate over.
-             * @param index Index of the bit to start the iteration from (bit index).
-             */
-            explicit iterator_base(BitSetTypeSpecifier bitset, const size_type& index = 0) noexcept : m_bitset(bitset), m_index(index) {}
+        /**
+         * Move constructfor
+         * @param other Other dynamic_bitset instance to move from
+         */
+        dynamic_bitset(dynamic_bitset&& other) noexcept : m_partial_size(other.m_partial_size), m_storage_size(other.m_storage_size), m_size(other.m_size), m_data(other.m_data)
+        {
+            _from_other(std::move(other));
+        }
 
-            /**
-             * Copy constructor.
-             * @param other Other iterator_base instance to copy from.
-             */
-            iterator_base(const iterator_base& other) noexcept : m_bitset(other.m_bitset), m_index(other.m_index) {}
+        /**
+         * General conversion constructor
+         * @tparam OtherBlockType Type of the block to copy from
+         * @param other Other bitset instance to copy from
+         */
+        template <unsigned_integer OtherBlockType> requires (std::convertible_to<OtherBlockType, BlockType> && !std::is_same_v<BlockType, OtherBlockType>)
+    	dynamic_bitset(const dynamic_bitset<OtherBlockType>& other) noexcept : m_partial_size(other.m_size % m_block_size), m_storage_size(other.m_size / m_block_size + !!m_partial_size), m_size(other.m_size), m_data(new BlockType[m_storage_size])
+        {
+            _from_other<OtherBlockType>(other);
+        }
 
-            /**
-             * Destructor.
-             */
-            ~iterator_base() noexcept = default;
+        /**
+		 * Size and general conversion constructor
+		 * @tparam OtherBlockType Type of the block to copy from
+		 * @param size Size of bitset to create (bit count)
+		 * @param other Other bitset instance to copy from
+		 */
+        template <unsigned_integer OtherBlockType> requires (std::convertible_to<OtherBlockType, BlockType> && !std::is_same_v<BlockType, OtherBlockType>)
+        explicit dynamic_bitset(const size_type& size, const dynamic_bitset<OtherBlockType>& other) noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+        {
+            _from_other<OtherBlockType>(other);
+        }
 
-            /**
-             * Copy assignment operator.
-             */
-            iterator_base& operator=(const iterator_base& other) noexcept {
-                m_bitset = other.m_bitset;
-                m_index = other.m_index;
-                return *this;
-            }
+        /**
+         * C string stack array conversion constructor
+         * @tparam Elem Type of the character array
+         * @tparam StrSize m_size of the character array
+         * @param c_str Array c string to fill the bitset with (must be null-terminated)
+         * @param set_chr Character that represents set bits
+         */
+        template <char_type Elem, size_type StrSize>
+        dynamic_bitset(const Elem(&c_str)[StrSize], const Elem& set_chr = '1') noexcept : m_partial_size((StrSize - 1) % m_block_size), m_storage_size((StrSize - 1) / m_block_size + !!m_partial_size), m_size(StrSize - 1), m_data(new BlockType[m_storage_size])
+        {
+            reset();
+            _from_c_string<Elem, StrSize>(c_str, set_chr);
+        }
 
-            BitSetTypeSpecifier m_bitset;
-            size_type m_index;
-        };
+        /**
+		 * Size and c string array conversion constructor
+		 * @tparam Elem Type of the character array
+		 * @tparam StrSize m_size of the character array
+		 * @param size Size of the bitset to create (bit count)
+		 * @param c_str Array c string to fill the bitset with (must be null-terminated)
+		 * @param set_chr Character that represents set bits
+		 */
+        template <char_type Elem, size_type StrSize>
+        explicit dynamic_bitset(const size_type& size, const Elem(&c_str)[StrSize], const Elem& set_chr = '1') noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+        {
+            reset();
+            _from_c_string<Elem, StrSize>(c_str, set_chr);
+        }
 
         /**
-         * Iterator class.
+         * Size and c string pointer conversion constructor
+         * @tparam PtrArr Type of the character array [don't use]
+         * @tparam Elem Type of the character array [don't use]
+         * @param size Size of bitset to create (bit count)
+         * @param c_str Pointer to c string to fill the bitset with (must be null-terminated)
+         * @param set_chr Character that represents set bits
          */
-        class iterator : public iterator_base<dynamic_bitset&> {
-        public:
-            using iterator_base<dynamic_bitset&>::iterator_base;
-
-            /**
-             * Conversion constructor to const_iterator.
-             * @param other Other const_iterator instance to convert from.
-             */
-            iterator(const const_iterator& other) noexcept : iterator_base<dynamic_bitset&>(other.m_bitset, other.m_index) {}
+        template <typename PtrArr = const char*, char_type Elem = std::remove_cvref_t<std::remove_pointer_t<std::remove_cvref_t<PtrArr>>>> requires (std::is_pointer_v<PtrArr> && !std::is_array_v<PtrArr>&& char_type<Elem>)
+        explicit dynamic_bitset(const size_type& size, PtrArr c_str, const Elem& set_chr = '1') noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+        {
+            reset();
+            _from_c_string<PtrArr, Elem>(c_str, set_chr);
+        }
+
+        /**
+         * String conversion constructor
+         * @tparam Elem Type of the character array
+         * @param str String to fill the bitset with (must be null-terminated), it's size ought to be >= size(), but nothing will happen if it's not
+         * @param set_chr Character that represents set bits
+         */
+        template <char_type Elem>
+        dynamic_bitset(const std::basic_string<Elem>& str, const Elem& set_chr = '1') noexcept : m_partial_size(str.size() % m_block_size), m_storage_size(str.size() / m_block_size + !!m_partial_size), m_size(str.size()), m_data(new BlockType[m_storage_size])
+        {
+            reset();
+            _from_string(str, set_chr);
+        }
+
+        /**
+		 * Size and string conversion constructor
+		 * @tparam Elem Type of the character array
+		 * @param size Size of bitset to create (bit count)
+		 * @param str String to fill the bitset with (must be null-terminated), it's size ought to be >= size(), but nothing will happen if it's not
+		 * @param set_chr Character that represents set bits
+		 * @param sep_present Whenever character that separates the bit blocks exists
+		 */
+        template <typename Elem>
+        explicit dynamic_bitset(const size_type& size, const std::basic_string<Elem>& str, const Elem& set_chr = '1') noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+        {
+            reset();
+            _from_string(str, set_chr);
+        }
+
+        /**
+         * std::vector<bool> conversion constructor, copies whole words where std::vector<bool> exposes them
+         * @param other std::vector<bool> to convert from
+         */
+        explicit dynamic_bitset(const std::vector<bool>& other) noexcept : m_partial_size(other.size() % m_block_size), m_storage_size(other.size() / m_block_size + !!m_partial_size), m_size(other.size()), m_data(new BlockType[m_storage_size])
+        {
+            reset();
+            detail::from_std_vector(other, m_data);
+        }
+
+        /**
+         * std::bitset conversion constructor, copies whole words where the layout of std::bitset is known
+         * @tparam OtherSize Size of the std::bitset to convert from
+         * @param other std::bitset to convert from
+         */
+        template <size_type OtherSize>
+        explicit dynamic_bitset(const std::bitset<OtherSize>& other) noexcept : m_partial_size(OtherSize % m_block_size), m_storage_size(OtherSize / m_block_size + !!m_partial_size), m_size(OtherSize), m_data(new BlockType[m_storage_size])
+        {
+            reset();
+            detail::from_std_bitset(other, m_data, OtherSize);
+        }
+
+        /**
+		 * Destructor
+		 */
+        ~dynamic_bitset() noexcept
+        {
+            delete[] m_data;
+        }
+
+        /**
+         * Returns the value of the bit at the specified index
+         * @param index Index of the bit to retrieve (bit index)
+         * @return Value of the bit at the specified index (bit value)
+         */
+        [[nodiscard]] const_reference operator[](const size_type& index) const noexcept
+        {
+            return m_data[index / m_block_size] & BlockType{ 1 } << index % m_block_size;
+        }
+
+        /**
+         * Returns reference to the value of the bit at the specified index
+         * @param index Index of the bit to retrieve (bit index)
+         * @return Reference to the value of the bit at the specified index
+         */
+        [[nodiscard]] reference operator[](const size_type& index) noexcept
+        {
+            return reference(m_data + index / m_block_size, static_cast<BlockType>(BlockType{ 1 } << index % m_block_size));
+        }
+
+        /**
+         * General copy assignment operator
+         * @tparam OtherBlockType Type of the block to copy from
+         * @param other Other dynamic_bitset instance to copy from
+         */
+        template <unsigned_integer OtherBlockType> requires (std::convertible_to<OtherBlockType, BlockType> && !std::is_same_v<BlockType, OtherBlockType>)
+        dynamic_bitset& operator=(const dynamic_bitset<OtherBlockType>& other) noexcept
+        {
+            const size_type storage_size = other.m_size / m_block_size + !!(other.m_size % m_block_size);
+            if (m_storage_size != storage_size)
+            {
+                delete[] m_data;
+                m_storage_size = storage_size;
+                m_data = new BlockType[m_storage_size];
+            }
+            m_size = other.m_size;
+            m_partial_size = m_size % m_block_size;
+            _from_other<OtherBlockType>(other);
+            return *this;
+        }
+
+        // Conversion functions/operators
+
+        /**
+         * Copy assignment operator
+         * @param other Other dynamic_bitset instance to copy from
+         */
+        dynamic_bitset& operator=(const dynamic_bitset& other) noexcept
+        {
+            if (this == &other)
+            {
+                return *this;
+            }
+
+            if (other.m_storage_size != m_storage_size)
+            {
+                delete[] m_data;
+                m_data = new BlockType[other.m_storage_size];
+                m_storage_size = other.m_storage_size;
+            }
+
+        	m_size = other.m_size;
+            m_partial_size = other.m_partial_size;
+
+            std::copy(other.m_data, other.m_data + (std::min)(m_storage_size, other.m_storage_size), m_data);
+            
+        	return *this;
+        }
+
+        /**
+		 * Move assignment operator
+		 * @param other Other dynamic_bitset instance to move from
+		 */
+        dynamic_bitset& operator=(dynamic_bitset&& other) noexcept
+        {
+            if (this != &other)
+            {
+                delete[] m_data;
+
+                m_partial_size = other.m_partial_size;
+                m_storage_size = other.m_storage_size;
+                m_size = other.m_size;
+                m_data = other.m_data;
+            	_from_other(std::move(other));
+            }
+
+        	return *this;
+        }
+
+        /**
+        * Integer value to bitset conversion operator
+        * @tparam T Type of the integral value to convert from
+        * @param value Value to convert from
+        */
+        template <unsigned_integer T>
+        dynamic_bitset& operator=(const T& value) noexcept
+        {
+            _from_integer<T>(value);
+            return *this;
+        }
+
+    private:
+
+        /**
+         * Copy function
+         * @param other Other dynamic_bitset instance to copy from
+         */
+        void _from_other(const dynamic_bitset& other) noexcept
+        {
+            if (this != &other)
+                std::copy(other.m_data, other.m_data + (std::min)(m_storage_size, other.m_storage_size), m_data);
+            for (size_type i = other.m_storage_size; i < m_storage_size; ++i)
+                *(m_data + i) = 0;
+        }
+
+        /**
+         * Move function
+         * @param other Other dynamic_bitset instance to move from
+         */
+        static void _from_other(dynamic_bitset&& other) noexcept
+        {
+            other.m_partial_size = 0;
+            other.m_storage_size = other.m_size = 0;
+            other.m_data = nullptr;
+        }
+
+        /**
+         * Conversion function with different block type and size
+         * @tparam OtherBlockType Type of the block to convert from
+         * @param other Other bitset instance to convert from
+         */
+        template <unsigned_integer OtherBlockType> requires (std::convertible_to<OtherBlockType, BlockType> && !std::is_same_v<BlockType, OtherBlockType>)
+        void _from_other(const dynamic_bitset<OtherBlockType>& other) noexcept
+        {
+            detail::convert_blocks(other.m_data, m_data, m_storage_size, (std::min)(m_size, other.m_size));
+        }
+
+        /**
+         * String to bitset conversion function
+         * @tparam Elem Type of the character array
+         * @param str String to convert from (must be null-terminated)
+         * @param set_chr Character that represents set bits
+         */
+        template <char_type Elem>
+        void _from_string(const std::basic_string<Elem>& str, const Elem& set_chr = '1') noexcept
+        {
+            for (size_type i = 0; i < m_storage_size; ++i)
+            {
+                for (uint16_t j = 0; j < m_block_size; ++j)
+                {
+                    if (i * m_block_size + j >= str.size())
+                    {
+                        return;
+                    }
+                    m_data[i] |= str[i * m_block_size + j] == set_chr ? BlockType{ 1 } << j : 0;
+                }
+            }
+        }
+
+        /**
+         * C string stack array to bitset conversion function
+         * @tparam Elem Type of the character array
+         * @tparam StrSize Size of the character array
+         * @param c_str Array c string to fill the bitset with (must be null-terminated)
+         * @param set_chr Character that represents set bits
+         */
+        template <char_type Elem, size_type StrSize>
+        void _from_c_string(const Elem(&c_str)[StrSize], const Elem& set_chr = '1') noexcept
+        {
+            for (size_type i = 0; i < m_storage_size; ++i)
+            {
+                for (uint16_t j = 0; j < m_block_size; ++j)
+                {
+                    if (!c_str[i * m_block_size + j])
+                    {
+                        return;
+                    }
+                    m_data[i] |= c_str[i * m_block_size + j] == set_chr ? BlockType{ 1 } << j : 0;
+                }
+            }
+        }
+
+        /**
+         * C string pointer array to bitset conversion function
+         * @tparam PtrArr Type of the character array [don't use]
+         * @tparam Elem Type of the character array [don't use]
+         * @param c_str Pointer to c string to fill the bitset with (must be null-terminated)
+         * @param set_chr Character that represents set bits
+         */
+        template <typename PtrArr = const char*, char_type Elem = std::remove_cvref_t<std::remove_pointer_t<std::remove_cvref_t<PtrArr>>>> requires (std::is_pointer_v<PtrArr> && !std::is_array_v<PtrArr>)
+        void _from_c_string(PtrArr c_str, const Elem& set_chr = '1') noexcept
+        {
+            for (size_type i = 0; i < m_storage_size; ++i)
+            {
+                for (uint16_t j = 0; j < m_block_size; ++j)
+                {
+                    if (!*c_str)
+                    {
+                        return;
+                    }
+                    m_data[i] |= *c_str++ == set_chr ? BlockType{ 1 } << j : 0;
+                }
+            }
+        }
+
+    public:
+
+        /**
+         * Bitset to C string conversion function
+         * @param set_chr Character to represent set bits
+         * @param rst_chr Character to represent reset bits
+         * @tparam Elem Type of character in the array
+         * @return C string representation of the bitset
+         */
+        template <char_type Elem = char>
+        [[nodiscard]] Elem* to_c_string(const Elem& set_chr = '1', const Elem& rst_chr = '0') const noexcept
+        {
+            Elem* result = new Elem[m_size + 1];
+            for (size_type i = 0; i < m_storage_size - !!m_partial_size; ++i)
+            {
+                for (uint16_t j = 0; j < m_block_size; ++j)
+                    *(result + i * m_block_size + j) = m_data[i] & BlockType{ 1 } << j ? set_chr : rst_chr;
+            }
+            if (m_partial_size)
+            {
+                for (size_type i = 0; i < m_partial_size; ++i)
+                    *(result + (m_storage_size - 1) * m_block_size + i) = m_data[m_storage_size - 1] & BlockType{ 1 } << i ? set_chr : rst_chr;
+            }
+            *(result + m_size) = '\0';
+            return result;
+        }
+
+        /**
+         * Bitset to std::vector<bool> conversion function, copies whole words where std::vector<bool> exposes them
+         * @return std::vector<bool> holding the same bits
+         */
+        [[nodiscard]] std::vector<bool> to_std() const
+        {
+            std::vector<bool> result(m_size);
+            detail::to_std_vector(m_data, result);
+            return result;
+        }
+
+    private:
+
+        /**
+         * Integer value to bitset conversion function
+         * @tparam T Type of the integral value to convert from
+         * @param value Value to convert from
+         */
+        template <unsigned_integer T>
+        void _from_integer(const T value) noexcept
+        {
+            if constexpr (sizeof(T) <= sizeof(BlockType))
+            {
+                if (m_storage_size != 1)
+                {
+                    delete[] m_data;
+                    m_data = new BlockType;
+                	m_storage_size = 1;
+                    m_size = sizeof(T) * CHAR_BIT;
+                }
+                if constexpr (sizeof(T) != sizeof(BlockType))
+                    *m_data = BlockType{ 0 } | value;
+                else
+                    *m_data = value;
+                return;
+            }
+
+            constexpr uint16_t diff = sizeof(T) / sizeof(BlockType);
+
+            if (m_storage_size != diff)
+            {
+                delete[] m_data;
+                m_data = new BlockType[diff];
+                m_storage_size = diff;
+                m_size = sizeof(T) * CHAR_BIT;
+            }
+
+            for (uint16_t i = 0; i < diff; ++i)
+            {
+                m_data[i] = value >> i * m_block_size;
+            }
+        }
+
+    public:
+
+        /**
+         * Bitset to integer value conversion function
+         * @tparam T Type of the integral value to convert to
+         * @return Converted integer value.
+         */
+        template <unsigned_integer T>
+        [[nodiscard]] T to_integer() const noexcept
+        {
+            if constexpr (sizeof(T) <= sizeof(BlockType))
+                return *m_data;
+
+            constexpr uint16_t diff = sizeof(T) / sizeof(BlockType);
+            T result = 0;
+            for (int16_t i = 0; i < diff; ++i)
+                result |= static_cast<T>(m_data[i]) << i * m_block_size;
+
+            return result;
+        }
+
+        // TODO: General comp & bitwise operators
+
+        operator bool() const noexcept
+        {
+            return m_size;
+        }
+
+        // comparison operators
+
+        /**
+         * Equality operator
+         * @param other Other bitset instance to compare with
+         * @return True if the two instances are equal, false otherwise
+         */
+        [[nodiscard]] bool operator==(const dynamic_bitset& other) const noexcept
+        {
+            if (m_size != other.m_size)
+                return false;
+            for (size_type i = 0; i < m_storage_size - !!m_partial_size; ++i)
+            {
+                if (m_data[i] != other.m_data[i])
+                    return false;
+            }
+            if (m_partial_size)
+            {
+                const BlockType mask = (BlockType{ 1 } << m_partial_size) - 1;
+                if ((m_data[m_storage_size - 1] & mask) != (other.m_data[m_storage_size - 1] & mask))
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+         * Inequality operator
+         * @param other Other bitset instance to compare with
+         * @return True if the two instances are not equal, false otherwise
+         */
+        [[nodiscard]] bool operator!=(const dynamic_bitset& other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+    private:
+
+        /**
+         * Orders two differing blocks by the lowest bit index they differ at
+         * @param lhs Block of the left-hand side
+         * @param rhs Block of the right-hand side (must differ from lhs)
+         * @return greater if lhs has the differing bit set, less otherwise
+         */
+        [[nodiscard]] static std::strong_ordering _lexicographic_order(const BlockType lhs, const BlockType rhs) noexcept
+        {
+            return lhs >> detail::countr_zero(static_cast<BlockType>(lhs ^ rhs)) & 1 ? std::strong_ordering::greater : std::strong_ordering::less;
+        }
+
+        /**
+         * Block with the bits past m_size cleared, blocks past the storage read as zero
+         * @param index Index of the block
+         * @return Masked block
+         */
+        [[nodiscard]] BlockType _masked_block(const size_type index) const noexcept
+        {
+            if (index >= m_storage_size)
+                return 0;
+            if (m_partial_size && index == m_storage_size - 1)
+                return m_data[index] & ((BlockType{ 1 } << m_partial_size) - 1);
+            return m_data[index];
+        }
+
+    public:
+
+        /**
+         * Numeric three-way comparison, the bitset is compared as an unsigned integer whose most significant bit is bit size() - 1
+         * Bitsets of equal value but different sizes are ordered by size.
+         * @param other Other bitset instance to compare with
+         * @return Ordering of the two instances
+         */
+        [[nodiscard]] std::strong_ordering compare_numeric(const dynamic_bitset& other) const noexcept
+        {
+            const size_type common_storage_size = (std::min)(m_storage_size, other.m_storage_size);
+
+            // Blocks only one of the bitsets has, plus the (possibly partial) top common block
+            for (size_type i = (std::max)(m_storage_size, other.m_storage_size); i-- > 0 && i + 1 >= common_storage_size;)
+            {
+                const BlockType lhs = _masked_block(i), rhs = other._masked_block(i);
+                if (lhs != rhs)
+                    return lhs <=> rhs;
+            }
+            for (size_type i = common_storage_size - !!common_storage_size; i-- > 0;)
+            {
+                if (m_data[i] != other.m_data[i])
+                    return m_data[i] <=> other.m_data[i];
+            }
+            return m_size <=> other.m_size;
+        }
+
+        /**
+         * Lexicographic three-way comparison by bit index (bit 0 first), the same order as comparing the results of to_c_string()
+         * A bitset that is a prefix of the other one is ordered first.
+         * @param other Other bitset instance to compare with
+         * @return Ordering of the two instances
+         */
+        [[nodiscard]] std::strong_ordering compare_lexicographic(const dynamic_bitset& other) const noexcept
+        {
+            const size_type common_size = (std::min)(m_size, other.m_size);
+            const size_type full_blocks = common_size / m_block_size;
+            for (size_type i = 0; i < full_blocks; ++i)
+            {
+                if (m_data[i] != other.m_data[i])
+                    return _lexicographic_order(m_data[i], other.m_data[i]);
+            }
+            if (const size_type rest = common_size % m_block_size)
+            {
+                const BlockType mask = (BlockType{ 1 } << rest) - 1;
+                const BlockType lhs = m_data[full_blocks] & mask, rhs = other.m_data[full_blocks] & mask;
+                if (lhs != rhs)
+                    return _lexicographic_order(lhs, rhs);
+            }
+            return m_size <=> other.m_size;
+        }
+
+        /**
+         * Three-way comparison operator (numeric order, see compare_numeric)
+         * @param other Other bitset instance to compare with
+         * @return Ordering of the two instances
+         */
+        [[nodiscard]] std::strong_ordering operator<=>(const dynamic_bitset& other) const noexcept
+        {
+            return compare_numeric(other);
+        }
+
+        // Set predicates (bits past the size of the shorter bitset count as reset)
+
+    private:
+
+        /**
+         * Bits set in lhs but not in rhs
+         */
+        static constexpr auto _difference_block = [](const BlockType lhs, const BlockType rhs) noexcept { return static_cast<BlockType>(lhs & ~rhs); };
+
+        /**
+         * Bits set in both lhs and rhs
+         */
+        static constexpr auto _intersection_block = [](const BlockType lhs, const BlockType rhs) noexcept { return static_cast<BlockType>(lhs & rhs); };
+
+    public:
+
+        /**
+         * Checks if every bit set in this bitset is also set in the other bitset
+         * @param other Other bitset instance to compare with
+         * @return true if this bitset is a subset of the other bitset, false otherwise
+         */
+        [[nodiscard]] bool is_subset_of(const dynamic_bitset& other) const noexcept
+        {
+            const size_type common_blocks = (std::min)(m_size, other.m_size) / m_block_size;
+            if (detail::any_of_blocks(m_data, other.m_data, common_blocks, _difference_block))
+                return false;
+            for (size_type i = common_blocks; i < m_storage_size; ++i)
+            {
+                if (_difference_block(_masked_block(i), other._masked_block(i)))
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+         * Checks if this bitset is a subset of the other bitset and the two hold different bits
+         * @param other Other bitset instance to compare with
+         * @return true if this bitset is a proper subset of the other bitset, false otherwise
+         */
+        [[nodiscard]] bool is_proper_subset_of(const dynamic_bitset& other) const noexcept
+        {
+            return is_subset_of(other) && !other.is_subset_of(*this);
+        }
+
+        /**
+         * Checks if every bit set in the other bitset is also set in this bitset
+         * @param other Other bitset instance to compare with
+         * @return true if this bitset is a superset of the other bitset, false otherwise
+         */
+        [[nodiscard]] bool is_superset_of(const dynamic_bitset& other) const noexcept
+        {
+            return other.is_subset_of(*this);
+        }
+
+        /**
+         * Checks if this bitset is a superset of the other bitset and the two hold different bits
+         * @param other Other bitset instance to compare with
+         * @return true if this bitset is a proper superset of the other bitset, false otherwise
+         */
+        [[nodiscard]] bool is_proper_superset_of(const dynamic_bitset& other) const noexcept
+        {
+            return other.is_proper_subset_of(*this);
+        }
+
+        /**
+         * Checks if any bit is set in both bitsets
+         * @param other Other bitset instance to compare with
+         * @return true if the bitsets share a set bit, false otherwise
+         */
+        [[nodiscard]] bool intersects(const dynamic_bitset& other) const noexcept
+        {
+            const size_type common_blocks = (std::min)(m_size, other.m_size) / m_block_size;
+            if (detail::any_of_blocks(m_data, other.m_data, common_blocks, _intersection_block))
+                return true;
+            const size_type common_storage_size = (std::min)(m_storage_size, other.m_storage_size);
+            for (size_type i = common_blocks; i < common_storage_size; ++i)
+            {
+                if (_intersection_block(_masked_block(i), other._masked_block(i)))
+                    return true;
+            }
+            return false;
+        }
+
+        /**
+         * Checks if no bit is set in both bitsets
+         * @param other Other bitset instance to compare with
+         * @return true if the bitsets share no set bit, false otherwise
+         */
+        [[nodiscard]] bool is_disjoint(const dynamic_bitset& other) const noexcept
+        {
+            return !intersects(other);
+        }
+
+        /**
+         * Hashes the bits of the bitset (bits past size() are ignored)
+         * @return 64-bit hash of the bitset (truncated to size_t)
+         */
+        [[nodiscard]] std::size_t hash() const noexcept
+        {
+            std::uint64_t hash = detail::hash_bytes(m_data, (m_storage_size - !!m_partial_size) * sizeof(BlockType), m_size);
+            if (m_partial_size)
+            {
+                const BlockType tail = m_data[m_storage_size - 1] & ((BlockType{ 1 } << m_partial_size) - 1);
+                hash = detail::hash_bytes(&tail, sizeof(tail), hash);
+            }
+            return static_cast<std::size_t>(hash);
+        }
+
+        // Bitwise operators
+
+    private:
+
+        /**
+         * Applies a block operation to the blocks of this and another bitset
+         * @tparam Op Block operation (see detail::combine_blocks)
+         * @param other Right-hand side of the operation
+         * @param result Bitset receiving the result (may be this or other)
+         * @param op Block operation
+         */
+        template <typename Op>
+        void _combine(const dynamic_bitset& other, dynamic_bitset& result, Op op) const noexcept
+        {
+            detail::combine_blocks(m_data, other.m_data, result.m_data, result.m_storage_size, op);
+        }
+
+    public:
+
+        /**
+         * Bitwise AND operator
+         * @param other Other bitset instance to perform the operation with
+         * @return New bitset instance containing the result of the operation
+         */
+        [[nodiscard]] dynamic_bitset operator&(const dynamic_bitset& other) const noexcept
+        {
+            dynamic_bitset result(m_size);
+            _combine(other, result, std::bit_and<>{});
+            return result;
+        }
+
+        /**
+         * Apply bitwise AND operation with another bitset instance
+         * @param other Other bitset instance to perform the operation with
+         */
+        dynamic_bitset& operator&=(const dynamic_bitset& other) noexcept
+        {
+            _combine(other, *this, std::bit_and<>{});
+            return *this;
+        }
+
+        /**
+         * Bitwise OR operator
+         * @param other Other bitset instance to perform the operation with
+         * @return New bitset instance containing the result of the operation
+         */
+        [[nodiscard]] dynamic_bitset operator|(const dynamic_bitset& other) const noexcept
+        {
+            dynamic_bitset result(m_size);
+            _combine(other, result, std::bit_or<>{});
+            return result;
+        }
+
+        /**
+         * Apply bitwise OR operation with another bitset instance
+         * @param other Other bitset instance to perform the operation with
+         */
+        dynamic_bitset& operator|=(const dynamic_bitset& other) noexcept
+        {
+            _combine(other, *this, std::bit_or<>{});
+            return *this;
+        }
+
+        /**
+         * Bitwise XOR operator
+         * @param other Other bitset instance to perform the operation with
+         * @return New bitset instance containing the result of the operation
+         */
+        [[nodiscard]] dynamic_bitset operator^(const dynamic_bitset& other) const noexcept
+        {
+            dynamic_bitset result(m_size);
+            _combine(other, result, std::bit_xor<>{});
+            return result;
+        }
+
+        /**
+         * Apply bitwise XOR operation with another bitset instance
+         * @param other Other bitset instance to perform the operation with
+         */
+        dynamic_bitset& operator^=(const dynamic_bitset& other) noexcept
+        {
+            _combine(other, *this, std::bit_xor<>{});
+            return *this;
+        }
+
+        /**
+         * Bitwise NOT operator
+         * @return New bitset instance containing the result of the operation
+         */
+        [[nodiscard]] dynamic_bitset operator~() const noexcept
+        {
+            dynamic_bitset result(m_size);
+            _combine(*this, result, detail::bit_invert{});
+            return result;
+        }
+
+        /**
+         * Packs the bits selected by a mask densely into the low bits of a new bitset (parallel bit extract)
+         * @param mask Bits to take (must have the same size)
+         * @return New bitset instance holding the selected bits from bit 0, the remaining bits are reset
+         */
+        [[nodiscard]] dynamic_bitset compress(const dynamic_bitset& mask) const noexcept
+        {
+            dynamic_bitset result(m_size);
+            detail::compress_blocks(m_data, mask.m_data, result.m_data, m_storage_size, detail::mask_until<BlockType>(m_size));
+            return result;
+        }
+
+        /**
+         * Scatters the low bits into the positions selected by a mask (parallel bit deposit), the inverse of compress
+         * @param mask Bits to fill (must have the same size)
+         * @return New bitset instance holding the low bits at the positions of the set bits of the mask, the remaining bits are reset
+         */
+        [[nodiscard]] dynamic_bitset expand(const dynamic_bitset& mask) const noexcept
+        {
+            dynamic_bitset result(m_size);
+            detail::expand_blocks(m_data, mask.m_data, result.m_data, m_storage_size, detail::mask_until<BlockType>(m_size));
+            return result;
+        }
+
+        /**
+		 * Bitwise right shift operator
+		 * @param shift Amount of bits to shift to the right
+		 * @return New bitset instance containing the result of the operation
+		 */
+        [[nodiscard]] dynamic_bitset operator>>(const size_type& shift) const noexcept
+        {
+            dynamic_bitset result(*this);
+            result >>= shift;
+            return result;
+        }
+
+        /**
+        * Apply bitwise right shift operation
+        * @param shift Amount of bits to shift to the right
+        */
+        dynamic_bitset& operator>>=(const size_type& shift) noexcept
+        {
+            if (shift >= m_size)
+            {
+                reset();
+                return *this;
+            }
+
+            // Bits past m_size are unspecified, clear them so they are not shifted into the valid range
+            if (m_partial_size)
+                m_data[m_storage_size - 1] &= static_cast<BlockType>((BlockType{ 1 } << m_partial_size) - 1);
+
+            // Number of blocks to shift
+            const size_type block_shift = shift / m_block_size;
+
+            // Number of bits to shift within a block
+            const size_type bit_shift = shift % m_block_size;
+
+            // Shift across multiple blocks, lower blocks only read from higher ones
+            for (size_type i = 0; i < m_storage_size; ++i)
+            {
+                // Handle shifting within a block
+                m_data[i] = i + block_shift < m_storage_size ?
+                    static_cast<BlockType>(m_data[i + block_shift] >> bit_shift) :
+                    BlockType{ 0 }; // If shifting exceeds block boundaries, fill with zeros
+                // If there are remaining bits to shift to the next block
+                if (bit_shift > 0 && i + block_shift + 1 < m_storage_size)
+                {
+                    // Shift the remaining bits to the next block
+                    m_data[i] |= static_cast<BlockType>(m_data[i + block_shift + 1] << (m_block_size - bit_shift));
+                }
+            }
+            return *this;
+        }
+
+        /**
+         * Bitwise left shift operator
+         * @param shift Amount of bits to shift to the left
+         * @return New bitset instance containing the result of the operation
+         */
+        [[nodiscard]] dynamic_bitset operator<<(const size_type& shift) const noexcept
+        {
+            dynamic_bitset result(*this);
+            result <<= shift;
+            return result;
+        }
+
+        /**
+         * Apply bitwise left shift operation
+         * @param shift Amount of bits to shift to the left
+         */
+        dynamic_bitset& operator<<=(const size_type& shift) noexcept
+        {
+            if (shift >= m_size)
+            {
+                reset();
+                return *this;
+            }
+
+            // Number of blocks to shift
+            const size_type block_shift = shift / m_block_size;
+
+            // Number of bits to shift within a block
+            const size_type bit_shift = shift % m_block_size;
+
+            // Shift across multiple blocks, walk downwards so higher blocks only read from lower ones
+            for (size_type i = m_storage_size; i-- > 0;)
+            {
+                // Handle shifting within a block
+                m_data[i] = i >= block_shift ?
+                    static_cast<BlockType>(m_data[i - block_shift] << bit_shift) :
+                    BlockType{ 0 }; // If shifting exceeds block boundaries, fill with zeros
+                // If there are remaining bits to shift to the previous block
+                if (bit_shift > 0 && i >= block_shift + 1)
+                {
+                    // Shift the remaining bits to the previous block
+                    m_data[i] |= static_cast<BlockType>(m_data[i - block_shift - 1] >> (m_block_size - bit_shift));
+                }
+            }
+
+            return *this;
+        }
+
+        /**
+         * Difference operator
+         * @param other Other bitset instance to compare with
+         * @return New bitset instance containing the result of the operation
+         */
+        [[nodiscard]] dynamic_bitset operator-(const dynamic_bitset& other) const noexcept
+        {
+            dynamic_bitset result(m_size);
+            _combine(other, result, detail::bit_and_not{});
+            return result;
+        }
+
+        /**
+         * Apply difference operation
+         * @param other Other bitset instance to compare with
+         */
+        dynamic_bitset& operator-=(const dynamic_bitset& other) noexcept
+        {
+            _combine(other, *this, detail::bit_and_not{});
+            return *this;
+        }
+
+        // Utility functions
+
+        /**
+         * Returns current dynamic_bitset instance as const (use when iterating, using [] operator, ...)
+         */
+    	[[nodiscard]] const dynamic_bitset& as_const() const noexcept
+        {
+            return *this;
+        }
+
+        /**
+         * Swaps the values of two bits
+         * @param index_1 Index of first value to swap (bit index)
+         * @param index_2 Index of second value to swap (bit index)
+         */
+        void swap(const size_type& index_1, const size_type& index_2) noexcept
+        {
+            const bool tmp = test(index_1);
+            set(index_1, test(index_2));
+            set(index_2, tmp);
+        }
+
+        /**
+         * Reverses the bitset (bit values)
+         */
+        void reverse() noexcept
+        {
+            for (size_type i = 0; i < m_size / 2; ++i)
+            {
+                swap(i, m_size - i - 1);
+            }
+        }
+
+        /**
+         * Rotates each bit to the left by the specified amount
+         * @param shift Amount of bits to rotate to the left (bit count)
+         */
+        void rotate(const size_type& shift) noexcept
+        {
+            const dynamic_bitset tmp_cpy = *this;
+            for (size_type i = 0; i < m_size; ++i)
+                set(i, tmp_cpy.test((i + shift) % m_size));
+        }
+
+        /**
+         * @return m_size of the bitset (bit count)
+         */
+        [[nodiscard]] size_type& size() noexcept { return m_size; }
+
+
+        /**
+         * @return m_size of the bitset (bit count)
+         */
+        [[nodiscard]] const size_type& size() const noexcept { return m_size; }
+
+        /**
+         * @return Number of blocks in the bitset
+         */
+        [[nodiscard]] size_type& storage_size() noexcept { return m_storage_size; }
+
+        /**
+		 * @return Number of blocks in the bitset
+		 */
+        [[nodiscard]] const size_type& storage_size() const noexcept { return m_storage_size; }
+
+        /**
+         * @return Pointer to the underlying array
+         */
+        [[nodiscard]] BlockType*& data() noexcept { return m_data; }
+
+        /**
+         * @return Const pointer to the underlying array
+         */
+        [[nodiscard]] const BlockType* const& data() const noexcept { return m_data; }
+
+        // Iteration functions
+
+        [[nodiscard]] iterator begin() noexcept
+        {
+            return iterator(m_data, 0);
+        }
+
+        [[nodiscard]] iterator end() noexcept
+        {
+            return iterator(m_data, m_size);
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            return const_iterator(m_data, 0);
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return const_iterator(m_data, m_size);
+        }
+
+        [[nodiscard]] const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        [[nodiscard]] const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        [[nodiscard]] reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        [[nodiscard]] reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        [[nodiscard]] const_reverse_iterator crbegin() const noexcept
+        {
+            return rbegin();
+        }
+
+        [[nodiscard]] const_reverse_iterator crend() const noexcept
+        {
+            return rend();
+        }
+
+        [[nodiscard]] const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+
+        [[nodiscard]] const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        // bitset operations
+
+        /**
+         * Sets the bit at the specified index to the specified value
+         * @param value Value to set the bit to (bit value)
+         * @param index Index of the bit to set (bit index)
+         */
+        void set(const size_type& index, const bool value) noexcept
+        {
+            if (value)
+                m_data[index / m_block_size] |= BlockType{ 1 } << index % m_block_size;
+            else
+                m_data[index / m_block_size] &= ~(BlockType{ 1 } << index % m_block_size);
+        }
+
+        /**
+		 * Sets the bit at the specified index to 1 (true)
+		 * @param index Index of the bit to set (bit index)
+		 */
+        void set(const size_type& index) noexcept
+        {
+            m_data[index / m_block_size] |= BlockType{ 1 } << index % m_block_size;
+        }
+
+        /**
+         * Sets the bit at the specified index to 0 (false)
+         * @param index Index of the bit to reset (bit index)
+         */
+        void reset(const size_type& index) noexcept
+        {
+            m_data[index / m_block_size] &= ~(BlockType{ 1 } << index % m_block_size);
+        }
+
+        /**
+         * Constructs a bitset with the bits at the specified indices set
+         * @tparam Indices Type of the contiguous range of unsigned indices
+         * @param size Size of the bitset (bit count)
+         * @param indices Indices of the bits to set (bit indices)
+         * @param partition Whether to radix-partition the indices by 256 KiB region first, for many indices into large bitsets
+         * @return New bitset instance
+         */
+        template <std::ranges::contiguous_range Indices> requires std::unsigned_integral<std::ranges::range_value_t<Indices>>
+        [[nodiscard]] static dynamic_bitset from_indices(const size_type& size, const Indices& indices, const bool partition = false) noexcept
+        {
+            dynamic_bitset result(size);
+            result.set_many(indices, partition);
+            return result;
+        }
+
+        /**
+         * Sets the bits at the specified indices, prefetching their blocks a window ahead
+         * @tparam Indices Type of the contiguous range of unsigned indices
+         * @param indices Indices of the bits to set (bit indices)
+         * @param partition Whether to radix-partition the indices by 256 KiB region first, for many indices into large bitsets
+         */
+        template <std::ranges::contiguous_range Indices> requires std::unsigned_integral<std::ranges::range_value_t<Indices>>
+        void set_many(const Indices& indices, const bool partition = false) noexcept
+        {
+            detail::apply_indices(m_data, m_size, std::ranges::data(indices), std::ranges::size(indices), partition, [](BlockType& block, const BlockType mask) noexcept { block |= mask; });
+        }
+
+        /**
+         * Resets the bits at the specified indices, prefetching their blocks a window ahead
+         * @tparam Indices Type of the contiguous range of unsigned indices
+         * @param indices Indices of the bits to reset (bit indices)
+         * @param partition Whether to radix-partition the indices by 256 KiB region first, for many indices into large bitsets
+         */
+        template <std::ranges::contiguous_range Indices> requires std::unsigned_integral<std::ranges::range_value_t<Indices>>
+        void reset_many(const Indices& indices, const bool partition = false) noexcept
+        {
+            detail::apply_indices(m_data, m_size, std::ranges::data(indices), std::ranges::size(indices), partition, [](BlockType& block, const BlockType mask) noexcept { block &= static_cast<BlockType>(~mask); });
+        }
+
+        /**
+         * Flips the bits at the specified indices, prefetching their blocks a window ahead
+         * @tparam Indices Type of the contiguous range of unsigned indices
+         * @param indices Indices of the bits to flip (bit indices, a repeated index flips its bit again)
+         * @param partition Whether to radix-partition the indices by 256 KiB region first, for many indices into large bitsets
+         */
+        template <std::ranges::contiguous_range Indices> requires std::unsigned_integral<std::ranges::range_value_t<Indices>>
+        void flip_many(const Indices& indices, const bool partition = false) noexcept
+        {
+            detail::apply_indices(m_data, m_size, std::ranges::data(indices), std::ranges::size(indices), partition, [](BlockType& block, const BlockType mask) noexcept { block ^= mask; });
+        }
+
+        /**
+         * Fills all the bits with the specified value
+         * @param value Value to fill the bits with (bit value)
+         */
+        void fill(const bool value) noexcept
+        {
+            ::memset(m_data, value ? (std::numeric_limits<BlockType>::max)() : 0, m_storage_size * sizeof(BlockType));
+        }
+
+        /**
+         * Fills all the bits with 1 (true)
+         */
+        void set() noexcept
+        {
+            ::memset(m_data, 255u, m_storage_size * sizeof(BlockType));
+        }
+
+        /**
+         * Resets all the bits (sets all bits to 0)
+         */
+        void reset() noexcept
+        {
+            ::memset(m_data, 0, m_storage_size * sizeof(BlockType));
+        }
+
+        /**
+         * Fills all the bits in the specified range with the specified value
+         * @param value Value to fill the bits with (bit value)
+         * @param end End of the range to fill (bit index)
+         */
+        void fill_range(const size_type& end, const bool value) noexcept
+        {
+            fill_range(0, end, value);
+        }
+
+        /**
+         * Sets all the bits in the specified range to 1 (true)
+         * @param end End of the range to set (bit index)
+         */
+        void set_range(const size_type& end) noexcept
+        {
+            fill_range(0, end, true);
+        }
+
+        /**
+         * Sets all the bits in the specified range to 0 (false)
+         * @param end End of the range to set (bit index)
+         */
+        void reset_range(const size_type& end) noexcept
+        {
+            fill_range(0, end, false);
+        }
+
+        /**
+         * Fills all the bits in the specified range with the specified value
+         * @param value Value to fill the bits with (bit value)
+         * @param begin Begin of the range to fill (bit index)
+         * @param end End of the range to fill (bit index)
+         */
+        void fill_range(const size_type& begin, const size_type& end, const bool value) noexcept
+        {
+            detail::fill_range(m_data, begin, end, value);
+        }
+
+        /**
+         * Sets all the bits in the specified range to 1 (true)
+         * @param begin Begin of the range to fill (bit index)
+         * @param end End of the range to fill (bit index)
+         */
+        void set_range(const size_type& begin, const size_type& end) noexcept
+        {
+            fill_range(begin, end, true);
+        }
+
+        /**
+         * Sets all the bits in the specified range to 0 (false)
+         * @param begin Begin of the range to fill (bit index)
+         * @param end End of the range to fill (bit index)
+         */
+        void reset_range(const size_type& begin, const size_type& end) noexcept
+        {
+            fill_range(begin, end, false);
+        }
+
+    private:
+
+        /**
+         * Block operations applied by the strided range functions
+         */
+        static constexpr auto _set_bits = [](BlockType& block, const BlockType mask) noexcept { block |= mask; };
+        static constexpr auto _reset_bits = [](BlockType& block, const BlockType mask) noexcept { block &= static_cast<BlockType>(~mask); };
+        static constexpr auto _flip_bits = [](BlockType& block, const BlockType mask) noexcept { block ^= mask; };
+
+    public:
+
+        /**
+         * Fills all the bits in the specified range with the specified value
+         * @param value Value to fill the bits with (bit value)
+         * @param begin Begin of the range to fill (bit index)
+         * @param end End of the range to fill (bit index)
+         * @param step Step size between the bits to fill (bit step)
+         */
+        void fill_range(const size_type& begin, const size_type& end, const size_type& step, const bool value) noexcept
+        {
+            if (step == 1)
+                fill_range(begin, end, value);
+            else if (value)
+                detail::apply_strided(m_data, begin, end, step, _set_bits);
+            else
+                detail::apply_strided(m_data, begin, end, step, _reset_bits);
+        }
+
+        /**
+         * Fills every step-th bit in the specified range with the specified value
+         * @deprecated Kept for source compatibility, same as fill_range(begin, end, step, value)
+         */
+        [[deprecated("use fill_range(begin, end, step, value)")]]
+        void fill_range_optimized(const size_type& begin, const size_type& end, const size_type& step, const bool value) noexcept
+        {
+            fill_range(begin, end, step, value);
+        }
+
+        /**
+         * Sets all the bits in the specified range to 1 (true)
+         * @param begin Begin of the range to fill (bit index)
+         * @param end End of the range to fill (bit index)
+         * @param step Step size between the bits to fill (bit step)
+         */
+        void set_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
+        {
+            fill_range(begin, end, step, true);
+        }
+
+        /**
+         * Sets all the bits in the specified range to 0 (false)
+         * @param begin Begin of the range to fill (bit index)
+         * @param end End of the range to fill (bit index)
+         * @param step Step size between the bits to fill (bit step)
+         */
+        void reset_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
+        {
+            fill_range(begin, end, step, false);
+        }
+
+        /**
+         * Sets the block at the specified index to the specified value (default is max value, all bits set to 1)
+         * @param block Block to set (block value)
+         * @param index Index of the block to set (block index)
+         */
+        void set_block(const size_type& index, const BlockType& block = (std::numeric_limits<BlockType>::max)()) noexcept
+        {
+            m_data[index] = block;
+        }
+
+        /**
+         * Sets the block at the specified index to 0 (all bits set to 0)
+         * @param index Index of the block to reset (block index)
+         */
+        void reset_block(const size_type& index) noexcept
+        {
+            m_data[index] = 0u;
+        }
+
+        /**
+         * Fills all the blocks with the specified block
+         * @param block Block to fill the blocks with (block value)
+         */
+        void fill_block(const BlockType& block) noexcept
+        {
+            for (size_type i = 0; i < m_storage_size; ++i)
+                m_data[i] = block;
+        }
+
+        /**
+		 * Sets all the blocks in the specified range to their max value
+		 * @param end End of the range to fill (block index)
+		 */
+        void set_block_range(const size_type& end) noexcept
+        {
+            for (size_type i = 0; i < end; ++i)
+                m_data[i] = (std::numeric_limits<BlockType>::max)();
+        }
+
+        /**
+		 * Sets all the blocks in the specified range to 0
+		 * @param end End of the range to fill (block index)
+		 */
+        void reset_block_range(const size_type& end) noexcept
+        {
+            for (size_type i = 0; i < end; ++i)
+                m_data[i] = 0;
+        }
+
+        /**
+         * Fills all the blocks in the specified range with the specified block
+         * @param end End of the range to fill (block index)
+         * @param block Block to fill the bits with (block value)
+         */
+        void fill_block_range(const size_type& end, const BlockType& block = (std::numeric_limits<BlockType>::max)()) noexcept
+        {
+            for (size_type i = 0; i < end; ++i)
+                m_data[i] = block;
+        }
+
+        /**
+		 * Sets all the blocks in the specified range to their max value
+		 * @param begin begin of the range to fill (block index)
+		 * @param end End of the range to fill (block index)
+		 */
+        void set_block_range(const size_type& begin, const size_type& end) noexcept
+        {
+            for (size_type i = begin; i < end; ++i)
+                m_data[i] = (std::numeric_limits<BlockType>::max)();
+        }
+
+        /**
+		 * Sets all the blocks in the specified range to 0
+		 * @param begin begin of the range to fill (block index)
+		 * @param end End of the range to fill (block index)
+		 */
+        void reset_block_range(const size_type& begin, const size_type& end) noexcept
+        {
+            for (size_type i = begin; i < end; ++i)
+                m_data[i] = 0;
+        }
+
+        /**
+         * Fills all the blocks in the specified range with the specified block
+         * @param begin begin of the range to fill (block index)
+         * @param end End of the range to fill (block index)
+         * @param block Block to fill the bits with
+         */
+        void fill_block_range(const size_type& begin, const size_type& end, const BlockType& block = (std::numeric_limits<BlockType>::max)()) noexcept
+        {
+            for (size_type i = begin; i < end; ++i)
+                m_data[i] = block;
+        }
+
+        /**
+		 * Sets all the blocks in the specified range to their max value
+		 * @param begin begin of the range to fill (block index)
+		 * @param end End of the range to fill (block index)
+		 * @param step Step size between the bits to fill (block step)
+		 */
+        void set_block_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
+        {
+            for (size_type i = begin; i < end; i += step)
+                m_data[i] = (std::numeric_limits<BlockType>::max)();
+        }
+
+        /**
+		 * Sets all the blocks in the specified range to 0
+		 * @param begin begin of the range to fill (block index)
+		 * @param end End of the range to fill (block index)
+		 * @param step Step size between the bits to fill (block step)
+		 */
+        void reset_block_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
+        {
+            for (size_type i = begin; i < end; i += step)
+                m_data[i] = 0;
+        }
+
+        /**
+         * Fills all the blocks in the specified range with the specified block
+         * @param begin begin of the range to fill (block index)
+         * @param end End of the range to fill (block index)
+         * @param step Step size between the bits to fill (block step)
+         * @param block Block to fill the bits with (block value)
+         */
+        void fill_block_range(const size_type& begin, const size_type& end, const size_type& step, const BlockType& block = (std::numeric_limits<BlockType>::max)()) noexcept
+        {
+            for (size_type i = begin; i < end; i += step)
+                m_data[i] = block;
+        }
+
+        /**
+         * Flips the bit at the specified index
+         * @param index Index of the bit to flip (bit index)
+         */
+        void flip(const size_type& index) noexcept
+        {
+            m_data[index / m_block_size] ^= BlockType{ 1 } << index % m_block_size;
+        }
+
+        /**
+         * Flips all the bits
+         */
+        void flip() noexcept
+        {
+            _combine(*this, *this, detail::bit_invert{});
+        }
+
+        /**
+         * Flips all the bits in the specified range
+         * @param end End of the range to fill (bit index)
+         */
+        void flip_range(const size_type& end) noexcept
+        {
+            flip_range(0, end);
+        }
+
+        /**
+         * Flip all the bits in the specified range
+         * @param begin Begin of the range to fill (bit index)
+         * @param end End of the range to fill (bit index)
+         */
+        void flip_range(const size_type& begin, const size_type& end) noexcept
+        {
+            if (begin >= end)
+                return;
+
+            const size_type first_block = begin / m_block_size;
+            const size_type last_block = (end - 1) / m_block_size;
+
+            // Masks of the bits that belong to the range within the first and the last block
+            const BlockType first_mask = detail::mask_from<BlockType>(begin);
+            const BlockType last_mask = detail::mask_until<BlockType>(end);
+
+            if (first_block == last_block)
+            {
+                m_data[first_block] ^= first_mask & last_mask;
+                return;
+            }
+
+            m_data[first_block] ^= first_mask;
+            for (size_type i = first_block + 1; i < last_block; ++i)
+                m_data[i] = ~m_data[i];
+            m_data[last_block] ^= last_mask;
+        }
+
+        /**
+         * Flips all the bits in the specified range
+         * @param begin Begin of the range to fill (bit index)
+         * @param end End of the range to fill (bit index)
+         * @param step Step size between the bits to flip (bit step)
+         */
+        void flip_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
+        {
+            if (step == 1)
+                flip_range(begin, end);
+            else
+                detail::apply_strided(m_data, begin, end, step, _flip_bits);
+        }
+
+        /**
+         * Flips the block at the specified index
+         * @param index Index of the block to flip (block index)
+         */
+        void flip_block(const size_type& index) noexcept
+        {
+            m_data[index] = ~m_data[index];
+        }
+
+        /**
+         * Flips all the blocks in the specified range
+         * @param end End of the range to fill (block index)
+         */
+        void flip_block_range(const size_type& end) noexcept
+        {
+            for (size_type i = 0; i < end; ++i)
+                m_data[i] = ~m_data[i];
+        }
+
+        /**
+         * Flips all the blocks in the specified range
+         * @param begin Begin of the range to fill (block index)
+         * @param end End of the range to fill (block index)
+         */
+        void flip_block_range(const size_type& begin, const size_type& end) noexcept
+        {
+            for (size_type i = begin; i < end; ++i)
+                m_data[i] = ~m_data[i];
+        }
+
+        /**
+         * Flips all the blocks in the specified range
+         * @param begin Begin of the range to fill (block index)
+         * @param end End of the range to fill (block index)
+         * @param step Step size between the bits to flip (block step)
+         */
+        void flip_block_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
+        {
+            for (size_type i = begin; i < end; i += step)
+                m_data[i] = ~m_data[i];
+        }
+
+        /**
+         * Retrieves the value of a bit at a specified index
+         * @param index The index of the bit to read (bit index)
+         * @return The value of the bit at the specified index
+         */
+        [[nodiscard]] bool test(const size_type& index) const noexcept
+        {
+            return m_data[index / m_block_size] & BlockType{ 1 } << index % m_block_size;
+        }
+
+        /**
+         * Tests the bits at the specified indices, prefetching their blocks a window ahead
+         * @tparam Indices Type of the contiguous range of unsigned indices
+         * @param indices Indices of the bits to test (bit indices)
+         * @param results Values of the bits, results[i] for indices[i] (indices.size() elements)
+         * @param partition Whether to radix-partition the indices by 256 KiB region first, for many indices into large bitsets
+         */
+        template <std::ranges::contiguous_range Indices> requires std::unsigned_integral<std::ranges::range_value_t<Indices>>
+        void test_many(const Indices& indices, bool* results, const bool partition = false) const noexcept
+        {
+            detail::test_indices(m_data, m_size, std::ranges::data(indices), std::ranges::size(indices), partition, [results](const std::size_t position, const bool value) noexcept { results[position] = value; });
+        }
+
+        /**
+         * Tests the bits at the specified indices, prefetching their blocks a window ahead
+         * @tparam Indices Type of the contiguous range of unsigned indices
+         * @tparam Results Type of the bitset receiving the results
+         * @param indices Indices of the bits to test (bit indices)
+         * @param results Bitset of at least indices.size() bits, bit i receives the value of the bit at indices[i]
+         * @param partition Whether to radix-partition the indices by 256 KiB region first, for many indices into large bitsets
+         */
+        template <std::ranges::contiguous_range Indices, typename Results> requires std::unsigned_integral<std::ranges::range_value_t<Indices>> && requires (Results& results) { results.set(std::size_t{}, bool{}); }
+        void test_many(const Indices& indices, Results& results, const bool partition = false) const noexcept
+        {
+            detail::test_indices(m_data, m_size, std::ranges::data(indices), std::ranges::size(indices), partition, [&results](const std::size_t position, const bool value) noexcept { results.set(position, value); });
+        }
+
+        /**
+         * Retrieves the block at the specified index
+         * @param index Index of the block to retrieve (block index)
+         * @return Block at the specified index
+         */
+        [[nodiscard]] const BlockType& get_block(const size_type& index) const noexcept
+        {
+            return m_data[index];
+        }
+
+        /**
+         * Retrieves the block at the specified index
+         * @param index Index of the block to retrieve (block index)
+         * @return Block at the specified index
+         */
+        [[nodiscard]] BlockType& get_block(const size_type& index) noexcept
+        {
+            return m_data[index];
+        }
+
+        /**
+         * Reads a field of bits, bit pos becomes the least significant bit of the result
+         * @tparam T Type of the field
+         * @param pos Index of the first bit of the field (bit index)
+         * @param len Length of the field (bit count, at most the width of T, pos + len must not exceed size())
+         * @return Value of the field
+         */
+        template <unsigned_integer T = std::uint64_t>
+        [[nodiscard]] T get_bits(const size_type& pos, const size_type& len) const noexcept
+        {
+            return detail::read_bits<T>(m_data, m_storage_size, pos, len);
+        }
+
+        /**
+         * Reads a field of at most one block of bits without branching on whether it straddles two blocks
+         * @tparam T Type of the field
+         * @param pos Index of the first bit of the field (bit index, must be less than size())
+         * @param len Length of the field (bit count, at most the width of T and of BlockType, pos + len must not exceed size())
+         * @return Value of the field
+         */
+        template <unsigned_integer T = BlockType>
+        [[nodiscard]] T get_bits_straddling(const size_type& pos, const size_type& len) const noexcept
+        {
+            return detail::read_bits_straddling<T>(m_data, m_storage_size, pos, len);
+        }
+
+        /**
+         * Writes a field of bits, the least significant bit of value goes to bit pos
+         * @tparam T Type of the field
+         * @param pos Index of the first bit of the field (bit index)
+         * @param len Length of the field (bit count, at most the width of T, pos + len must not exceed size())
+         * @param value Value of the field (bits above len are ignored)
+         */
+        template <unsigned_integer T>
+        void set_bits(const size_type& pos, const size_type& len, const T value) noexcept
+        {
+            detail::write_bits(m_data, m_storage_size, pos, len, value);
+        }
+
+        /**
+         * Checks if all bits are set
+         * @return true if all bits are set, false otherwise
+         */
+        [[nodiscard]] bool all() const noexcept
+        {
+            return all(0, m_size);
+        }
+
+        /**
+         * Checks if all bits in the specified range are set
+         * @param begin Begin of the range to check (bit index)
+         * @param end End of the range to check (bit index)
+         * @return true if all bits in the range are set (or the range is empty), false otherwise
+         */
+        [[nodiscard]] bool all(const size_type& begin, const size_type& end) const noexcept
+        {
+            if (begin >= end)
+                return true;
+
+            const size_type first_block = begin / m_block_size;
+            const size_type last_block = (end - 1) / m_block_size;
+            const BlockType first_mask = detail::mask_from<BlockType>(begin);
+            const BlockType last_mask = detail::mask_until<BlockType>(end);
+
+            if (first_block == last_block)
+                return (m_data[first_block] & first_mask & last_mask) == (first_mask & last_mask);
+            if ((m_data[first_block] & first_mask) != first_mask || (m_data[last_block] & last_mask) != last_mask)
+                return false;
+            return !detail::any_of_blocks(m_data + first_block + 1, last_block - first_block - 1, [](const BlockType block) noexcept { return static_cast<BlockType>(~block); });
+        }
+
+        /**
+         * Checks if any bit is set
+         * @return true if any bit is set, false otherwise
+         */
+        [[nodiscard]] bool any() const noexcept
+        {
+            return any(0, m_size);
+        }
+
+        /**
+         * Checks if any bit in the specified range is set
+         * @param begin Begin of the range to check (bit index)
+         * @param end End of the range to check (bit index)
+         * @return true if any bit in the range is set, false otherwise
+         */
+        [[nodiscard]] bool any(const size_type& begin, const size_type& end) const noexcept
+        {
+            if (begin >= end)
+                return false;
+
+            const size_type first_block = begin / m_block_size;
+            const size_type last_block = (end - 1) / m_block_size;
+            const BlockType first_mask = detail::mask_from<BlockType>(begin);
+            const BlockType last_mask = detail::mask_until<BlockType>(end);
+
+            if (first_block == last_block)
+                return (m_data[first_block] & first_mask & last_mask) != 0;
+            if (m_data[first_block] & first_mask || m_data[last_block] & last_mask)
+                return true;
+            return detail::any_of_blocks(m_data + first_block + 1, last_block - first_block - 1, [](const BlockType block) noexcept { return block; });
+        }
+
+        /**
+         * Checks if none of the bits are set
+         * @return true if none of the bits are set, false otherwise
+         */
+        [[nodiscard]] bool none() const noexcept
+        {
+            return !any(0, m_size);
+        }
+
+        /**
+         * Checks if none of the bits in the specified range are set
+         * @param begin Begin of the range to check (bit index)
+         * @param end End of the range to check (bit index)
+         * @return true if none of the bits in the range are set, false otherwise
+         */
+        [[nodiscard]] bool none(const size_type& begin, const size_type& end) const noexcept
+        {
+            return !any(begin, end);
+        }
+
+        /**
+         * Checks if all bits are reseted (none are set)
+         * @return true if all bits are reseted, false otherwise
+         */
+        [[nodiscard]] bool all_reset() const noexcept
+        {
+            return none();
+        }
+
+        /**
+         * @return The number of set bits
+         */
+        [[nodiscard]] size_type count() const noexcept
+        {
+            return count(0, m_size);
+        }
+
+        /**
+         * Counts the set bits in the specified range
+         * @param begin Begin of the range to count (bit index)
+         * @param end End of the range to count (bit index)
+         * @return The number of set bits in the range
+         */
+        [[nodiscard]] size_type count(const size_type& begin, const size_type& end) const noexcept
+        {
+            return detail::count_range(m_data, begin, end);
+        }
+
+        /**
+         * Finds the first set bit
+         * @return Index of the first set bit, size() if there is none
+         */
+        [[nodiscard]] size_type find_first() const noexcept
+        {
+            return detail::find_next(m_data, m_size, 0);
+        }
+
+        /**
+         * Finds the first set bit at or after the specified position
+         * @param pos Position to start the search at (bit index)
+         * @return Index of the found bit, size() if there is none
+         */
+        [[nodiscard]] size_type find_next(const size_type& pos) const noexcept
+        {
+            return detail::find_next(m_data, m_size, pos);
+        }
+
+        /**
+         * Checks if the bitset is empty
+         * @return true if the bitset is empty, false otherwise
+         */
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return !m_size;
+        }
+
+        /**
+         * Returns bitset's capacity in bits (capacity = number of bits that can be stored w/o reallocation)
+         * @return 
+         */
+        [[nodiscard]] size_type capacity() const noexcept
+        {
+	        return m_storage_size * m_block_size;
+		}
+
+        /**
+         * Resizes the bitset to the specified size, but does not define values in the expanded area
+         * @param new_size New size of the bitset to resize to (bit count)
+         */
+        void resize(const size_type& new_size)
+        {
+            if (new_size == m_size)
+                return;
+
+            if (!new_size)
+            {
+                m_partial_size = m_storage_size = m_size = 0;
+                if (m_data)
+                {
+	                delete[] m_data;
+                }
+                m_data = nullptr;
+                return;
+            }
+
+            const size_type new_storage_size = new_size / m_block_size + !!(new_size % m_block_size);
+            if (new_storage_size != m_storage_size)
+            {
+                BlockType* new_data = new BlockType[new_storage_size];
+                if (m_data)
+                {
+                    if (m_storage_size < new_storage_size)
+                    {
+                        std::copy(m_data, m_data + m_storage_size, new_data);
+                        ::memset(new_data + m_storage_size, 0, (new_storage_size - m_storage_size) * sizeof(BlockType)); // ensure 0 initialization
+                    }
+                    else
+                    {
+                        std::copy(m_data, m_data + new_storage_size, new_data);
+                    }
+                    delete[] m_data;
+                }
+                else
+                    ::memset(new_data, 0, new_storage_size * sizeof(BlockType));
+                m_data = new_data;
+            }
+            m_partial_size = new_size % m_block_size;
+            m_storage_size = new_storage_size;
+            m_size = new_size;
+        }
+
+        /**
+		 * Pushes back bit value to the bitset
+		 * @param value Value to push back (bit value)
+		 */
+        void push_back(const bool value)
+        {
+            if (!(m_size % m_block_size))
+            {
+                BlockType* new_data = new BlockType[m_storage_size + 1];
+                if (m_data)
+                {
+                    std::copy(m_data, m_data + m_storage_size, new_data);
+                    delete[] m_data;
+                }
+                *(new_data + m_storage_size++) = 0;
+                m_data = new_data;
+            }
+            m_partial_size = ++m_size % m_block_size;
+            if (value)
+				set(m_size - 1);
+            else
+				reset(m_size - 1);
+        }
+
+        /**
+		 * Pops back bit value from the bitset
+		 */
+        void pop_back()
+        {
+            if (!(--m_size % m_block_size))
+            {
+                --m_storage_size;
+                if (m_size)
+                {
+                    BlockType* new_data = new BlockType[m_storage_size];
+                    std::copy(m_data, m_data + m_storage_size, new_data);
+                    delete[] m_data;
+                    m_data = new_data;
+                }
+                else
+                {
+                    delete[] m_data;
+                    m_data = nullptr;
+                }
+            }
+            m_partial_size = m_size % m_block_size;
+        }
+
+        /**
+         * Inserts bit value at the specified index
+         * When inserting at the last position, for more info see push_back
+         * @param index Index to insert the value at (bit index)
+         * @param value Value to insert (bit value)
+         */
+        void insert(const size_type& index, const bool value)
+        {
+            [[unlikely]] if (index == m_size)
+            {
+                push_back(value);
+                return;
+            }
+
+            if (!(m_size % m_block_size))
+            {
+                BlockType* new_data = new BlockType[++m_storage_size];
+                ++m_partial_size;
+                ++m_size;
+                if (m_data)
+                {
+                    // copy everything prepending the bit
+                    for (size_type i = 0; i < index; ++i)
+                    {
+                        if (test(i))
+                            *(new_data + i / m_block_size) |= BlockType{ 1 } << i % m_block_size;
+                        else
+                            *(new_data + i / m_block_size) &= ~(BlockType{ 1 } << i % m_block_size);
+                    }
+                    // copy everything appending the bit
+                    for (size_type i = m_size - 1; ; --i)
+                    {
+                        const size_type next_i = i + 1;
+
+                        if (test(i))
+                            *(new_data + next_i / m_block_size) |= BlockType{ 1 } << next_i % m_block_size;
+                        else
+                            *(new_data + next_i / m_block_size) &= ~(BlockType{ 1 } << next_i % m_block_size);
+                        [[unlikely]] if (i == index)
+                            break;
+                    }
+                    delete[] m_data;
+                    m_data = new_data;
+                    set(index, value);
+                }
+                m_data = new_data;
+            }
+            else
+            {
+                const dynamic_bitset tmp_copy(*this);
+                // copy everything appending the bit
+                for (size_type i = m_size; ; --i)
+                {
+                    set(i + 1, tmp_copy.test(i));
+                    [[unlikely]] if (i == index) 
+						break;
+                }
+                set(index, value);
+                m_partial_size = ++m_size % m_block_size;
+            }
+        }
+
+        /**
+		 * Pushes back block value to the bitset. \n
+		 * If bitset's size is not a multiple of/divisible by block size, \n
+		 * additionally fully expands the not fully utilized block, \n
+		 * although values in the expanded area are in valid, but unspecified state by this function \n
+		 * e.g. (BlockType=uint64_t, m_size=65, push_back_block call -> {m_size 65 -> 128 [expansion of not fully utilized block] -> 192 [expansion to hold 1 additional block]})
+		 * @param block Block value to push back (block value)
+		 */
+        void push_back_block(const BlockType& block)
+        {
+            m_size = ++m_storage_size * m_block_size;
+            m_partial_size = 0;
+            BlockType* new_data = new BlockType[m_storage_size];
+            if (m_data)
+            {
+                std::copy(m_data, m_data + m_storage_size, new_data);
+                delete[] m_data;
+            }
+            m_data = new_data;
+            *(m_data + m_storage_size - 1) = block;
+        }
+
+        /**
+         * Pops back block value from the bitset. \n
+         * If bitset's size is not a multiple of/divisible by block size, \n
+         * removes the not fully utilized block first \n
+         * e.g. (BlockType=uint64_t, m_size=65, pp_back_block call -> {m_size 65 -> 64 [removal of last, not fully utilized block]}
+         */
+        void pop_back_block()
+        {
+            m_size = --m_storage_size * m_block_size;
+            m_partial_size = 0;
+            BlockType* new_data = new BlockType[m_storage_size];
+            if (m_data)
+            {
+                std::copy(m_data, m_data + m_storage_size, new_data);
+                delete[] m_data;
+            }
+            m_data = new_data;
+        }
+
+        /**
+		 * Inserts block value at the specified index to the bitset.\n
+		 * When inserting at the last position, for more info see push_back_block
+		 * @param index Index to insert the value at (block index)
+		 * @param block Block value to insert (block value)
+		 */
+        void insert_block(const size_type& index, const BlockType& block)
+        {
+            if (index == m_storage_size)
+            {
+	            push_back_block(block);
+                return;
+            }
+
+            BlockType* new_data = new BlockType[m_storage_size + 1];
+            if (m_data)
+            {
+                // copy everything prepending the block
+                for (size_type i = 0; i < index; ++i)
+                    *(new_data + i) = *(m_data + i);
+
+                // copy everything appending the block
+                for (size_type i = m_storage_size - 1; ; --i)
+                {
+                    *(new_data + i + 1) = *(m_data + i);
+					[[unlikely]] if (i == index)
+						break;
+                }
+                delete[] m_data;
+            }
+            
+            m_size += m_block_size;
+            ++m_storage_size;
+        	m_data = new_data;
+
+            *(new_data + index) = block;
+        }
+
+        /**
+         * Bit-length of the underlying type
+         */
+        static constexpr uint16_t m_block_size = sizeof(BlockType) * CHAR_BIT;
+        
+        /**
+         * Count of bits that are utilized in last dangling block, if any
+         */
+        uint8_t m_partial_size;
+
+        /**
+         * m_size of the bitset in blocks
+         */
+        size_type m_storage_size;
+
+        /**
+         * m_size of the bitset in bits
+         */
+        size_type m_size;
+        
+        /**
+         * Underlying array of blocks containing the bits
+         */
+        alignas(BlockType) BlockType* m_data;
+    };
+
+    /**
+     * Function object ordering bitsets lexicographically by bit index (see compare_lexicographic), for use with ordered containers and algorithms
+     */
+    struct lexicographic_less
+    {
+        typedef void is_transparent;
+
+        template <typename Bitset>
+        [[nodiscard]] constexpr bool operator()(const Bitset& lhs, const Bitset& rhs) const noexcept
+        {
+            return lhs.compare_lexicographic(rhs) < 0;
+        }
+    };
+
+    /**
+     * Transposes an 8x8 bit matrix stored one row per byte
+     * Bit j of byte i is the element at row i and column j.
+     * @param matrix Matrix to transpose
+     * @return Transposed matrix
+     */
+    [[nodiscard]] constexpr std::uint64_t transpose_8x8(std::uint64_t matrix) noexcept
+    {
+        // Swap the off-diagonal elements of the 2x2, then 4x4, then 8x8 blocks
+        std::uint64_t swapped = (matrix ^ matrix >> 7) & 0x00aa00aa00aa00aaull;
+        matrix ^= swapped ^ swapped << 7;
+        swapped = (matrix ^ matrix >> 14) & 0x0000cccc0000ccccull;
+        matrix ^= swapped ^ swapped << 14;
+        swapped = (matrix ^ matrix >> 28) & 0x00000000f0f0f0f0ull;
+        matrix ^= swapped ^ swapped << 28;
+        return matrix;
+    }
+
+    /**
+     * Transposes a 32x32 bit matrix in place, bit j of rows[i] is the element at row i and column j
+     * @param rows Rows of the matrix
+     */
+    constexpr void transpose_32x32(std::uint32_t (&rows)[32]) noexcept
+    {
+        detail::transpose_square(rows);
+    }
+
+    /**
+     * Transposes a 64x64 bit matrix in place, bit j of rows[i] is the element at row i and column j
+     * @param rows Rows of the matrix
+     */
+    constexpr void transpose_64x64(std::uint64_t (&rows)[64]) noexcept
+    {
+        detail::transpose_square(rows);
+    }
+
+    /**
+     * Transposes rows into columns, bit c of rows[r] becomes bit r of the c-th column
+     * The matrix is processed in 64x64 tiles.
+     * @tparam Size Size of the rows (bit count)
+     * @tparam Extent Extent of the span
+     * @param rows Rows to transpose
+     * @return Size columns, each holding one bit per row
+     */
+    template <std::size_t Size, std::size_t Extent>
+    [[nodiscard]] std::vector<dynamic_bitset<std::uint64_t>> transpose(const std::span<const bitset<std::uint64_t, Size>, Extent> rows)
+    {
+        std::vector<dynamic_bitset<std::uint64_t>> columns(Size, dynamic_bitset<std::uint64_t>(rows.size()));
+
+        std::uint64_t tile[64];
+        for (std::size_t row = 0; row < rows.size(); row += 64)
+        {
+            const std::size_t height = (std::min)(rows.size() - row, std::size_t{ 64 });
+            for (std::size_t column = 0; column < Size; column += 64)
+            {
+                for (std::size_t i = 0; i < height; ++i)
+                    tile[i] = rows[row + i].get_block(column / 64);
+                std::fill(tile + height, tile + 64, std::uint64_t{ 0 });
+
+                transpose_64x64(tile);
+
+                const std::size_t width = (std::min)(Size - column, std::size_t{ 64 });
+                for (std::size_t i = 0; i < width; ++i)
+                    columns[column + i].get_block(row / 64) = tile[i];
+            }
+        }
+        return columns;
+    }
+
+    /**
+     * Dense matrix over GF(2) with contiguous row-major storage
+     * Every row starts on a 64-byte boundary, bits past the last column and the padding blocks are kept reset.
+     * @tparam BlockType Type of block to use for bit storage (may be one of unsigned integer types)
+     */
+    template <unsigned_integer BlockType = std::uint64_t>
+    class bit_matrix
+    {
+    public:
+        friend std::ostream& operator<<(std::ostream& os, const bit_matrix& obj)
+        {
+            for (size_type i = 0; i < obj.m_rows; ++i)
+            {
+                for (size_type j = 0; j < obj.m_cols; ++j)
+                    os << obj.test(i, j);
+                os << '\n';
+            }
+            return os;
+        }
+        // Type definitions
+
+        // Row views
+        template <typename Block>
+        class basic_row;
+        typedef basic_row<BlockType> row_reference;
+        typedef basic_row<const BlockType> const_row_reference;
+
+        // Other types
+        typedef std::size_t size_type;
+        typedef BlockType block_type;
+
+        /**
+         * Non-owning view of a matrix row, with the bit access and bitwise operations of dynamic_bitset
+         * @tparam Block BlockType for mutable rows, const BlockType for read-only rows
+         */
+        template <typename Block>
+        class basic_row
+        {
+        public:
+            /**
+             * Constructs a view of the specified blocks
+             * @param data First block of the row
+             * @param size Size of the row (bit count)
+             */
+            basic_row(Block* data, const size_type& size) noexcept : m_data(data), m_size(size) {}
+
+            /**
+             * Copy constructor (copies the view, not the bits)
+             */
+            basic_row(const basic_row&) noexcept = default;
+
+            /**
+             * Destructor
+             */
+            ~basic_row() noexcept = default;
+
+            /**
+             * Conversion to a read-only view
+             */
+            [[nodiscard]] operator basic_row<const BlockType>() const noexcept
+            {
+                return basic_row<const BlockType>(m_data, m_size);
+            }
+
+            /**
+             * Copies the bits of the row into a new dynamic_bitset instance
+             * @return New dynamic_bitset instance holding the row
+             */
+            [[nodiscard]] dynamic_bitset<BlockType> to_dynamic_bitset() const noexcept
+            {
+                dynamic_bitset<BlockType> result(m_size);
+                std::copy(m_data, m_data + storage_size(), &result.get_block(0));
+                return result;
+            }
+
+            /**
+             * Returns the size of the row
+             * @return Size of the row (bit count)
+             */
+            [[nodiscard]] size_type size() const noexcept
+            {
+                return m_size;
+            }
+
+            /**
+             * Returns the count of blocks holding the row
+             * @return Count of blocks (block count)
+             */
+            [[nodiscard]] size_type storage_size() const noexcept
+            {
+                return (m_size + m_block_size - 1) / m_block_size;
+            }
+
+            /**
+             * Returns the blocks of the row
+             * @return Pointer to the first block
+             */
+            [[nodiscard]] Block* data() const noexcept
+            {
+                return m_data;
+            }
+
+            /**
+             * Retrieves the block at the specified index
+             * @param index Index of the block to retrieve (block index)
+             * @return Block at the specified index
+             */
+            [[nodiscard]] Block& get_block(const size_type& index) const noexcept
+            {
+                return m_data[index];
+            }
+
+            /**
+             * Returns the value of the bit at the specified index
+             * @param index Index of the bit to retrieve (bit index)
+             * @return Value of the bit at the specified index (bit value)
+             */
+            [[nodiscard]] bool operator[](const size_type& index) const noexcept
+            {
+                return test(index);
+            }
+
+            /**
+             * Returns the value of the bit at the specified index
+             * @param index Index of the bit to retrieve (bit index)
+             * @return Value of the bit at the specified index (bit value)
+             */
+            [[nodiscard]] bool test(const size_type& index) const noexcept
+            {
+                return m_data[index / m_block_size] >> index % m_block_size & 1;
+            }
+
+            /**
+             * Sets the bit at the specified index to the specified value
+             * @param index Index of the bit to set (bit index)
+             * @param value Value to set the bit to (bit value)
+             */
+            void set(const size_type& index, const bool value = true) const noexcept requires (!std::is_const_v<Block>)
+            {
+                const BlockType bit = static_cast<BlockType>(BlockType{ 1 } << index % m_block_size);
+                m_data[index / m_block_size] = value ? m_data[index / m_block_size] | bit : m_data[index / m_block_size] & static_cast<BlockType>(~bit);
+            }
+
+            /**
+             * Resets the bit at the specified index
+             * @param index Index of the bit to reset (bit index)
+             */
+            void reset(const size_type& index) const noexcept requires (!std::is_const_v<Block>)
+            {
+                set(index, false);
+            }
+
+            /**
+             * Flips the bit at the specified index
+             * @param index Index of the bit to flip (bit index)
+             */
+            void flip(const size_type& index) const noexcept requires (!std::is_const_v<Block>)
+            {
+                m_data[index / m_block_size] ^= static_cast<BlockType>(BlockType{ 1 } << index % m_block_size);
+            }
+
+            /**
+             * Sets all bits of the row
+             */
+            void set() const noexcept requires (!std::is_const_v<Block>)
+            {
+                std::fill(m_data, m_data + storage_size(), (std::numeric_limits<BlockType>::max)());
+                _clear_tail();
+            }
+
+            /**
+             * Resets all bits of the row
+             */
+            void reset() const noexcept requires (!std::is_const_v<Block>)
+            {
+                std::fill(m_data, m_data + storage_size(), BlockType{ 0 });
+            }
+
+            /**
+             * Flips all bits of the row
+             */
+            void flip() const noexcept requires (!std::is_const_v<Block>)
+            {
+                for (size_type i = 0; i < storage_size(); ++i)
+                    m_data[i] = static_cast<BlockType>(~m_data[i]);
+                _clear_tail();
+            }
+
+            /**
+             * Copies the bits of another row of the same size
+             * @param other Row to copy from
+             */
+            void assign(const basic_row<const BlockType>& other) const noexcept requires (!std::is_const_v<Block>)
+            {
+                std::copy(other.data(), other.data() + storage_size(), m_data);
+            }
+
+            /**
+             * Copies the bits of a dynamic_bitset instance of the same size
+             * @param other Bitset to copy from
+             */
+            void assign(const dynamic_bitset<BlockType>& other) const noexcept requires (!std::is_const_v<Block>)
+            {
+                for (size_type i = 0; i < storage_size(); ++i)
+                    m_data[i] = other.get_block(i);
+                _clear_tail();
+            }
 
             /**
-             * Conversion assign operator to const_iterator.
-             * @param other Other const_iterator instance to convert from.
+             * Apply bitwise AND operation with another row of the same size
+             * @param other Other row to perform the operation with
              */
-            iterator& operator=(const const_iterator& other) noexcept {
-                this->m_bitset = other.m_bitset;
-                this->m_index = other.m_index;
+            const basic_row& operator&=(const basic_row<const BlockType>& other) const noexcept requires (!std::is_const_v<Block>)
+            {
+                for (size_type i = 0; i < storage_size(); ++i)
+                    m_data[i] &= other.get_block(i);
                 return *this;
             }
 
             /**
-             * Dereference operator (returns the value of the bit at the current bit index).
-             * @return Reference to the bit at the current index.
+             * Apply bitwise OR operation with another row of the same size
+             * @param other Other row to perform the operation with
              */
-            [[nodiscard]] reference operator*() noexcept {
-                return reference(this->m_bitset, this->m_index);
+            const basic_row& operator|=(const basic_row<const BlockType>& other) const noexcept requires (!std::is_const_v<Block>)
+            {
+                for (size_type i = 0; i < storage_size(); ++i)
+                    m_data[i] |= other.get_block(i);
+                return *this;
             }
 
             /**
-             * Increments the iterator to the next bit, pre-increment.
+             * Apply bitwise XOR operation (addition over GF(2)) with another row of the same size
+             * @param other Other row to perform the operation with
              */
-            iterator& operator++() noexcept
+            const basic_row& operator^=(const basic_row<const BlockType>& other) const noexcept requires (!std::is_const_v<Block>)
             {
-                ++this->m_index;
+                for (size_type i = 0; i < storage_size(); ++i)
+                    m_data[i] ^= other.get_block(i);
                 return *this;
             }
 
-            /**
-             * Increments the iterator to the next bit, post-increment
-             */
-            iterator& operator++(int) noexcept
+            /**
+             * Checks if all bits are set
+             * @return true if all bits are set, false otherwise
+             */
+            [[nodiscard]] bool all() const noexcept
+            {
+                return count() == m_size;
+            }
+
+            /**
+             * Checks if any bit is set
+             * @return true if any bit is set, false otherwise
+             */
+            [[nodiscard]] bool any() const noexcept
+            {
+                return detail::any_of_blocks(m_data, storage_size(), [](const BlockType block) noexcept { return block; });
+            }
+
+            /**
+             * Checks if none of the bits are set
+             * @return true if none of the bits are set, false otherwise
+             */
+            [[nodiscard]] bool none() const noexcept
+            {
+                return !any();
+            }
+
+            /**
+             * Counts the set bits
+             * @return The number of set bits
+             */
+            [[nodiscard]] size_type count() const noexcept
+            {
+                return detail::count_blocks(m_data, storage_size());
+            }
+
+            /**
+             * Finds the first set bit
+             * @return Index of the first set bit, size() if there is none
+             */
+            [[nodiscard]] size_type find_first() const noexcept
+            {
+                return detail::find_next(m_data, m_size, 0);
+            }
+
+            /**
+             * Finds the first set bit at or after the specified position
+             * @param pos Position to start the search at (bit index)
+             * @return Index of the found bit, size() if there is none
+             */
+            [[nodiscard]] size_type find_next(const size_type& pos) const noexcept
+            {
+                return detail::find_next(m_data, m_size, pos);
+            }
+
+            /**
+             * Equality operator
+             * @param other Other row of the same size to compare with
+             * @return true if the rows hold the same bits, false otherwise
+             */
+            [[nodiscard]] bool operator==(const basic_row<const BlockType>& other) const noexcept
+            {
+                return std::equal(m_data, m_data + storage_size(), other.data());
+            }
+
+        private:
+            /**
+             * Resets the bits past the end of the row
+             */
+            void _clear_tail() const noexcept
+            {
+                if (m_size % m_block_size)
+                    m_data[m_size / m_block_size] &= detail::mask_until<BlockType>(m_size);
+            }
+
+            Block* m_data;
+            size_type m_size;
+        };
+
+        /**
+         * Default constructor, constructs an empty matrix
+         */
+        bit_matrix() noexcept : m_rows(0), m_cols(0), m_stride(0), m_data(nullptr) {}
+
+        /**
+         * Size constructor, constructs a zero matrix
+         * @param rows Count of rows
+         * @param cols Count of columns (bit count of every row)
+         */
+        bit_matrix(const size_type& rows, const size_type& cols) noexcept : m_rows(rows), m_cols(cols), m_stride(_stride(cols)), m_data(_allocate(rows * m_stride))
+        {
+            std::fill(m_data, m_data + m_rows * m_stride, BlockType{ 0 });
+        }
+
+        /**
+         * Copy constructor
+         * @param other Other matrix to copy from
+         */
+        bit_matrix(const bit_matrix& other) noexcept : m_rows(other.m_rows), m_cols(other.m_cols), m_stride(other.m_stride), m_data(_allocate(other.m_rows * other.m_stride))
+        {
+            std::copy(other.m_data, other.m_data + m_rows * m_stride, m_data);
+        }
+
+        /**
+         * Move constructor
+         * @param other Other matrix to move from
+         */
+        bit_matrix(bit_matrix&& other) noexcept : m_rows(other.m_rows), m_cols(other.m_cols), m_stride(other.m_stride), m_data(other.m_data)
+        {
+            other.m_rows = other.m_cols = other.m_stride = 0;
+            other.m_data = nullptr;
+        }
+
+        /**
+         * Destructor
+         */
+        ~bit_matrix() noexcept
+        {
+            _deallocate(m_data);
+        }
+
+        /**
+         * Copy assignment operator
+         * @param other Other matrix to copy from
+         */
+        bit_matrix& operator=(const bit_matrix& other) noexcept
+        {
+            if (this != &other)
+                *this = bit_matrix(other);
+            return *this;
+        }
+
+        /**
+         * Move assignment operator
+         * @param other Other matrix to move from
+         */
+        bit_matrix& operator=(bit_matrix&& other) noexcept
+        {
+            std::swap(m_rows, other.m_rows);
+            std::swap(m_cols, other.m_cols);
+            std::swap(m_stride, other.m_stride);
+            std::swap(m_data, other.m_data);
+            return *this;
+        }
+
+        /**
+         * Constructs an identity matrix
+         * @param size Count of rows and columns
+         * @return New identity matrix
+         */
+        [[nodiscard]] static bit_matrix identity(const size_type& size) noexcept
+        {
+            bit_matrix result(size, size);
+            for (size_type i = 0; i < size; ++i)
+                result.set(i, i);
+            return result;
+        }
+
+        /**
+         * Returns the count of rows
+         * @return Count of rows
+         */
+        [[nodiscard]] size_type rows() const noexcept
+        {
+            return m_rows;
+        }
+
+        /**
+         * Returns the count of columns
+         * @return Count of columns
+         */
+        [[nodiscard]] size_type cols() const noexcept
+        {
+            return m_cols;
+        }
+
+        /**
+         * Returns the distance between the first blocks of consecutive rows
+         * @return Row stride (block count)
+         */
+        [[nodiscard]] size_type stride() const noexcept
+        {
+            return m_stride;
+        }
+
+        /**
+         * Returns a view of the row at the specified index
+         * @param index Index of the row
+         * @return View of the row
+         */
+        [[nodiscard]] row_reference operator[](const size_type& index) noexcept
+        {
+            return row_reference(m_data + index * m_stride, m_cols);
+        }
+
+        /**
+         * Returns a read-only view of the row at the specified index
+         * @param index Index of the row
+         * @return View of the row
+         */
+        [[nodiscard]] const_row_reference operator[](const size_type& index) const noexcept
+        {
+            return const_row_reference(m_data + index * m_stride, m_cols);
+        }
+
+        /**
+         * Returns the value of the element at the specified position
+         * @param row Index of the row
+         * @param col Index of the column
+         * @return Value of the element (bit value)
+         */
+        [[nodiscard]] bool test(const size_type& row, const size_type& col) const noexcept
+        {
+            return (*this)[row].test(col);
+        }
+
+        /**
+         * Sets the element at the specified position to the specified value
+         * @param row Index of the row
+         * @param col Index of the column
+         * @param value Value to set the element to (bit value)
+         */
+        void set(const size_type& row, const size_type& col, const bool value = true) noexcept
+        {
+            (*this)[row].set(col, value);
+        }
+
+        /**
+         * Resets the element at the specified position
+         * @param row Index of the row
+         * @param col Index of the column
+         */
+        void reset(const size_type& row, const size_type& col) noexcept
+        {
+            (*this)[row].reset(col);
+        }
+
+        /**
+         * Flips the element at the specified position
+         * @param row Index of the row
+         * @param col Index of the column
+         */
+        void flip(const size_type& row, const size_type& col) noexcept
+        {
+            (*this)[row].flip(col);
+        }
+
+        /**
+         * Swaps two rows
+         * @param first Index of the first row
+         * @param second Index of the second row
+         */
+        void swap_rows(const size_type& first, const size_type& second) noexcept
+        {
+            std::swap_ranges(m_data + first * m_stride, m_data + (first + 1) * m_stride, m_data + second * m_stride);
+        }
+
+        /**
+         * Transposes the matrix, in tiles of one block per row
+         * @return New transposed matrix
+         */
+        [[nodiscard]] bit_matrix transpose() const noexcept
+        {
+            bit_matrix result(m_cols, m_rows);
+
+            BlockType tile[m_block_size];
+            for (size_type row = 0; row < m_rows; row += m_block_size)
             {
-                iterator tmp = *this;
-                ++this->m_index;
-                return tmp;
-            }
+                const size_type height = (std::min)(m_rows - row, m_block_size);
+                for (size_type col = 0; col < m_cols; col += m_block_size)
+                {
+                    for (size_type i = 0; i < height; ++i)
+                        tile[i] = m_data[(row + i) * m_stride + col / m_block_size];
+                    std::fill(tile + height, tile + m_block_size, BlockType{ 0 });
 
-            /**
-             * Decrements the iterator to the previous bit, pre-decrement.
-             */
-            iterator& operator--() noexcept
-            {
-                --this->m_index;
-                return *this;
-            }
+                    detail::transpose_square(tile);
 
-            /**
-             * Decrements the iterator to the previous bit, post-decrement.
-             */
-            iterator& operator--(int) noexcept
-            {
-                iterator tmp = *this;
-                --this->m_index;
-                return tmp;
+                    const size_type width = (std::min)(m_cols - col, m_block_size);
+                    for (size_type i = 0; i < width; ++i)
+                        result.m_data[(col + i) * result.m_stride + row / m_block_size] = tile[i];
+                }
             }
+            return result;
+        }
 
-            /**
-             * Returns the iterator with the specified amount added to it
-             * @param amount Amount to add to the iterator (bit count)
-             * @return New iterator instance with the specified amount added to it
-             */
-            [[nodiscard]] iterator operator+(const size_type& amount) const noexcept
-            {
-                return iterator(this->m_bitset, this->m_index + amount);
-            }
+        /**
+         * Addition over GF(2)
+         * @param other Other matrix of the same dimensions
+         * @return New matrix holding the sum
+         */
+        [[nodiscard]] bit_matrix operator^(const bit_matrix& other) const noexcept
+        {
+            bit_matrix result(*this);
+            result ^= other;
+            return result;
+        }
 
-            /**
-             * Returns the iterator with the specified amount subtracted from it
-             * @param amount Amount to subtract from the iterator (bit count)
-             * @return New iterator instance with the specified amount subtracted from it
-             */
-            [[nodiscard]] iterator operator-(const size_type& amount) const noexcept
-            {
-                return iterator(this->m_bitset, this->m_index - amount);
-            }
+        /**
+         * Apply addition over GF(2) with another matrix of the same dimensions
+         * @param other Other matrix to add
+         */
+        bit_matrix& operator^=(const bit_matrix& other) noexcept
+        {
+            for (size_type i = 0; i < m_rows * m_stride; ++i)
+                m_data[i] ^= other.m_data[i];
+            return *this;
+        }
 
-            /**
-             * Returns difference between two iterators
-             * @param other Other iterator instance subtract with
-             * @return Difference between two iterators
-             */
-            [[nodiscard]] difference_type operator-(const iterator& other) const noexcept
-            {
-                return this->m_index - other.m_index;
-            }
+        /**
+         * Multiplication over GF(2) (Method of Four Russians)
+         * @param other Other matrix, with as many rows as this matrix has columns
+         * @return New matrix holding the product
+         */
+        [[nodiscard]] bit_matrix operator*(const bit_matrix& other) const noexcept
+        {
+            bit_matrix result(m_rows, other.m_cols);
+            _multiply(other, result);
+            return result;
+        }
 
-            /**
-             * Returns difference between two iterators
-             * @param other Other iterator instance subtract with
-             * @return Difference between two iterators
-             */
-            [[nodiscard]] difference_type operator-(const const_iterator& other) const noexcept
-            {
-                return this->m_index - other.m_index;
-            }
+        /**
+         * Equality operator
+         * @param other Other matrix to compare with
+         * @return true if the matrices have the same dimensions and elements, false otherwise
+         */
+        [[nodiscard]] bool operator==(const bit_matrix& other) const noexcept
+        {
+            return m_rows == other.m_rows && m_cols == other.m_cols && std::equal(m_data, m_data + m_rows * m_stride, other.m_data);
+        }
 
-            /**
-             * Returns the iterator multiplied by the specified amount
-             * @param amount Amount to multiply the iterator by (bit count ?)
-             * @return New iterator instance multiplied by the specified amount
-             */
-            [[nodiscard]] iterator operator*(const size_type& amount) const noexcept
-            {
-                return iterator(this->m_bitset, this->m_index * amount);
-            }
+        // Elimination over GF(2)
 
+        /**
+         * Brings the matrix to reduced row echelon form in place (Gauss-Jordan elimination)
+         * @return Rank of the matrix, the first rank rows hold the pivots in increasing column order
+         */
+        size_type row_reduce() noexcept
+        {
+            return _eliminate(true);
+        }
 
-            /**
-             * Returns the iterator divided by the specified amount
-             * @param amount Amount to multiply the iterator by (bit count ?)
-             * @return New iterator instance divided by the specified amount
-             */
-            [[nodiscard]] iterator operator/(const size_type& amount) const noexcept
-            {
-                return iterator(this->m_bitset, this->m_index / amount);
-            }
+        /**
+         * Computes the reduced row echelon form
+         * @return New matrix in reduced row echelon form
+         */
+        [[nodiscard]] bit_matrix rref() const noexcept
+        {
+            bit_matrix result(*this);
+            result.row_reduce();
+            return result;
+        }
 
-            /**
-             * Adds the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
-             */
-            iterator& operator+=(const size_type& amount) noexcept
-            {
-                this->m_index += amount;
-                return *this;
-            }
+        /**
+         * Computes the rank (forward elimination only)
+         * @return Rank of the matrix
+         */
+        [[nodiscard]] size_type rank() const noexcept
+        {
+            bit_matrix echelon(*this);
+            return echelon._eliminate(false);
+        }
 
-            /**
-             * Subtracts the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
-             */
-            iterator& operator-=(const size_type& amount) noexcept
+        /**
+         * Computes a basis of the nullspace, the vectors x with A x = 0
+         * @return Matrix whose rows form the basis (cols() - rank() rows of cols() bits)
+         */
+        [[nodiscard]] bit_matrix nullspace() const noexcept
+        {
+            bit_matrix reduced(*this);
+            const size_type rank = reduced.row_reduce();
+            std::vector<size_type> pivots(rank);
+            for (size_type i = 0; i < rank; ++i)
+                pivots[i] = reduced[i].find_first();
+
+            // Every free column gives one basis vector, its pivot variables are read off the reduced rows
+            bit_matrix result(m_cols - rank, m_cols);
+            for (size_type col = 0, pivot = 0, vector = 0; col < m_cols; ++col)
             {
-                this->m_index -= amount;
-                return *this;
+                if (pivot < rank && pivots[pivot] == col)
+                {
+                    ++pivot;
+                    continue;
+                }
+                result.set(vector, col);
+                for (size_type i = 0; i < pivot; ++i)
+                {
+                    if (reduced.test(i, col))
+                        result.set(vector, pivots[i]);
+                }
+                ++vector;
             }
+            return result;
+        }
 
-            /**
-             * Adds the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
-             */
-            iterator& operator*=(const size_type& amount) noexcept
+        /**
+         * Solves A x = b
+         * The structured pre-pass repeatedly takes columns with a single nonzero among the remaining rows as pivots,
+         * removing their rows without any row operation, and drops the columns it empties, so sparse systems reach the dense elimination smaller.
+         * @param b Right-hand side (rows() bits)
+         * @param structured true to run the structured Gaussian pre-pass first
+         * @return A solution (free variables are reset), std::nullopt if the system is inconsistent
+         */
+        [[nodiscard]] std::optional<dynamic_bitset<BlockType>> solve(const dynamic_bitset<BlockType>& b, const bool structured = false) const noexcept
+        {
+            dynamic_bitset<BlockType> x(m_cols);
+
+            // Rows removed by the pre-pass, with the column they determine, in removal order
+            std::vector<std::pair<size_type, size_type>> removed;
+            std::vector<bool> active(m_rows, true);
+            if (structured)
             {
-                this->m_index *= amount;
-                return *this;
-            }
+                // Columns left empty by the pre-pass are dropped from the dense part, weight becomes their new index
+                std::vector<size_type> weight, columns;
+                _singleton_pivots(removed, active, weight);
+                for (size_type col = 0; col < m_cols; ++col)
+                {
+                    if (weight[col])
+                    {
+                        weight[col] = columns.size();
+                        columns.push_back(col);
+                    }
+                }
 
-            /**
-             * Subtracts the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
-             */
-            iterator& operator/=(const size_type& amount) noexcept
+                bit_matrix augmented(m_rows - removed.size(), columns.size() + 1);
+                for (size_type i = 0, row = 0; i < m_rows; ++i)
+                {
+                    if (!active[i])
+                        continue;
+                    for (size_type col = (*this)[i].find_first(); col < m_cols; col = (*this)[i].find_next(col + 1))
+                        augmented.set(row, weight[col]);
+                    augmented.set(row++, columns.size(), b.test(i));
+                }
+                if (!augmented._solve_augmented(x, columns.data()))
+                    return std::nullopt;
+            }
+            else
             {
-                this->m_index /= amount;
-                return *this;
+                bit_matrix augmented(m_rows, m_cols + 1);
+                for (size_type i = 0; i < m_rows; ++i)
+                {
+                    std::copy(m_data + i * m_stride, m_data + (i + 1) * m_stride, augmented.m_data + i * augmented.m_stride);
+                    augmented.set(i, m_cols, b.test(i));
+                }
+                if (!augmented._solve_augmented(x, nullptr))
+                    return std::nullopt;
             }
 
-            /**
-             * Inequality operator
-             * @param other Other iterator instance to compare with
-             * @return true if the iterators are not equal, false otherwise
-             */
-            [[nodiscard]] bool operator!=(const iterator& other) const noexcept
+            // Back-substitution of the removed rows, each one only depends on columns determined after it
+            for (size_type i = removed.size(); i-- > 0;)
             {
-                return this->m_index != other.m_index;
+                const auto [row, col] = removed[i];
+                size_type parity = b.test(row);
+                for (size_type j = 0; j < x.storage_size(); ++j)
+                    parity += static_cast<size_type>(detail::popcount(static_cast<BlockType>(m_data[row * m_stride + j] & x.get_block(j))));
+                x.set(col, parity & 1);
             }
+            return x;
+        }
 
-            /**
-             *  Less than operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is less than the other iterator, false otherwise
-             */
-            [[nodiscard]] bool operator<(const iterator& other) const noexcept
+    private:
+        /**
+         * Reduces an augmented system [A | b] and reads its solution off the pivot rows
+         * @param x Solution receiving the pivot variables
+         * @param columns Columns of x of the columns of A (nullptr when they are the same)
+         * @return false if the system is inconsistent, true otherwise
+         */
+        bool _solve_augmented(dynamic_bitset<BlockType>& x, const size_type* columns) noexcept
+        {
+            const size_type last = m_cols - 1;
+            const size_type rank = row_reduce();
+            for (size_type i = 0; i < rank; ++i)
             {
-                return this->m_index < other.m_index;
+                const size_type pivot = (*this)[i].find_first();
+                if (pivot == last)
+                    return false;
+                x.set(columns ? columns[pivot] : pivot, test(i, last));
             }
+            return true;
+        }
 
-            /**
-             *  Less than or equal operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is less than or equal to the other iterator, false otherwise
-             */
-            [[nodiscard]] bool operator<=(const iterator& other) const noexcept
+        /**
+         * Gaussian elimination, pivots are located with find_next on the remaining rows and rows are added a block at a time
+         * @param reduced true to clear the pivot columns above the pivots too (reduced row echelon form)
+         * @return Rank of the matrix
+         */
+        size_type _eliminate(const bool reduced) noexcept
+        {
+            const size_type storage = (m_cols + m_block_size - 1) / m_block_size;
+
+            size_type rank = 0;
+            for (size_type col = 0; rank < m_rows; ++rank, ++col)
             {
-                return this->m_index <= other.m_index;
+                // Leftmost leading bit among the remaining rows, their columns before col are all reset
+                size_type pivot = m_rows, pivot_col = m_cols;
+                for (size_type row = rank; row < m_rows && pivot_col != col; ++row)
+                {
+                    const size_type lead = (*this)[row].find_next(col);
+                    if (lead < pivot_col)
+                    {
+                        pivot = row;
+                        pivot_col = lead;
+                    }
+                }
+                if (pivot == m_rows)
+                    break;
+                col = pivot_col;
+                swap_rows(rank, pivot);
+
+                // The pivot row is reset before its pivot, so only the blocks from the pivot on are added
+                const size_type first_block = col / m_block_size;
+                const BlockType bit = static_cast<BlockType>(BlockType{ 1 } << col % m_block_size);
+                const BlockType* source = m_data + rank * m_stride;
+                for (size_type row = reduced ? 0 : rank + 1; row < m_rows; ++row)
+                {
+                    BlockType* target = m_data + row * m_stride;
+                    if (row == rank || !(target[first_block] & bit))
+                        continue;
+                    for (size_type i = first_block; i < storage; ++i)
+                        target[i] ^= source[i];
+                }
             }
+            return rank;
+        }
 
-            /**
-             *  Equality operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the iterators are equal, false otherwise
-             */
-            [[nodiscard]] bool operator==(const iterator& other) const noexcept
+        /**
+         * Structured Gaussian pre-pass, takes columns with a single nonzero among the active rows as pivots
+         * Removing the row of such a pivot may leave further columns with a single nonzero, which are taken in turn.
+         * @param removed Receives the (row, column) pivots in removal order
+         * @param active Active rows, the rows of the pivots are deactivated
+         * @param weight Receives the count of nonzeros of every column among the rows left active
+         */
+        void _singleton_pivots(std::vector<std::pair<size_type, size_type>>& removed, std::vector<bool>& active, std::vector<size_type>& weight) const noexcept
+        {
+            // Weight of every column and the XOR of the indices of the active rows containing it, which is the row itself at weight one
+            std::vector<size_type> rows(m_cols);
+            weight.assign(m_cols, 0);
+            for (size_type row = 0; row < m_rows; ++row)
             {
-                return this->m_index == other.m_index;
+                for (size_type col = (*this)[row].find_first(); col < m_cols; col = (*this)[row].find_next(col + 1))
+                {
+                    ++weight[col];
+                    rows[col] ^= row;
+                }
             }
 
-            /**
-             *  Bigger than or equal operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is bigger than or equal to the other iterator, false otherwise
-             */
-            [[nodiscard]] bool operator>=(const iterator& other) const noexcept
+            std::vector<size_type> singletons;
+            for (size_type col = 0; col < m_cols; ++col)
             {
-                return this->m_index >= other.m_index;
+                if (weight[col] == 1)
+                    singletons.push_back(col);
             }
-
-            /**
-             *  Bigger than operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is bigger than the other iterator, false otherwise
-             */
-            [[nodiscard]] bool operator>(const iterator& other) const noexcept
+            while (!singletons.empty())
             {
-                return this->m_index > other.m_index;
+                const size_type pivot = singletons.back();
+                singletons.pop_back();
+                if (weight[pivot] != 1)
+                    continue;
+
+                const size_type row = rows[pivot];
+                removed.emplace_back(row, pivot);
+                active[row] = false;
+                for (size_type col = (*this)[row].find_first(); col < m_cols; col = (*this)[row].find_next(col + 1))
+                {
+                    rows[col] ^= row;
+                    if (--weight[col] == 1)
+                        singletons.push_back(col);
+                }
             }
-        };
+        }
 
         /**
-         * Const iterator class
+         * Accumulates this * other into result with the Method of Four Russians
+         * For every pass over 64 columns of this, eight tables hold all sums of 8 rows of other, so every row of
+         * the result takes one table lookup per byte of this instead of one row addition per bit. The columns of
+         * other are processed in tiles, keeping the tables in L2 and the result tile of a row in registers.
+         * @param other Right operand
+         * @param result Zeroed matrix receiving the product
          */
-        class const_iterator : public iterator_base<const dynamic_bitset&>
+        void _multiply(const bit_matrix& other, bit_matrix& result) const noexcept
         {
-        public:
-            using iterator_base<const dynamic_bitset&>::iterator_base;
+            constexpr size_type table_bits = 8;
+            constexpr size_type table_count = 8;
+            constexpr size_type table_size = size_type{ 1 } << table_bits;
+            constexpr size_type tile_blocks = (std::max)(size_type{ 1 }, size_type{ 128 } / sizeof(BlockType));
 
-            /**
-             * Dereference operator (returns the value of the bit at the current bit index)
-             * @return Reference to the bit at the current index
-             */
-            [[nodiscard]] const_reference operator*() const noexcept
-            {
-                return this->m_bitset.test(this->m_index);
-            }
+            std::vector<BlockType> tables(table_count * table_size * tile_blocks);
+            const size_type other_storage = (other.m_cols + m_block_size - 1) / m_block_size;
 
-            /**
-             * Increments the iterator to the next bit, pre-increment
-             */
-            const_iterator& operator++() noexcept
+            for (size_type col = 0; col < other_storage; col += tile_blocks)
             {
-                ++this->m_index;
-                return *this;
-            }
+                const size_type width = (std::min)(tile_blocks, other_storage - col);
+                for (size_type pass = 0; pass < m_cols; pass += table_bits * table_count)
+                {
+                    const size_type used = (std::min)(table_count, (m_cols - pass + table_bits - 1) / table_bits);
 
-            /**
-             * Increments the iterator to the next bit, post-increment
-             */
-            const_iterator& operator++(int) noexcept
-            {
-                const_iterator tmp = *this;
-                ++this->m_index;
-                return tmp;
-            }
+                    // Entry i is entry i without its lowest set bit plus the row of that bit
+                    for (size_type t = 0; t < used; ++t)
+                    {
+                        BlockType* table = tables.data() + t * table_size * tile_blocks;
+                        const size_type first = pass + t * table_bits;
+                        const size_type entries = size_type{ 1 } << (std::min)(table_bits, m_cols - first);
+                        std::fill(table, table + width, BlockType{ 0 });
+                        for (size_type entry = 1; entry < entries; ++entry)
+                        {
+                            const BlockType* previous = table + (entry & (entry - 1)) * tile_blocks;
+                            const BlockType* source = other.m_data + (first + detail::countr_zero(entry)) * other.m_stride + col;
+                            BlockType* target = table + entry * tile_blocks;
+                            for (size_type j = 0; j < width; ++j)
+                                target[j] = previous[j] ^ source[j];
+                        }
+                    }
 
-            /**
-             * Decrements the iterator to the previous bit, pre-decrement
-             */
-            const_iterator& operator--() noexcept
-            {
-                --this->m_index;
-                return *this;
+                    // Bits past m_cols are reset, so the indices of a partial table stay in range
+                    for (size_type row = 0; row < m_rows; ++row)
+                    {
+                        const BlockType* lhs = m_data + row * m_stride;
+                        BlockType* target = result.m_data + row * result.m_stride + col;
+                        BlockType accumulator[tile_blocks];
+                        std::copy(target, target + width, accumulator);
+                        for (size_type t = 0; t < used; ++t)
+                        {
+                            const size_type first = pass + t * table_bits;
+                            const size_type index = static_cast<size_type>(lhs[first / m_block_size] >> first % m_block_size) & (table_size - 1);
+                            const BlockType* entry = tables.data() + (t * table_size + index) * tile_blocks;
+                            for (size_type j = 0; j < width; ++j)
+                                accumulator[j] ^= entry[j];
+                        }
+                        std::copy(accumulator, accumulator + width, target);
+                    }
+                }
             }
+        }
 
-            /**
-             * Decrements the iterator to the previous bit, post-decrement
-             */
-            const_iterator& operator--(int) noexcept
-            {
-                const_iterator tmp = *this;
-                --this->m_index;
-                return tmp;
-            }
+        /**
+         * Computes the row stride, rounding every row up to the row alignment
+         * @param cols Count of columns
+         * @return Row stride (block count)
+         */
+        [[nodiscard]] static size_type _stride(const size_type& cols) noexcept
+        {
+            constexpr size_type blocks_per_line = (std::max)(size_type{ 1 }, m_row_alignment / sizeof(BlockType));
+            return ((cols + m_block_size - 1) / m_block_size + blocks_per_line - 1) / blocks_per_line * blocks_per_line;
+        }
 
-            /**
-             * Returns the iterator with the specified amount added to it
-             * @param amount Amount to add to the iterator (bit count)
-             * @return New iterator instance with the specified amount added to it
-             */
-            [[nodiscard]] const_iterator operator+(const size_type& amount) const noexcept
-            {
-                return const_iterator(this->m_bitset, this->m_index + amount);
-            }
+        /**
+         * Allocates blocks aligned to the row alignment
+         * @param count Count of blocks
+         * @return Pointer to the uninitialized blocks
+         */
+        [[nodiscard]] static BlockType* _allocate(const size_type& count) noexcept
+        {
+            return static_cast<BlockType*>(::operator new[](count * sizeof(BlockType), std::align_val_t{ m_row_alignment }));
+        }
 
-            /**
-             * Returns the iterator with the specified amount subtracted from it
-             * @param amount Amount to subtract from the iterator (bit count)
-             * @return New iterator instance with the specified amount subtracted from it
-             */
-            [[nodiscard]] const_iterator operator-(const size_type& amount) const noexcept
-            {
-                return const_iterator(this->m_bitset, this->m_index - amount);
-            }
+        /**
+         * Frees blocks allocated by _allocate
+         * @param data Pointer to the blocks
+         */
+        static void _deallocate(BlockType* data) noexcept
+        {
+            ::operator delete[](data, std::align_val_t{ m_row_alignment });
+        }
 
-            /**
-             * Returns difference between two iterators
-             * @param other Other iterator instance subtract with
-             * @return Difference between two iterators
-             */
-            [[nodiscard]] difference_type operator-(const const_iterator& other) const noexcept
-            {
-                return this->m_index - other.m_index;
-            }
+        /**
+         * Size of a single block in bits
+         */
+        static constexpr size_type m_block_size = sizeof(BlockType) * CHAR_BIT;
 
-            /**
-             * Returns difference between two iterators
-             * @param other Other iterator instance subtract with
-             * @return Difference between two iterators
-             */
-            [[nodiscard]] difference_type operator-(const iterator& other) const noexcept
-            {
-                return this->m_index - other.m_index;
-            }
+        /**
+         * Alignment of every row in bytes
+         */
+        static constexpr size_type m_row_alignment = (std::max)(size_type{ 64 }, alignof(BlockType));
 
-            /**
-             * Returns the iterator multiplied by the specified amount
-             * @param amount Amount to multiply the iterator by (bit count ?)
-             * @return New iterator instance multiplied by the specified amount
-             */
-            [[nodiscard]] const_iterator operator*(const size_type& amount) const noexcept
-            {
-                return const_iterator(this->m_bitset, this->m_index * amount);
-            }
+        /**
+         * Count of rows
+         */
+        size_type m_rows;
 
+        /**
+         * Count of columns
+         */
+        size_type m_cols;
 
-            /**
-             * Returns the iterator divided by the specified amount
-             * @param amount Amount to multiply the iterator by (bit count ?)
-             * @return New iterator instance divided by the specified amount
-             */
-            [[nodiscard]] const_iterator operator/(const size_type& amount) const noexcept
-            {
-                return const_iterator(this->m_bitset, this->m_index / amount);
-            }
+        /**
+         * Distance between the first blocks of consecutive rows (block count)
+         */
+        size_type m_stride;
 
-            /**
-             * Adds the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
-             */
-            const_iterator& operator+=(const size_type& amount) noexcept
-            {
-                this->m_index += amount;
-                return *this;
-            }
+        /**
+         * Row-major array of blocks containing the elements
+         */
+        BlockType* m_data;
+    };
 
-            /**
-             * Subtracts the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
-             */
-            const_iterator& operator-=(const size_type& amount) noexcept
-            {
-                this->m_index -= amount;
-                return *this;
-            }
+    /**
+     * Split-block Bloom filter, all probes of a key fall into one 64-byte block so a query costs one cache miss
+     * Every block is one 512-bit row of a bit_matrix, which aligns it to its own cache line. The eight probes set
+     * one bit in each word of the block.
+     */
+    class blocked_bloom_filter
+    {
+    public:
+        // Type definitions
+        typedef std::size_t size_type;
 
-            /**
-             * Adds the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
-             */
-            const_iterator& operator*=(const size_type& amount) noexcept
-            {
-                this->m_index *= amount;
-                return *this;
-            }
+        /**
+         * Default constructor, constructs a filter of a single block
+         */
+        blocked_bloom_filter() noexcept : blocked_bloom_filter(m_block_bits) {}
 
-            /**
-             * Subtracts the specified amount to the iterator
-             * @param amount Amount to add to the iterator (bit count)
-             */
-            const_iterator& operator/=(const size_type& amount) noexcept
-            {
-                this->m_index /= amount;
-                return *this;
-            }
+        /**
+         * Size constructor, constructs an empty filter
+         * @param bits Minimal size of the filter (bit count, rounded up to whole blocks)
+         */
+        explicit blocked_bloom_filter(const size_type& bits) noexcept : m_blocks((std::max)(size_type{ 1 }, (bits + m_block_bits - 1) / m_block_bits), m_block_bits) {}
 
-            /**
-             * Inequality operator
-             * @param other Other iterator instance to compare with
-             * @return true if the iterators are not equal, false otherwise
-             */
-            [[nodiscard]] bool operator!=(const const_iterator& other) const noexcept
-            {
-                return this->m_index != other.m_index;
-            }
+        /**
+         * Constructs an empty filter sized for the expected count of keys
+         * @param keys Expected count of keys
+         * @param bits_per_key Bits of the filter per key (around 10 gives a false positive rate below 1%)
+         * @return New filter instance
+         */
+        [[nodiscard]] static blocked_bloom_filter for_keys(const size_type& keys, const size_type& bits_per_key = 10) noexcept
+        {
+            return blocked_bloom_filter(keys * bits_per_key);
+        }
 
-            /**
-             *  Less than operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is less than the other iterator, false otherwise
-             */
-            [[nodiscard]] bool operator<(const const_iterator& other) const noexcept
-            {
-                return this->m_index < other.m_index;
-            }
+        /**
+         * Returns the size of the filter
+         * @return Size of the filter (bit count)
+         */
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return m_blocks.rows() * m_block_bits;
+        }
 
-            /**
-             *  Less than or equal operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is less than or equal to the other iterator, false otherwise
-             */
-            [[nodiscard]] bool operator<=(const const_iterator& other) const noexcept
-            {
-                return this->m_index <= other.m_index;
-            }
+        /**
+         * Returns the count of 64-byte blocks
+         * @return Count of blocks
+         */
+        [[nodiscard]] size_type block_count() const noexcept
+        {
+            return m_blocks.rows();
+        }
 
-            /**
-             *  Equality operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the iterators are equal, false otherwise
-             */
-            [[nodiscard]] bool operator==(const const_iterator& other) const noexcept
-            {
-                return this->m_index == other.m_index;
-            }
+        /**
+         * Counts the set bits, to estimate the fill of the filter
+         * @return The number of set bits
+         */
+        [[nodiscard]] size_type count() const noexcept
+        {
+            size_type result = 0;
+            for (size_type i = 0; i < m_blocks.rows(); ++i)
+                result += m_blocks[i].count();
+            return result;
+        }
 
-            /**
-             *  Bigger than or equal operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is bigger than or equal to the other iterator, false otherwise
-             */
-            [[nodiscard]] bool operator>=(const const_iterator& other) const noexcept
-            {
-                return this->m_index >= other.m_index;
-            }
+        /**
+         * Removes all keys
+         */
+        void clear() noexcept
+        {
+            for (size_type i = 0; i < m_blocks.rows(); ++i)
+                m_blocks[i].reset();
+        }
 
-            /**
-             *  Bigger than operator
-             *  @param other Other iterator instance to compare with
-             *  @return true if the current iterator is bigger than the other iterator, false otherwise
-             */
-            [[nodiscard]] bool operator>(const const_iterator& other) const noexcept
-            {
-                return this->m_index > other.m_index;
-            }
-        };
+        /**
+         * Adds the keys of another filter of the same size
+         * @param other Other filter to merge
+         */
+        blocked_bloom_filter& operator|=(const blocked_bloom_filter& other) noexcept
+        {
+            for (size_type i = 0; i < m_blocks.rows(); ++i)
+                m_blocks[i] |= other.m_blocks[i];
+            return *this;
+        }
 
         /**
-         * Reverse iterator class
+         * Adds a key
+         * @param hash 64-bit hash of the key
          */
-        class reverse_iterator : public iterator_base<dynamic_bitset&>
+        void insert(const std::uint64_t hash) noexcept
         {
-        public:
-            using iterator_base<dynamic_bitset&>::iterator_base;
+            const std::uint64_t mixed = _mix(hash);
+            detail::bloom_insert(m_blocks[_block(mixed)].data(), static_cast<std::uint32_t>(mixed));
+        }
 
-            /**
-             * Conversion constructor to const_reverse_iterator
-             * @param other Other const_reverse_iterator instance to convert from
-             */
-            reverse_iterator(const const_reverse_iterator& other) noexcept : iterator_base<dynamic_bitset&>(other.m_bitset, other.m_index) {}
+        /**
+         * Checks if a key may have been added
+         * @param hash 64-bit hash of the key
+         * @return false if the key was not added, true if it probably was
+         */
+        [[nodiscard]] bool contains(const std::uint64_t hash) const noexcept
+        {
+            const std::uint64_t mixed = _mix(hash);
+            return detail::bloom_contains(m_blocks[_block(mixed)].data(), static_cast<std::uint32_t>(mixed));
+        }
 
-            /**
-             * Conversion assign operator to const_reverse_iterator
-             * @param other Other const_reverse_iterator instance to convert from
-             */
-            reverse_iterator& operator=(const const_reverse_iterator& other) noexcept
+        /**
+         * Adds keys in batches, all hashes of a batch are computed and their blocks prefetched before any of them is touched
+         * @tparam Keys Type of the contiguous range of keys
+         * @tparam Hash Type of the hasher
+         * @param keys Keys to add
+         * @param hasher Hash function object applied to every key
+         */
+        template <std::ranges::contiguous_range Keys, typename Hash = std::hash<std::ranges::range_value_t<Keys>>>
+        void insert_many(const Keys& keys, const Hash& hasher = Hash{}) noexcept
+        {
+            const auto* const data = std::ranges::data(keys);
+            const size_type size = std::ranges::size(keys);
+            std::uint64_t hashes[m_batch_size];
+            std::uint64_t* blocks[m_batch_size];
+            for (size_type first = 0; first < size; first += m_batch_size)
             {
-                this->m_bitset = other.m_bitset;
-                this->m_index = other.m_index;
-                return *this;
+                const size_type count = (std::min)(size - first, m_batch_size);
+                for (size_type i = 0; i < count; ++i)
+                {
+                    hashes[i] = _mix(static_cast<std::uint64_t>(hasher(data[first + i])));
+                    blocks[i] = m_blocks[_block(hashes[i])].data();
+                    detail::prefetch(blocks[i]);
+                }
+                for (size_type i = 0; i < count; ++i)
+                    detail::bloom_insert(blocks[i], static_cast<std::uint32_t>(hashes[i]));
             }
+        }
 
-            /**
-             * Dereference operator (returns the value of the bit at the current bit index)
-             * @return Reference to the bit at the current index
-             */
-            [[nodiscard]] reference operator*() noexcept
+        /**
+         * Checks keys in batches, all hashes of a batch are computed and their blocks prefetched before any of them is probed
+         * @tparam Keys Type of the contiguous range of keys
+         * @tparam Hash Type of the hasher
+         * @param keys Keys to check
+         * @param results Receives the result of every key (may be nullptr to only count)
+         * @param hasher Hash function object applied to every key
+         * @return Count of keys that may have been added
+         */
+        template <std::ranges::contiguous_range Keys, typename Hash = std::hash<std::ranges::range_value_t<Keys>>>
+        size_type contains_many(const Keys& keys, bool* results = nullptr, const Hash& hasher = Hash{}) const noexcept
+        {
+            const auto* const data = std::ranges::data(keys);
+            const size_type size = std::ranges::size(keys);
+            std::uint64_t hashes[m_batch_size];
+            const std::uint64_t* blocks[m_batch_size];
+            size_type found = 0;
+            for (size_type first = 0; first < size; first += m_batch_size)
             {
-                return reference(this->m_bitset, this->m_index);
+                const size_type count = (std::min)(size - first, m_batch_size);
+                for (size_type i = 0; i < count; ++i)
+                {
+                    hashes[i] = _mix(static_cast<std::uint64_t>(hasher(data[first + i])));
+                    blocks[i] = m_blocks[_block(hashes[i])].data();
+                    detail::prefetch(blocks[i]);
+                }
+                for (size_type i = 0; i < count; ++i)
+                {
+                    const bool contained = detail::bloom_contains(blocks[i], static_cast<std::uint32_t>(hashes[i]));
+                    found += contained;
+                    if (results)
+                        results[first + i] = contained;
+                }
             }
+            return found;
+        }
+
+    private:
+        /**
+         * Remixes a hash, so identity hashes of integers still spread over all blocks and probes
+         * @param hash Hash to remix
+         * @return Remixed hash
+         */
+        [[nodiscard]] static std::uint64_t _mix(const std::uint64_t hash) noexcept
+        {
+            return detail::hash_multiply_fold(hash ^ detail::hash_secret[0], detail::hash_secret[1]);
+        }
 
+        /**
+         * Maps the high half of a hash onto a block (multiply-shift, no division), the low half selects the probes
+         * @param hash Remixed hash
+         * @return Index of the block
+         */
+        [[nodiscard]] size_type _block(const std::uint64_t hash) const noexcept
+        {
+            return static_cast<size_type>((hash >> 32) * m_blocks.rows() >> 32);
+        }
 
-            /**
-             * Increments the reverse_iterator to the next bit
-             */
-            reverse_iterator& operator++() noexcept
-            {
-                --this->m_index;
-                return *this;
-            }
+        /**
+         * Size of a single block in bits (one cache line)
+         */
+        static constexpr size_type m_block_bits = 512;
 
-            /**
-             * Increments the reverse_iterator to the next bit, post-increment
-             */
-            reverse_iterator& operator++(int) noexcept
-            {
-                reverse_iterator tmp = *this;
-                --this->m_index;
-                return tmp;
-            }
+        /**
+         * Count of keys hashed and prefetched ahead of their probes
+         */
+        static constexpr size_type m_batch_size = 16;
 
-            /**
-             * Decrements the reverse_iterator to the previous bit
-             */
-            reverse_iterator& operator--() noexcept
-            {
-                ++this->m_index;
-                return *this;
-            }
+        /**
+         * Blocks of the filter, one per row
+         */
+        bit_matrix<std::uint64_t> m_blocks;
+    };
 
+    /**
+     * Bitset with summary levels for fast searches in huge sparse sets
+     * Level 0 holds the bits, bit i of level k + 1 is set if block i of level k is non-zero. The top level fits in one
+     * block, so find_first/find_next read one block per level and any/none/count are constant time.
+     * @tparam BlockType Type of block to use for bit storage (may be one of unsigned integer types)
+     */
+    template <unsigned_integer BlockType = std::uint64_t>
+    class hierarchical_bitset
+    {
+    public:
+        // Type definitions
+        typedef std::size_t size_type;
+        typedef BlockType block_type;
 
+        /**
+         * Default constructor, constructs an empty bitset
+         */
+        hierarchical_bitset() noexcept : hierarchical_bitset(0) {}
 
-            /**
-             * Decrements the reverse_iterator to the previous bit, post-decrement
-             */
-            reverse_iterator& operator--(int) noexcept
-            {
-                reverse_iterator tmp = *this;
-                ++this->m_index;
-                return tmp;
-            }
+        /**
+         * Size constructor, constructs a bitset with all bits reset
+         * @param size Size of the bitset (bit count)
+         */
+        explicit hierarchical_bitset(const size_type& size) noexcept : m_count(0)
+        {
+            m_levels.emplace_back(size);
+            _build_summaries();
+        }
 
-            /**
-             * Returns the reverse_iterator with the specified amount added to it
-             * @param amount Amount to add to the reverse_iterator (bit count)
-             * @return New reverse_iterator instance with the specified amount added to it
-             */
-            [[nodiscard]] reverse_iterator&& operator+(const size_type& amount) const noexcept
-            {
-                return reverse_iterator(this->m_bitset, this->m_index - amount);
-            }
-            /**
-             * Returns the reverse_iterator with the specified amount subtracted from it
-             * @param amount Amount to subtract from the reverse_iterator (bit count)
-             * @return New reverse_iterator instance with the specified amount subtracted from it
-             */
-            [[nodiscard]] reverse_iterator&& operator-(const size_type& amount) const noexcept
-            {
-                return reverse_iterator(this->m_bitset, this->m_index + amount);
-            }
+        /**
+         * Conversion constructor, builds the summaries of the bits of a dynamic_bitset instance
+         * @param bits Bits to copy
+         */
+        explicit hierarchical_bitset(const dynamic_bitset<BlockType>& bits) noexcept : m_count(0)
+        {
+            m_levels.emplace_back(bits);
+            if (bits.size() % m_block_size)
+                m_levels[0].get_block(bits.size() / m_block_size) &= detail::mask_until<BlockType>(bits.size());
+            m_count = detail::count_blocks(&m_levels[0].get_block(0), m_levels[0].storage_size());
+            _build_summaries();
+        }
 
-            /**
-             * Returns difference between two iterators
-             * @param other Other iterator instance subtract with
-             * @return Difference between two iterators
-             */
-            [[nodiscard]] difference_type operator-(const reverse_iterator& other) const noexcept
-            {
-                return this->m_index + other.m_index;
-            }
+        /**
+         * Returns the size of the bitset
+         * @return Size of the bitset (bit count)
+         */
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return m_levels[0].size();
+        }
 
-            /**
-             * Returns difference between two iterators
-             * @param other Other iterator instance subtract with
-             * @return Difference between two iterators
-             */
-            [[nodiscard]] difference_type operator-(const const_reverse_iterator& other) const noexcept
-            {
-                return this->m_index + other.m_index;
-            }
+        /**
+         * Returns the count of levels, including the bits
+         * @return Count of levels
+         */
+        [[nodiscard]] size_type levels() const noexcept
+        {
+            return m_levels.size();
+        }
 
-            /**
-             * Adds the specified amount to the reverse_iterator
-             * @param amount Amount to add to the reverse_iterator (bit count)
-             */
-            reverse_iterator& operator+=(const size_type& amount) const noexcept
-            {
-                this->m_index -= amount;
-                return *this;
-            }
+        /**
+         * Returns the bits (level 0)
+         * @return Bitset holding the bits, bits past size() are reset
+         */
+        [[nodiscard]] const dynamic_bitset<BlockType>& bits() const noexcept
+        {
+            return m_levels[0];
+        }
 
-            /**
-             * Subtracts the specified amount to the reverse_iterator
-             * @param amount Amount to add to the reverse_iterator (bit count)
-             */
-            reverse_iterator& operator-=(const size_type& amount) const noexcept
-            {
-                this->m_index += amount;
-                return *this;
-            }
+        /**
+         * Returns the value of the bit at the specified index
+         * @param index Index of the bit to retrieve (bit index)
+         * @return Value of the bit at the specified index (bit value)
+         */
+        [[nodiscard]] bool operator[](const size_type& index) const noexcept
+        {
+            return test(index);
+        }
 
-            /**
-             * Inequality operator
-             * @param other Other reverse_iterator instance to compare against
-             * @return True if the instances are not equal, false otherwise
-             */
-            [[nodiscard]] bool operator!=(const reverse_iterator& other) const noexcept
+        /**
+         * Returns the value of the bit at the specified index
+         * @param index Index of the bit to retrieve (bit index)
+         * @return Value of the bit at the specified index (bit value)
+         */
+        [[nodiscard]] bool test(const size_type& index) const noexcept
+        {
+            return m_levels[0].get_block(index / m_block_size) >> index % m_block_size & 1;
+        }
+
+        /**
+         * Sets the bit at the specified index to the specified value
+         * @param index Index of the bit to set (bit index)
+         * @param value Value to set the bit to (bit value)
+         */
+        void set(const size_type& index, const bool value) noexcept
+        {
+            if (value)
+                set(index);
+            else
+                reset(index);
+        }
+
+        /**
+         * Sets the bit at the specified index, marking its blocks in the summaries up to the first already non-zero one
+         * @param index Index of the bit to set (bit index)
+         */
+        void set(size_type index) noexcept
+        {
+            for (size_type level = 0; level < m_levels.size(); ++level, index /= m_block_size)
             {
-                return this->m_index != other.m_index;
-            }
+                BlockType& block = m_levels[level].get_block(index / m_block_size);
+                const BlockType before = block;
+                block |= static_cast<BlockType>(BlockType{ 1 } << index % m_block_size);
+                if (!level)
+                    m_count += block != before;
 
-            /**
-             *  Less than operator
-             *  @param other Other reverse_iterator instance to compare against
-             *  @return True if the current instance is less than the other instance, false otherwise
-             */
-            [[nodiscard]] bool operator<(const reverse_iterator& other) const noexcept
-            {
-                return this->m_index > other.m_index;
+                // The summaries already mark a block that was non-zero
+                if (before)
+                    return;
             }
+        }
 
-            /**
-             *  Less than or equal operator
-             *  @param other Other reverse_iterator instance to compare against
-             *  @return True if the current instance is less than or equal to the other instance, false otherwise
-             */
-            [[nodiscard]] bool operator<=(const reverse_iterator& other) const noexcept
+        /**
+         * Resets the bit at the specified index, clearing its blocks in the summaries up to the first one left non-zero
+         * @param index Index of the bit to reset (bit index)
+         */
+        void reset(size_type index) noexcept
+        {
+            for (size_type level = 0; level < m_levels.size(); ++level, index /= m_block_size)
             {
-                return this->m_index >= other.m_index;
-            }
+                BlockType& block = m_levels[level].get_block(index / m_block_size);
+                const BlockType before = block;
+                block &= static_cast<BlockType>(~(BlockType{ 1 } << index % m_block_size));
+                if (!level)
+                    m_count -= block != before;
 
-            /**
-             *  Equality operator
-             *  @param other Other reverse_iterator instance to compare against
-             *  @return True if the instances are equal, false otherwise
-             */
-            [[nodiscard]] bool operator==(const reverse_iterator& other) const noexcept
-            {
-                return this->m_index == other.m_index;
+                // Only a block that has just become empty clears its bit in the summary above
+                if (block || !before)
+                    return;
             }
+        }
 
-            /**
-             *  Bigger than or equal operator
-             *  @param other Other reverse_iterator instance to compare against
-             *  @return True if the current instance is bigger than or equal to the other instance, false otherwise
-             */
-            [[nodiscard]] bool operator>=(const reverse_iterator& other) const noexcept
-            {
-                return this->m_index >= other.m_index;
-            }
+        /**
+         * Flips the bit at the specified index
+         * @param index Index of the bit to flip (bit index)
+         */
+        void flip(const size_type& index) noexcept
+        {
+            set(index, !test(index));
+        }
 
-            /**
-             *  Bigger than operator
-             *  @param other Other reverse_iterator instance to compare against
-             *  @return True if the current instance is bigger than the other instance, false otherwise
-             */
-            [[nodiscard]] bool operator>(const reverse_iterator& other) const noexcept
-            {
-                return this->m_index < other.m_index;
-            }
-        };
+        /**
+         * Resets all bits
+         */
+        void reset() noexcept
+        {
+            for (dynamic_bitset<BlockType>& level : m_levels)
+                level.reset();
+            m_count = 0;
+        }
 
         /**
-         * Reverse iterator class
+         * Checks if any bit is set
+         * @return true if any bit is set, false otherwise
          */
-        class const_reverse_iterator : public iterator_base<const dynamic_bitset&>
+        [[nodiscard]] bool any() const noexcept
         {
-        public:
-            using iterator_base<const dynamic_bitset&>::iterator_base;
+            return m_count != 0;
+        }
 
-            /**
-             * Dereference operator (returns the value of the bit at the current bit index)
-             * @return Value of the bit at the current index (bit value)
-             */
-            [[nodiscard]] const_reference operator*() const noexcept
-            {
-                return this->m_bitset.test(this->m_index);
-            }
+        /**
+         * Checks if none of the bits are set
+         * @return true if none of the bits are set, false otherwise
+         */
+        [[nodiscard]] bool none() const noexcept
+        {
+            return m_count == 0;
+        }
 
+        /**
+         * Counts the set bits
+         * @return The number of set bits
+         */
+        [[nodiscard]] size_type count() const noexcept
+        {
+            return m_count;
+        }
 
-            /**
-             * Increments the reverse_iterator to the next bit
-             */
-            const_reverse_iterator& operator++() noexcept
-            {
-                --this->m_index;
-                return *this;
-            }
+        /**
+         * Finds the first set bit
+         * @return Index of the first set bit, size() if there is none
+         */
+        [[nodiscard]] size_type find_first() const noexcept
+        {
+            return find_next(0);
+        }
 
-            /**
-             * Increments the reverse_iterator to the next bit, post-increment
-             */
-            const_reverse_iterator& operator++(int) noexcept
-            {
-                const_reverse_iterator tmp = *this;
-                --this->m_index;
-                return tmp;
-            }
+        /**
+         * Finds the first set bit at or after the specified position
+         * Climbs while the rest of the current block is empty, then descends through the lowest set bits.
+         * @param pos Position to start the search at (bit index)
+         * @return Index of the found bit, size() if there is none
+         */
+        [[nodiscard]] size_type find_next(const size_type& pos) const noexcept
+        {
+            if (pos >= size())
+                return size();
 
-            /**
-             * Decrements the reverse_iterator to the previous bit
-             */
-            const_reverse_iterator& operator--() noexcept
+            size_type index = pos, level = 0;
+            for (;; ++level)
             {
-                ++this->m_index;
-                return *this;
-            }
+                const size_type block = index / m_block_size;
+                const BlockType bits = static_cast<BlockType>(m_levels[level].get_block(block) & detail::mask_from<BlockType>(index));
+                if (bits)
+                {
+                    index = block * m_block_size + static_cast<size_type>(detail::countr_zero(bits));
+                    break;
+                }
 
-            /**
-             * Decrements the reverse_iterator to the previous bit, post-decrement
-             */
-            const_reverse_iterator& operator--(int) noexcept
-            {
-                const_reverse_iterator tmp = *this;
-                ++this->m_index;
-                return tmp;
+                // Continue with the next block, which is the next bit of the level above
+                index = block + 1;
+                if (level + 1 == m_levels.size() || index >= m_levels[level + 1].size())
+                    return size();
             }
+            while (level--)
+                index = index * m_block_size + static_cast<size_type>(detail::countr_zero(m_levels[level].get_block(index)));
+            return index;
+        }
 
-            /**
-             * Returns the reverse_iterator with the specified amount added to it
-             * @param amount Amount to add to the reverse_iterator (bit count)
-             * @return New reverse_iterator instance with the specified amount added to it
-             */
-            [[nodiscard]] const_reverse_iterator&& operator+(const size_type& amount) const noexcept
-            {
-                return const_reverse_iterator(this->m_index, this->m_index - amount);
-            }
-            /**
-             * Returns the reverse_iterator with the specified amount subtracted from it
-             * @param amount Amount to subtract from the reverse_iterator (bit count)
-             * @return New reverse_iterator instance with the specified amount subtracted from it
-             */
-            [[nodiscard]] const_reverse_iterator&& operator-(const size_type& amount) const noexcept
+    private:
+        /**
+         * Appends the summary levels of the bits, until a level fits in a single block
+         */
+        void _build_summaries() noexcept
+        {
+            while (m_levels.back().size() > m_block_size)
             {
-                return const_reverse_iterator(this->m_index, this->m_index + amount);
+                const dynamic_bitset<BlockType>& below = m_levels.back();
+                dynamic_bitset<BlockType> summary(below.storage_size());
+                for (size_type i = 0; i < below.storage_size(); ++i)
+                {
+                    if (below.get_block(i))
+                        summary.get_block(i / m_block_size) |= static_cast<BlockType>(BlockType{ 1 } << i % m_block_size);
+                }
+                m_levels.push_back(std::move(summary));
             }
+        }
 
-            /**
-             * Returns difference between two iterators
-             * @param other Other iterator instance subtract with
-             * @return Difference between two iterators
-             */
-            [[nodiscard]] difference_type operator-(const const_reverse_iterator& other) const noexcept
-            {
-                return this->m_index - other.m_index;
-            }
+        /**
+         * Size of a single block in bits
+         */
+        static constexpr size_type m_block_size = sizeof(BlockType) * CHAR_BIT;
 
-            /**
-             * Returns difference between two iterators
-             * @param other Other iterator instance subtract with
-             * @return Difference between two iterators
-             */
-            [[nodiscard]] difference_type operator-(const reverse_iterator& other) const noexcept
-            {
-                return this->m_index - other.m_index;
-            }
+        /**
+         * Levels from the bits (level 0) to the single-block top summary
+         */
+        std::vector<dynamic_bitset<BlockType>> m_levels;
 
-            /**
-             * Adds the specified amount to the reverse_iterator
-             * @param amount Amount to add to the reverse_iterator (bit count)
-             */
-            const_reverse_iterator& operator+=(const size_type& amount) noexcept
-            {
-                this->m_index -= amount;
-                return *this;
-            }
+        /**
+         * Count of set bits
+         */
+        size_type m_count;
+    };
 
-            /**
-             * Subtracts the specified amount to the reverse_iterator
-             * @param amount Amount to add to the reverse_iterator (bit count)
-             */
-            const_reverse_iterator& operator-=(const size_type& amount) noexcept
-            {
-                this->m_index += amount;
-                return *this;
-            }
+    /**
+     * Bitset switching between a sorted index array and a dynamic_bitset depending on its density
+     * Sparse sets store their indices (count * sizeof(size_type) bytes), dense sets the bits (size / 8 bytes). The
+     * set switches to the bits once the indices would take more memory and back once they would take less than half,
+     * so a count oscillating around the threshold does not convert on every change. Operations between two sets
+     * dispatch on both representations: index merges, probes of the indices into the bits, or block operations.
+     * @tparam BlockType Type of block to use for bit storage (may be one of unsigned integer types)
+     */
+    template <unsigned_integer BlockType = std::uint64_t>
+    class adaptive_bitset
+    {
+    public:
+        // Type definitions
+        typedef std::size_t size_type;
+        typedef BlockType block_type;
 
-            /**
-             * Inequality operator
-             * @param other Other const_reverse_iterator instance to compare against
-             * @return true if instances are not equal, false otherwise
-             */
-            [[nodiscard]] bool operator!=(const const_reverse_iterator& other) const noexcept
-            {
-                return this->m_index != other.m_index;
-            }
+        /**
+         * Default constructor, constructs an empty bitset
+         */
+        adaptive_bitset() noexcept : adaptive_bitset(0) {}
 
-            /**
-             *  Less than operator
-             *  @param other Other const_reverse_iterator instance to compare against
-             *  @return true if the current instance is less than the other instance, false otherwise
-             */
-            [[nodiscard]] bool operator<(const const_reverse_iterator& other) const noexcept
-            {
-                return this->m_index > other.m_index;
-            }
+        /**
+         * Size constructor, constructs a sparse bitset with all bits reset
+         * @param size Size of the bitset (bit count)
+         */
+        explicit adaptive_bitset(const size_type& size) noexcept : m_size(size), m_count(0), m_dense(false) {}
 
-            /**
-             *  Less than or equal operator
-             *  @param other Other const_reverse_iterator instance to compare against
-             *  @return true if the current instance is less than or equal to the other instance, false otherwise
-             */
-            [[nodiscard]] bool operator<=(const const_reverse_iterator& other) const noexcept
-            {
-                return this->m_index >= other.m_index;
-            }
+        /**
+         * Conversion constructor, copies the bits of a dynamic_bitset instance into the representation fitting their count
+         * @param bits Bits to copy
+         */
+        explicit adaptive_bitset(const dynamic_bitset<BlockType>& bits) noexcept : m_size(bits.size()), m_count(0), m_dense(true), m_bits(bits)
+        {
+            if (m_size % m_block_size)
+                m_bits.get_block(m_size / m_block_size) &= detail::mask_until<BlockType>(m_size);
+            _recount();
 
-            /**
-             *  Equality operator
-             *  @param other Other const_reverse_iterator instance to compare against
-             *  @return true if instances are equal, false otherwise
-             */
-            [[nodiscard]] bool operator==(const const_reverse_iterator& other) const noexcept
-            {
-                return this->m_index == other.m_index;
-            }
+            // A new set has no history, so it takes the smaller representation rather than keeping the bits down to half the threshold
+            if (m_count <= _dense_threshold())
+                _to_sparse();
+        }
 
-            /**
-             *  Bigger than or equal operator
-             *  @param other Other const_reverse_iterator instance to compare against
-             *  @return true if the current instance is bigger than or equal to the other instance, false otherwise
-             */
-            [[nodiscard]] bool operator>=(const const_reverse_iterator& other) const noexcept
-            {
-                return this->m_index >= other.m_index;
-            }
+        /**
+         * Returns the size of the bitset
+         * @return Size of the bitset (bit count)
+         */
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return m_size;
+        }
 
-            /**
-             *  Bigger than operator
-             *  @param other Other const_reverse_iterator instance to compare against
-             *  @return true if the current instance is bigger than the other instance, false otherwise
-             */
-            [[nodiscard]] bool operator>(const const_reverse_iterator& other) const noexcept
-            {
-                return this->m_index < other.m_index;
-            }
-        };
+        /**
+         * Checks which representation is in use
+         * @return true if the bits are stored in a dynamic_bitset, false if the indices are stored
+         */
+        [[nodiscard]] bool is_dense() const noexcept
+        {
+            return m_dense;
+        }
 
         /**
-         * Empty constructor
+         * Returns the indices of the set bits of a sparse bitset
+         * @return Indices of the set bits in increasing order, empty if the bitset is dense
          */
-        dynamic_bitset() noexcept : m_partial_size(0), m_storage_size(0), m_size(0), m_data(nullptr) {}
+        [[nodiscard]] const std::vector<size_type>& indices() const noexcept
+        {
+            return m_indices;
+        }
 
         /**
-		 * Size constructor
-		 * @param size Size of the bitset to create (bit count)
-		 */
-        explicit dynamic_bitset(const size_type& size) noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+         * Copies the bits into a dynamic_bitset instance
+         * @return Bitset holding the bits
+         */
+        [[nodiscard]] dynamic_bitset<BlockType> to_dynamic_bitset() const noexcept
         {
-            reset();
+            if (m_dense)
+                return m_bits;
+            dynamic_bitset<BlockType> result(m_size);
+            for (const size_type index : m_indices)
+                result.get_block(index / m_block_size) |= static_cast<BlockType>(BlockType{ 1 } << index % m_block_size);
+            return result;
         }
 
         /**
-         * Size and bool value constructor
-         * @tparam U Used to constrain type to bool. [don't use]
-         * @param size Size of the bitset to create (bit count)
-         * @param val Bool value to fill the bitset with (bit value)
+         * Returns the value of the bit at the specified index
+         * @param index Index of the bit to retrieve (bit index)
+         * @return Value of the bit at the specified index (bit value)
          */
-        template <unsigned_integer U = std::remove_cvref_t<BlockType>> requires (!std::is_same_v<bool, U> && !std::is_pointer_v<U> && !std::is_array_v<U>)
-        explicit dynamic_bitset(const size_type& size, const bool val) noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+        [[nodiscard]] bool operator[](const size_type& index) const noexcept
         {
-	        fill(val);
-		}
+            return test(index);
+        }
 
         /**
-         * Size and block value constructor
-         * @param size Size of the bitset to create (bit count)
-         * @param block Block to fill the bitset with (block value)
+         * Returns the value of the bit at the specified index
+         * @param index Index of the bit to retrieve (bit index)
+         * @return Value of the bit at the specified index (bit value)
          */
-        explicit dynamic_bitset(const size_type& size, const BlockType& block) noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+        [[nodiscard]] bool test(const size_type& index) const noexcept
         {
-            fill_block(block);
+            if (m_dense)
+                return m_bits.get_block(index / m_block_size) >> index % m_block_size & 1;
+            return std::binary_search(m_indices.begin(), m_indices.end(), index);
         }
 
         /**
-         * Copy constructor
-         * @param other Other dynamic_bitset instance to copy from
+         * Sets the bit at the specified index to the specified value
+         * @param index Index of the bit to set (bit index)
+         * @param value Value to set the bit to (bit value)
          */
-        dynamic_bitset(const dynamic_bitset& other) noexcept : m_partial_size(other.m_partial_size), m_storage_size(other.m_storage_size), m_size(other.m_size), m_data(new BlockType[other.m_storage_size])
+        void set(const size_type& index, const bool value) noexcept
         {
-            //std::copy(other.m_data, other.m_data + other.m_storage_size, m_data);
-            _from_other(other);
+            if (value)
+                set(index);
+            else
+                reset(index);
         }
 
         /**
-         * Size copy constructor
-         * @param size Size of the bitset to create (bit count)
-		 * @param other Other dynamic_bitset instance to copy from
+         * Sets the bit at the specified index
+         * @param index Index of the bit to set (bit index)
          */
-    	dynamic_bitset(const size_type& size, const dynamic_bitset& other) noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+        void set(const size_type& index) noexcept
         {
-            //::memset(m_data, 0, m_storage_size * sizeof(BlockType));;
-            //std::copy(other.m_data, other.m_data + (std::min)(m_storage_size, other.m_storage_size), m_data);
-            _from_other(other);
+            if (m_dense)
+            {
+                BlockType& block = m_bits.get_block(index / m_block_size);
+                const BlockType before = block;
+                block |= static_cast<BlockType>(BlockType{ 1 } << index % m_block_size);
+                m_count += block != before;
+                return;
+            }
+
+            const auto it = std::lower_bound(m_indices.begin(), m_indices.end(), index);
+            if (it != m_indices.end() && *it == index)
+                return;
+            m_indices.insert(it, index);
+            ++m_count;
+            _adapt();
+        }
+
+        /**
+         * Resets the bit at the specified index
+         * @param index Index of the bit to reset (bit index)
+         */
+        void reset(const size_type& index) noexcept
+        {
+            if (!m_dense)
+            {
+                const auto it = std::lower_bound(m_indices.begin(), m_indices.end(), index);
+                if (it != m_indices.end() && *it == index)
+                {
+                    m_indices.erase(it);
+                    --m_count;
+                }
+                return;
+            }
+
+            BlockType& block = m_bits.get_block(index / m_block_size);
+            const BlockType before = block;
+            block &= static_cast<BlockType>(~(BlockType{ 1 } << index % m_block_size));
+            m_count -= block != before;
+            _adapt();
+        }
+
+        /**
+         * Flips the bit at the specified index
+         * @param index Index of the bit to flip (bit index)
+         */
+        void flip(const size_type& index) noexcept
+        {
+            set(index, !test(index));
         }
 
         /**
-         * Move constructfor
-         * @param other Other dynamic_bitset instance to move from
+         * Resets all bits, releasing the storage of the bits
          */
-        dynamic_bitset(dynamic_bitset&& other) noexcept : m_partial_size(other.m_partial_size), m_storage_size(other.m_storage_size), m_size(other.m_size), m_data(other.m_data)
+        void reset() noexcept
         {
-            //other.m_partial_size = other.m_storage_size = other.m_size = other.m_data = 0;
-            _from_other(other);
+            m_indices.clear();
+            m_bits = dynamic_bitset<BlockType>();
+            m_count = 0;
+            m_dense = false;
         }
 
         /**
-         * General conversion constructor
-         * @tparam OtherBlockType Type of the block to copy from
-         * @param other Other bitset instance to copy from
+         * Checks if any bit is set
+         * @return true if any bit is set, false otherwise
          */
-        template <unsigned_integer OtherBlockType> requires (std::convertible_to<OtherBlockType, BlockType> && !std::is_same_v<BlockType, OtherBlockType>)
-    	dynamic_bitset(const dynamic_bitset<OtherBlockType>& other) noexcept : m_partial_size(other.m_size % m_block_size), m_storage_size(static_cast<size_type>(static_cast<double>(sizeof(OtherBlockType) / sizeof(BlockType)) * other.m_storage_size + !!m_partial_size)), m_size(other.m_size), m_data(new BlockType[m_storage_size])
+        [[nodiscard]] bool any() const noexcept
         {
-            reset();
-            _from_other<OtherBlockType>(other);
+            return m_count != 0;
         }
 
         /**
-		 * Size and general conversion constructor
-		 * @tparam OtherBlockType Type of the block to copy from
-		 * @param size Size of bitset to create (bit count)
-		 * @param other Other bitset instance to copy from
-		 */
-        template <unsigned_integer OtherBlockType> requires (std::convertible_to<OtherBlockType, BlockType> && !std::is_same_v<BlockType, OtherBlockType>)
-        explicit dynamic_bitset(const size_type& size, const dynamic_bitset<OtherBlockType>& other) noexcept : m_partial_size(size % m_block_size), m_storage_size(size / sizeof(BlockType) + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+         * Checks if none of the bits are set
+         * @return true if none of the bits are set, false otherwise
+         */
+        [[nodiscard]] bool none() const noexcept
         {
-            reset();
-            _from_other<OtherBlockType>(other);
+            return m_count == 0;
         }
 
         /**
-         * C string stack array conversion constructor
-         * @tparam Elem Type of the character array
-         * @tparam StrSize m_size of the character array
-         * @param c_str Array c string to fill the bitset with (must be null-terminated)
-         * @param set_chr Character that represents set bits
+         * Counts the set bits
+         * @return The number of set bits
          */
-        template <char_type Elem, size_type StrSize>
-        dynamic_bitset(const Elem(&c_str)[StrSize], const Elem& set_chr = '1') noexcept : m_partial_size((StrSize - 1) % m_block_size), m_storage_size((StrSize - 1) / m_block_size + !!m_partial_size), m_size(StrSize - 1), m_data(new BlockType[m_storage_size])
+        [[nodiscard]] size_type count() const noexcept
         {
-            reset();
-            _from_c_string<Elem, StrSize>(c_str, set_chr);
+            return m_count;
         }
 
         /**
-		 * Size and c string array conversion constructor
-		 * @tparam Elem Type of the character array
-		 * @tparam StrSize m_size of the character array
-		 * @param size Size of the bitset to create (bit count)
-		 * @param c_str Array c string to fill the bitset with (must be null-terminated)
-		 * @param set_chr Character that represents set bits
-		 */
-        template <char_type Elem, size_type StrSize>
-        explicit dynamic_bitset(const size_type& size, const Elem(&c_str)[StrSize], const Elem& set_chr = '1') noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+         * Finds the first set bit
+         * @return Index of the first set bit, size() if there is none
+         */
+        [[nodiscard]] size_type find_first() const noexcept
         {
-            reset();
-            _from_c_string<Elem, StrSize>(c_str, set_chr);
+            return find_next(0);
         }
 
         /**
-         * Size and c string pointer conversion constructor
-         * @tparam PtrArr Type of the character array [don't use]
-         * @tparam Elem Type of the character array [don't use]
-         * @param size Size of bitset to create (bit count)
-         * @param c_str Pointer to c string to fill the bitset with (must be null-terminated)
-         * @param set_chr Character that represents set bits
+         * Finds the first set bit at or after the specified position
+         * @param pos Position to start the search at (bit index)
+         * @return Index of the found bit, size() if there is none
          */
-        template <typename PtrArr = const char*, char_type Elem = std::remove_cvref_t<std::remove_pointer_t<std::remove_cvref_t<PtrArr>>>> requires (std::is_pointer_v<PtrArr> && !std::is_array_v<PtrArr>&& char_type<Elem>)
-        explicit dynamic_bitset(const size_type& size, PtrArr c_str, const Elem& set_chr = '1') noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+        [[nodiscard]] size_type find_next(const size_type& pos) const noexcept
         {
-            reset();
-            _from_c_string<PtrArr, Elem>(c_str, set_chr);
+            if (m_dense)
+                return detail::find_next(m_bits.data(), m_size, pos);
+            const auto it = std::lower_bound(m_indices.begin(), m_indices.end(), pos);
+            return it == m_indices.end() ? m_size : *it;
         }
 
         /**
-         * String conversion constructor
-         * @tparam Elem Type of the character array
-         * @param str String to fill the bitset with (must be null-terminated), it's size ought to be >= size(), but nothing will happen if it's not
-         * @param set_chr Character that represents set bits
+         * Checks if any bit is set in both bitsets
+         * @param other Other bitset instance to check (must be the same size)
+         * @return true if the bitsets share a set bit, false otherwise
          */
-        template <char_type Elem>
-        dynamic_bitset(const std::basic_string<Elem>& str, const Elem& set_chr = '1') noexcept : m_partial_size(str.size() % m_block_size), m_storage_size(str.size() / m_block_size + !!m_partial_size), m_size(str.size()), m_data(new BlockType[m_storage_size])
+        [[nodiscard]] bool intersects(const adaptive_bitset& other) const noexcept
         {
-            reset();
-            _from_string(str, set_chr);
+            if (!m_dense && !other.m_dense)
+            {
+                auto lhs = m_indices.begin(), rhs = other.m_indices.begin();
+                while (lhs != m_indices.end() && rhs != other.m_indices.end())
+                {
+                    if (*lhs == *rhs)
+                        return true;
+                    if (*lhs < *rhs)
+                        ++lhs;
+                    else
+                        ++rhs;
+                }
+                return false;
+            }
+            if (!m_dense || !other.m_dense)
+            {
+                const adaptive_bitset& sparse = m_dense ? other : *this;
+                const adaptive_bitset& dense = m_dense ? *this : other;
+                return std::any_of(sparse.m_indices.begin(), sparse.m_indices.end(), [&dense](const size_type index) { return dense.test(index); });
+            }
+            return detail::any_of_blocks(m_bits.data(), other.m_bits.data(), m_bits.storage_size(), [](const BlockType lhs, const BlockType rhs) noexcept { return static_cast<BlockType>(lhs & rhs); });
         }
 
         /**
-		 * Size and string conversion constructor
-		 * @tparam Elem Type of the character array
-		 * @param size Size of bitset to create (bit count)
-		 * @param str String to fill the bitset with (must be null-terminated), it's size ought to be >= size(), but nothing will happen if it's not
-		 * @param set_chr Character that represents set bits
-		 * @param sep_present Whenever character that separates the bit blocks exists
-		 */
-        template <typename Elem>
-        explicit dynamic_bitset(const size_type& size, const std::basic_string<Elem>& str, const Elem& set_chr = '1') noexcept : m_partial_size(size % m_block_size), m_storage_size(size / m_block_size + !!m_partial_size), m_size(size), m_data(new BlockType[m_storage_size])
+         * Equality operator, compares the bits regardless of the representations
+         * @param other Other bitset instance to compare with
+         * @return true if the bitsets have the same size and bits, false otherwise
+         */
+        [[nodiscard]] bool operator==(const adaptive_bitset& other) const noexcept
         {
-            reset();
-            _from_string(str, set_chr);
+            if (m_size != other.m_size || m_count != other.m_count)
+                return false;
+            if (!m_dense && !other.m_dense)
+                return m_indices == other.m_indices;
+            if (!m_dense || !other.m_dense)
+            {
+                // Equal counts, so every index being set in the other bitset is enough
+                const adaptive_bitset& sparse = m_dense ? other : *this;
+                const adaptive_bitset& dense = m_dense ? *this : other;
+                return std::all_of(sparse.m_indices.begin(), sparse.m_indices.end(), [&dense](const size_type index) { return dense.test(index); });
+            }
+            return !detail::any_of_blocks(m_bits.data(), other.m_bits.data(), m_bits.storage_size(), [](const BlockType lhs, const BlockType rhs) noexcept { return static_cast<BlockType>(lhs ^ rhs); });
         }
 
         /**
-		 * Destructor
-		 */
-        ~dynamic_bitset() noexcept
+         * Bitwise AND operator
+         * @param other Other bitset instance to perform the operation with (must be the same size)
+         * @return New bitset instance containing the result of the operation
+         */
+        [[nodiscard]] adaptive_bitset operator&(const adaptive_bitset& other) const noexcept
         {
-            delete[] m_data;
+            adaptive_bitset result(*this);
+            result &= other;
+            return result;
         }
 
         /**
-         * Returns the value of the bit at the specified index
-         * @param index Index of the bit to retrieve (bit index)
-         * @return Value of the bit at the specified index (bit value)
+         * Apply bitwise AND operation with another bitset instance
+         * Sparse operands are merged or probed, only two dense operands are combined block by block.
+         * @param other Other bitset instance to perform the operation with (must be the same size)
          */
-        [[nodiscard]] const_reference operator[](const size_type& index) const noexcept
+        adaptive_bitset& operator&=(const adaptive_bitset& other) noexcept
         {
-            return m_data[index / m_block_size] & BlockType{ 1 } << index % m_block_size;
+            if (!m_dense && !other.m_dense)
+            {
+                // The intersection is never longer than the indices, so it is written over them
+                size_type length = 0;
+                auto rhs = other.m_indices.begin();
+                for (size_type i = 0; i < m_indices.size() && rhs != other.m_indices.end(); ++i)
+                {
+                    rhs = std::lower_bound(rhs, other.m_indices.end(), m_indices[i]);
+                    if (rhs != other.m_indices.end() && *rhs == m_indices[i])
+                        m_indices[length++] = m_indices[i];
+                }
+                m_indices.resize(length);
+                m_count = length;
+            }
+            else if (!m_dense)
+            {
+                std::erase_if(m_indices, [&other](const size_type index) { return !other.test(index); });
+                m_count = m_indices.size();
+            }
+            else if (!other.m_dense)
+            {
+                // The result holds at most the indices of the other bitset, so it is sparse
+                std::vector<size_type> indices;
+                indices.reserve(other.m_indices.size());
+                std::copy_if(other.m_indices.begin(), other.m_indices.end(), std::back_inserter(indices), [this](const size_type index) { return test(index); });
+                _assign_sparse(std::move(indices));
+            }
+            else
+            {
+                m_bits &= other.m_bits;
+                _recount();
+            }
+            _adapt();
+            return *this;
         }
 
         /**
-         * Returns reference to the value of the bit at the specified index
-         * @param index Index of the bit to retrieve (bit index)
-         * @return Reference to the value of the bit at the specified index
+         * Bitwise OR operator
+         * @param other Other bitset instance to perform the operation with (must be the same size)
+         * @return New bitset instance containing the result of the operation
          */
-        [[nodiscard]] reference operator[](const size_type& index) noexcept
+        [[nodiscard]] adaptive_bitset operator|(const adaptive_bitset& other) const noexcept
         {
-            return reference(*this, index);
+            adaptive_bitset result(*this);
+            result |= other;
+            return result;
         }
 
         /**
-         * General copy assignment operator
-         * @tparam OtherBlockType Type of the block to copy from
-         * @param other Other dynamic_bitset instance to copy from
+         * Apply bitwise OR operation with another bitset instance
+         * Sparse operands are merged or set into the bits, only two dense operands are combined block by block.
+         * @param other Other bitset instance to perform the operation with (must be the same size)
          */
-        template <unsigned_integer OtherBlockType> requires (std::convertible_to<OtherBlockType, BlockType> && !std::is_same_v<BlockType, OtherBlockType>)
-        dynamic_bitset& operator=(const dynamic_bitset<OtherBlockType>& other) noexcept
+        adaptive_bitset& operator|=(const adaptive_bitset& other) noexcept
         {
-            if constexpr (sizeof(BlockType) > sizeof(OtherBlockType))
+            if (!m_dense && !other.m_dense)
             {
-                constexpr uint16_t diff = sizeof(BlockType) / sizeof(OtherBlockType);
-
-                if (other.m_storage_size != m_storage_size * diff)
+                std::vector<size_type> indices;
+                indices.reserve(m_indices.size() + other.m_indices.size());
+                std::set_union(m_indices.begin(), m_indices.end(), other.m_indices.begin(), other.m_indices.end(), std::back_inserter(indices));
+                _assign_sparse(std::move(indices));
+            }
+            else if (!other.m_dense)
+            {
+                for (const size_type index : other.m_indices)
+                    set(index);
+            }
+            else
+            {
+                if (!m_dense)
                 {
-                    delete[] m_data;
-                    m_storage_size = (other.m_storage_size + diff - 1) / diff;
-                    m_data = new BlockType[m_storage_size];
+                    std::vector<size_type> indices = std::move(m_indices);
+                    _assign_dense(other.m_bits);
+                    for (const size_type index : indices)
+                        set(index);
                 }
-
-                for (size_type i = 0; i < m_storage_size; ++i)
+                else
                 {
-                	m_data[i] = 0;
-                    for (uint16_t j = 0; j < diff; ++j)
-                    {
-                        if (i * diff + j >= other.m_storage_size)
-                            return *this;
-	                    m_data[i] |= static_cast<BlockType>(other.m_data[i * diff + j]) << j * other.m_block_size; // Accumulate
-                    }
+                    m_bits |= other.m_bits;
+                    _recount();
                 }
             }
-            else
-            {
-                constexpr uint16_t diff = sizeof(OtherBlockType) / sizeof(BlockType);
+            _adapt();
+            return *this;
+        }
 
-                const size_type other_converted_storage_size = other.m_storage_size * diff;
+        /**
+         * Bitwise XOR operator
+         * @param other Other bitset instance to perform the operation with (must be the same size)
+         * @return New bitset instance containing the result of the operation
+         */
+        [[nodiscard]] adaptive_bitset operator^(const adaptive_bitset& other) const noexcept
+        {
+            adaptive_bitset result(*this);
+            result ^= other;
+            return result;
+        }
 
-                if (m_storage_size != other_converted_storage_size)
+        /**
+         * Apply bitwise XOR operation with another bitset instance
+         * Sparse operands are merged or flipped in the bits, only two dense operands are combined block by block.
+         * @param other Other bitset instance to perform the operation with (must be the same size)
+         */
+        adaptive_bitset& operator^=(const adaptive_bitset& other) noexcept
+        {
+            if (!m_dense && !other.m_dense)
+            {
+                std::vector<size_type> indices;
+                indices.reserve(m_indices.size() + other.m_indices.size());
+                std::set_symmetric_difference(m_indices.begin(), m_indices.end(), other.m_indices.begin(), other.m_indices.end(), std::back_inserter(indices));
+                _assign_sparse(std::move(indices));
+            }
+            else if (!other.m_dense)
+            {
+                for (const size_type index : other.m_indices)
+                    _flip_dense(index);
+            }
+            else
+            {
+                if (!m_dense)
                 {
-                    delete[] m_data;
-                	m_storage_size = other_converted_storage_size;
-                    m_data = new BlockType[other_converted_storage_size];
+                    std::vector<size_type> indices = std::move(m_indices);
+                    _assign_dense(other.m_bits);
+                    for (const size_type index : indices)
+                        _flip_dense(index);
                 }
-
-                for (size_type i = 0; i < other.m_storage_size; ++i)
+                else
                 {
-                    for (uint16_t j = 0; j < diff; ++j)
-                    {
-                        if (i * diff + j >= m_storage_size)
-                            return *this;
-	                    m_data[i * diff + j] = other.m_data[i] >> j % diff * m_block_size; // Break down
-                    }
+                    m_bits ^= other.m_bits;
+                    _recount();
                 }
             }
-
+            _adapt();
             return *this;
         }
 
-        // Conversion functions/operators
+    private:
+        /**
+         * Returns the count of set bits above which the indices take more memory than the bits
+         * @return Count of set bits
+         */
+        [[nodiscard]] size_type _dense_threshold() const noexcept
+        {
+            return m_size / (sizeof(size_type) * CHAR_BIT);
+        }
 
         /**
-         * Copy assignment operator
-         * @param other Other dynamic_bitset instance to copy from
+         * Switches the representation when the count has crossed its threshold
          */
-        dynamic_bitset& operator=(const dynamic_bitset& other) noexcept
+        void _adapt() noexcept
         {
-            if (this == &other)
-            {
-                return *this;
-            }
+            if (!m_dense && m_count > _dense_threshold())
+                _to_dense();
+            else if (m_dense && m_count < _dense_threshold() / 2)
+                _to_sparse();
+        }
 
-            if (other.m_storage_size != m_storage_size)
+        /**
+         * Converts the indices into bits, releasing the indices
+         */
+        void _to_dense() noexcept
+        {
+            m_bits = to_dynamic_bitset();
+            std::vector<size_type>().swap(m_indices);
+            m_dense = true;
+        }
+
+        /**
+         * Converts the bits into indices, releasing the bits
+         */
+        void _to_sparse() noexcept
+        {
+            std::vector<size_type> indices;
+            indices.reserve(m_count);
+            for (size_type i = 0; i < m_bits.storage_size(); ++i)
             {
-                delete[] m_data;
-                m_data = new BlockType[other.m_storage_size];
-                m_storage_size = other.m_storage_size;
+                for (BlockType bits = m_bits.get_block(i); bits; bits &= bits - 1)
+                    indices.push_back(i * m_block_size + static_cast<size_type>(detail::countr_zero(bits)));
             }
+            _assign_sparse(std::move(indices));
+        }
 
-        	m_size = other.m_size;
+        /**
+         * Replaces the bits with sorted indices
+         * @param indices Indices of the set bits in increasing order
+         */
+        void _assign_sparse(std::vector<size_type>&& indices) noexcept
+        {
+            m_indices = std::move(indices);
+            m_bits = dynamic_bitset<BlockType>();
+            m_count = m_indices.size();
+            m_dense = false;
+        }
 
-            std::copy(other.m_data, other.m_data + (std::min)(m_storage_size, other.m_storage_size), m_data);
-            
-        	return *this;
+        /**
+         * Replaces the representation with a copy of the bits of another dense bitset
+         * @param bits Bits to copy (bits past the size are reset)
+         */
+        void _assign_dense(const dynamic_bitset<BlockType>& bits) noexcept
+        {
+            m_bits = bits;
+            std::vector<size_type>().swap(m_indices);
+            m_dense = true;
+            _recount();
         }
 
         /**
-		 * Move assignment operator
-		 * @param other Other dynamic_bitset instance to move from
-		 */
-        dynamic_bitset& operator=(dynamic_bitset&& other) noexcept
+         * Flips a bit of a dense bitset, without switching the representation
+         * @param index Index of the bit to flip (bit index)
+         */
+        void _flip_dense(const size_type& index) noexcept
         {
-            if (this != &other)
-            {
-                delete[] m_data;
+            BlockType& block = m_bits.get_block(index / m_block_size);
+            block ^= static_cast<BlockType>(BlockType{ 1 } << index % m_block_size);
+            if (block >> index % m_block_size & 1)
+                ++m_count;
+            else
+                --m_count;
+        }
 
-                m_partial_size = other.m_partial_size;
-                m_storage_size = other.m_storage_size;
-                m_size = other.m_size;
-                m_data = other.m_data;
-            	_from_other(other);
-            }
+        /**
+         * Recounts the set bits of a dense bitset
+         */
+        void _recount() noexcept
+        {
+            m_count = detail::count_blocks(m_bits.data(), m_bits.storage_size());
+        }
+
+        /**
+         * Size of a single block in bits
+         */
+        static constexpr size_type m_block_size = sizeof(BlockType) * CHAR_BIT;
+
+        /**
+         * Size of the bitset (bit count)
+         */
+        size_type m_size;
+
+        /**
+         * Count of set bits
+         */
+        size_type m_count;
+
+        /**
+         * Whether the bits (true) or the indices (false) are stored
+         */
+        bool m_dense;
+
+        /**
+         * Indices of the set bits in increasing order, empty when dense
+         */
+        std::vector<size_type> m_indices;
+
+        /**
+         * Bits, empty when sparse (bits past the size are reset)
+         */
+        dynamic_bitset<BlockType> m_bits;
+    };
+
+    /**
+     * Bitset with copy-on-write chunked storage, for cheap snapshots of large bitsets
+     * The bits live in reference-counted 4 KiB chunks listed in a reference-counted table. A copy shares the table,
+     * the first write after it copies the chunk pointers and every write clones the single chunk it touches if another
+     * copy still shares it. Unwritten chunks of a new bitset all share one
+     * chunk, so memory grows with the written chunks rather than with the size. Copies may be read and written from
+     * different threads, taking a copy must not race with writes to the copied instance.
+     * @tparam BlockType Type of block to use for bit storage (may be one of unsigned integer types)
+     */
+    template <unsigned_integer BlockType = std::uint64_t>
+    class cow_bitset
+    {
+    public:
+        // Type definitions
+        typedef std::size_t size_type;
+        typedef BlockType block_type;
 
-        	return *this;
-        }
+        /**
+         * Size of a single chunk in bits
+         */
+        static constexpr size_type chunk_size = 4096 * CHAR_BIT;
 
         /**
-        * Integer value to bitset conversion operator
-        * @tparam T Type of the integral value to convert from
-        * @param value Value to convert from
-        */
-        template <unsigned_integer T>
-        dynamic_bitset& operator=(const T& value) noexcept
-        {
-            _from_integer<T>(value);
-            return *this;
-        }
+         * Chunk type
+         */
+        typedef bitset<BlockType, chunk_size> chunk_type;
 
-    private:
+        /**
+         * Default constructor, constructs an empty bitset
+         */
+        cow_bitset() noexcept : cow_bitset(0) {}
 
         /**
-         * Copy function
-         * @param other Other dynamic_bitset instance to copy from
+         * Size constructor, constructs a bitset with all bits reset, every chunk sharing one zero chunk
+         * @param size Size of the bitset (bit count)
          */
-        void _from_other(const dynamic_bitset& other) noexcept
-        {
-            if (this != &other)
-                std::copy(other.m_data, other.m_data + (std::min)(m_storage_size, other.m_storage_size), m_data);
-            for (size_type i = other.m_storage_size; i < m_storage_size; ++i)
-                *(m_data + i) = 0;
-        }
+        explicit cow_bitset(const size_type& size) noexcept : m_size(size), m_table(std::make_shared<table_type>((size + chunk_size - 1) / chunk_size, std::make_shared<chunk_type>())) {}
 
         /**
-         * Move function
-         * @param other Other dynamic_bitset instance to move from
+         * Size and bool value constructor
+         * @param size Size of the bitset (bit count)
+         * @param value Value to set the bits to (bit value)
          */
-        static void _from_other(dynamic_bitset&& other) noexcept
+        cow_bitset(const size_type& size, const bool value) noexcept : cow_bitset(size)
         {
-            other.m_partial_size = other.m_partial_size = other.m_size = 0;
-            other.m_data = nullptr;
+            if (value)
+                set();
         }
 
         /**
-         * Conversion function with different block type and size
-         * @tparam OtherBlockType Type of the block to convert from
-         * @param other Other bitset instance to convert from
+         * Conversion constructor, copies the bits of a dynamic_bitset instance into unshared chunks
+         * @param bits Bits to copy
          */
-        template <unsigned_integer OtherBlockType> requires (std::convertible_to<OtherBlockType, BlockType> && !std::is_same_v<BlockType, OtherBlockType>)
-        void _from_other(const dynamic_bitset<OtherBlockType>& other) noexcept
+        explicit cow_bitset(const dynamic_bitset<BlockType>& bits) noexcept : m_size(bits.size()), m_table(std::make_shared<table_type>((bits.size() + chunk_size - 1) / chunk_size))
         {
-            reset();
-            if constexpr (sizeof(BlockType) > sizeof(OtherBlockType))
-            {
-                constexpr uint16_t diff = sizeof(BlockType) / sizeof(OtherBlockType);
-
-                for (size_type i = 0; i < m_storage_size; ++i)
-                {
-                    for (size_type j = 0; j < diff; ++j)
-                    {
-                        if (i * diff + j >= other.m_storage_size)
-                        {
-                            return;
-                        }
-                        *(m_data + i) |= static_cast<BlockType>(other.m_data[i * diff + j]) << j * other.m_block_size;
-                    }
-                }
-            }
-            else
+            for (size_type i = 0; i < m_table->size(); ++i)
             {
-                constexpr uint16_t diff = sizeof(OtherBlockType) / sizeof(BlockType);
-
-                for (size_type i = 0; i < other.m_storage_size; ++i)
-                {
-                    for (uint16_t j = 0; j < diff; ++j)
-                    {
-                        if (i * diff + j >= m_storage_size)
-                        {
-                            return;
-                        }
-                        *(m_data + i * diff + j) = other.m_data[i] >> j % diff * m_block_size;
-                    }
-                }
+                (*m_table)[i] = std::make_shared<chunk_type>();
+                const size_type first = i * m_chunk_blocks;
+                std::copy(bits.data() + first, bits.data() + (std::min)(first + m_chunk_blocks, bits.storage_size()), &(*m_table)[i]->get_block(0));
             }
+            if (m_size % m_block_size)
+                _chunk(m_table->size() - 1).get_block((m_size - 1) % chunk_size / m_block_size) &= detail::mask_until<BlockType>(m_size);
         }
 
         /**
-         * String to bitset conversion function
-         * @tparam Elem Type of the character array
-         * @param str String to convert from (must be null-terminated)
-         * @param set_chr Character that represents set bits
+         * Returns the size of the bitset
+         * @return Size of the bitset (bit count)
          */
-        template <char_type Elem>
-        void _from_string(const std::basic_string<Elem>& str, const Elem& set_chr = '1') noexcept
+        [[nodiscard]] size_type size() const noexcept
         {
-            for (size_type i = 0; i < m_storage_size; ++i)
-            {
-                for (uint16_t j = 0; j < m_block_size; ++j)
-                {
-                    if (i * m_block_size + j >= str.size())
-                    {
-                        return;
-                    }
-                    m_data[i] |= str[i * m_block_size + j] == set_chr ? BlockType{ 1 } << j : 0;
-                }
-            }
+            return m_size;
         }
 
         /**
-         * C string stack array to bitset conversion function
-         * @tparam Elem Type of the character array
-         * @tparam StrSize Size of the character array
-         * @param c_str Array c string to fill the bitset with (must be null-terminated)
-         * @param set_chr Character that represents set bits
+         * Returns the count of chunks
+         * @return Count of chunks
          */
-        template <char_type Elem, size_type StrSize>
-        void _from_c_string(const Elem(&c_str)[StrSize], const Elem& set_chr = '1') noexcept
+        [[nodiscard]] size_type chunk_count() const noexcept
         {
-            for (size_type i = 0; i < m_storage_size; ++i)
-            {
-                for (uint16_t j = 0; j < m_block_size; ++j)
-                {
-                    if (!c_str[i * m_block_size + j])
-                    {
-                        return;
-                    }
-                    m_data[i] |= c_str[i * m_block_size + j] == set_chr ? BlockType{ 1 } << j : 0;
-                }
-            }
+            return m_table->size();
         }
 
         /**
-         * C string pointer array to bitset conversion function
-         * @tparam PtrArr Type of the character array [don't use]
-         * @tparam Elem Type of the character array [don't use]
-         * @param c_str Pointer to c string to fill the bitset with (must be null-terminated)
-         * @param set_chr Character that represents set bits
+         * Returns the chunk at the specified index
+         * @param index Index of the chunk (chunk index)
+         * @return Chunk holding the bits [index * chunk_size, (index + 1) * chunk_size), bits past size() are reset
          */
-        template <typename PtrArr = const char*, char_type Elem = std::remove_cvref_t<std::remove_pointer_t<std::remove_cvref_t<PtrArr>>>> requires (std::is_pointer_v<PtrArr> && !std::is_array_v<PtrArr>)
-        void _from_c_string(PtrArr c_str, const Elem& set_chr = '1') noexcept
+        [[nodiscard]] const chunk_type& get_chunk(const size_type& index) const noexcept
         {
-            for (size_type i = 0; i < m_storage_size; ++i)
-            {
-                for (uint16_t j = 0; j < m_block_size; ++j)
-                {
-                    if (!*c_str)
-                    {
-                        return;
-                    }
-                    m_data[i] |= *c_str++ == set_chr ? BlockType{ 1 } << j : 0;
-                }
-            }
+            return *(*m_table)[index];
         }
 
-    public:
-
         /**
-         * Bitset to C string conversion function
-         * @param set_chr Character to represent set bits
-         * @param rst_chr Character to represent reset bits
-         * @tparam Elem Type of character in the array
-         * @return C string representation of the bitset
+         * Checks if the chunk at the specified index is shared with another bitset
+         * @param index Index of the chunk (chunk index)
+         * @return true if a write to the chunk would clone it, false otherwise
          */
-        template <char_type Elem = char>
-        [[nodiscard]] Elem* to_c_string(const Elem& set_chr = '1', const Elem& rst_chr = '0') const noexcept
+        [[nodiscard]] bool is_shared(const size_type& index) const noexcept
         {
-            Elem* result = new Elem[m_size + 1];
-            for (size_type i = 0; i < m_storage_size - !!m_partial_size; ++i)
-            {
-                for (uint16_t j = 0; j < m_block_size; ++j)
-                    *(result + i * m_block_size + j) = m_data[i] & BlockType{ 1 } << j ? set_chr : rst_chr;
-            }
-            if (m_partial_size)
-            {
-                for (size_type i = 0; i < m_partial_size; ++i)
-                    *(result + (m_storage_size - 1) * m_block_size + i) = m_data[i] & BlockType{ 1 } << i ? set_chr : rst_chr;
-            }
-            *(result + m_size) = '\0';
-            return result;
+            return m_table.use_count() != 1 || (*m_table)[index].use_count() != 1;
         }
 
-    private:
-
         /**
-         * Integer value to bitset conversion function
-         * @tparam T Type of the integral value to convert from
-         * @param value Value to convert from
+         * Returns the block at the specified index
+         * @param index Index of the block (block index)
+         * @return Value of the block
          */
-        template <unsigned_integer T>
-        void _from_integer(const T value) noexcept
+        [[nodiscard]] BlockType get_block(const size_type& index) const noexcept
         {
-            if constexpr (sizeof(T) <= sizeof(BlockType))
-            {
-                if (m_storage_size != 1)
-                {
-                    delete[] m_data;
-                    m_data = new BlockType;
-                	m_storage_size = 1;
-                    m_size = sizeof(T) * CHAR_BIT;
-                }
-                if constexpr (sizeof(T) != sizeof(BlockType))
-                    *m_data = BlockType{ 0 } | value;
-                else
-                    *m_data = value;
-                return;
-            }
-
-            constexpr uint16_t diff = sizeof(T) / sizeof(BlockType);
-
-            if (m_storage_size != diff)
-            {
-                delete[] m_data;
-                m_data = new BlockType[diff];
-                m_storage_size = diff;
-                m_size = sizeof(T) * CHAR_BIT;
-            }
-
-            for (uint16_t i = 0; i < diff; ++i)
-            {
-                m_data[i] = value >> i * m_block_size;
-            }
+            return (*m_table)[index / m_chunk_blocks]->get_block(index % m_chunk_blocks);
         }
 
-    public:
-
         /**
-         * Bitset to integer value conversion function
-         * @tparam T Type of the integral value to convert to
-         * @return Converted integer value.
+         * Copies the bits into a dynamic_bitset instance
+         * @return Bitset holding the bits
          */
-        template <unsigned_integer T>
-        [[nodiscard]] T to_integer() const noexcept
+        [[nodiscard]] dynamic_bitset<BlockType> to_dynamic_bitset() const noexcept
         {
-            if constexpr (sizeof(T) <= sizeof(BlockType))
-                return *m_data;
-
-            constexpr uint16_t diff = sizeof(T) / sizeof(BlockType);
-            T result = 0;
-            for (int16_t i = 0; i < diff; ++i)
-                result |= static_cast<T>(m_data[i]) << i * m_block_size;
-
+            dynamic_bitset<BlockType> result(m_size);
+            for (size_type i = 0; i < m_table->size(); ++i)
+            {
+                const size_type first = i * m_chunk_blocks;
+                const BlockType* chunk = &(*m_table)[i]->get_block(0);
+                std::copy(chunk, chunk + (std::min)(m_chunk_blocks, result.storage_size() - first), result.data() + first);
+            }
             return result;
         }
 
-        // TODO: General comp & bitwise operators
-
-        operator bool() const noexcept
+        /**
+         * Returns the value of the bit at the specified index
+         * @param index Index of the bit to retrieve (bit index)
+         * @return Value of the bit at the specified index (bit value)
+         */
+        [[nodiscard]] bool operator[](const size_type& index) const noexcept
         {
-            return m_size;
+            return test(index);
         }
 
-        // comparison operators
-
         /**
-         * Equality operator
-         * @param other Other bitset instance to compare with
-         * @return True if the two instances are equal, false otherwise
+         * Returns the value of the bit at the specified index
+         * @param index Index of the bit to retrieve (bit index)
+         * @return Value of the bit at the specified index (bit value)
          */
-        [[nodiscard]] bool operator==(const dynamic_bitset& other) const noexcept
+        [[nodiscard]] bool test(const size_type& index) const noexcept
         {
-            if (m_size != other.m_size)
-                return false;
-            for (size_type i = 0; i < m_storage_size - !!m_partial_size; ++i)
-            {
-                if (m_data[i] != other.m_data[i])
-                    return false;
-            }
-            if (m_partial_size)
-            {
-                const BlockType mask = (1 << m_partial_size) - 1;
-                if ((m_data[m_storage_size - 1] & mask) != (other.m_data[m_storage_size - 1] & mask))
-                    return false;
-            }
-            return true;
+            return (*m_table)[index / chunk_size]->test(index % chunk_size);
         }
 
         /**
-         * Inequality operator
-         * @param other Other bitset instance to compare with
-         * @return True if the two instances are not equal, false otherwise
+         * Sets the bit at the specified index to the specified value, cloning its chunk if shared and the bit changes
+         * @param index Index of the bit to set (bit index)
+         * @param value Value to set the bit to (bit value)
          */
-        [[nodiscard]] bool operator!=(const dynamic_bitset& other) const noexcept
+        void set(const size_type& index, const bool value) noexcept
         {
-            if (m_size != other.m_size)
-            for (size_type i = 0; i < m_storage_size - !!m_partial_size; ++i)
-            {
-                if (m_data[i] == other.m_data[i])
-                    return false;
-            }
-            if (m_partial_size)
-            {
-                const BlockType mask = (1 << m_partial_size) - 1;
-                if ((m_data[m_storage_size - 1] & mask) == (other.m_data[m_storage_size - 1] & mask))
-                    return false;
-            }
-            return true;
+            if (test(index) != value)
+                _chunk(index / chunk_size).flip(index % chunk_size);
         }
 
-        // Bitwise operators
-
-    private:
-
-        void _bitwise_and(const dynamic_bitset& other, dynamic_bitset& result) noexcept
+        /**
+         * Sets the bit at the specified index, cloning its chunk if shared and the bit changes
+         * @param index Index of the bit to set (bit index)
+         */
+        void set(const size_type& index) noexcept
         {
-            for (size_type i = 0; i < result.m_storage_size; ++i)
-                result.m_data = this->m_data[i] & other.m_data[i];
+            set(index, true);
         }
 
-    public:
-
         /**
-         * Bitwise AND operator
-         * @param other Other bitset instance to perform the operation with
-         * @return New bitset instance containing the result of the operation
+         * Resets the bit at the specified index, cloning its chunk if shared and the bit changes
+         * @param index Index of the bit to reset (bit index)
          */
-        [[nodiscard]] dynamic_bitset operator&(const dynamic_bitset& other) const noexcept
-        {
-            
-            dynamic_bitset result(m_size);
-            bitwise_and(other, result);
-            /*for (size_type i = 0; i < result.m_storage_size; ++i)
-                result.m_data[i] = m_data[i] & other.m_data[i];
-            return result;*/
-            return result;
+        void reset(const size_type& index) noexcept
+        {
+            set(index, false);
         }
 
         /**
-         * Apply bitwise AND operation with another bitset instance
-         * @param other Other bitset instance to perform the operation with
+         * Flips the bit at the specified index, cloning its chunk if shared
+         * @param index Index of the bit to flip (bit index)
          */
-        dynamic_bitset& operator&=(const dynamic_bitset& other) noexcept
+        void flip(const size_type& index) noexcept
         {
-            /*for (size_type i = 0; i < m_storage_size; ++i)
-                m_data[i] &= other.m_data[i];*/
-            bitwise_and(other, *this);
-            return *this;
+            _chunk(index / chunk_size).flip(index % chunk_size);
         }
 
         /**
-         * Bitwise OR operator
-         * @param other Other bitset instance to perform the operation with
-         * @return New bitset instance containing the result of the operation
+         * Sets all bits, every full chunk sharing one chunk
          */
-        [[nodiscard]] dynamic_bitset operator|(const dynamic_bitset& other) const noexcept
+        void set() noexcept
         {
-            dynamic_bitset result(m_size);
-            for (size_type i = 0; i < result.m_storage_size; ++i)
-                result.m_data[i] = m_data[i] | other.m_data[i];
-            return result;
+            if (!m_size)
+                return;
+
+            chunk_type full;
+            full.set();
+            m_table = std::make_shared<table_type>(m_table->size(), std::make_shared<chunk_type>(full));
+            if (m_size % chunk_size)
+                _chunk(m_table->size() - 1).reset_range(m_size % chunk_size, chunk_size);
         }
 
         /**
-         * Apply bitwise OR operation with another bitset instance
-         * @param other Other bitset instance to perform the operation with
+         * Resets all bits, every chunk sharing one zero chunk
          */
-        dynamic_bitset& operator|=(const dynamic_bitset& other) noexcept
+        void reset() noexcept
         {
-            for (size_type i = 0; i < m_storage_size; ++i)
-                *m_data[i] |= other.m_data[i];
-            return *this;
+            m_table = std::make_shared<table_type>(m_table->size(), std::make_shared<chunk_type>());
         }
 
         /**
-         * Bitwise XOR operator
-         * @param other Other bitset instance to perform the operation with
-         * @return New bitset instance containing the result of the operation
+         * Checks if any bit is set
+         * @return true if any bit is set, false otherwise
          */
-        [[nodiscard]] dynamic_bitset operator^(const dynamic_bitset& other) const noexcept
+        [[nodiscard]] bool any() const noexcept
         {
-            dynamic_bitset result(m_size);
-            for (size_type i = 0; i < result.m_storage_size; ++i)
-                result.m_data[i] = m_data[i] ^ other.m_data[i];
-            return result;
+            return std::any_of(m_table->begin(), m_table->end(), [](const std::shared_ptr<chunk_type>& chunk) { return chunk->any(); });
         }
 
         /**
-         * Apply bitwise XOR operation with another bitset instance
-         * @param other Other bitset instance to perform the operation with
+         * Checks if none of the bits are set
+         * @return true if none of the bits are set, false otherwise
          */
-        dynamic_bitset& operator^=(const dynamic_bitset& other) noexcept
+        [[nodiscard]] bool none() const noexcept
         {
-            for (size_type i = 0; i < m_storage_size; ++i)
-                m_data[i] ^= other.m_data[i];
-            return *this;
+            return !any();
         }
 
         /**
-         * Bitwise NOT operator
-         * @return New bitset instance containing the result of the operation
+         * Counts the set bits
+         * @return The number of set bits
          */
-        [[nodiscard]] dynamic_bitset operator~() const noexcept
+        [[nodiscard]] size_type count() const noexcept
         {
-            dynamic_bitset result(m_size);
-            for (size_type i = 0; i < m_storage_size; ++i)
-                result.m_data[i] = ~m_data[i];
+            size_type result = 0;
+            for (const std::shared_ptr<chunk_type>& chunk : *m_table)
+                result += chunk->count();
             return result;
         }
 
         /**
-		 * Bitwise right shift operator
-		 * @param shift Amount of bits to shift to the right
-		 * @return New bitset instance containing the result of the operation
-		 */
-        [[nodiscard]] constexpr dynamic_bitset operator>>(const size_type& shift) const noexcept
+         * Equality operator, chunks shared by both bitsets are not compared
+         * @param other Other bitset instance to compare with
+         * @return true if the bitsets have the same size and bits, false otherwise
+         */
+        [[nodiscard]] bool operator==(const cow_bitset& other) const noexcept
         {
-            dynamic_bitset result(m_size);
-
-            // Number of blocks to shift
-            const size_type block_shift = shift / m_block_size;
-
-            // Number of bits to shift within a block
-            const size_type bit_shift = shift % m_block_size;
-
-            // Shift across multiple blocks
-            for (size_type i = 0; i < m_storage_size; ++i)
+            if (m_size != other.m_size)
+                return false;
+            if (m_table == other.m_table)
+                return true;
+            for (size_type i = 0; i < m_table->size(); ++i)
             {
-                // Handle shifting within a block
-                result.m_data[i] = (i + block_shift < m_storage_size) ?
-                    (m_data[i + block_shift] >> bit_shift) :
-                    0; // If shifting exceeds block boundaries, fill with zeros
-                // If there are remaining bits to shift to the next block
-                if (bit_shift > 0 && i + block_shift + 1 < m_storage_size)
-                {
-                    // Shift the remaining bits to the next block
-                    result.m_data[i] |= (m_data[i + block_shift + 1] << (m_block_size - bit_shift));
-                }
+                if ((*m_table)[i] != (*other.m_table)[i] && *(*m_table)[i] != *(*other.m_table)[i])
+                    return false;
             }
-
-            return result;
+            return true;
         }
 
         /**
-        * Apply bitwise right shift operation
-        * @param shift Amount of bits to shift to the right
-        */
-        constexpr dynamic_bitset& operator>>=(const size_type& shift) noexcept
+         * Apply bitwise AND operation with another bitset instance, chunks shared by both bitsets are left as they are
+         * @param other Other bitset instance to perform the operation with (must be the same size)
+         */
+        cow_bitset& operator&=(const cow_bitset& other) noexcept
         {
-            if (shift > m_block_size)
-                reset();
-            else
+            if (m_table == other.m_table)
+                return *this;
+            for (size_type i = 0; i < m_table->size(); ++i)
             {
-                // Number of blocks to shift
-                const size_type block_shift = shift / m_block_size;
-
-                // Number of bits to shift within a block
-                const size_type bit_shift = shift % m_block_size;
-
-                // Shift across multiple blocks
-                for (size_type i = 0; i < m_storage_size; ++i)
-                {
-                    // Handle shifting within a block
-                    m_data[i] = i + block_shift < m_storage_size ?
-                        m_data[i + block_shift] >> bit_shift :
-                        0; // If shifting exceeds block boundaries, fill with zeros
-                    // If there are remaining bits to shift to the next block
-                    if (bit_shift > 0 && i + block_shift + 1 < m_storage_size)
-                    {
-                        // Shift the remaining bits to the next block
-                        m_data[i] |= m_data[i + block_shift + 1] << m_block_size - bit_shift;
-                    }
-                }
+                if ((*m_table)[i] != (*other.m_table)[i])
+                    _chunk(i) &= *(*other.m_table)[i];
             }
             return *this;
         }
 
         /**
-         * Bitwise left shift operator
-         * @param shift Amount of bits to shift to the left
-         * @return New bitset instance containing the result of the operation
+         * Apply bitwise OR operation with another bitset instance, chunks shared by both bitsets are left as they are
+         * @param other Other bitset instance to perform the operation with (must be the same size)
          */
-        [[nodiscard]] constexpr dynamic_bitset operator<<(const size_type& shift) const noexcept
+        cow_bitset& operator|=(const cow_bitset& other) noexcept
         {
-            dynamic_bitset result(m_size);
-
-            // Number of blocks to shift
-            const size_type block_shift = shift / m_block_size;
-
-            // Number of bits to shift within a block
-            const size_type bit_shift = shift % m_block_size;
-
-            // Shift across multiple blocks
-            for (size_type i = 0; i < m_storage_size; ++i)
+            if (m_table == other.m_table)
+                return *this;
+            for (size_type i = 0; i < m_table->size(); ++i)
             {
-                // Handle shifting within a block
-                result.m_data[i] = i >= block_shift ?
-                    m_data[i - block_shift] << bit_shift :
-                    0; // If shifting exceeds block boundaries, fill with zeros
-                // If there are remaining bits to shift to the previous block
-                if (bit_shift > 0 && i >= block_shift + 1)
-                {
-                    // Shift the remaining bits to the previous block
-                    result.m_data[i] |= m_data[i - block_shift - 1] >> m_block_size - bit_shift;
-                }
+                if ((*m_table)[i] != (*other.m_table)[i])
+                    _chunk(i) |= *(*other.m_table)[i];
             }
-
-            return result;
+            return *this;
         }
 
         /**
-         * Apply bitwise left shift operation
-         * @param shift Amount of bits to shift to the left
+         * Apply bitwise XOR operation with another bitset instance, chunks shared by both bitsets become zero chunks
+         * @param other Other bitset instance to perform the operation with (must be the same size)
          */
-        constexpr dynamic_bitset& operator<<=(const size_type& shift) noexcept
+        cow_bitset& operator^=(const cow_bitset& other) noexcept
         {
-            // Number of blocks to shift
-            const size_type block_shift = shift / m_block_size;
-
-            // Number of bits to shift within a block
-            const size_type bit_shift = shift % m_block_size;
+            if (m_table == other.m_table)
+            {
+                reset();
+                return *this;
+            }
 
-            // Shift across multiple blocks
-            for (size_type i = 0; i < m_storage_size; ++i)
+            std::shared_ptr<chunk_type> zero;
+            for (size_type i = 0; i < m_table->size(); ++i)
             {
-                // Handle shifting within a block
-                m_data[i] = i >= block_shift ?
-                    m_data[i - block_shift] << bit_shift :
-                    0; // If shifting exceeds block boundaries, fill with zeros
-                // If there are remaining bits to shift to the previous block
-                if (bit_shift > 0 && i >= block_shift + 1)
+                if ((*m_table)[i] != (*other.m_table)[i])
+                    _chunk(i) ^= *(*other.m_table)[i];
+                else
                 {
-                    // Shift the remaining bits to the previous block
-                    m_data[i] |= m_data[i - block_shift - 1] >> m_block_size - bit_shift;
+                    if (!zero)
+                        zero = std::make_shared<chunk_type>();
+                    _table()[i] = zero;
                 }
             }
-
             return *this;
         }
 
         /**
-         * Difference operator
-         * @param other Other bitset instance to compare with
+         * Bitwise AND operator
+         * @param other Other bitset instance to perform the operation with (must be the same size)
          * @return New bitset instance containing the result of the operation
          */
-        [[nodiscard]] dynamic_bitset operator-(const dynamic_bitset& other) const noexcept
+        [[nodiscard]] cow_bitset operator&(const cow_bitset& other) const noexcept
         {
-            dynamic_bitset result(m_size);
-            for (size_type i = 0; i < result.m_storage_size; ++i)
-                result.m_data[i] = m_data[i] & ~other.m_data[i];
+            cow_bitset result(*this);
+            result &= other;
             return result;
         }
 
         /**
-         * Apply difference operation
-         * @param other Other bitset instance to compare with
+         * Bitwise OR operator
+         * @param other Other bitset instance to perform the operation with (must be the same size)
+         * @return New bitset instance containing the result of the operation
          */
-        dynamic_bitset& operator-=(const dynamic_bitset& other) noexcept
+        [[nodiscard]] cow_bitset operator|(const cow_bitset& other) const noexcept
         {
-            for (size_type i = 0; i < m_storage_size; ++i)
-                m_data[i] &= ~other.m_data[i];
-            return *this;
+            cow_bitset result(*this);
+            result |= other;
+            return result;
         }
 
-        // Utility functions
-
         /**
-         * Returns current dynamic_bitset instance as const (use when iterating, using [] operator, ...)
+         * Bitwise XOR operator
+         * @param other Other bitset instance to perform the operation with (must be the same size)
+         * @return New bitset instance containing the result of the operation
          */
-    	[[nodiscard]] const dynamic_bitset& as_const() const noexcept
+        [[nodiscard]] cow_bitset operator^(const cow_bitset& other) const noexcept
         {
-            return *this;
+            cow_bitset result(*this);
+            result ^= other;
+            return result;
         }
 
+    private:
+        /**
+         * Table of chunk pointers
+         */
+        typedef std::vector<std::shared_ptr<chunk_type>> table_type;
+
         /**
-         * Swaps the values of two bits
-         * @param index_1 Index of first value to swap (bit index)
-         * @param index_2 Index of second value to swap (bit index)
+         * Returns a chunk for writing, cloning it first if another bitset shares it
+         * A count of 1 cannot grow while this instance is being written, since copying it would race with the write.
+         * use_count() is a relaxed load, so a count of 1 is followed by an acquire fence, which orders the write in place
+         * after the other copy's clone of the chunk and its release of the reference.
+         * @param index Index of the chunk (chunk index)
+         * @return Chunk owned by this instance alone
          */
-        void swap(const size_type& index_1, const size_type& index_2) noexcept
+        [[nodiscard]] chunk_type& _chunk(const size_type& index) noexcept
         {
-            const bool tmp = test(index_1);
-            set(index_1, test(index_2));
-            set(index_2, tmp);
+            std::shared_ptr<chunk_type>& chunk = _table()[index];
+            if (chunk.use_count() != 1)
+                chunk = std::make_shared<chunk_type>(*chunk);
+            else
+                std::atomic_thread_fence(std::memory_order_acquire);
+            return *chunk;
         }
 
         /**
-         * Reverses the bitset (bit values)
+         * Returns the table for writing, copying the chunk pointers first if another bitset shares it
+         * A count of 1 is followed by an acquire fence, like in _chunk.
+         * @return Table owned by this instance alone
          */
-        void reverse() noexcept
+        [[nodiscard]] table_type& _table() noexcept
         {
-            for (size_type i = 0; i < m_size / 2; ++i)
-            {
-                swap(i, m_size - i - 1);
-            }
+            if (m_table.use_count() != 1)
+                m_table = std::make_shared<table_type>(*m_table);
+            else
+                std::atomic_thread_fence(std::memory_order_acquire);
+            return *m_table;
         }
 
         /**
-         * Rotates each bit to the left by the specified amount
-         * @param shift Amount of bits to rotate to the left (bit count)
+         * Size of a single block in bits
          */
-        void rotate(const size_type& shift) noexcept
+        static constexpr size_type m_block_size = sizeof(BlockType) * CHAR_BIT;
+
+        /**
+         * Count of blocks in a chunk
+         */
+        static constexpr size_type m_chunk_blocks = chunk_size / m_block_size;
+
+        /**
+         * Size of the bitset (bit count)
+         */
+        size_type m_size;
+
+        /**
+         * Chunks of the bits, possibly shared with other bitsets (bits past the size are reset)
+         */
+        std::shared_ptr<table_type> m_table;
+    };
+
+    /**
+     * Persistent bitset, every update returns a new version sharing all untouched nodes with the old one
+     * The bits live in the leaves of a tree with 64 children per node, every leaf holds 512 bits. Missing subtrees
+     * are all zero and nodes are immutable, so a version is kept by copying a pointer and an update copies the path to
+     * its leaf. Operations on two versions skip the subtrees they share, which makes them cost time proportional to
+     * the part of the versions that differs.
+     */
+    class persistent_bitset
+    {
+    public:
+        // Type definitions
+        typedef std::size_t size_type;
+
+        /**
+         * Leaf type
+         */
+        typedef bitset<std::uint64_t, 512> leaf_type;
+
+        /**
+         * Count of children of an inner node
+         */
+        static constexpr size_type fanout = 64;
+
+        /**
+         * Default constructor, constructs an empty bitset
+         */
+        persistent_bitset() noexcept : persistent_bitset(0) {}
+
+        /**
+         * Size constructor, constructs a bitset with all bits reset (an empty tree)
+         * @param size Size of the bitset (bit count)
+         */
+        explicit persistent_bitset(const size_type& size) noexcept : m_size(size), m_height(0)
         {
-            const dynamic_bitset tmp_cpy = *this;
-            for (size_type i = 0; i < m_size; ++i)
-                set(i, tmp_cpy.test((i + shift) % m_size));
+            for (size_type leaves = size ? (size - 1) >> m_leaf_shift : 0; leaves; leaves >>= m_fanout_shift)
+                ++m_height;
         }
 
         /**
-         * @return m_size of the bitset (bit count)
+         * Conversion constructor, builds a tree of the bits of a dynamic_bitset instance
+         * @param bits Bits to copy
          */
-        [[nodiscard]] size_type& size() noexcept { return m_size; }
-
+        explicit persistent_bitset(const dynamic_bitset<std::uint64_t>& bits) noexcept : persistent_bitset(bits.size())
+        {
+            m_root = _build(bits, m_height, 0);
+        }
 
         /**
-         * @return m_size of the bitset (bit count)
+         * Returns the size of the bitset
+         * @return Size of the bitset (bit count)
          */
-        [[nodiscard]] const size_type& size() const noexcept { return m_size; }
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return m_size;
+        }
 
         /**
-         * @return Number of blocks in the bitset
+         * Returns the count of inner levels above the leaves
+         * @return Height of the tree
          */
-        [[nodiscard]] size_type& storage_size() noexcept { return m_storage_size; }
+        [[nodiscard]] size_type height() const noexcept
+        {
+            return m_height;
+        }
 
         /**
-		 * @return Number of blocks in the bitset
-		 */
-        [[nodiscard]] const size_type& storage_size() const noexcept { return m_storage_size; }
+         * Copies the bits into a dynamic_bitset instance
+         * @return Bitset holding the bits
+         */
+        [[nodiscard]] dynamic_bitset<std::uint64_t> to_dynamic_bitset() const noexcept
+        {
+            dynamic_bitset<std::uint64_t> result(m_size);
+            _for_each_leaf(m_root, m_height, 0, [&result](const size_type first, const leaf_type& leaf)
+            {
+                const size_type block = first / 64;
+                for (size_type i = 0; i < leaf_type::storage_size() && block + i < result.storage_size(); ++i)
+                    result.get_block(block + i) = leaf.get_block(i);
+            });
+            return result;
+        }
 
         /**
-         * @return Pointer to the underlying array
+         * Returns the value of the bit at the specified index
+         * @param index Index of the bit to retrieve (bit index)
+         * @return Value of the bit at the specified index (bit value)
          */
-        [[nodiscard]] BlockType*& data() noexcept { return m_data; }
+        [[nodiscard]] bool operator[](const size_type& index) const noexcept
+        {
+            return test(index);
+        }
 
         /**
-         * @return Const pointer to the underlying array
+         * Returns the value of the bit at the specified index
+         * @param index Index of the bit to retrieve (bit index)
+         * @return Value of the bit at the specified index (bit value)
          */
-        [[nodiscard]] const BlockType* const& data() const noexcept { return m_data; }
+        [[nodiscard]] bool test(const size_type& index) const noexcept
+        {
+            const node* current = m_root.get();
+            for (size_type level = m_height; current && level; --level)
+                current = static_cast<const inner_node*>(current)->children[_child(index, level)].get();
+            return current && static_cast<const leaf_node*>(current)->bits.test(index % leaf_type::size());
+        }
 
-        // Iteration functions
+        /**
+         * Returns a version with the bit at the specified index set to the specified value
+         * @param index Index of the bit to set (bit index)
+         * @param value Value to set the bit to (bit value)
+         * @return New version, sharing every node off the path to the bit (this version if the bit already has the value)
+         */
+        [[nodiscard]] persistent_bitset set(const size_type& index, const bool value = true) const noexcept
+        {
+            persistent_bitset result(*this);
+            result.m_root = _set(m_root, m_height, index, value);
+            return result;
+        }
 
-        [[nodiscard]] iterator begin() noexcept
+        /**
+         * Returns a version with the bit at the specified index reset
+         * @param index Index of the bit to reset (bit index)
+         * @return New version, sharing every node off the path to the bit (this version if the bit is already reset)
+         */
+        [[nodiscard]] persistent_bitset reset(const size_type& index) const noexcept
         {
-            return iterator(*this);
+            return set(index, false);
         }
 
-        [[nodiscard]] iterator end() noexcept
+        /**
+         * Returns a version with the bit at the specified index flipped
+         * @param index Index of the bit to flip (bit index)
+         * @return New version, sharing every node off the path to the bit
+         */
+        [[nodiscard]] persistent_bitset flip(const size_type& index) const noexcept
         {
-            return iterator(*this, m_size);
+            return set(index, !test(index));
         }
 
-        [[nodiscard]] const_iterator begin() const noexcept
+        /**
+         * Checks if any bit is set
+         * @return true if any bit is set, false otherwise
+         */
+        [[nodiscard]] bool any() const noexcept
         {
-            return const_iterator(*this);
+            return m_root != nullptr;
         }
 
-        [[nodiscard]] const_iterator end() const noexcept
+        /**
+         * Checks if none of the bits are set
+         * @return true if none of the bits are set, false otherwise
+         */
+        [[nodiscard]] bool none() const noexcept
         {
-            return const_iterator(*this, m_size);
+            return m_root == nullptr;
         }
 
-        [[nodiscard]] const_iterator cbegin() const noexcept
+        /**
+         * Counts the set bits
+         * @return The number of set bits
+         */
+        [[nodiscard]] size_type count() const noexcept
         {
-            return const_iterator(*this);
+            return m_root ? m_root->count : 0;
         }
 
-        [[nodiscard]] const_iterator cend() const noexcept
+        /**
+         * Checks if both versions share all their nodes
+         * @param other Other bitset instance to check
+         * @return true if the versions share the root, which implies equal bits, false otherwise
+         */
+        [[nodiscard]] bool shares_root(const persistent_bitset& other) const noexcept
         {
-            return const_iterator(*this, m_size);
+            return m_root == other.m_root;
         }
 
-        [[nodiscard]] reverse_iterator rbegin() noexcept
+        /**
+         * Finds the first set bit
+         * @return Index of the first set bit, size() if there is none
+         */
+        [[nodiscard]] size_type find_first() const noexcept
         {
-            return reverse_iterator(*this, m_size - 1);
+            return find_next(0);
         }
 
-        [[nodiscard]] reverse_iterator rend() noexcept
+        /**
+         * Finds the first set bit at or after the specified position, skipping the missing subtrees
+         * @param pos Position to start the search at (bit index)
+         * @return Index of the found bit, size() if there is none
+         */
+        [[nodiscard]] size_type find_next(const size_type& pos) const noexcept
         {
-            return reverse_iterator(*this, -1);
+            if (pos >= m_size)
+                return m_size;
+            return (std::min)(_find_next(m_root.get(), m_height, 0, pos), m_size);
         }
 
-        [[nodiscard]] const_reverse_iterator crbegin() const noexcept
+        /**
+         * Calls a function with the index of every bit that differs between the versions, in increasing order
+         * Shared subtrees are skipped, so the cost is proportional to the count of differing bits and their paths.
+         * @tparam F Type of the function
+         * @param other Other version to compare with (must be the same size)
+         * @param f Function called as f(index)
+         */
+        template <typename F>
+        void for_each_difference(const persistent_bitset& other, F f) const
         {
-            return const_reverse_iterator(*this);
+            _difference(m_root.get(), other.m_root.get(), m_height, 0, f);
         }
 
-        [[nodiscard]] const_reverse_iterator crend() const noexcept
+        /**
+         * Collects the indices of the bits that differ between the versions
+         * @param other Other version to compare with (must be the same size)
+         * @return Indices of the differing bits in increasing order
+         */
+        [[nodiscard]] std::vector<size_type> diff(const persistent_bitset& other) const
         {
-            return const_reverse_iterator(*this, -1);
+            std::vector<size_type> result;
+            for_each_difference(other, [&result](const size_type index) { result.push_back(index); });
+            return result;
         }
 
-        [[nodiscard]] const_reverse_iterator rbegin() const noexcept
+        /**
+         * Equality operator, shared subtrees are not compared
+         * @param other Other bitset instance to compare with
+         * @return true if the bitsets have the same size and bits, false otherwise
+         */
+        [[nodiscard]] bool operator==(const persistent_bitset& other) const noexcept
         {
-            return const_reverse_iterator(*this);
+            return m_size == other.m_size && _equal(m_root.get(), other.m_root.get(), m_height);
         }
 
-        [[nodiscard]] const_reverse_iterator rend() const noexcept
+        /**
+         * Bitwise AND operator, shared subtrees are reused and missing ones are skipped
+         * @param other Other bitset instance to perform the operation with (must be the same size)
+         * @return New version containing the result of the operation
+         */
+        [[nodiscard]] persistent_bitset operator&(const persistent_bitset& other) const noexcept
         {
-            return const_reverse_iterator(*this, -1);
+            persistent_bitset result(*this);
+            result.m_root = _combine<std::bit_and<>>(m_root, other.m_root, m_height);
+            return result;
         }
 
-        // bitset operations
-
         /**
-         * Sets the bit at the specified index to the specified value
-         * @param value Value to set the bit to (bit value)
-         * @param index Index of the bit to set (bit index)
+         * Bitwise OR operator, shared subtrees are reused and missing ones are skipped
+         * @param other Other bitset instance to perform the operation with (must be the same size)
+         * @return New version containing the result of the operation
          */
-        void set(const size_type& index, const bool value) noexcept
+        [[nodiscard]] persistent_bitset operator|(const persistent_bitset& other) const noexcept
         {
-            if (value)
-                m_data[index / m_block_size] |= BlockType{ 1 } << index % m_block_size;
-            else
-                m_data[index / m_block_size] &= ~(BlockType{ 1 } << index % m_block_size);
+            persistent_bitset result(*this);
+            result.m_root = _combine<std::bit_or<>>(m_root, other.m_root, m_height);
+            return result;
         }
 
         /**
-		 * Sets the bit at the specified index to 1 (true)
-		 * @param index Index of the bit to set (bit index)
-		 */
-        void set(const size_type& index) noexcept
+         * Bitwise XOR operator, shared subtrees cancel out and missing ones are skipped
+         * @param other Other bitset instance to perform the operation with (must be the same size)
+         * @return New version containing the result of the operation
+         */
+        [[nodiscard]] persistent_bitset operator^(const persistent_bitset& other) const noexcept
         {
-            m_data[index / m_block_size] |= BlockType{ 1 } << index % m_block_size;
+            persistent_bitset result(*this);
+            result.m_root = _combine<std::bit_xor<>>(m_root, other.m_root, m_height);
+            return result;
         }
 
+    private:
         /**
-         * Sets the bit at the specified index to 0 (false)
-         * @param index Index of the bit to reset (bit index)
+         * Node of the tree, holding the count of set bits below it
          */
-        void reset(const size_type& index) noexcept
+        struct node
         {
-            m_data[index / m_block_size] &= ~(BlockType{ 1 } << index % m_block_size);
-        }
+            size_type count = 0;
+        };
 
         /**
-         * Fills all the bits with the specified value
-         * @param value Value to fill the bits with (bit value)
+         * Inner node, a missing child is an all-zero subtree
          */
-        void fill(const bool value) noexcept
+        struct inner_node : node
         {
-            ::memset(m_data, value ? (std::numeric_limits<BlockType>::max)() : 0, m_storage_size * sizeof(BlockType));
-        }
+            std::shared_ptr<const node> children[fanout];
+        };
 
         /**
-         * Fills all the bits with 1 (true)
+         * Leaf node
          */
-        void set() noexcept
+        struct leaf_node : node
         {
-            ::memset(m_data, 255u, m_storage_size * sizeof(BlockType));
-        }
+            leaf_type bits;
+        };
 
         /**
-         * Resets all the bits (sets all bits to 0)
+         * Returns the index of the child holding a bit
+         * @param index Index of the bit (bit index)
+         * @param level Level of the inner node (1 above the leaves)
+         * @return Index of the child
          */
-        void reset() noexcept
+        [[nodiscard]] static size_type _child(const size_type& index, const size_type& level) noexcept
         {
-            ::memset(m_data, 0, m_storage_size * sizeof(BlockType));
+            return index >> (m_leaf_shift + m_fanout_shift * (level - 1)) & (fanout - 1);
         }
 
         /**
-         * Fills all the bits in the specified range with the specified value
-         * @param value Value to fill the bits with (bit value)
-         * @param end End of the range to fill (bit index)
+         * Returns the count of bits covered by a node
+         * @param level Level of the node (0 for leaves)
+         * @return Count of bits below the node
          */
-        void fill_range(const size_type& end, const bool value) noexcept
+        [[nodiscard]] static size_type _span(const size_type& level) noexcept
         {
-            ::memset(m_data, value ? 255u : 0, end / m_block_size * sizeof(BlockType));
-
-            if (end % m_block_size) [[likely]]
-            {
-                if (value)
-                {
-                    for (uint16_t i = 0; i < end % m_block_size; ++i)
-                        m_data[end / m_block_size] |= BlockType{ 1 } << i;
-                }
-                else if (!value)
-                {
-                    for (uint16_t i = 0; i < end % m_block_size; ++i)
-                        m_data[end / m_block_size] &= ~(BlockType{ 1 } << i);
-                }
-            }
+            return size_type{ 1 } << (m_leaf_shift + m_fanout_shift * level);
         }
 
         /**
-         * Sets all the bits in the specified range to 1 (true)
-         * @param end End of the range to set (bit index)
+         * Copies the path to a bit, setting it to the specified value
+         * @param current Subtree holding the bit (nullptr if all zero)
+         * @param level Level of the subtree (0 for leaves)
+         * @param index Index of the bit (bit index)
+         * @param value Value to set the bit to (bit value)
+         * @return Updated subtree, current itself if the bit already has the value, nullptr if it became all zero
          */
-        void set_range(const size_type& end) noexcept
+        [[nodiscard]] static std::shared_ptr<const node> _set(const std::shared_ptr<const node>& current, const size_type& level, const size_type& index, const bool value) noexcept
         {
-            ::memset(m_data, 255u, end / m_block_size * sizeof(BlockType));
-
-            if (end % m_block_size) [[likely]]
+            if (!level)
             {
-                for (uint16_t i = 0; i < end % m_block_size; ++i)
-                    m_data[end / m_block_size] |= BlockType{ 1 } << i;
+                const size_type bit = index % leaf_type::size();
+                if ((current && static_cast<const leaf_node&>(*current).bits.test(bit)) == value)
+                    return current;
+                if (!value && current->count == 1)
+                    return nullptr;
+
+                const std::shared_ptr<leaf_node> result = current ? std::make_shared<leaf_node>(static_cast<const leaf_node&>(*current)) : std::make_shared<leaf_node>();
+                result->bits.set(bit, value);
+                result->count = value ? result->count + 1 : result->count - 1;
+                return result;
             }
+
+            const size_type child = _child(index, level);
+            const std::shared_ptr<const node> before = current ? static_cast<const inner_node&>(*current).children[child] : nullptr;
+            std::shared_ptr<const node> after = _set(before, level - 1, index, value);
+            if (after == before)
+                return current;
+
+            // Removing the last set bit removes the whole path
+            if (!after && current->count == 1)
+                return nullptr;
+
+            const std::shared_ptr<inner_node> result = current ? std::make_shared<inner_node>(static_cast<const inner_node&>(*current)) : std::make_shared<inner_node>();
+            result->count = value ? result->count + 1 : result->count - 1;
+            result->children[child] = std::move(after);
+            return result;
         }
 
         /**
-         * Sets all the bits in the specified range to 0 (false)
-         * @param end End of the range to set (bit index)
+         * Combines two subtrees, reusing shared and missing subtrees
+         * @tparam Op Operation applied to the leaves (std::bit_and, std::bit_or or std::bit_xor)
+         * @param lhs Left-hand subtree (nullptr if all zero)
+         * @param rhs Right-hand subtree (nullptr if all zero)
+         * @param level Level of the subtrees (0 for leaves)
+         * @return Combined subtree, one of the operands where the result equals it, nullptr if all zero
+         */
+        template <typename Op>
+        [[nodiscard]] static std::shared_ptr<const node> _combine(const std::shared_ptr<const node>& lhs, const std::shared_ptr<const node>& rhs, const size_type& level) noexcept
+        {
+            constexpr bool is_and = std::is_same_v<Op, std::bit_and<>>;
+            constexpr bool is_xor = std::is_same_v<Op, std::bit_xor<>>;
+
+            if (lhs == rhs)
+                return is_xor ? nullptr : lhs;
+            if (!lhs || !rhs)
+                return is_and ? nullptr : lhs ? lhs : rhs;
+
+            if (!level)
+            {
+                const leaf_type& lhs_bits = static_cast<const leaf_node&>(*lhs).bits;
+                const leaf_type& rhs_bits = static_cast<const leaf_node&>(*rhs).bits;
+                const leaf_type bits = Op{}(lhs_bits, rhs_bits);
+                if (bits == lhs_bits)
+                    return lhs;
+                if (bits == rhs_bits)
+                    return rhs;
+                if (bits.none())
+                    return nullptr;
+
+                const std::shared_ptr<leaf_node> result = std::make_shared<leaf_node>();
+                result->bits = bits;
+                result->count = bits.count();
+                return result;
+            }
+
+            const inner_node& lhs_node = static_cast<const inner_node&>(*lhs);
+            const inner_node& rhs_node = static_cast<const inner_node&>(*rhs);
+            const std::shared_ptr<inner_node> result = std::make_shared<inner_node>();
+            bool same_as_lhs = true, same_as_rhs = true;
+            for (size_type i = 0; i < fanout; ++i)
+            {
+                result->children[i] = _combine<Op>(lhs_node.children[i], rhs_node.children[i], level - 1);
+                result->count += result->children[i] ? result->children[i]->count : 0;
+                same_as_lhs &= result->children[i] == lhs_node.children[i];
+                same_as_rhs &= result->children[i] == rhs_node.children[i];
+            }
+            if (same_as_lhs)
+                return lhs;
+            if (same_as_rhs)
+                return rhs;
+            if (!result->count)
+                return nullptr;
+            return result;
+        }
+
+        /**
+         * Compares two subtrees, skipping shared ones
+         * @param lhs Left-hand subtree (nullptr if all zero)
+         * @param rhs Right-hand subtree (nullptr if all zero)
+         * @param level Level of the subtrees (0 for leaves)
+         * @return true if the subtrees hold the same bits, false otherwise
          */
-        void reset_range(const size_type& end) noexcept
+        [[nodiscard]] static bool _equal(const node* lhs, const node* rhs, const size_type& level) noexcept
         {
-            ::memset(m_data, 0, end / m_block_size * sizeof(BlockType));
+            if (lhs == rhs)
+                return true;
 
-            if (end % m_block_size) [[likely]]
+            // Missing subtrees are all zero and present ones never are
+            if (!lhs || !rhs || lhs->count != rhs->count)
+                return false;
+            if (!level)
+                return static_cast<const leaf_node*>(lhs)->bits == static_cast<const leaf_node*>(rhs)->bits;
+            for (size_type i = 0; i < fanout; ++i)
             {
-                for (uint16_t i = 0; i < end % m_block_size; ++i)
-                    m_data[end / m_block_size] &= ~(BlockType{ 1 } << i);
+                if (!_equal(static_cast<const inner_node*>(lhs)->children[i].get(), static_cast<const inner_node*>(rhs)->children[i].get(), level - 1))
+                    return false;
             }
+            return true;
         }
 
         /**
-         * Fills all the bits in the specified range with the specified value
-         * @param value Value to fill the bits with (bit value)
-         * @param begin Begin of the range to fill (bit index)
-         * @param end End of the range to fill (bit index)
+         * Calls a function with the index of every bit that differs between two subtrees
+         * @tparam F Type of the function
+         * @param lhs Left-hand subtree (nullptr if all zero)
+         * @param rhs Right-hand subtree (nullptr if all zero)
+         * @param level Level of the subtrees (0 for leaves)
+         * @param first Index of the first bit of the subtrees (bit index)
+         * @param f Function called as f(index)
          */
-        void fill_range(const size_type& begin, const size_type& end, const bool value) noexcept
+        template <typename F>
+        static void _difference(const node* lhs, const node* rhs, const size_type& level, const size_type& first, F& f)
         {
-            uint8_t to_add = 1, to_sub = 1;
-            // create begin_block and fill the first byte with it
-            if (begin % m_block_size) [[likely]]
+            if (lhs == rhs)
+                return;
+
+            if (!level)
             {
-                const uint16_t end_bit = (begin / m_block_size == end / m_block_size) ? end % m_block_size : m_block_size;
-                if (value)
-                {
-                    for (uint16_t i = begin % m_block_size; i < end_bit; ++i)
-                        m_data[begin / m_block_size] |= BlockType{ 1 } << i;
-                }
-                else
+                static constexpr leaf_type zero;
+                const leaf_type bits = (lhs ? static_cast<const leaf_node*>(lhs)->bits : zero) ^ (rhs ? static_cast<const leaf_node*>(rhs)->bits : zero);
+                for (size_type i = 0; i < leaf_type::storage_size(); ++i)
                 {
-                    for (uint16_t i = begin % m_block_size; i < end_bit; ++i)
-                        m_data[begin / m_block_size] &= ~(BlockType{ 1 } << i);
+                    for (std::uint64_t block = bits.get_block(i); block; block &= block - 1)
+                        f(first + i * 64 + static_cast<size_type>(detail::countr_zero(block)));
                 }
+                return;
             }
-            else
-                to_add = 0;
 
-            // set the end block if the end is not aligned with the block size
-            if (end % m_block_size && begin / m_block_size != end / m_block_size) [[likely]]
+            for (size_type i = 0; i < fanout; ++i)
             {
-                if (value)
-                {
-                    for (uint16_t i = 0; i < end % m_block_size; ++i)
-                        m_data[end / m_block_size] |= BlockType{ 1 } << i;
-                }
-                else
-                {
-                    for (uint16_t i = 0; i < end % m_block_size; ++i)
-                        m_data[end / m_block_size] &= ~(BlockType{ 1 } << i);
-                }
+                const node* lhs_child = lhs ? static_cast<const inner_node*>(lhs)->children[i].get() : nullptr;
+                const node* rhs_child = rhs ? static_cast<const inner_node*>(rhs)->children[i].get() : nullptr;
+                _difference(lhs_child, rhs_child, level - 1, first + i * _span(level - 1), f);
             }
-            else
-                to_sub = 0;
-
-            ::memset(m_data + begin / m_block_size + to_add, value ? 255u : 0, (end - begin) / m_block_size * sizeof(BlockType) - to_sub);
         }
 
         /**
-         * Sets all the bits in the specified range to 1 (true)
-         * @param begin Begin of the range to fill (bit index)
-         * @param end End of the range to fill (bit index)
+         * Finds the first set bit of a subtree at or after the specified position
+         * @param current Subtree to search (nullptr if all zero)
+         * @param level Level of the subtree (0 for leaves)
+         * @param first Index of the first bit of the subtree (bit index)
+         * @param pos Position to start the search at (bit index, not before first)
+         * @return Index of the found bit, the largest size_type value if there is none
          */
-        void set_range(const size_type& begin, const size_type& end) noexcept
+        [[nodiscard]] static size_type _find_next(const node* current, const size_type& level, const size_type& first, const size_type& pos) noexcept
         {
-            uint8_t to_add = 1, to_sub = 1;
-            // create begin_block and fill the first byte with it
-            if (begin % m_block_size) [[likely]]
+            if (!current)
+                return (std::numeric_limits<size_type>::max)();
+
+            if (!level)
             {
-                const uint16_t end_bit = begin / m_block_size == end / m_block_size ? end % m_block_size : m_block_size;
-                for (uint16_t i = begin % m_block_size; i < end_bit; ++i)
-                    m_data[begin / m_block_size] |= BlockType{ 1 } << i;
+                const leaf_type& bits = static_cast<const leaf_node*>(current)->bits;
+                const size_type found = detail::find_next(&bits.get_block(0), leaf_type::size(), pos - first);
+                return found < leaf_type::size() ? first + found : (std::numeric_limits<size_type>::max)();
             }
-            else
-                to_add = 0;
 
-            // set the end block if the end is not aligned with the block size
-            if (end % m_block_size && begin / m_block_size != end / m_block_size) [[likely]]
-            { 
-                for (uint16_t i = 0; i < end % m_block_size; ++i)
-                    m_data[end / m_block_size] |= BlockType{ 1 } << i;
+            const size_type span = _span(level - 1);
+            for (size_type i = (pos - first) / span; i < fanout; ++i)
+            {
+                const size_type child_first = first + i * span;
+                const size_type found = _find_next(static_cast<const inner_node*>(current)->children[i].get(), level - 1, child_first, (std::max)(pos, child_first));
+                if (found != (std::numeric_limits<size_type>::max)())
+                    return found;
             }
-            else
-                to_sub = 0;
-
-            ::memset(m_data + begin / m_block_size + to_add, 255u, (end - begin) / m_block_size * sizeof(BlockType) - to_sub);
+            return (std::numeric_limits<size_type>::max)();
         }
 
         /**
-         * Sets all the bits in the specified range to 0 (false)
-         * @param begin Begin of the range to fill (bit index)
-         * @param end End of the range to fill (bit index)
+         * Calls a function with every leaf of a subtree, in increasing order
+         * @tparam F Type of the function
+         * @param current Subtree to visit (nullptr if all zero)
+         * @param level Level of the subtree (0 for leaves)
+         * @param first Index of the first bit of the subtree (bit index)
+         * @param f Function called as f(first, leaf)
          */
-        void reset_range(const size_type& begin, const size_type& end) noexcept
+        template <typename F>
+        static void _for_each_leaf(const std::shared_ptr<const node>& current, const size_type& level, const size_type& first, F&& f)
         {
-            uint8_t to_add = 1, to_sub = 1;
-            // create begin_block and fill the first byte with it
-            if (begin % m_block_size) [[likely]]
-            {
-                const uint16_t end_bit = begin / m_block_size == end / m_block_size ? end % m_block_size : m_block_size;
-                for (uint16_t i = begin % m_block_size; i < end_bit; ++i)
-                    m_data[begin / m_block_size] &= ~(BlockType{ 1 } << i);
-            }
-            else
-                to_add = 0;
-
-            // set the end block if the end is not aligned with the block size
-            if (end % m_block_size && begin / m_block_size != end / m_block_size) [[likely]]
+            if (!current)
+                return;
+            if (!level)
             {
-                for (uint16_t i = 0; i < end % m_block_size; ++i)
-                    m_data[end / m_block_size] &= ~(BlockType{ 1 } << i);
+                f(first, static_cast<const leaf_node&>(*current).bits);
+                return;
             }
-            else
-                to_sub = 0;
-
-            ::memset(m_data + begin / m_block_size + to_add, 0, (end - begin) / m_block_size * sizeof(BlockType) - to_sub);
+            for (size_type i = 0; i < fanout; ++i)
+                _for_each_leaf(static_cast<const inner_node&>(*current).children[i], level - 1, first + i * _span(level - 1), f);
         }
 
         /**
-         * Fills all the bits in the specified range with the specified value
-         * @param value Value to fill the bits with (bit value)
-         * @param begin Begin of the range to fill (bit index)
-         * @param end End of the range to fill (bit index)
-         * @param step Step size between the bits to fill (bit step)
+         * Builds the subtree of a range of bits
+         * @param bits Bits to copy
+         * @param level Level of the subtree (0 for leaves)
+         * @param first Index of the first bit of the subtree (bit index)
+         * @return Subtree holding the bits, nullptr if they are all zero
          */
-        void fill_range(const size_type& begin, const size_type& end, const size_type& step, const bool value) noexcept
+        [[nodiscard]] static std::shared_ptr<const node> _build(const dynamic_bitset<std::uint64_t>& bits, const size_type& level, const size_type& first) noexcept
         {
-            for (size_type i = begin; i < end; i += step)
+            if (first >= bits.size())
+                return nullptr;
+
+            if (!level)
             {
-                if (value)
-                    m_data[i / m_block_size] |= BlockType{ 1 } << i % m_block_size;
-                else
-                    m_data[i / m_block_size] &= ~(BlockType{ 1 } << i % m_block_size);
+                const std::shared_ptr<leaf_node> result = std::make_shared<leaf_node>();
+                const size_type block = first / 64;
+                for (size_type i = 0; i < leaf_type::storage_size() && block + i < bits.storage_size(); ++i)
+                    result->bits.get_block(i) = bits.get_block(block + i);
+                if (bits.size() - first < leaf_type::size())
+                    result->bits.reset_range(bits.size() - first, leaf_type::size());
+                result->count = result->bits.count();
+                return result->count ? result : nullptr;
+            }
+
+            const std::shared_ptr<inner_node> result = std::make_shared<inner_node>();
+            for (size_type i = 0; i < fanout; ++i)
+            {
+                result->children[i] = _build(bits, level - 1, first + i * _span(level - 1));
+                result->count += result->children[i] ? result->children[i]->count : 0;
             }
+            return result->count ? result : nullptr;
         }
 
         /**
-         * Sets all the bits in the specified range to 1 (true)
-         * @param begin Begin of the range to fill (bit index)
-         * @param end End of the range to fill (bit index)
-         * @param step Step size between the bits to fill (bit step)
+         * Count of index bits selecting a bit in a leaf
          */
-        void set_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
-        {
-            for (size_type i = begin; i < end; i += step)
-                m_data[i / m_block_size] |= BlockType{ 1 } << i % m_block_size;
-        }
+        static constexpr size_type m_leaf_shift = 9;
 
         /**
-         * FSets all the bits in the specified range to 0 (false)
-         * @param begin Begin of the range to fill (bit index)
-         * @param end End of the range to fill (bit index)
-         * @param step Step size between the bits to fill (bit step)
+         * Count of index bits selecting a child of an inner node
          */
-        void reset_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
-        {
-            for (size_type i = begin; i < end; i += step)
-                m_data[i / m_block_size] &= ~(BlockType{ 1 } << i % m_block_size);
-        }
+        static constexpr size_type m_fanout_shift = 6;
 
         /**
-         * !!! W.I.P. - Does not function correctly at the moment !!!
+         * Size of the bitset (bit count)
          */
-        void fill_range_optimized(const size_type& begin, const size_type& end, const size_type& step, const bool value) noexcept
-        {
-            // Initialize variables
-            size_type blocks_size, current_block = begin / m_block_size + 1 + step / m_block_size, current_offset = 0;
-            uint16_t offset;
-            const size_type end_block = end / m_block_size + (end % m_block_size ? 1 : 0);
-
-            // Determine the size of blocks based on step and block size
-            if ((step % 2 || step <= m_block_size) && m_block_size % step) {
-                blocks_size = (std::min)(m_storage_size, step);
-            }
-            else if (!(m_block_size % step))
-                blocks_size = 1;
-            else if (!(step % m_block_size))
-                blocks_size = step / m_block_size;
-            else
-            {
-                // GCD of step and m_block_size
-                if (step % m_block_size)
-                {
-                    size_type a = step, b = m_block_size, t = m_block_size;
-                    while (b) {
-                        t = b;
-                        b = a % b;
-                        a = t;
-                    }
-                    blocks_size = a;
-                }
-                else
-                    blocks_size = 1;
-            }
-
-            // Calculate the offset
-            offset = begin % m_block_size;
-
-            std::cout << "offset: " << offset << '\n';
-
-            // Create and apply the beginning block
-            {
-                const uint16_t end_bit = (begin / m_block_size == end / m_block_size) ? end % m_block_size : m_block_size;
-                if (value)
-                {
-                    for (uint16_t i = begin % m_block_size; i < end_bit; i += step)
-                        m_data[begin / m_block_size] |= BlockType{ 1 } << i;
-                }
-                else
-                {
-                    for (uint16_t i = begin % m_block_size; i < end_bit; i += step)
-                        m_data[begin / m_block_size] &= ~(BlockType{ 1 } << i);
-                }
-            }
-
-
-            // Fill with appropriate block
-            std::cout << blocks_size << " blocks\n";
-            std::cout << (std::min)(blocks_size + begin / m_block_size, m_storage_size) << " blocks\n";
-            for (size_type i = 0; i < (std::min)(blocks_size, m_storage_size); ++i)
-            {
-                // Generate block for the current iteration
-                BlockType block = 0;
-
-                if (value)
-                {
-                    for (uint16_t j = !i ? offset : 0; j < m_block_size; ++j)
-                    {
-                        std::cout << current_block * m_block_size + j - offset << '\n';
-                        if (!((current_block * m_block_size + j - offset) % step))
-                            block |= BlockType{ 1 } << j;
-                    }
-                }
-                else
-                {
-                    block = (std::numeric_limits<BlockType>::max)();
-                    for (uint16_t j = (!i ? offset : 0); j < m_block_size; ++j)
-                    {
-                        if (!((current_block * m_block_size + j - offset) % step))
-                            block &= ~(BlockType{ 1 } << j);
-                    }
-                }
-
-                // print the block
-                for (uint16_t j = 0; j < m_block_size; ++j)
-                {
-                    std::cout << ((block & BlockType{ 1 } << j) >> j);
-                }
-
-                std::cout << '\n';
+        size_type m_size;
 
-                // Apply the block
-                for (size_type j = current_block; j < m_storage_size; ++j)
-                {
-                    if (j == end_block - 1 && end % m_block_size)
-                    {
-                        // Remove bits that overflow the range
-                        if (value)
-                        {
-                            for (uint16_t k = end % m_block_size; k < m_block_size; ++k)
-                                block &= ~(BlockType{ 1 } << k);
-                            *(m_data + j) |= block;
-                        }
-                        else
-                        {
-                            for (uint16_t k = end % m_block_size; k < m_block_size; ++k)
-                                block |= BlockType{ 1 } << k;
-                            *(m_data + j) &= block;
-                        }
-                        break;
-                    }
-                    if (value)
-                        *(m_data + j) |= block;
-                    else
-                        *(m_data + j) &= block;
-                }
-                ++current_block;
-            }
-        }
+        /**
+         * Count of inner levels above the leaves
+         */
+        size_type m_height;
 
         /**
-         * Sets the block at the specified index to the specified value (default is max value, all bits set to 1)
-         * @param block Block to set (block value)
-         * @param index Index of the block to set (block index)
+         * Root of the tree, nullptr if all bits are reset
          */
-        void set_block(const size_type& index, const BlockType& block = (std::numeric_limits<BlockType>::max)()) noexcept
-        {
-            m_data[index] = block;
-        }
+        std::shared_ptr<const node> m_root;
+    };
+
+    /**
+     * Delta between two bitsets of the same size, as runs of consecutive blocks and their XOR words
+     * @tparam BlockType Type of the blocks of the bitsets
+     */
+    template <unsigned_integer BlockType = std::uint64_t>
+    struct bitset_patch
+    {
+        // Type definitions
+        typedef std::size_t size_type;
 
         /**
-         * Sets the block at the specified index to 0 (all bits set to 0)
-         * @param index Index of the block to reset (block index)
+         * Run of consecutive changed blocks
          */
-        void reset_block(const size_type& index) noexcept
+        struct run
         {
-            m_data[index] = 0u;
-        }
+            /**
+             * Index of the first block of the run (block index)
+             */
+            size_type offset;
+
+            /**
+             * Count of blocks in the run
+             */
+            size_type length;
+        };
 
         /**
-         * Fills all the blocks with the specified block
-         * @param block Block to fill the blocks with (block value)
+         * Appends the XOR word of a changed block, extending the last run if the block follows it
+         * @param index Index of the block (block index, greater than the blocks appended before)
+         * @param word XOR of the old and the new block (non-zero)
          */
-        void fill_block(const BlockType& block) noexcept
+        void append(const size_type& index, const BlockType& word)
         {
-            for (size_type i = 0; i < m_storage_size; ++i)
-                m_data[i] = block;
+            if (runs.empty() || runs.back().offset + runs.back().length != index)
+                runs.push_back({ index, 0 });
+            ++runs.back().length;
+            words.push_back(word);
         }
 
         /**
-		 * Sets all the blocks in the specified range to their max value
-		 * @param end End of the range to fill (block index)
-		 */
-        void set_block_range(const size_type& end) noexcept
+         * Returns the count of bytes of the runs and words, the size of the patch when sent as they are
+         * @return Count of bytes
+         */
+        [[nodiscard]] size_type byte_size() const noexcept
         {
-            for (size_type i = 0; i < end; ++i)
-                m_data[i] = (std::numeric_limits<BlockType>::max)();
+            return sizeof(size) + runs.size() * sizeof(run) + words.size() * sizeof(BlockType);
         }
 
         /**
-		 * Sets all the blocks in the specified range to 0
-		 * @param end End of the range to fill (block index)
-		 */
-        void reset_block_range(const size_type& end) noexcept
-        {
-            for (size_type i = 0; i < end; ++i)
-                m_data[i] = 0;
-        }
+         * Size of the bitsets (bit count)
+         */
+        size_type size = 0;
 
         /**
-         * Fills all the blocks in the specified range with the specified block
-         * @param end End of the range to fill (block index)
-         * @param block Block to fill the bits with (block value)
+         * Runs of changed blocks in increasing order
          */
-        void fill_block_range(const size_type& end, const BlockType& block = (std::numeric_limits<BlockType>::max)()) noexcept
-        {
-            for (size_type i = 0; i < end; ++i)
-                m_data[i] = block;
-        }
+        std::vector<run> runs;
 
         /**
-		 * Sets all the blocks in the specified range to their max value
-		 * @param begin begin of the range to fill (block index)
-		 * @param end End of the range to fill (block index)
-		 */
-        void set_block_range(const size_type& begin, const size_type& end) noexcept
+         * XOR words of the blocks of the runs, in the order of the runs
+         */
+        std::vector<BlockType> words;
+    };
+
+    /**
+     * Computes the delta turning one bitset into another, skipping equal blocks 256 bytes at a time
+     * @tparam BlockType Type of the blocks
+     * @param from Bitset to patch
+     * @param to Bitset to get by applying the patch (must be the same size)
+     * @return Patch holding every changed block (bits past the size are ignored)
+     */
+    template <unsigned_integer BlockType>
+    [[nodiscard]] bitset_patch<BlockType> diff(const dynamic_bitset<BlockType>& from, const dynamic_bitset<BlockType>& to)
+    {
+        constexpr std::size_t chunk_size = 256 / sizeof(BlockType);
+        const std::size_t storage_size = from.storage_size();
+
+        bitset_patch<BlockType> result;
+        result.size = from.size();
+        for (std::size_t chunk = 0; chunk < storage_size; chunk += chunk_size)
         {
-            for (size_type i = begin; i < end; ++i)
-                m_data[i] = (std::numeric_limits<BlockType>::max)();
+            const std::size_t end = (std::min)(chunk + chunk_size, storage_size);
+            if (!detail::any_of_blocks(from.data() + chunk, to.data() + chunk, end - chunk, [](const BlockType lhs, const BlockType rhs) noexcept { return static_cast<BlockType>(lhs ^ rhs); }))
+                continue;
+
+            for (std::size_t i = chunk; i < end; ++i)
+            {
+                BlockType word = static_cast<BlockType>(from.get_block(i) ^ to.get_block(i));
+                if (i + 1 == storage_size)
+                    word &= detail::mask_until<BlockType>(from.size());
+                if (word)
+                    result.append(i, word);
+            }
         }
+        return result;
+    }
 
-        /**
-		 * Sets all the blocks in the specified range to 0
-		 * @param begin begin of the range to fill (block index)
-		 * @param end End of the range to fill (block index)
-		 */
-        void reset_block_range(const size_type& begin, const size_type& end) noexcept
+    /**
+     * Applies a patch, XOR-ing its words into the blocks of its runs
+     * @tparam BlockType Type of the blocks
+     * @param bits Bitset to patch (must be the size of the patch)
+     * @param patch Patch to apply
+     */
+    template <unsigned_integer BlockType>
+    void apply_patch(dynamic_bitset<BlockType>& bits, const bitset_patch<BlockType>& patch) noexcept
+    {
+        const BlockType* word = patch.words.data();
+        for (const typename bitset_patch<BlockType>::run& run : patch.runs)
         {
-            for (size_type i = begin; i < end; ++i)
-                m_data[i] = 0;
+            for (std::size_t i = 0; i < run.length; ++i)
+                bits.get_block(run.offset + i) ^= *word++;
         }
+    }
+
+    /**
+     * dynamic_bitset recording the blocks changed since the last patch was taken
+     * The first write to a block marks it in a hierarchical_bitset over the blocks, whose summary levels are the
+     * per-chunk dirty summary, and saves its old value. take_patch() then costs time proportional to the changed
+     * blocks rather than to the size. Writes that leave a block unchanged do not mark it.
+     * @tparam BlockType Type of block to use for bit storage (may be one of unsigned integer types)
+     */
+    template <unsigned_integer BlockType = std::uint64_t>
+    class tracked_bitset
+    {
+    public:
+        // Type definitions
+        typedef std::size_t size_type;
+        typedef BlockType block_type;
 
         /**
-         * Fills all the blocks in the specified range with the specified block
-         * @param begin begin of the range to fill (block index)
-         * @param end End of the range to fill (block index)
-         * @param block Block to fill the bits with
+         * Default constructor, constructs an empty bitset
          */
-        void fill_block_range(const size_type& begin, const size_type& end, const BlockType& block = (std::numeric_limits<BlockType>::max)()) noexcept
-        {
-            for (size_type i = begin; i < end; ++i)
-                m_data[i] = block;
-        }
+        tracked_bitset() noexcept : tracked_bitset(0) {}
 
         /**
-		 * Sets all the blocks in the specified range to their max value
-		 * @param begin begin of the range to fill (block index)
-		 * @param end End of the range to fill (block index)
-		 * @param step Step size between the bits to fill (block step)
-		 */
-        void set_block_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
-        {
-            for (size_type i = begin; i < end; i += step)
-                m_data[i] = (std::numeric_limits<BlockType>::max)();
-        }
+         * Size constructor, constructs a clean bitset with all bits reset
+         * @param size Size of the bitset (bit count)
+         */
+        explicit tracked_bitset(const size_type& size) noexcept : m_bits(size), m_dirty(m_bits.storage_size()) {}
 
         /**
-		 * Sets all the blocks in the specified range to 0
-		 * @param begin begin of the range to fill (block index)
-		 * @param end End of the range to fill (block index)
-		 * @param step Step size between the bits to fill (block step)
-		 */
-        void reset_block_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
-        {
-            for (size_type i = begin; i < end; i += step)
-                m_data[i] = 0;
-        }
+         * Size and bool value constructor, constructs a clean bitset
+         * @param size Size of the bitset (bit count)
+         * @param value Value to set the bits to (bit value)
+         */
+        tracked_bitset(const size_type& size, const bool value) noexcept : m_bits(size, value), m_dirty(m_bits.storage_size()) {}
 
         /**
-         * Fills all the blocks in the specified range with the specified block
-         * @param begin begin of the range to fill (block index)
-         * @param end End of the range to fill (block index)
-         * @param step Step size between the bits to fill (block step)
-         * @param block Block to fill the bits with (block value)
+         * Conversion constructor, constructs a clean copy of a dynamic_bitset instance
+         * @param bits Bits to copy
          */
-        void fill_block_range(const size_type& begin, const size_type& end, const size_type& step, const BlockType& block = (std::numeric_limits<BlockType>::max)()) noexcept
-        {
-            for (size_type i = begin; i < end; i += step)
-                m_data[i] = block;
-        }
+        explicit tracked_bitset(const dynamic_bitset<BlockType>& bits) noexcept : m_bits(bits), m_dirty(m_bits.storage_size()) {}
 
         /**
-         * Flips the bit at the specified index
-         * @param index Index of the bit to flip (bit index)
+         * Returns the size of the bitset
+         * @return Size of the bitset (bit count)
          */
-        void flip(const size_type& index) noexcept
+        [[nodiscard]] size_type size() const noexcept
         {
-            m_data[index / m_block_size] ^= BlockType{ 1 } << index % m_block_size;
+            return m_bits.size();
         }
 
         /**
-         * Flips all the bits
+         * Returns the bits
+         * @return Bitset holding the bits
          */
-        void flip() noexcept
+        [[nodiscard]] const dynamic_bitset<BlockType>& bits() const noexcept
         {
-            for (size_type i = 0; i < m_storage_size; ++i)
-                m_data[i] = ~m_data[i];
+            return m_bits;
         }
 
         /**
-         * Flips all the bits in the specified range
-         * @param end End of the range to fill (bit index)
+         * Returns the dirty blocks
+         * @return Bitset with a bit set for every block changed since the last patch (block index)
          */
-        void flip_range(const size_type& end) noexcept
+        [[nodiscard]] const hierarchical_bitset<std::uint64_t>& dirty_blocks() const noexcept
         {
-            // flip blocks that are in range by bulk, rest flip normally
-            for (size_type i = 0; i < end / m_block_size; ++i)
-                m_data[i] = ~m_data[i];
-            for (uint16_t i = 0; i < end % m_block_size; ++i)
-                m_data[end / m_block_size] ^= BlockType{ 1 } << i;
+            return m_dirty;
         }
 
         /**
-         * Flip all the bits in the specified range
-         * @param begin Begin of the range to fill (bit index)
-         * @param end End of the range to fill (bit index)
+         * Returns the block at the specified index
+         * @param index Index of the block (block index)
+         * @return Value of the block
          */
-        void flip_range(const size_type& begin, const size_type& end) noexcept
+        [[nodiscard]] BlockType get_block(const size_type& index) const noexcept
         {
-            size_type to_add = 1;
-            if (begin % m_block_size) [[likely]]
-            {
-                for (uint16_t i = begin % m_block_size; i < m_block_size; ++i)
-                    m_data[begin / m_block_size] ^= BlockType{ 1 } << i;
-            }
-            else
-                to_add = 0;
-
-            for (size_type i = begin / m_block_size + to_add; i < end / m_block_size; ++i)
-                m_data[i] = ~m_data[i];
-
-            if (end % m_block_size) [[likely]]
-            {
-                for (uint16_t i = 0; i < end % m_block_size; ++i)
-                    m_data[end / m_block_size] ^= BlockType{ 1 } << i;
-            }
+            return m_bits.get_block(index);
         }
 
         /**
-         * Flips all the bits in the specified range
-         * @param begin Begin of the range to fill (bit index)
-         * @param end End of the range to fill (bit index)
-         * @param step Step size between the bits to flip (bit step)
+         * Sets the block at the specified index
+         * @param index Index of the block (block index)
+         * @param block Value to set the block to
          */
-        void flip_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
+        void set_block(const size_type& index, const BlockType& block) noexcept
         {
-            for (size_type i = begin; i < end; i += step)
-            {
-                m_data[i / m_block_size] ^= BlockType{ 1 } << i % m_block_size;
-            }
+            _write(index, block);
         }
 
         /**
-         * Flips the block at the specified index
-         * @param index Index of the block to flip (block index)
+         * Returns the value of the bit at the specified index
+         * @param index Index of the bit to retrieve (bit index)
+         * @return Value of the bit at the specified index (bit value)
          */
-        void flip_block(const size_type& index) noexcept
+        [[nodiscard]] bool operator[](const size_type& index) const noexcept
         {
-            m_data[index] = ~m_data[index];
+            return test(index);
         }
 
         /**
-         * Flips all the blocks in the specified range
-         * @param end End of the range to fill (block index)
+         * Returns the value of the bit at the specified index
+         * @param index Index of the bit to retrieve (bit index)
+         * @return Value of the bit at the specified index (bit value)
          */
-        void flip_block_range(const size_type& end) noexcept
+        [[nodiscard]] bool test(const size_type& index) const noexcept
         {
-            for (size_type i = 0; i < end; ++i)
-                m_data[i] = ~m_data[i];
+            return m_bits.test(index);
         }
 
         /**
-         * Flips all the blocks in the specified range
-         * @param begin Begin of the range to fill (block index)
-         * @param end End of the range to fill (block index)
+         * Sets the bit at the specified index to the specified value
+         * @param index Index of the bit to set (bit index)
+         * @param value Value to set the bit to (bit value)
          */
-        void flip_block_range(const size_type& begin, const size_type& end) noexcept
+        void set(const size_type& index, const bool value) noexcept
         {
-            for (size_type i = begin; i < end; ++i)
-                m_data[i] = ~m_data[i];
+            const BlockType mask = static_cast<BlockType>(BlockType{ 1 } << index % m_block_size);
+            const BlockType block = m_bits.get_block(index / m_block_size);
+            _write(index / m_block_size, static_cast<BlockType>(value ? block | mask : block & ~mask));
         }
 
         /**
-         * Flips all the blocks in the specified range
-         * @param begin Begin of the range to fill (block index)
-         * @param end End of the range to fill (block index)
-         * @param step Step size between the bits to flip (block step)
+         * Sets the bit at the specified index
+         * @param index Index of the bit to set (bit index)
          */
-        void flip_block_range(const size_type& begin, const size_type& end, const size_type& step) noexcept
+        void set(const size_type& index) noexcept
         {
-            for (size_type i = begin; i < end; i += step)
-                m_data[i] = ~m_data[i];
+            set(index, true);
         }
 
         /**
-         * Retrieves the value of a bit at a specified index
-         * @param index The index of the bit to read (bit index)
-         * @return The value of the bit at the specified index
+         * Resets the bit at the specified index
+         * @param index Index of the bit to reset (bit index)
          */
-        [[nodiscard]] bool test(const size_type& index) const noexcept
+        void reset(const size_type& index) noexcept
         {
-            return m_data[index / m_block_size] & BlockType{ 1 } << index % m_block_size;
+            set(index, false);
         }
 
         /**
-         * Retrieves the block at the specified index
-         * @param index Index of the block to retrieve (block index)
-         * @return Block at the specified index
+         * Flips the bit at the specified index
+         * @param index Index of the bit to flip (bit index)
          */
-        [[nodiscard]] const BlockType& get_block(const size_type& index) const noexcept
+        void flip(const size_type& index) noexcept
         {
-            return m_data[index];
+            _write(index / m_block_size, static_cast<BlockType>(m_bits.get_block(index / m_block_size) ^ BlockType{ 1 } << index % m_block_size));
         }
 
         /**
-         * Retrieves the block at the specified index
-         * @param index Index of the block to retrieve (block index)
-         * @return Block at the specified index
+         * Sets all bits to the specified value
+         * @param value Value to set the bits to (bit value)
          */
-        [[nodiscard]] BlockType& get_block(const size_type& index) noexcept
+        void fill(const bool value) noexcept
         {
-            return m_data[index];
+            fill_range(0, size(), value);
         }
 
-
         /**
-         * Checks if all bits are set
-         * @return true if all bits are set, false otherwise
+         * Sets all bits
          */
-        [[nodiscard]] bool all() const noexcept
+        void set() noexcept
         {
-            // check all except the last one if the size is not divisible by m_block_size
-            for (size_type i = 0; i < m_storage_size - !!m_partial_size; ++i)
-            {
-                if (m_data[i] != (std::numeric_limits<BlockType>::max)())
-                    return false;
-            }
-            if (m_partial_size)
-            {
-                for (uint16_t i = 0; i < m_partial_size; ++i)
-                {
-                    if (!(m_data[m_size / m_block_size] & BlockType{ 1 } << i))
-                        return false;
-                }
-            }
-            return true;
+            fill(true);
         }
 
         /**
-         * Checks if any bit is set
-         * @return true if any bit is set, false otherwise
+         * Resets all bits
          */
-        [[nodiscard]] bool any() const noexcept
+        void reset() noexcept
         {
-            for (size_type i = 0; i < m_storage_size - !!m_partial_size; ++i)
-            {
-                if (m_data[i])
-                    return true;
-            }
-            if (m_partial_size)
-            {
-                for (uint16_t i = 0; i < m_partial_size; ++i)
-                {
-                    if (m_data[m_size / m_block_size] & BlockType{ 1 } << i)
-                        return true;
-                }
-            }
-            return false;
+            fill(false);
         }
 
         /**
-         * Checks if none of the bits are set
-         * @return true if none of the bits are set, false otherwise
-         */
-        [[nodiscard]] bool none() const noexcept
-        {
-            for (size_type i = 0; i < m_storage_size - !!m_partial_size; ++i)
-            {
-                if (m_data[i])
-                    return false;
-            }
-            if (m_partial_size)
-            {
-                for (uint16_t i = 0; i < m_partial_size; ++i)
-                {
-                    if (m_data[m_size / m_block_size] & BlockType{ 1 } << i)
-                        return false;
-                }
-            }
-            return true;
+         * Flips all bits
+         */
+        void flip() noexcept
+        {
+            flip_range(0, size());
         }
 
         /**
-         * Checks if all bits are reseted (none are set)
-         * @return true if all bits are reseted, false otherwise
+         * Sets the bits in the range [begin, end) to the specified value
+         * @param begin Begin of the range (bit index)
+         * @param end End of the range (bit index)
+         * @param value Value to set the bits to (bit value)
          */
-        [[nodiscard]] bool all_reset() const noexcept
+        void fill_range(const size_type& begin, const size_type& end, const bool value) noexcept
         {
-            return none();
+            _modify_range(begin, end, [value](const BlockType block, const BlockType mask) noexcept { return static_cast<BlockType>(value ? block | mask : block & ~mask); });
         }
 
         /**
-         * @return The number of set bits
+         * Sets the bits in the range [begin, end)
+         * @param begin Begin of the range (bit index)
+         * @param end End of the range (bit index)
          */
-        [[nodiscard]] size_type count() const noexcept
+        void set_range(const size_type& begin, const size_type& end) noexcept
         {
-            size_type count = 0;
-            for (size_type i = 0; i < m_storage_size; ++i)
-            {
-                BlockType j = m_data[i];
-                while (j)
-                {
-                    j &= j - 1;
-                    ++count;
-                }
-            }
-            return count;
+            fill_range(begin, end, true);
         }
 
         /**
-         * Checks if the bitset is empty
-         * @return true if the bitset is empty, false otherwise
+         * Resets the bits in the range [begin, end)
+         * @param begin Begin of the range (bit index)
+         * @param end End of the range (bit index)
          */
-        [[nodiscard]] bool empty() const noexcept
+        void reset_range(const size_type& begin, const size_type& end) noexcept
         {
-            return !m_size;
+            fill_range(begin, end, false);
         }
 
         /**
-         * Returns bitset's capacity in bits (capacity = number of bits that can be stored w/o reallocation)
-         * @return 
+         * Flips the bits in the range [begin, end)
+         * @param begin Begin of the range (bit index)
+         * @param end End of the range (bit index)
          */
-        [[nodiscard]] size_type capacity() const noexcept
+        void flip_range(const size_type& begin, const size_type& end) noexcept
         {
-	        return m_storage_size * m_block_size;
-		}
+            _modify_range(begin, end, [](const BlockType block, const BlockType mask) noexcept { return static_cast<BlockType>(block ^ mask); });
+        }
 
         /**
-         * Resizes the bitset to the specified size, but does not define values in the expanded area
-         * @param new_size New size of the bitset to resize to (bit count)
+         * Apply bitwise AND operation with another bitset instance
+         * @param other Other bitset instance to perform the operation with (must be the same size)
          */
-        void resize(const size_type& new_size)
+        tracked_bitset& operator&=(const dynamic_bitset<BlockType>& other) noexcept
         {
-            if (new_size == m_size)
-                return;
-
-            if (!new_size)
-            {
-                m_partial_size = m_storage_size = m_size = 0;
-                if (m_data)
-                {
-	                delete[] m_data;
-                }
-                m_data = nullptr;
-                return;
-            }
-
-            BlockType* new_data = new BlockType[new_size];
-            if (m_data)
-            {
-                if (m_storage_size < new_size)
-                {
-                    std::copy(m_data, m_data + m_storage_size, new_data);
-                    ::memset(new_data + m_storage_size, 0, (new_size - m_storage_size) * sizeof(BlockType)); // ensure 0 initialization
-                }
-                else
-                {
-                	std::copy(m_data, m_data + new_size, new_data);
-                }
-                delete[] m_data;
-            }
-            m_partial_size = new_size % m_block_size;
-            m_storage_size = new_size / m_block_size + !!m_partial_size;
-            m_size = new_size;
-            m_data = new_data;
+            for (size_type i = 0; i < m_bits.storage_size(); ++i)
+                _write(i, static_cast<BlockType>(m_bits.get_block(i) & other.get_block(i)));
+            return *this;
         }
 
         /**
-		 * Pushes back bit value to the bitset
-		 * @param value Value to push back (bit value)
-		 */
-        void push_back(const bool value)
+         * Apply bitwise OR operation with another bitset instance
+         * @param other Other bitset instance to perform the operation with (must be the same size)
+         */
+        tracked_bitset& operator|=(const dynamic_bitset<BlockType>& other) noexcept
         {
-            if (!(m_size++ % m_block_size))
-            {
-                m_partial_size = 0;
-                BlockType* new_data = new BlockType[++m_storage_size];
-                if (m_data)
-                {
-                    std::copy(m_data, m_data + m_storage_size, new_data);
-                    delete[] m_data;
-                }
-                *(new_data + m_storage_size - 1) = 0;
-                m_data = new_data;
-            }
-            else
-            {
-                ++m_partial_size;
-            }
-            if (value)
-				m_data[m_storage_size - 1] |= BlockType{ 1 } << m_partial_size - 1;
-            else
-				m_data[m_storage_size - 1] &= ~(BlockType{ 1 } << m_partial_size - 1);
+            for (size_type i = 0; i < m_bits.storage_size(); ++i)
+                _write(i, static_cast<BlockType>(m_bits.get_block(i) | other.get_block(i)));
+            return *this;
         }
 
         /**
-		 * Pops back bit value from the bitset
-		 */
-        void pop_back()
+         * Apply bitwise XOR operation with another bitset instance
+         * @param other Other bitset instance to perform the operation with (must be the same size)
+         */
+        tracked_bitset& operator^=(const dynamic_bitset<BlockType>& other) noexcept
         {
-            if (!(--m_size % m_block_size))
-            {
-                m_partial_size = 0;
-                --m_storage_size;
-                if (m_size)
-                {
-                    BlockType* new_data = new BlockType[m_storage_size];
-                    std::copy(m_data, m_data + m_storage_size, new_data);
-                    delete[] m_data;
-                    m_data = new_data;
-                }
-                else
-                {
-                    delete[] m_data;
-                    m_data = nullptr;
-                }
-                --m_size;
-            }
-            else
-            {
-                --m_partial_size;
-            }
+            for (size_type i = 0; i < m_bits.storage_size(); ++i)
+                _write(i, static_cast<BlockType>(m_bits.get_block(i) ^ other.get_block(i)));
+            return *this;
         }
 
         /**
-         * Inserts bit value at the specified index
-         * When inserting at the last position, for more info see push_back
-         * @param index Index to insert the value at (bit index)
-         * @param value Value to insert (bit value)
+         * Applies a patch, marking the blocks it changes
+         * @param patch Patch to apply (must be the size of the bitset)
          */
-        void insert(const size_type& index, const bool value)
+        void apply_patch(const bitset_patch<BlockType>& patch) noexcept
         {
-            [[unlikely]] if (index == m_size)
-            {
-                push_back(value);
-                return;
-            }
-
-            if (!(m_size % m_block_size))
-            {
-                BlockType* new_data = new BlockType[++m_storage_size];
-                ++m_partial_size;
-                ++m_size;
-                if (m_data)
-                {
-                    // copy everything prepending the bit
-                    for (size_type i = 0; i < index; ++i)
-                    {
-                        if (test(i))
-                            *(new_data + i / m_block_size) |= BlockType{ 1 } << i % m_block_size;
-                        else
-                            *(new_data + i / m_block_size) &= ~(BlockType{ 1 } << i % m_block_size);
-                    }
-                    // copy everything appending the bit
-                    for (size_type i = m_size - 1; ; --i)
-                    {
-                        const size_type next_i = i + 1;
-
-                        if (test(i))
-                            *(new_data + next_i / m_block_size) |= BlockType{ 1 } << next_i % m_block_size;
-                        else
-                            *(new_data + next_i / m_block_size) &= ~(BlockType{ 1 } << next_i % m_block_size);
-                        [[unlikely]] if (i == index)
-                            break;
-                    }
-                    delete[] m_data;
-                    m_data = new_data;
-                    set(index, value);
-                }
-                m_data = new_data;
-            }
-            else
+            const BlockType* word = patch.words.data();
+            for (const typename bitset_patch<BlockType>::run& run : patch.runs)
             {
-                const dynamic_bitset tmp_copy(*this);
-                // copy everything appending the bit
-                for (size_type i = m_size; ; --i)
-                {
-                    set(i + 1, tmp_copy.test(i));
-                    [[unlikely]] if (i == index) 
-						break;
-                }
-                set(index, value);
-                m_partial_size = ++m_size % m_block_size;
+                for (size_type i = 0; i < run.length; ++i)
+                    _write(run.offset + i, static_cast<BlockType>(m_bits.get_block(run.offset + i) ^ *word++));
             }
         }
 
         /**
-		 * Pushes back block value to the bitset. \n
-		 * If bitset's size is not a multiple of/divisible by block size, \n
-		 * additionally fully expands the not fully utilized block, \n
-		 * although values in the expanded area are in valid, but unspecified state by this function \n
-		 * e.g. (BlockType=uint64_t, m_size=65, push_back_block call -> {m_size 65 -> 128 [expansion of not fully utilized block] -> 192 [expansion to hold 1 additional block]})
-		 * @param block Block value to push back (block value)
-		 */
-        void push_back_block(const BlockType& block)
+         * Builds the patch of the changes since construction or the last patch taken, and marks all blocks clean
+         * Blocks changed back to their old value are left out.
+         * @return Patch turning the bits at the last patch into the current bits
+         */
+        [[nodiscard]] bitset_patch<BlockType> take_patch()
         {
-            m_size = ++m_storage_size * m_block_size;
-            m_partial_size = 0;
-            BlockType* new_data = new BlockType[m_storage_size];
-            if (m_data)
+            std::sort(m_original.begin(), m_original.end(), [](const std::pair<size_type, BlockType>& lhs, const std::pair<size_type, BlockType>& rhs) { return lhs.first < rhs.first; });
+
+            bitset_patch<BlockType> result;
+            result.size = size();
+            for (const auto& [index, original] : m_original)
             {
-                std::copy(m_data, m_data + m_storage_size, new_data);
-                delete[] m_data;
+                BlockType word = static_cast<BlockType>(original ^ m_bits.get_block(index));
+                if (index + 1 == m_bits.storage_size())
+                    word &= detail::mask_until<BlockType>(size());
+                if (word)
+                    result.append(index, word);
+                m_dirty.reset(index);
             }
-            m_data = new_data;
-            *(m_data + m_storage_size - 1) = block;
+            m_original.clear();
+            return result;
         }
 
+    private:
         /**
-         * Pops back block value from the bitset. \n
-         * If bitset's size is not a multiple of/divisible by block size, \n
-         * removes the not fully utilized block first \n
-         * e.g. (BlockType=uint64_t, m_size=65, pp_back_block call -> {m_size 65 -> 64 [removal of last, not fully utilized block]}
+         * Writes a block, marking it and saving its old value if it changes for the first time since the last patch
+         * @param index Index of the block (block index)
+         * @param block Value to write
          */
-        void pop_back_block()
+        void _write(const size_type& index, const BlockType block) noexcept
         {
-            m_size = --m_storage_size * m_block_size;
-            m_partial_size = 0;
-            BlockType* new_data = new BlockType[m_storage_size];
-            if (m_data)
+            BlockType& target = m_bits.get_block(index);
+            if (target == block)
+                return;
+            if (!m_dirty.test(index))
             {
-                std::copy(m_data, m_data + m_storage_size, new_data);
-                delete[] m_data;
+                m_dirty.set(index);
+                m_original.emplace_back(index, target);
             }
-            m_data = new_data;
+            target = block;
         }
 
         /**
-		 * Inserts block value at the specified index to the bitset.\n
-		 * When inserting at the last position, for more info see push_back_block
-		 * @param index Index to insert the value at (block index)
-		 * @param block Block value to insert (block value)
-		 */
-        void insert_block(const size_type& index, const BlockType& block)
+         * Writes op(block, mask) to every block overlapping a range, mask selecting the bits of the block in the range
+         * @tparam Op Type of the operation
+         * @param begin Begin of the range (bit index)
+         * @param end End of the range (bit index)
+         * @param op Operation returning the new block
+         */
+        template <typename Op>
+        void _modify_range(const size_type& begin, const size_type& end, Op op) noexcept
         {
-            if (index == m_storage_size)
-            {
-	            push_back_block(block);
+            if (begin >= end)
                 return;
-            }
 
-            BlockType* new_data = new BlockType[m_storage_size + 1];
-            if (m_data)
+            const size_type first = begin / m_block_size, last = (end - 1) / m_block_size;
+            for (size_type i = first; i <= last; ++i)
             {
-                // copy everything prepending the block
-                for (size_type i = 0; i < index; ++i)
-                    *(new_data + i) = *(m_data + i);
-
-                // copy everything appending the block
-                for (size_type i = m_storage_size - 1; ; --i)
-                {
-                    *(new_data + i + 1) = *(m_data + i);
-					[[unlikely]] if (i == index)
-						break;
-                }
-                delete[] m_data;
+                BlockType mask = (std::numeric_limits<BlockType>::max)();
+                if (i == first)
+                    mask &= detail::mask_from<BlockType>(begin);
+                if (i == last)
+                    mask &= detail::mask_until<BlockType>(end);
+                _write(i, op(m_bits.get_block(i), mask));
             }
-            
-            m_size += m_block_size;
-            ++m_storage_size;
-        	m_data = new_data;
-
-            *(new_data + index) = block;
         }
 
         /**
-         * Bit-length of the underlying type
-         */
-        static constexpr uint16_t m_block_size = sizeof(BlockType) * CHAR_BIT;
-        
-        /**
-         * Count of bits that are utilized in last dangling block, if any
+         * Size of a single block in bits
          */
-        uint8_t m_partial_size;
+        static constexpr size_type m_block_size = sizeof(BlockType) * CHAR_BIT;
 
         /**
-         * m_size of the bitset in blocks
+         * Bits
          */
-        size_type m_storage_size;
+        dynamic_bitset<BlockType> m_bits;
 
         /**
-         * m_size of the bitset in bits
+         * Blocks changed since the last patch (block index)
          */
-        size_type m_size;
-        
+        hierarchical_bitset<std::uint64_t> m_dirty;
+
         /**
-         * Underlying array of blocks containing the bits
+         * Indices and old values of the changed blocks, in the order of their first change
          */
-        alignas(BlockType) BlockType* m_data;
+        std::vector<std::pair<size_type, BlockType>> m_original;
     };
 };
 
+namespace std
+{
+    /**
+     * Hash support for woj::bitset
+     * @tparam BlockType Type of block used by the bitset
+     * @tparam Size Size of the bitset, in bits
+     */
+    template <woj::unsigned_integer BlockType, std::size_t Size>
+    struct hash<woj::bitset<BlockType, Size>>
+    {
+        [[nodiscard]] std::size_t operator()(const woj::bitset<BlockType, Size>& bitset) const noexcept
+        {
+            return bitset.hash();
+        }
+    };
+
+    /**
+     * Hash support for woj::dynamic_bitset
+     * @tparam BlockType Type of block used by the bitset
+     */
+    template <woj::unsigned_integer BlockType>
+    struct hash<woj::dynamic_bitset<BlockType>>
+    {
+        [[nodiscard]] std::size_t operator()(const woj::dynamic_bitset<BlockType>& bitset) const noexcept
+        {
+            return bitset.hash();
+        }
+    };
+}
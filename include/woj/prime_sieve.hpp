@@ -0,0 +1,224 @@
+#pragma once
+#include "bitset.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace woj
+{
+    /**
+     * Segmented sieve of Eratosthenes over odd numbers
+     * Segments are L1-sized bitsets, bit i of a segment stands for the odd number low + 2 * i. Every segment starts
+     * as a copy of a presieved wheel pattern of 3, 5, 7, 11 and 13, the remaining sieving primes are crossed off with
+     * the strided reset_range kernel. Counting uses the block popcount and iteration scans the set bits.
+     */
+    class prime_sieve
+    {
+    public:
+        // Type definitions
+        typedef std::uint64_t value_type;
+        typedef std::size_t size_type;
+
+        /**
+         * Count of odd numbers in one segment (bit count, 32 KiB)
+         */
+        static constexpr size_type segment_size = size_type{ 1 } << 18;
+
+        /**
+         * Segment type
+         */
+        typedef bitset<std::uint64_t, segment_size> segment_type;
+
+        /**
+         * Constructs a sieve of the numbers up to limit, computing the sieving primes up to its square root
+         * @param limit Largest number sieved (inclusive)
+         */
+        explicit prime_sieve(const value_type& limit) noexcept : m_limit(limit), m_pattern(m_period + segment_size + 64, true)
+        {
+            // Sieving primes, odd only, with a plain sieve of the numbers up to the square root
+            value_type root = static_cast<value_type>(std::sqrt(static_cast<double>(limit)));
+            while (root * root > limit)
+                --root;
+            while ((root + 1) * (root + 1) <= limit)
+                ++root;
+            dynamic_bitset<std::uint64_t> small(root / 2 + 1, true);
+            for (value_type i = 1; (2 * i + 1) * (2 * i + 1) <= root; ++i)
+            {
+                if (small.test(i))
+                    small.reset_range((2 * i + 1) * (2 * i + 1) / 2, small.size(), 2 * i + 1);
+            }
+            for (value_type i = 1; 2 * i + 1 <= root; ++i)
+            {
+                if (small.test(i) && 2 * i + 1 > m_wheel[std::size(m_wheel) - 1])
+                    m_primes.push_back(2 * i + 1);
+            }
+
+            // Wheel pattern, long enough to cover a segment from any phase of the period
+            for (const value_type prime : m_wheel)
+                m_pattern.reset_range(prime / 2, m_pattern.size(), prime);
+        }
+
+        /**
+         * Returns the largest number sieved
+         * @return Limit of the sieve (inclusive)
+         */
+        [[nodiscard]] value_type limit() const noexcept
+        {
+            return m_limit;
+        }
+
+        /**
+         * Counts the primes up to the limit, sieving contiguous runs of segments on separate threads
+         * @param threads Count of threads (0 uses the hardware concurrency)
+         * @return Count of primes not greater than limit()
+         */
+        [[nodiscard]] value_type count(unsigned threads = 0) const
+        {
+            if (m_limit < 2)
+                return 0;
+
+            const size_type segments = _segment_count();
+            if (!threads)
+                threads = (std::max)(1u, std::thread::hardware_concurrency());
+            threads = static_cast<unsigned>((std::min)(static_cast<size_type>(threads), segments));
+
+            std::vector<value_type> counts(threads);
+            const auto run = [&](const unsigned thread)
+            {
+                segment_type segment;
+                const size_type first = segments * thread / threads, last = segments * (thread + 1) / threads;
+                for (size_type i = first; i < last; ++i)
+                    counts[thread] += segment.count(0, _sieve(segment, i));
+            };
+
+            std::vector<std::thread> workers;
+            for (unsigned thread = 1; thread < threads; ++thread)
+                workers.emplace_back(run, thread);
+            run(0);
+            for (std::thread& worker : workers)
+                worker.join();
+
+            // 2 is the only prime the odd-only segments do not hold
+            value_type result = 1;
+            for (const value_type count : counts)
+                result += count;
+            return result;
+        }
+
+        /**
+         * Calls a function with every prime up to the limit, in increasing order
+         * @tparam F Type of the function
+         * @param f Function called as f(prime)
+         */
+        template <typename F>
+        void for_each(F f) const
+        {
+            if (m_limit < 2)
+                return;
+            f(value_type{ 2 });
+
+            segment_type segment;
+            const size_type segments = _segment_count();
+            for (size_type i = 0; i < segments; ++i)
+            {
+                const size_type length = _sieve(segment, i);
+                const value_type low = 2 * static_cast<value_type>(i) * segment_size + 1;
+                for (size_type block = 0; block * 64 < length; ++block)
+                {
+                    std::uint64_t bits = segment.get_block(block) & detail::mask_until<std::uint64_t>((std::min)(length, (block + 1) * 64));
+                    for (; bits; bits &= bits - 1)
+                        f(low + 2 * (block * 64 + static_cast<size_type>(std::countr_zero(bits))));
+                }
+            }
+        }
+
+        /**
+         * Collects the primes up to the limit
+         * @return Primes not greater than limit(), in increasing order
+         */
+        [[nodiscard]] std::vector<value_type> primes() const
+        {
+            std::vector<value_type> result;
+            for_each([&result](const value_type prime) { result.push_back(prime); });
+            return result;
+        }
+
+    private:
+        /**
+         * Returns the count of segments covering the odd numbers up to the limit
+         * @return Count of segments
+         */
+        [[nodiscard]] size_type _segment_count() const noexcept
+        {
+            const value_type odd = (m_limit + 1) / 2;
+            return static_cast<size_type>((odd + segment_size - 1) / segment_size);
+        }
+
+        /**
+         * Sieves one segment
+         * @param segment Segment to fill, bit i stands for the odd number 2 * (index * segment_size + i) + 1
+         * @param index Index of the segment
+         * @return Count of valid bits (the last segment ends at the limit)
+         */
+        size_type _sieve(segment_type& segment, const size_type& index) const noexcept
+        {
+            const value_type first = static_cast<value_type>(index) * segment_size;
+            const size_type length = static_cast<size_type>((std::min)(static_cast<value_type>(segment_size), (m_limit + 1) / 2 - first));
+
+            // Presieved copy of the wheel pattern at the phase of the segment
+            const size_type phase = static_cast<size_type>(first % m_period);
+            for (size_type block = 0; block < segment_type::storage_size(); ++block)
+                segment.get_block(block) = m_pattern.get_bits(phase + block * 64, 64);
+
+            for (const value_type prime : m_primes)
+            {
+                const value_type square = prime * prime / 2;
+                if (square >= first + length)
+                    break;
+
+                // First odd multiple in the segment, consecutive odd multiples are prime bits apart
+                value_type start = square;
+                if (start < first)
+                    start = first + (prime - (first - square) % prime) % prime;
+                segment.reset_range(static_cast<size_type>(start - first), length, static_cast<size_type>(prime));
+            }
+
+            // The pattern crosses off the wheel primes themselves and does not know that 1 is not prime
+            if (!index)
+            {
+                segment.reset(0);
+                for (const value_type prime : m_wheel)
+                    segment.set(static_cast<size_type>(prime / 2));
+            }
+            return length;
+        }
+
+        /**
+         * Primes presieved by the wheel pattern
+         */
+        static constexpr value_type m_wheel[] = { 3, 5, 7, 11, 13 };
+
+        /**
+         * Period of the wheel pattern over odd numbers (bit count)
+         */
+        static constexpr size_type m_period = 3 * 5 * 7 * 11 * 13;
+
+        /**
+         * Largest number sieved (inclusive)
+         */
+        value_type m_limit;
+
+        /**
+         * Sieving primes above the wheel primes, up to the square root of the limit
+         */
+        std::vector<value_type> m_primes;
+
+        /**
+         * Wheel pattern over odd numbers from 1, repeated past one segment
+         */
+        dynamic_bitset<std::uint64_t> m_pattern;
+    };
+}
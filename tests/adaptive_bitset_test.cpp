@@ -0,0 +1,222 @@
+#include "test.hpp"
+#include "woj/bitset.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+// adaptive_bitset checked against a std::vector<bool> model in both representations and across the switches
+
+namespace
+{
+    std::mt19937_64 rng(2026);
+
+    // Count above which a sparse set turns dense, a dense set turns sparse below half of it
+    std::size_t threshold(const std::size_t size)
+    {
+        return size / (sizeof(std::size_t) * CHAR_BIT);
+    }
+
+    template <typename BlockType>
+    bool matches(const woj::adaptive_bitset<BlockType>& bits, const std::vector<bool>& model)
+    {
+        if (bits.size() != model.size() || bits.count() != static_cast<std::size_t>(std::count(model.begin(), model.end(), true)))
+            return false;
+        if (bits.any() == bits.none() || bits.any() != (bits.count() != 0))
+            return false;
+        if (!bits.is_dense() && bits.indices().size() != bits.count())
+            return false;
+        const woj::dynamic_bitset<BlockType> copy = bits.to_dynamic_bitset();
+        if (copy.size() != model.size())
+            return false;
+
+        std::size_t next = model.size();
+        for (std::size_t i = model.size(); i-- > 0;)
+        {
+            if (model[i])
+                next = i;
+            if (bits.test(i) != model[i] || bits[i] != model[i] || copy.test(i) != model[i] || bits.find_next(i) != next)
+                return false;
+        }
+        return bits.find_first() == next && bits.find_next(model.size()) == model.size();
+    }
+
+    /**
+     * Builds a set of the specified representation with random bits, dense sets hold far more bits than the threshold
+     */
+    template <typename BlockType>
+    woj::adaptive_bitset<BlockType> random_set(const std::size_t size, const bool dense, std::vector<bool>& model)
+    {
+        woj::adaptive_bitset<BlockType> bits(size);
+        model.assign(size, false);
+        const std::size_t target = dense ? size / 3 : threshold(size) / 2;
+        for (std::size_t i = 0; i < target; ++i)
+        {
+            const std::size_t index = rng() % size;
+            bits.set(index);
+            model[index] = true;
+        }
+        return bits;
+    }
+
+    // Growing past the threshold turns the set dense, shrinking below half of it turns it sparse again
+    template <typename BlockType>
+    void switching(const std::size_t size)
+    {
+        woj::adaptive_bitset<BlockType> bits(size);
+        std::vector<bool> model(size);
+        WOJ_CHECK(!bits.is_dense() && matches(bits, model));
+
+        std::vector<std::size_t> order(size);
+        for (std::size_t i = 0; i < size; ++i)
+            order[i] = i;
+        std::shuffle(order.begin(), order.end(), rng);
+
+        bool switched = true;
+        for (std::size_t i = 0; i <= threshold(size); ++i)
+        {
+            switched &= !bits.is_dense();
+            bits.set(order[i]);
+            model[order[i]] = true;
+        }
+        WOJ_CHECK(switched && bits.is_dense() && bits.indices().empty());
+        WOJ_CHECK(matches(bits, model));
+
+        // Dense sets tolerate counts down to half of the threshold
+        bool kept = true;
+        std::size_t count = threshold(size) + 1;
+        for (; count > threshold(size) / 2; --count)
+        {
+            kept &= bits.is_dense();
+            bits.flip(order[count - 1]);
+            model[order[count - 1]] = false;
+        }
+        WOJ_CHECK(kept && bits.is_dense() && bits.count() == threshold(size) / 2);
+        bits.reset(order[--count]);
+        model[order[count]] = false;
+        WOJ_CHECK(!bits.is_dense() && bits.count() == count);
+        WOJ_CHECK(matches(bits, model));
+
+        // The representations are interchangeable for the single-bit operations
+        for (int op = 0; op < 400; ++op)
+        {
+            const std::size_t index = rng() % size;
+            const bool value = rng() % 4 != 0;
+            bits.set(index, value);
+            model[index] = value;
+        }
+        WOJ_CHECK(bits.is_dense() && matches(bits, model));
+
+        bits.reset();
+        std::fill(model.begin(), model.end(), false);
+        WOJ_CHECK(!bits.is_dense() && matches(bits, model));
+    }
+
+    // Construction from a dynamic_bitset picks the representation fitting the count and ignores the bits past the size
+    template <typename BlockType>
+    void construction(const std::size_t size, const bool dense)
+    {
+        constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+        std::vector<bool> model;
+        const woj::dynamic_bitset<BlockType> source_bits = random_set<BlockType>(size, dense, model).to_dynamic_bitset();
+        woj::dynamic_bitset<BlockType> source = source_bits;
+        if (size % block_size)
+            source.get_block(size / block_size) |= static_cast<BlockType>(~BlockType{ 0 } << size % block_size);
+
+        const woj::adaptive_bitset<BlockType> bits(source);
+        WOJ_CHECK(bits.is_dense() == dense && matches(bits, model));
+    }
+
+    template <typename Op>
+    std::vector<bool> combined(const std::vector<bool>& lhs, const std::vector<bool>& rhs, Op op)
+    {
+        std::vector<bool> result(lhs.size());
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+            result[i] = op(lhs[i], rhs[i]);
+        return result;
+    }
+
+    // &, |, ^, == and intersects for every pair of representations
+    template <typename BlockType>
+    void operators(const std::size_t size)
+    {
+        for (const bool lhs_dense : { false, true })
+        {
+            for (const bool rhs_dense : { false, true })
+            {
+                std::vector<bool> lhs_model, rhs_model;
+                const woj::adaptive_bitset<BlockType> lhs = random_set<BlockType>(size, lhs_dense, lhs_model);
+                const woj::adaptive_bitset<BlockType> rhs = random_set<BlockType>(size, rhs_dense, rhs_model);
+                WOJ_CHECK(lhs.is_dense() == lhs_dense && rhs.is_dense() == rhs_dense);
+
+                WOJ_CHECK(matches(lhs & rhs, combined(lhs_model, rhs_model, std::bit_and<>())));
+                WOJ_CHECK(matches(lhs | rhs, combined(lhs_model, rhs_model, std::bit_or<>())));
+                WOJ_CHECK(matches(lhs ^ rhs, combined(lhs_model, rhs_model, std::bit_xor<>())));
+                WOJ_CHECK((lhs ^ lhs).none() && (lhs & lhs) == lhs && (lhs | lhs) == lhs);
+
+                const std::vector<bool> common = combined(lhs_model, rhs_model, std::bit_and<>());
+                WOJ_CHECK(lhs.intersects(rhs) == std::any_of(common.begin(), common.end(), [](const bool bit) { return bit; }));
+                WOJ_CHECK(lhs.intersects(rhs) == rhs.intersects(lhs));
+                WOJ_CHECK((lhs == rhs) == (lhs_model == rhs_model) && (lhs == lhs));
+
+            }
+        }
+    }
+
+    // Equal bits held in different representations compare equal and combine like the model
+    template <typename BlockType>
+    void representations(const std::size_t size)
+    {
+        // A sparse set at the threshold, and a dense one with the same bits that went past the threshold and back
+        std::vector<bool> model(size);
+        woj::adaptive_bitset<BlockType> sparse(size);
+        std::size_t index = 0;
+        while (sparse.count() < threshold(size))
+        {
+            index = rng() % size;
+            sparse.set(index);
+            model[index] = true;
+        }
+        woj::adaptive_bitset<BlockType> dense = sparse;
+        const std::size_t extra = static_cast<std::size_t>(std::find(model.begin(), model.end(), false) - model.begin());
+        dense.set(extra);
+        WOJ_CHECK(dense.is_dense() && !(dense == sparse));
+        dense.reset(extra);
+        WOJ_CHECK(!sparse.is_dense() && dense.is_dense());
+        WOJ_CHECK(sparse == dense && dense == sparse && matches(dense, model) && matches(sparse, model));
+        WOJ_CHECK((sparse & dense) == sparse && (dense | sparse) == dense && (sparse ^ dense).none() && sparse.intersects(dense));
+
+        dense.flip(index);
+        WOJ_CHECK(!(sparse == dense) && !(dense == sparse));
+        const woj::adaptive_bitset<BlockType> difference = sparse ^ dense;
+        WOJ_CHECK(difference.count() == 1 && difference.find_first() == index);
+    }
+
+    template <typename BlockType>
+    void run()
+    {
+        for (const std::size_t size : { 200, 1000, 4097, 20000 })
+        {
+            switching<BlockType>(size);
+            construction<BlockType>(size, false);
+            construction<BlockType>(size, true);
+            operators<BlockType>(size);
+            representations<BlockType>(size);
+        }
+        WOJ_CHECK(woj::adaptive_bitset<BlockType>(1).find_first() == 1);
+    }
+}
+
+int main()
+{
+    run<std::uint8_t>();
+    run<std::uint16_t>();
+    run<std::uint32_t>();
+    run<std::uint64_t>();
+    return woj::test::report();
+}
@@ -0,0 +1,318 @@
+#include "test.hpp"
+#include "woj/bitset.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+// bit_matrix checked against a row-major std::vector<std::vector<bool>> model
+
+namespace
+{
+    std::mt19937_64 rng(2026);
+
+    using model = std::vector<std::vector<bool>>;
+
+    /**
+     * Fills a matrix with random elements, each one set with the specified probability
+     * @return Model of the matrix
+     */
+    template <typename BlockType>
+    model randomize(woj::bit_matrix<BlockType>& matrix, const double density = 0.5)
+    {
+        std::bernoulli_distribution element(density);
+        model result(matrix.rows(), std::vector<bool>(matrix.cols()));
+        for (std::size_t i = 0; i < matrix.rows(); ++i)
+        {
+            for (std::size_t j = 0; j < matrix.cols(); ++j)
+            {
+                result[i][j] = element(rng);
+                matrix.set(i, j, result[i][j]);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Compares a matrix with its model element by element, and checks that the bits past the last column are reset
+     */
+    template <typename BlockType>
+    bool matches(const woj::bit_matrix<BlockType>& matrix, const model& expected)
+    {
+        constexpr std::size_t block_size = sizeof(BlockType) * 8;
+
+        if (matrix.rows() != expected.size())
+            return false;
+        for (std::size_t i = 0; i < matrix.rows(); ++i)
+        {
+            const auto row = matrix[i];
+            if (row.size() != matrix.cols() || expected[i].size() != matrix.cols())
+                return false;
+            for (std::size_t j = 0; j < matrix.cols(); ++j)
+            {
+                if (matrix.test(i, j) != expected[i][j])
+                    return false;
+            }
+            if (matrix.cols() % block_size && row.get_block(matrix.cols() / block_size) >> matrix.cols() % block_size)
+                return false;
+        }
+        return true;
+    }
+
+    model naive_multiply(const model& lhs, const model& rhs, const std::size_t inner, const std::size_t cols)
+    {
+        model result(lhs.size(), std::vector<bool>(cols));
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+        {
+            for (std::size_t j = 0; j < cols; ++j)
+            {
+                bool sum = false;
+                for (std::size_t k = 0; k < inner; ++k)
+                    sum ^= lhs[i][k] && rhs[k][j];
+                result[i][j] = sum;
+            }
+        }
+        return result;
+    }
+
+    model naive_transpose(const model& matrix, const std::size_t rows, const std::size_t cols)
+    {
+        model result(cols, std::vector<bool>(rows));
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            for (std::size_t j = 0; j < cols; ++j)
+                result[j][i] = matrix[i][j];
+        }
+        return result;
+    }
+
+    /**
+     * Rank of a model matrix by Gaussian elimination over its elements
+     */
+    std::size_t naive_rank(model matrix, const std::size_t cols)
+    {
+        std::size_t rank = 0;
+        for (std::size_t col = 0; col < cols && rank < matrix.size(); ++col)
+        {
+            std::size_t pivot = rank;
+            while (pivot < matrix.size() && !matrix[pivot][col])
+                ++pivot;
+            if (pivot == matrix.size())
+                continue;
+            std::swap(matrix[rank], matrix[pivot]);
+            for (std::size_t row = 0; row < matrix.size(); ++row)
+            {
+                if (row != rank && matrix[row][col])
+                {
+                    for (std::size_t j = 0; j < cols; ++j)
+                        matrix[row][j] = matrix[row][j] != matrix[rank][j];
+                }
+            }
+            ++rank;
+        }
+        return rank;
+    }
+
+    /**
+     * Product of a model matrix and a vector
+     */
+    template <typename Vector>
+    std::vector<bool> naive_apply(const model& matrix, const Vector& x, const std::size_t cols)
+    {
+        std::vector<bool> result(matrix.size());
+        for (std::size_t i = 0; i < matrix.size(); ++i)
+        {
+            bool sum = false;
+            for (std::size_t j = 0; j < cols; ++j)
+                sum ^= matrix[i][j] && x.test(j);
+            result[i] = sum;
+        }
+        return result;
+    }
+
+    // Dimensions around the block, table (8 bits), pass (64 columns) and tile boundaries
+    constexpr std::size_t dimensions[] = { 1, 7, 8, 9, 63, 64, 65, 100, 130, 200 };
+
+    template <typename BlockType>
+    void multiply()
+    {
+        using matrix = woj::bit_matrix<BlockType>;
+
+        for (const std::size_t rows : dimensions)
+        {
+            for (const std::size_t inner : dimensions)
+            {
+                const std::size_t cols = dimensions[rng() % std::size(dimensions)];
+                matrix lhs(rows, inner), rhs(inner, cols);
+                const model lhs_model = randomize(lhs), rhs_model = randomize(rhs);
+                WOJ_CHECK(matches(lhs * rhs, naive_multiply(lhs_model, rhs_model, inner, cols)));
+            }
+        }
+
+        // Wide right operands cross the 128-byte column tiles, long inner dimensions take several passes
+        for (const std::size_t cols : { 1023, 1024, 1025, 1100 })
+        {
+            matrix lhs(13, 300), rhs(300, cols);
+            const model lhs_model = randomize(lhs, 0.3), rhs_model = randomize(rhs);
+            WOJ_CHECK(matches(lhs * rhs, naive_multiply(lhs_model, rhs_model, 300, cols)));
+        }
+
+        // Identity is neutral on both sides
+        matrix square(130, 130);
+        const model square_model = randomize(square);
+        WOJ_CHECK(matches(square * matrix::identity(130), square_model));
+        WOJ_CHECK(matches(matrix::identity(130) * square, square_model));
+
+        // (A B)^T = B^T A^T
+        matrix lhs(70, 90), rhs(90, 65);
+        randomize(lhs);
+        randomize(rhs);
+        WOJ_CHECK((lhs * rhs).transpose() == rhs.transpose() * lhs.transpose());
+    }
+
+    template <typename BlockType>
+    void transpose()
+    {
+        using matrix = woj::bit_matrix<BlockType>;
+
+        for (const std::size_t rows : dimensions)
+        {
+            for (const std::size_t cols : dimensions)
+            {
+                matrix original(rows, cols);
+                const model original_model = randomize(original);
+                const matrix transposed = original.transpose();
+                WOJ_CHECK(transposed.rows() == cols && transposed.cols() == rows);
+                WOJ_CHECK(matches(transposed, naive_transpose(original_model, rows, cols)));
+                WOJ_CHECK(transposed.transpose() == original);
+            }
+        }
+
+        matrix empty(0, 5);
+        WOJ_CHECK(empty.transpose().rows() == 5 && empty.transpose().cols() == 0);
+    }
+
+    /**
+     * Solves random systems with the dense elimination and with the structured pre-pass
+     * @param density Probability of every element of A to be set
+     */
+    template <typename BlockType>
+    void solve(const std::size_t rows, const std::size_t cols, const double density)
+    {
+        using matrix = woj::bit_matrix<BlockType>;
+        using vector = woj::dynamic_bitset<BlockType>;
+
+        matrix a(rows, cols);
+        const model a_model = randomize(a, density);
+        const std::size_t rank = naive_rank(a_model, cols);
+        WOJ_CHECK(a.rank() == rank);
+
+        // b = A x0 is always consistent
+        vector x0(cols);
+        for (std::size_t j = 0; j < cols; ++j)
+            x0.set(j, rng() & 1);
+        const std::vector<bool> image = naive_apply(a_model, x0, cols);
+        vector consistent(rows);
+        for (std::size_t i = 0; i < rows; ++i)
+            consistent.set(i, image[i]);
+
+        // A random b is inconsistent exactly when appending it raises the rank
+        vector random(rows);
+        model augmented = a_model;
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            random.set(i, rng() & 1);
+            augmented[i].push_back(random.test(i));
+        }
+        const bool solvable = naive_rank(augmented, cols + 1) == rank;
+
+        for (const bool structured : { false, true })
+        {
+            const auto x = a.solve(consistent, structured);
+            WOJ_CHECK(x.has_value());
+            if (x)
+                WOJ_CHECK(x->size() == cols && naive_apply(a_model, *x, cols) == image);
+
+            const auto y = a.solve(random, structured);
+            WOJ_CHECK(y.has_value() == solvable);
+            if (y)
+            {
+                bool satisfied = y->size() == cols;
+                const std::vector<bool> product = naive_apply(a_model, *y, cols);
+                for (std::size_t i = 0; i < rows; ++i)
+                    satisfied &= product[i] == random.test(i);
+                WOJ_CHECK(satisfied);
+            }
+        }
+
+        // The nullspace basis has cols - rank independent vectors, each one mapped to zero
+        const matrix basis = a.nullspace();
+        WOJ_CHECK(basis.rows() == cols - rank && basis.cols() == cols);
+        bool annihilated = true;
+        for (std::size_t k = 0; k < basis.rows(); ++k)
+        {
+            const std::vector<bool> product = naive_apply(a_model, basis[k], cols);
+            annihilated &= std::find(product.begin(), product.end(), true) == product.end();
+        }
+        WOJ_CHECK(annihilated);
+        WOJ_CHECK(basis.rank() == basis.rows());
+
+        // Reduced row echelon form keeps the row space
+        const matrix reduced = a.rref();
+        WOJ_CHECK(reduced.rank() == rank && (reduced * basis.transpose()).rank() == 0);
+    }
+
+    template <typename BlockType>
+    void elimination()
+    {
+        // Dense systems of every shape, then sparse ones where the structured pre-pass removes most rows
+        for (const std::size_t rows : { 1, 7, 63, 64, 65, 100, 130 })
+        {
+            for (const std::size_t cols : { 1, 9, 63, 64, 65, 130 })
+            {
+                solve<BlockType>(rows, cols, 0.5);
+                solve<BlockType>(rows, cols, 0.03);
+            }
+        }
+        for (int round = 0; round < 20; ++round)
+        {
+            solve<BlockType>(150, 200, 0.015);
+            solve<BlockType>(200, 150, 0.015);
+            solve<BlockType>(100, 100, 0.02);
+        }
+
+        // Rank deficient dense systems, built from duplicated rows
+        woj::bit_matrix<BlockType> a(70, 67);
+        const model a_model = randomize(a);
+        for (std::size_t i = 35; i < 70; ++i)
+            a[i].assign(a[i - 35]);
+        WOJ_CHECK(a.rank() == naive_rank(model(a_model.begin(), a_model.begin() + 35), 67));
+        WOJ_CHECK(a.nullspace().rows() == 67 - a.rank());
+        woj::dynamic_bitset<BlockType> b(70);
+        b.set(0);
+        WOJ_CHECK(!a.solve(b).has_value() && !a.solve(b, true).has_value());
+        b.set(35);
+        WOJ_CHECK(a.solve(b).has_value() && a.solve(b, true).has_value());
+    }
+
+    template <typename BlockType>
+    void run()
+    {
+        multiply<BlockType>();
+        transpose<BlockType>();
+        elimination<BlockType>();
+    }
+}
+
+int main()
+{
+    run<std::uint8_t>();
+    run<std::uint16_t>();
+    run<std::uint32_t>();
+    run<std::uint64_t>();
+    return woj::test::report();
+}
@@ -0,0 +1,224 @@
+#include "test.hpp"
+#include "woj/bitset.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+// diff, apply_patch and tracked_bitset checked against a block-by-block comparison of the bitsets
+
+namespace
+{
+    std::mt19937_64 rng(2026);
+
+    template <typename BlockType>
+    woj::dynamic_bitset<BlockType> random_bits(const std::size_t size)
+    {
+        woj::dynamic_bitset<BlockType> bits(size);
+        for (std::size_t i = 0; i < bits.storage_size(); ++i)
+            bits.get_block(i) = static_cast<BlockType>(rng());
+        return bits;
+    }
+
+    /**
+     * Checks that a patch holds one non-zero word per block differing below the size, in runs of consecutive blocks
+     */
+    template <typename BlockType>
+    bool well_formed(const woj::bitset_patch<BlockType>& patch, const woj::dynamic_bitset<BlockType>& from, const woj::dynamic_bitset<BlockType>& to)
+    {
+        constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+        std::vector<std::size_t> changed;
+        for (std::size_t i = 0; i < from.size(); ++i)
+        {
+            if (from.test(i) != to.test(i) && (changed.empty() || changed.back() != i / block_size))
+                changed.push_back(i / block_size);
+        }
+
+        std::size_t word = 0, previous_end = 0;
+        for (std::size_t r = 0; r < patch.runs.size(); ++r)
+        {
+            const auto& run = patch.runs[r];
+            if (!run.length || (r && run.offset <= previous_end))
+                return false;
+            for (std::size_t i = 0; i < run.length; ++i, ++word)
+            {
+                if (word >= changed.size() || changed[word] != run.offset + i || !patch.words[word])
+                    return false;
+            }
+            previous_end = run.offset + run.length;
+        }
+        return patch.size == from.size() && word == changed.size() && patch.words.size() == changed.size()
+            && patch.byte_size() == sizeof(patch.size) + patch.runs.size() * sizeof(patch.runs[0]) + patch.words.size() * sizeof(BlockType);
+    }
+
+    template <typename BlockType>
+    bool same_patch(const woj::bitset_patch<BlockType>& lhs, const woj::bitset_patch<BlockType>& rhs)
+    {
+        if (lhs.size != rhs.size || lhs.runs.size() != rhs.runs.size() || lhs.words != rhs.words)
+            return false;
+        for (std::size_t i = 0; i < lhs.runs.size(); ++i)
+        {
+            if (lhs.runs[i].offset != rhs.runs[i].offset || lhs.runs[i].length != rhs.runs[i].length)
+                return false;
+        }
+        return true;
+    }
+
+    // diff followed by apply_patch turns from into to, for no, scattered, clustered and tail-only changes
+    template <typename BlockType>
+    void patches(const std::size_t size)
+    {
+        constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+        const woj::dynamic_bitset<BlockType> from = random_bits<BlockType>(size);
+        for (int round = 0; round < 6; ++round)
+        {
+            woj::dynamic_bitset<BlockType> to = from;
+            switch (round)
+            {
+            case 0:
+                break;
+            case 1:
+                to.flip(size - 1);
+                break;
+            case 2:
+                for (int i = 0; i < 20; ++i)
+                    to.flip(rng() % size);
+                break;
+            case 3:
+            {
+                const std::size_t begin = rng() % size;
+                to.flip_range(begin, (std::min)(size, begin + 5 * block_size));
+                break;
+            }
+            case 4:
+                to = random_bits<BlockType>(size);
+                break;
+            default:
+                // Bits past the size are not part of the delta
+                if (size % block_size)
+                    to.get_block(size / block_size) ^= static_cast<BlockType>(~BlockType{ 0 } << size % block_size);
+                break;
+            }
+
+            const woj::bitset_patch<BlockType> patch = woj::diff(from, to);
+            WOJ_CHECK(well_formed(patch, from, to));
+            WOJ_CHECK(patch.words.empty() == (from == to));
+
+            woj::dynamic_bitset<BlockType> patched = from;
+            woj::apply_patch(patched, patch);
+            WOJ_CHECK(patched == to);
+
+            // The patch keeps the tail block of the patched bitset past the size
+            if (size % block_size)
+            {
+                const BlockType tail = static_cast<BlockType>(~BlockType{ 0 } << size % block_size);
+                WOJ_CHECK((patched.get_block(size / block_size) & tail) == (from.get_block(size / block_size) & tail));
+            }
+
+            // The reverse patch is the same set of XOR words
+            WOJ_CHECK(same_patch(woj::diff(to, from), patch));
+        }
+    }
+
+    // take_patch returns what diff of the bits at the last patch and the current bits would
+    template <typename BlockType>
+    void tracking(const std::size_t size)
+    {
+        constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+        woj::tracked_bitset<BlockType> bits(random_bits<BlockType>(size));
+        woj::dynamic_bitset<BlockType> base = bits.bits();
+        WOJ_CHECK(bits.size() == size && bits.dirty_blocks().none() && bits.take_patch().words.empty());
+
+        for (int round = 0; round < 40; ++round)
+        {
+            const int writes = round % 5 == 4 ? 0 : 1 + static_cast<int>(rng() % 8);
+            for (int op = 0; op < writes; ++op)
+            {
+                const std::size_t index = rng() % size;
+                std::size_t begin = rng() % (size + 1), end = rng() % (size + 1);
+                if (begin > end)
+                    std::swap(begin, end);
+                switch (rng() % 9)
+                {
+                case 0:
+                    bits.set(index);
+                    break;
+                case 1:
+                    bits.reset(index);
+                    break;
+                case 2:
+                    bits.flip(index);
+                    break;
+                case 3:
+                    bits.set_block(index / block_size, static_cast<BlockType>(rng()));
+                    break;
+                case 4:
+                    bits.fill_range(begin, end, rng() & 1);
+                    break;
+                case 5:
+                    bits.flip_range(begin, end);
+                    break;
+                case 6:
+                    bits ^= random_bits<BlockType>(size);
+                    break;
+                case 7:
+                    // A flip and its undo leave the block as it was, so it must not be in the patch
+                    bits.flip(index);
+                    bits.flip(index);
+                    break;
+                default:
+                    if (rng() & 1)
+                        bits &= random_bits<BlockType>(size);
+                    else
+                        bits |= random_bits<BlockType>(size);
+                    break;
+                }
+            }
+
+            bool marked = true;
+            for (std::size_t i = 0; i < base.storage_size(); ++i)
+                marked &= bits.get_block(i) == base.get_block(i) || bits.dirty_blocks().test(i);
+            WOJ_CHECK(marked);
+
+            const woj::bitset_patch<BlockType> expected = woj::diff(base, bits.bits());
+            const woj::bitset_patch<BlockType> patch = bits.take_patch();
+            WOJ_CHECK(same_patch(patch, expected) && well_formed(patch, base, bits.bits()));
+            WOJ_CHECK(bits.dirty_blocks().none() && bits.take_patch().words.empty());
+
+            woj::apply_patch(base, patch);
+            WOJ_CHECK(base == bits.bits());
+            base = bits.bits();
+        }
+
+        // apply_patch of a tracked bitset marks the blocks it changes
+        const woj::dynamic_bitset<BlockType> target = random_bits<BlockType>(size);
+        bits.apply_patch(woj::diff(bits.bits(), target));
+        WOJ_CHECK(bits.bits() == target && same_patch(bits.take_patch(), woj::diff(base, target)));
+    }
+
+    template <typename BlockType>
+    void run()
+    {
+        for (const std::size_t size : { 1, 7, 8, 9, 63, 64, 65, 200, 1000, 5000, 40001 })
+        {
+            patches<BlockType>(size);
+            tracking<BlockType>(size);
+        }
+    }
+}
+
+int main()
+{
+    run<std::uint8_t>();
+    run<std::uint16_t>();
+    run<std::uint32_t>();
+    run<std::uint64_t>();
+    return woj::test::report();
+}
@@ -0,0 +1,718 @@
+#include "test.hpp"
+#include "woj/bitset.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <climits>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Behaviour of bitset and dynamic_bitset checked against a std::vector<bool> model
+
+namespace
+{
+    std::mt19937_64 rng(2026);
+
+    // Sizes around the block boundaries of every block type
+    constexpr std::size_t sizes[] = { 1, 7, 8, 9, 63, 64, 65, 127, 128, 129, 200, 1000 };
+
+    /**
+     * Fills a bitset with random bits and sets the unspecified bits past its size
+     * @return Model of the bitset
+     */
+    template <typename Set>
+    std::vector<bool> randomize(Set& bits)
+    {
+        using block_type = typename Set::block_type;
+        constexpr std::size_t block_size = sizeof(block_type) * CHAR_BIT;
+
+        std::vector<bool> model(bits.size());
+        for (std::size_t i = 0; i < bits.size(); ++i)
+        {
+            model[i] = rng() & 1;
+            bits.set(i, model[i]);
+        }
+        if (bits.size() % block_size)
+            bits.data()[bits.size() / block_size] |= static_cast<block_type>(~block_type{ 0 } << bits.size() % block_size);
+        return model;
+    }
+
+    /**
+     * Compares a bitset with its model bit by bit
+     */
+    template <typename Set>
+    bool matches(const Set& bits, const std::vector<bool>& model)
+    {
+        if (bits.size() != model.size())
+            return false;
+        for (std::size_t i = 0; i < model.size(); ++i)
+        {
+            if (bits.test(i) != model[i])
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * Assigns the bits of a model to a bitset of its size and sets the unspecified bits past its size
+     */
+    template <typename Set>
+    void assign(Set& bits, const std::vector<bool>& model)
+    {
+        using block_type = typename Set::block_type;
+        constexpr std::size_t block_size = sizeof(block_type) * CHAR_BIT;
+
+        bits.reset();
+        for (std::size_t i = 0; i < model.size(); ++i)
+            bits.set(i, model[i]);
+        if (bits.size() % block_size)
+            bits.data()[bits.size() / block_size] |= static_cast<block_type>(~block_type{ 0 } << bits.size() % block_size);
+    }
+
+    std::vector<bool> shifted_right(const std::vector<bool>& model, const std::size_t shift)
+    {
+        std::vector<bool> result(model.size());
+        for (std::size_t i = 0; i + shift < model.size(); ++i)
+            result[i] = model[i + shift];
+        return result;
+    }
+
+    std::vector<bool> shifted_left(const std::vector<bool>& model, const std::size_t shift)
+    {
+        std::vector<bool> result(model.size());
+        for (std::size_t i = shift; i < model.size(); ++i)
+            result[i] = model[i - shift];
+        return result;
+    }
+
+    // Shifts by multiples of the block size and by the whole size, with the tail bits set
+    template <typename Set>
+    void shifts(Set bits)
+    {
+        const std::size_t block_size = sizeof(typename Set::block_type) * CHAR_BIT;
+        const std::size_t amounts[] = { 0, 1, 3, block_size - 1, block_size, block_size + 1, 2 * block_size, bits.size() - 1, bits.size(), bits.size() + 5 };
+        for (const std::size_t shift : amounts)
+        {
+            const std::vector<bool> model = randomize(bits);
+            WOJ_CHECK(matches(bits >> shift, shifted_right(model, shift)));
+            WOJ_CHECK(matches(bits << shift, shifted_left(model, shift)));
+            Set copy = bits;
+            copy >>= shift;
+            WOJ_CHECK(matches(copy, shifted_right(model, shift)));
+            copy = bits;
+            copy <<= shift;
+            WOJ_CHECK(matches(copy, shifted_left(model, shift)));
+        }
+    }
+
+    // ==, !=, count and the string conversions only read the bits below the size
+    template <typename Set>
+    void tail_reads(Set bits)
+    {
+        const std::vector<bool> model = randomize(bits);
+        Set clean = bits;
+        clean.reset();
+        std::string expected;
+        for (std::size_t i = 0; i < model.size(); ++i)
+        {
+            clean.set(i, model[i]);
+            expected += model[i] ? '1' : '0';
+        }
+
+        WOJ_CHECK(bits == clean && !(bits != clean));
+        WOJ_CHECK(bits.count() == static_cast<std::size_t>(std::count(model.begin(), model.end(), true)));
+        if constexpr (requires { bits.to_string(); })
+            WOJ_CHECK(bits.to_string() == expected);
+        const std::unique_ptr<char[]> c_string(bits.to_c_string());
+        WOJ_CHECK(std::string(c_string.get()) == expected);
+        std::ostringstream stream;
+        stream << bits;
+        WOJ_CHECK(stream.str() == expected);
+
+        const std::size_t index = rng() % model.size();
+        clean.flip(index);
+        WOJ_CHECK(bits != clean && !(bits == clean));
+    }
+
+    template <typename Op>
+    std::vector<bool> combined(const std::vector<bool>& lhs, const std::vector<bool>& rhs, Op op)
+    {
+        std::vector<bool> result(lhs.size());
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+            result[i] = op(lhs[i], rhs[i]);
+        return result;
+    }
+
+    // Binary operators and their compound forms use the operand block by block
+    template <typename Set>
+    void bitwise(Set lhs)
+    {
+        Set rhs = lhs;
+        const std::vector<bool> lhs_model = randomize(lhs), rhs_model = randomize(rhs);
+        const auto and_model = combined(lhs_model, rhs_model, std::bit_and<>()), or_model = combined(lhs_model, rhs_model, std::bit_or<>()), xor_model = combined(lhs_model, rhs_model, std::bit_xor<>());
+
+        WOJ_CHECK(matches(lhs & rhs, and_model));
+        WOJ_CHECK(matches(lhs | rhs, or_model));
+        WOJ_CHECK(matches(lhs ^ rhs, xor_model));
+
+        Set result = lhs;
+        result &= rhs;
+        WOJ_CHECK(matches(result, and_model));
+        result = lhs;
+        result |= rhs;
+        WOJ_CHECK(matches(result, or_model));
+        result = lhs;
+        result ^= rhs;
+        WOJ_CHECK(matches(result, xor_model));
+    }
+
+    // Range fills and flips touch exactly [begin, end), including ranges within a single block
+    template <typename Set>
+    void ranges(Set bits)
+    {
+        std::vector<bool> model = randomize(bits);
+        for (int round = 0; round < 40; ++round)
+        {
+            std::size_t begin = rng() % (model.size() + 1), end = rng() % (model.size() + 1);
+            if (begin > end)
+                std::swap(begin, end);
+            const bool value = rng() & 1;
+            switch (round % 6)
+            {
+            case 0:
+                bits.fill_range(begin, end, value);
+                for (std::size_t i = begin; i < end; ++i)
+                    model[i] = value;
+                break;
+            case 1:
+                bits.flip_range(begin, end);
+                for (std::size_t i = begin; i < end; ++i)
+                    model[i] = !model[i];
+                break;
+            case 2:
+                bits.set_range(begin, end);
+                for (std::size_t i = begin; i < end; ++i)
+                    model[i] = true;
+                break;
+            case 3:
+                bits.reset_range(begin, end);
+                for (std::size_t i = begin; i < end; ++i)
+                    model[i] = false;
+                break;
+            case 4:
+                bits.flip_range(end);
+                for (std::size_t i = 0; i < end; ++i)
+                    model[i] = !model[i];
+                break;
+            default:
+                // The deprecated name must keep forwarding to the strided fill
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+                bits.fill_range_optimized(begin, end, 3, value);
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+                for (std::size_t i = begin; i < end; i += 3)
+                    model[i] = value;
+                break;
+            }
+            WOJ_CHECK(matches(bits, model));
+        }
+    }
+
+    // hash and std::hash only read the bits below the size
+    template <typename Set>
+    void hashes(Set bits)
+    {
+        const std::vector<bool> model = randomize(bits);
+        Set clean = bits;
+        clean.reset();
+        for (std::size_t i = 0; i < model.size(); ++i)
+            clean.set(i, model[i]);
+
+        WOJ_CHECK(bits.hash() == clean.hash() && std::hash<Set>{}(bits) == bits.hash() && std::hash<Set>{}(clean) == clean.hash());
+
+        // Single bit changes, including the last bit, change the hash
+        bool changed = true;
+        for (const std::size_t index : { std::size_t{ 0 }, model.size() / 2, model.size() - 1 })
+        {
+            Set flipped = clean;
+            flipped.flip(index);
+            changed &= flipped.hash() != clean.hash();
+        }
+        WOJ_CHECK(changed);
+    }
+
+    std::string to_string(const std::vector<bool>& model)
+    {
+        std::string result;
+        for (const bool bit : model)
+            result += bit ? '1' : '0';
+        return result;
+    }
+
+    // Numeric order of the models, bit size() - 1 being the most significant, equal values ordered by size
+    std::strong_ordering numeric_order(const std::vector<bool>& lhs, const std::vector<bool>& rhs)
+    {
+        for (std::size_t i = (std::max)(lhs.size(), rhs.size()); i-- > 0;)
+        {
+            const bool lhs_bit = i < lhs.size() && lhs[i], rhs_bit = i < rhs.size() && rhs[i];
+            if (lhs_bit != rhs_bit)
+                return lhs_bit <=> rhs_bit;
+        }
+        return lhs.size() <=> rhs.size();
+    }
+
+    /**
+     * Checks compare_numeric, operator<=> and compare_lexicographic of two bitsets against their models
+     */
+    template <typename Set>
+    bool ordered(const Set& lhs, const Set& rhs, const std::vector<bool>& lhs_model, const std::vector<bool>& rhs_model)
+    {
+        const std::strong_ordering numeric = numeric_order(lhs_model, rhs_model);
+        const std::strong_ordering lexicographic = to_string(lhs_model) <=> to_string(rhs_model);
+        return lhs.compare_numeric(rhs) == numeric && (lhs <=> rhs) == numeric && rhs.compare_numeric(lhs) == 0 <=> numeric
+            && lhs.compare_lexicographic(rhs) == lexicographic && rhs.compare_lexicographic(lhs) == 0 <=> lexicographic;
+    }
+
+    // Both orders ignore the bits past the size, the lexicographic one is the order of the strings
+    template <typename Set>
+    void comparisons(Set lhs)
+    {
+        Set rhs = lhs;
+        const std::vector<bool> lhs_model = randomize(lhs);
+        std::vector<bool> rhs_model = lhs_model;
+        assign(rhs, rhs_model);
+        WOJ_CHECK(ordered(lhs, rhs, lhs_model, rhs_model) && lhs.compare_numeric(rhs) == 0 && lhs.compare_lexicographic(rhs) == 0);
+
+        for (int round = 0; round < 20; ++round)
+        {
+            // Differing in one bit, so the first difference can be anywhere, or in random bits
+            if (round % 2)
+                rhs_model = randomize(rhs);
+            else
+            {
+                rhs_model = lhs_model;
+                const std::size_t index = rng() % rhs_model.size();
+                rhs_model[index] = !rhs_model[index];
+                assign(rhs, rhs_model);
+            }
+            WOJ_CHECK(ordered(lhs, rhs, lhs_model, rhs_model));
+        }
+    }
+
+    // Bitsets of different sizes compare by value then by size, and lexicographically with prefixes first
+    template <typename BlockType>
+    void sized_comparisons(const std::size_t size)
+    {
+        for (const std::size_t other_size : { std::size_t{ 1 }, size / 2 + 1, size, size + 1, size + 70 })
+        {
+            woj::dynamic_bitset<BlockType> lhs(size), rhs(other_size);
+            const std::vector<bool> lhs_model = randomize(lhs);
+            std::vector<bool> rhs_model = randomize(rhs);
+            WOJ_CHECK(ordered(lhs, rhs, lhs_model, rhs_model));
+
+            // A copy of the common prefix, and the same value with zeros above
+            for (std::size_t i = 0; i < rhs_model.size(); ++i)
+                rhs_model[i] = i < lhs_model.size() ? lhs_model[i] : false;
+            assign(rhs, rhs_model);
+            WOJ_CHECK(ordered(lhs, rhs, lhs_model, rhs_model));
+        }
+    }
+
+    // Subset, superset, intersects and disjoint against the models, the bits past the size set on both sides
+    template <typename Set>
+    void predicates(Set lhs)
+    {
+        Set rhs = lhs;
+        const std::vector<bool> lhs_model = randomize(lhs);
+        for (int round = 0; round < 12; ++round)
+        {
+            std::vector<bool> rhs_model(lhs_model.size());
+            for (std::size_t i = 0; i < rhs_model.size(); ++i)
+            {
+                const bool random = rng() & 1;
+                // Equal, superset, subset, complement, disjoint or random
+                switch (round % 6)
+                {
+                case 0:
+                    rhs_model[i] = lhs_model[i];
+                    break;
+                case 1:
+                    rhs_model[i] = lhs_model[i] || random;
+                    break;
+                case 2:
+                    rhs_model[i] = lhs_model[i] && random;
+                    break;
+                case 3:
+                    rhs_model[i] = !lhs_model[i];
+                    break;
+                case 4:
+                    rhs_model[i] = !lhs_model[i] && random;
+                    break;
+                default:
+                    rhs_model[i] = random;
+                    break;
+                }
+            }
+            assign(rhs, rhs_model);
+
+            bool subset = true, superset = true, intersects = false;
+            for (std::size_t i = 0; i < lhs_model.size(); ++i)
+            {
+                subset &= !lhs_model[i] || rhs_model[i];
+                superset &= lhs_model[i] || !rhs_model[i];
+                intersects |= lhs_model[i] && rhs_model[i];
+            }
+            WOJ_CHECK(lhs.is_subset_of(rhs) == subset && lhs.is_superset_of(rhs) == superset);
+            WOJ_CHECK(lhs.is_proper_subset_of(rhs) == (subset && !superset) && lhs.is_proper_superset_of(rhs) == (superset && !subset));
+            WOJ_CHECK(lhs.intersects(rhs) == intersects && rhs.intersects(lhs) == intersects && lhs.is_disjoint(rhs) == !intersects);
+        }
+    }
+
+    // count, any, none and all over [begin, end), the range ending at the size must not read the bits past it
+    template <typename Set>
+    void range_queries(Set bits)
+    {
+        for (int round = 0; round < 60; ++round)
+        {
+            // Random bits, or a run of ones or zeros so that all and none hold over long ranges
+            std::vector<bool> model = randomize(bits);
+            std::size_t begin = rng() % (model.size() + 1), end = round % 3 == 0 ? model.size() : rng() % (model.size() + 1);
+            if (begin > end)
+                std::swap(begin, end);
+            if (round % 4 == 1 || round % 4 == 2)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                    model[i] = round % 4 == 1;
+                assign(bits, model);
+            }
+
+            std::size_t count = 0;
+            for (std::size_t i = begin; i < end; ++i)
+                count += model[i];
+            WOJ_CHECK(bits.count(begin, end) == count);
+            WOJ_CHECK(bits.any(begin, end) == (count != 0) && bits.none(begin, end) == (count == 0) && bits.all(begin, end) == (count == end - begin));
+        }
+    }
+
+    std::uint64_t model_field(const std::vector<bool>& model, const std::size_t pos, const std::size_t len)
+    {
+        std::uint64_t result = 0;
+        for (std::size_t i = 0; i < len; ++i)
+            result |= std::uint64_t{ model[pos + i] } << i;
+        return result;
+    }
+
+    /**
+     * Reads a field of type T and writes it back with a random value, every other field straddles a block boundary
+     */
+    template <typename T, typename Set>
+    void field(Set& bits, std::vector<bool>& model, const bool straddling)
+    {
+        constexpr std::size_t width = sizeof(T) * CHAR_BIT, block_size = sizeof(typename Set::block_type) * CHAR_BIT;
+
+        const std::size_t len = rng() % ((std::min)(width, model.size()) + 1);
+        std::size_t pos = rng() % (model.size() - len + 1);
+        if (straddling && model.size() > block_size && len > 1)
+            pos = (std::min)((1 + rng() % (model.size() / block_size)) * block_size - 1 - rng() % (len - 1), model.size() - len);
+
+        WOJ_CHECK(bits.template get_bits<T>(pos, len) == static_cast<T>(model_field(model, pos, len)));
+        if (len <= block_size && pos < model.size())
+            WOJ_CHECK(bits.template get_bits_straddling<T>(pos, len) == static_cast<T>(model_field(model, pos, len)));
+
+        // The bits above len of the value are ignored and the neighbours of the field keep their values
+        const T value = static_cast<T>(rng());
+        bits.set_bits(pos, len, value);
+        for (std::size_t i = 0; i < len; ++i)
+            model[pos + i] = value >> i & 1;
+        WOJ_CHECK(matches(bits, model) && bits.template get_bits<T>(pos, len) == static_cast<T>(model_field(model, pos, len)));
+    }
+
+    // get_bits, get_bits_straddling and set_bits with fields narrower and wider than the blocks
+    template <typename Set>
+    void fields(Set bits)
+    {
+        std::vector<bool> model = randomize(bits);
+        for (int round = 0; round < 20; ++round)
+        {
+            field<std::uint8_t>(bits, model, round & 1);
+            field<std::uint16_t>(bits, model, round & 1);
+            field<std::uint32_t>(bits, model, round & 1);
+            field<std::uint64_t>(bits, model, round & 1);
+        }
+    }
+
+    // compress and expand against the models, with the bits past the size set in the bitset and the mask
+    template <typename Set>
+    void compress_expand(Set bits)
+    {
+        Set mask = bits;
+        for (int round = 0; round < 20; ++round)
+        {
+            const std::vector<bool> model = randomize(bits);
+            std::vector<bool> mask_model = randomize(mask);
+            if (round % 4 == 1)
+            {
+                mask_model.assign(model.size(), round % 8 == 1);
+                assign(mask, mask_model);
+            }
+
+            std::vector<bool> compressed(model.size()), expanded(model.size());
+            for (std::size_t i = 0, selected = 0; i < model.size(); ++i)
+            {
+                if (mask_model[i])
+                {
+                    compressed[selected] = model[i];
+                    expanded[i] = model[selected++];
+                }
+            }
+            WOJ_CHECK(matches(bits.compress(mask), compressed));
+            WOJ_CHECK(matches(bits.expand(mask), expanded));
+
+            // expand undoes compress for the selected bits
+            WOJ_CHECK(matches(bits.compress(mask).expand(mask), combined(model, mask_model, std::bit_and<>())));
+        }
+    }
+
+    template <typename BlockType, std::size_t Size, typename Indices>
+    woj::bitset<BlockType, Size> from_indices(const woj::bitset<BlockType, Size>&, const Indices& indices, const bool partition)
+    {
+        return woj::bitset<BlockType, Size>::from_indices(indices, partition);
+    }
+
+    template <typename BlockType, typename Indices>
+    woj::dynamic_bitset<BlockType> from_indices(const woj::dynamic_bitset<BlockType>& bits, const Indices& indices, const bool partition)
+    {
+        return woj::dynamic_bitset<BlockType>::from_indices(bits.size(), indices, partition);
+    }
+
+    /**
+     * set_many, reset_many, flip_many, test_many and from_indices with and without partitioning, the indices holding
+     * duplicates and the first and last bit
+     */
+    template <typename Index, typename Set>
+    void many(Set bits)
+    {
+        using block_type = typename Set::block_type;
+
+        const std::vector<bool> model = randomize(bits);
+        std::vector<Index> indices{ 0, static_cast<Index>(model.size() - 1) };
+        for (std::size_t i = 0; i < 50 + model.size() / 1000; ++i)
+            indices.push_back(static_cast<Index>(i % 4 == 3 ? indices[rng() % indices.size()] : rng() % model.size()));
+
+        std::vector<bool> set_model = model, reset_model = model, flip_model = model, indexed_model(model.size());
+        for (const Index index : indices)
+        {
+            set_model[index] = indexed_model[index] = true;
+            reset_model[index] = false;
+            flip_model[index] = !flip_model[index];
+        }
+
+        for (const bool partition : { false, true })
+        {
+            Set result = bits;
+            result.set_many(indices, partition);
+            WOJ_CHECK(matches(result, set_model));
+            result = bits;
+            result.reset_many(indices, partition);
+            WOJ_CHECK(matches(result, reset_model));
+            result = bits;
+            result.flip_many(indices, partition);
+            WOJ_CHECK(matches(result, flip_model));
+            WOJ_CHECK(matches(from_indices(bits, indices, partition), indexed_model));
+
+            // Results come in the order of the indices, whichever order the partitions are tested in
+            const std::unique_ptr<bool[]> values(new bool[indices.size()]);
+            woj::dynamic_bitset<block_type> value_bits(indices.size());
+            bits.test_many(indices, values.get(), partition);
+            bits.test_many(indices, value_bits, partition);
+            bool tested = true;
+            for (std::size_t i = 0; i < indices.size(); ++i)
+                tested = tested && values[i] == model[indices[i]] && value_bits.test(i) == model[indices[i]];
+            WOJ_CHECK(tested);
+        }
+    }
+
+    template <typename BlockType>
+    bool consistent(const woj::dynamic_bitset<BlockType>& bits)
+    {
+        constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+        return bits.storage_size() == (bits.size() + block_size - 1) / block_size && (bits.size() ? bits.data() != nullptr : true);
+    }
+
+    // Move, copy assignment, resize, push_back and pop_back keep the size and storage bookkeeping in sync
+    template <typename BlockType>
+    void storage(const std::size_t size)
+    {
+        using set_type = woj::dynamic_bitset<BlockType>;
+
+        set_type source(size);
+        const std::vector<bool> model = randomize(source);
+
+        set_type moved(std::move(source));
+        WOJ_CHECK(matches(moved, model) && consistent(moved));
+        WOJ_CHECK(source.size() == 0 && source.storage_size() == 0 && source.data() == nullptr);
+
+        set_type assigned(3);
+        assigned = std::move(moved);
+        WOJ_CHECK(matches(assigned, model) && consistent(assigned));
+        WOJ_CHECK(moved.size() == 0 && moved.storage_size() == 0 && moved.data() == nullptr);
+
+        // Copy assignment from a bitset of another size must take over its size as well as its blocks
+        for (const std::size_t other_size : { std::size_t{ 1 }, size / 2 + 1, size, size + 70 })
+        {
+            set_type copy(other_size);
+            randomize(copy);
+            copy = assigned;
+            WOJ_CHECK(matches(copy, model) && consistent(copy) && copy == assigned && copy.count() == assigned.count());
+        }
+
+        // resize keeps the bits below the smaller size
+        for (const std::size_t new_size : { size + 1, size + 100, size / 3 + 1, std::size_t{ 0 }, size })
+        {
+            set_type resized = assigned;
+            resized.resize(new_size);
+            std::vector<bool> prefix(model.begin(), model.begin() + static_cast<std::ptrdiff_t>((std::min)(size, new_size)));
+            WOJ_CHECK(resized.size() == new_size && consistent(resized));
+            bool kept = true;
+            for (std::size_t i = 0; i < prefix.size(); ++i)
+                kept = kept && resized.test(i) == prefix[i];
+            WOJ_CHECK(kept);
+        }
+
+        // push_back and pop_back across block boundaries
+        set_type grown;
+        std::vector<bool> grown_model;
+        for (std::size_t i = 0; i < size + 70; ++i)
+        {
+            const bool value = rng() & 1;
+            grown.push_back(value);
+            grown_model.push_back(value);
+        }
+        WOJ_CHECK(matches(grown, grown_model) && consistent(grown));
+        while (!grown_model.empty())
+        {
+            grown.pop_back();
+            grown_model.pop_back();
+            if (grown_model.size() % 13 == 0 || grown_model.empty())
+                WOJ_CHECK(matches(grown, grown_model) && consistent(grown));
+        }
+    }
+
+    template <std::size_t Size>
+    std::bitset<Size> random_std_bitset(const std::vector<bool>& model)
+    {
+        std::bitset<Size> result;
+        for (std::size_t i = 0; i < Size; ++i)
+            result[i] = i < model.size() ? model[i] : rng() & 1;
+        return result;
+    }
+
+    // std::bitset conversions of the same, a smaller and a larger size, both ways and into dynamic_bitset
+    template <typename BlockType, std::size_t Size>
+    void std_conversions(woj::bitset<BlockType, Size> bits)
+    {
+        const std::vector<bool> model = randomize(bits);
+        const std::vector<bool> prefix(model.begin(), model.begin() + Size / 2 + 1);
+        std::vector<bool> padded = prefix;
+        padded.resize(Size);
+
+        WOJ_CHECK(matches(woj::bitset<BlockType, Size>(random_std_bitset<Size>(model)), model));
+        WOJ_CHECK(matches(woj::bitset<BlockType, Size>(random_std_bitset<Size / 2 + 1>(prefix)), padded));
+        WOJ_CHECK(matches(woj::bitset<BlockType, Size>(random_std_bitset<Size + 37>(model)), model));
+
+        // to_std drops the bits past the size
+        WOJ_CHECK(bits.to_std() == random_std_bitset<Size>(model));
+        WOJ_CHECK(woj::bitset<BlockType, Size>(bits.to_std()) == bits);
+
+        const std::bitset<Size + 37> larger = random_std_bitset<Size + 37>(model);
+        const woj::dynamic_bitset<BlockType> dynamic(larger);
+        std::vector<bool> larger_model(Size + 37);
+        for (std::size_t i = 0; i < larger_model.size(); ++i)
+            larger_model[i] = larger[i];
+        WOJ_CHECK(matches(dynamic, larger_model) && consistent(dynamic) && dynamic.to_std() == larger_model);
+    }
+
+    // std::vector<bool> conversions both ways, to_std drops the bits past the size
+    template <typename BlockType>
+    void std_conversions(woj::dynamic_bitset<BlockType> bits)
+    {
+        const std::vector<bool> model = randomize(bits);
+        WOJ_CHECK(bits.to_std() == model);
+
+        const woj::dynamic_bitset<BlockType> converted(model);
+        WOJ_CHECK(matches(converted, model) && consistent(converted) && converted == bits && converted.to_std() == model);
+    }
+
+    template <typename BlockType, std::size_t... Sizes>
+    void fixed(std::index_sequence<Sizes...>)
+    {
+        (shifts(woj::bitset<BlockType, Sizes>()), ...);
+        (tail_reads(woj::bitset<BlockType, Sizes>()), ...);
+        (bitwise(woj::bitset<BlockType, Sizes>()), ...);
+        (ranges(woj::bitset<BlockType, Sizes>()), ...);
+        (hashes(woj::bitset<BlockType, Sizes>()), ...);
+        (comparisons(woj::bitset<BlockType, Sizes>()), ...);
+        (predicates(woj::bitset<BlockType, Sizes>()), ...);
+        (range_queries(woj::bitset<BlockType, Sizes>()), ...);
+        (fields(woj::bitset<BlockType, Sizes>()), ...);
+        (compress_expand(woj::bitset<BlockType, Sizes>()), ...);
+        (many<std::uint32_t>(woj::bitset<BlockType, Sizes>()), ...);
+        (many<std::size_t>(woj::bitset<BlockType, Sizes>()), ...);
+        (std_conversions(woj::bitset<BlockType, Sizes>()), ...);
+    }
+
+    template <typename BlockType>
+    void dynamic()
+    {
+        for (const std::size_t size : sizes)
+        {
+            shifts(woj::dynamic_bitset<BlockType>(size));
+            tail_reads(woj::dynamic_bitset<BlockType>(size));
+            bitwise(woj::dynamic_bitset<BlockType>(size));
+            ranges(woj::dynamic_bitset<BlockType>(size));
+            hashes(woj::dynamic_bitset<BlockType>(size));
+            comparisons(woj::dynamic_bitset<BlockType>(size));
+            sized_comparisons<BlockType>(size);
+            predicates(woj::dynamic_bitset<BlockType>(size));
+            range_queries(woj::dynamic_bitset<BlockType>(size));
+            fields(woj::dynamic_bitset<BlockType>(size));
+            compress_expand(woj::dynamic_bitset<BlockType>(size));
+            many<std::uint32_t>(woj::dynamic_bitset<BlockType>(size));
+            many<std::size_t>(woj::dynamic_bitset<BlockType>(size));
+            std_conversions(woj::dynamic_bitset<BlockType>(size));
+            storage<BlockType>(size);
+        }
+
+        // Spans several 256 KiB regions, so set_many and test_many partition the indices
+        many<std::uint32_t>(woj::dynamic_bitset<BlockType>((std::size_t{ 3 } << 21) + 77));
+        many<std::size_t>(woj::dynamic_bitset<BlockType>((std::size_t{ 3 } << 21) + 77));
+    }
+
+    template <typename BlockType>
+    void run()
+    {
+        fixed<BlockType>(std::index_sequence<1, 7, 8, 9, 63, 64, 65, 127, 128, 129, 200, 1000>{});
+        dynamic<BlockType>();
+    }
+}
+
+int main()
+{
+    run<std::uint8_t>();
+    run<std::uint16_t>();
+    run<std::uint32_t>();
+    run<std::uint64_t>();
+    return woj::test::report();
+}
@@ -0,0 +1,143 @@
+#include "test.hpp"
+#include "woj/bitset.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+// blocked_bloom_filter checked for false negatives and against its single-key queries
+// Built once as is and once with -mavx2 (bloom_filter_avx2_test), so both probe paths are compared with bloom_mask
+
+namespace
+{
+    std::mt19937_64 rng(2026);
+
+    std::vector<std::uint64_t> random_keys(const std::size_t count)
+    {
+        std::vector<std::uint64_t> keys(count);
+        for (std::uint64_t& key : keys)
+            key = rng();
+        return keys;
+    }
+
+    /**
+     * Checks that bloom_insert sets exactly the bits of bloom_mask and that bloom_contains tests exactly them
+     */
+    void probes()
+    {
+        struct alignas(64) block
+        {
+            std::uint64_t words[8];
+        };
+
+        for (int round = 0; round < 100000; ++round)
+        {
+            const std::uint32_t hash = round < 2 ? (round ? ~std::uint32_t{ 0 } : 0) : static_cast<std::uint32_t>(rng());
+            std::uint64_t mask[8];
+            woj::detail::bloom_mask(hash, mask);
+
+            block inserted = {};
+            woj::detail::bloom_insert(inserted.words, hash);
+            bool same = true;
+            for (std::size_t i = 0; i < 8; ++i)
+                same &= inserted.words[i] == mask[i] && woj::detail::popcount(mask[i]) == 1;
+            WOJ_CHECK(same);
+            WOJ_CHECK(woj::detail::bloom_contains(inserted.words, hash));
+
+            // Clearing any single probe must make the query fail, extra bits must not matter
+            block full;
+            for (std::size_t i = 0; i < 8; ++i)
+                full.words[i] = rng() | mask[i];
+            WOJ_CHECK(woj::detail::bloom_contains(full.words, hash));
+            const std::size_t word = rng() % 8;
+            full.words[word] &= ~mask[word];
+            WOJ_CHECK(!woj::detail::bloom_contains(full.words, hash));
+        }
+    }
+
+    /**
+     * Adds keys through insert_many and queries them, and as many absent keys, through contains_many and contains
+     */
+    void batches(const std::size_t count, const std::size_t bits_per_key)
+    {
+        auto filter = woj::blocked_bloom_filter::for_keys(count, bits_per_key);
+        const std::vector<std::uint64_t> keys = random_keys(count), absent = random_keys(count);
+        filter.insert_many(keys);
+
+        const std::unique_ptr<bool[]> results(new bool[count]);
+        WOJ_CHECK(filter.contains_many(keys, results.get()) == count);
+        bool all = true;
+        for (std::size_t i = 0; i < count; ++i)
+            all &= results[i] && filter.contains(std::hash<std::uint64_t>{}(keys[i]));
+        WOJ_CHECK(all);
+
+        // Per-key results of absent keys match single queries, the return value counts them
+        const std::size_t found = filter.contains_many(absent, results.get());
+        std::size_t expected = 0;
+        bool same = true;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const bool contained = filter.contains(std::hash<std::uint64_t>{}(absent[i]));
+            same &= results[i] == contained;
+            expected += contained;
+        }
+        WOJ_CHECK(same);
+        WOJ_CHECK(found == expected);
+        WOJ_CHECK(filter.contains_many(absent) == found);
+
+        // Around 10 bits per key keeps the false positive rate near 1%
+        if (bits_per_key == 10 && count >= 10000)
+            WOJ_CHECK(found * 50 < count);
+
+        // Single inserts and insert_many set the same bits
+        woj::blocked_bloom_filter single = woj::blocked_bloom_filter::for_keys(count, bits_per_key);
+        for (const std::uint64_t key : keys)
+            single.insert(std::hash<std::uint64_t>{}(key));
+        WOJ_CHECK(single.count() == filter.count());
+        single.clear();
+        WOJ_CHECK(single.count() == 0 && single.contains_many(keys) == 0);
+    }
+
+    void merge()
+    {
+        const std::vector<std::uint64_t> first = random_keys(1000), second = random_keys(1000);
+        auto lhs = woj::blocked_bloom_filter::for_keys(2000), rhs = woj::blocked_bloom_filter::for_keys(2000);
+        lhs.insert_many(first);
+        rhs.insert_many(second);
+        lhs |= rhs;
+        WOJ_CHECK(lhs.contains_many(first) == first.size());
+        WOJ_CHECK(lhs.contains_many(second) == second.size());
+
+        // A custom hasher is applied to every key
+        const auto hasher = [](const std::uint64_t key) { return key * 31; };
+        woj::blocked_bloom_filter hashed(512);
+        WOJ_CHECK(hashed.size() == 512 && hashed.block_count() == 1);
+        hashed.insert_many(std::span(first).first(10), hasher);
+        bool all = true;
+        for (std::size_t i = 0; i < 10; ++i)
+            all &= hashed.contains(first[i] * 31);
+        WOJ_CHECK(all);
+    }
+}
+
+int main()
+{
+#if defined(__AVX2__) && (defined(__GNUC__) || defined(__clang__))
+    // Tells ctest to skip the test on processors without AVX2
+    if (!__builtin_cpu_supports("avx2"))
+        return 77;
+#endif
+
+    probes();
+    for (const std::size_t count : { 1, 15, 16, 17, 1000, 100000 })
+    {
+        batches(count, 10);
+        batches(count, 4);
+    }
+    merge();
+    return woj::test::report();
+}
@@ -0,0 +1,123 @@
+#include "test.hpp"
+#include "woj/bitset.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+
+// The fixed-size API must stay usable in constant evaluation, a regression fails the build of this test
+
+namespace constant_evaluation
+{
+    using narrow = woj::bitset<std::uint8_t, 21>;
+    using wide = woj::bitset<std::uint64_t, 130>;
+
+    constexpr narrow parsed("101100000000000000001");
+    static_assert(parsed.test(0) && !parsed.test(1) && parsed[2] && parsed.test(20));
+    static_assert(parsed.count() == 4 && parsed.count(1, 20) == 2);
+    static_assert(parsed.find_first() == 0 && parsed.find_next(1) == 2 && parsed.find_next(4) == 20 && narrow().find_first() == narrow::size());
+    static_assert((parsed << std::size_t{ 1 }).test(1) && (parsed >> std::size_t{ 2 }).test(0) && (parsed >> std::size_t{ 2 }).count() == 3);
+    static_assert(parsed.to_string() == "101100000000000000001");
+    static_assert(narrow(parsed.to_string()) == parsed);
+    static_assert(wide(true).count() == wide::size() && wide(true).all() && wide().none());
+    static_assert((wide(true) ^ wide(true)).none() && (~wide()).count() == wide::size());
+    static_assert(parsed.hash() != narrow().hash());
+
+    constexpr bool rotate()
+    {
+        narrow bits = parsed;
+        bits.rotate(1);
+        return bits.test(19) && bits.test(1) && bits.test(2) && bits.count() == 4;
+    }
+    static_assert(rotate());
+
+    constexpr bool references()
+    {
+        narrow bits;
+        bits[3] = true;
+        bits[4] = bits[3];
+        bits[4] ^= true;
+        bits.data()[1] = 0x81;
+        return bits.test(3) && !bits.test(4) && bits.test(8) && bits.test(15) && bits.count() == 3;
+    }
+    static_assert(references());
+
+    constexpr bool strings()
+    {
+        const char* pointer = "0011";
+        char* string = narrow(pointer).to_c_string();
+        const bool result = string[2] == '1' && string[1] == '0' && string[narrow::size()] == '\0';
+        delete[] string;
+        return result;
+    }
+    static_assert(strings());
+
+    constexpr bool integers()
+    {
+        wide bits;
+        bits.from_integer<std::uint64_t>(0xf0);
+        return bits.to_integer<std::uint64_t>() == 0xf0 && narrow("1").to_integer<std::uint64_t>() == 1;
+    }
+    static_assert(integers());
+
+    constexpr bool iteration()
+    {
+        std::size_t set = 0;
+        for (const bool bit : parsed)
+            set += bit;
+        return set == parsed.count();
+    }
+    static_assert(iteration());
+
+    constexpr bool fields()
+    {
+        wide bits;
+        bits.set_bits(60, 10, std::uint64_t{ 0x2a5 });
+        bits.set_range(100, 120, 3);
+        return bits.get_bits(60, 10) == 0x2a5 && bits.count(100, 120) == 7;
+    }
+    static_assert(fields());
+
+    // One and two block bitsets take their own loop-free paths
+    constexpr bool words()
+    {
+        woj::bitset<std::uint64_t, 40> single;
+        single.set(1);
+        single.set(39);
+        single.reverse();
+        woj::bitset<std::uint32_t, 50> pair;
+        pair.set_range(30, 36);
+        pair.flip_range(33, 40);
+        pair <<= 3;
+        return single.test(0) && single.test(38) && single.find_next(1) == 38 && (single >> std::size_t{ 38 }).count() == 1
+            && pair.count() == 7 && pair.all(33, 36) && !pair.any(36, 39) && pair.find_next(36) == 39 && (pair >> std::size_t{ 33 }).find_first() == 0;
+    }
+    static_assert(words());
+
+    // Conversion between block types re-packs the blocks, bits past the source are reset
+    constexpr bool conversion()
+    {
+        const woj::bitset<std::uint64_t, 130> widened(parsed);
+        const narrow narrowed(widened);
+        const woj::bitset<std::uint8_t, 12> truncated(widened);
+        return widened.count() == 4 && widened.test(20) && narrowed == parsed && truncated.count() == 3;
+    }
+    static_assert(conversion());
+
+    // The iterators are random access and find, count and fill over them, found by argument-dependent lookup, work on whole blocks
+    static_assert(std::random_access_iterator<wide::iterator> && std::ranges::random_access_range<const wide>);
+    constexpr bool algorithms()
+    {
+        wide bits;
+        fill(bits.begin() + 3, bits.end() - 2, true);
+        *(bits.rbegin() + 2) = false;
+        return count(bits.cbegin(), bits.cend(), true) == 124 && find(bits.begin(), bits.end(), true) - bits.begin() == 3
+            && find(bits.begin() + 3, bits.end(), false) == bits.end() - 3 && bits.end() - bits.begin() == 130;
+    }
+    static_assert(algorithms());
+}
+int main()
+{
+    return woj::test::report();
+}
@@ -0,0 +1,249 @@
+#include "test.hpp"
+#include "woj/bitset.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+// cow_bitset checked against a std::vector<bool> model, snapshots must not see the writes made after them
+
+namespace
+{
+    std::mt19937_64 rng(2026);
+
+    template <typename BlockType>
+    bool matches(const woj::cow_bitset<BlockType>& bits, const std::vector<bool>& model)
+    {
+        if (bits.size() != model.size() || bits.count() != static_cast<std::size_t>(std::count(model.begin(), model.end(), true)))
+            return false;
+        if (bits.any() == bits.none() || bits.any() != (bits.count() != 0))
+            return false;
+        const woj::dynamic_bitset<BlockType> copy = bits.to_dynamic_bitset();
+        if (copy.size() != model.size())
+            return false;
+        for (std::size_t i = 0; i < model.size(); ++i)
+        {
+            if (bits.test(i) != model[i] || bits[i] != model[i] || copy.test(i) != model[i])
+                return false;
+        }
+
+        // Blocks read through get_block agree with the copy, bits past the size are reset
+        for (std::size_t i = 0; i < copy.storage_size(); ++i)
+        {
+            if (bits.get_block(i) != copy.get_block(i))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * Applies random set, reset, flip and set(index, value) calls to a bitset and its model
+     * @param region Count of bits the writes fall into, from the begin of the bitset
+     */
+    template <typename BlockType>
+    void write(woj::cow_bitset<BlockType>& bits, std::vector<bool>& model, const std::size_t region, const int count)
+    {
+        for (int op = 0; op < count; ++op)
+        {
+            const std::size_t index = rng() % region;
+            switch (rng() % 4)
+            {
+            case 0:
+                bits.set(index);
+                model[index] = true;
+                break;
+            case 1:
+                bits.reset(index);
+                model[index] = false;
+                break;
+            case 2:
+                bits.flip(index);
+                model[index] = !model[index];
+                break;
+            default:
+            {
+                const bool value = rng() & 1;
+                bits.set(index, value);
+                model[index] = value;
+                break;
+            }
+            }
+        }
+    }
+
+    template <typename BlockType>
+    woj::cow_bitset<BlockType> random_set(const std::size_t size, std::vector<bool>& model)
+    {
+        constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+        woj::dynamic_bitset<BlockType> source(size);
+        model.assign(size, false);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            model[i] = rng() & 1;
+            source.set(i, model[i]);
+        }
+
+        // Construction ignores the bits past the size
+        if (size % block_size)
+            source.get_block(size / block_size) |= static_cast<BlockType>(~BlockType{ 0 } << size % block_size);
+        return woj::cow_bitset<BlockType>(source);
+    }
+
+    // A new bitset shares one zero chunk, writes clone only the chunk they touch
+    template <typename BlockType>
+    void writes(const std::size_t size)
+    {
+        constexpr std::size_t chunk_size = woj::cow_bitset<BlockType>::chunk_size;
+
+        woj::cow_bitset<BlockType> bits(size);
+        std::vector<bool> model(size);
+        WOJ_CHECK(bits.chunk_count() == (size + chunk_size - 1) / chunk_size && matches(bits, model));
+        WOJ_CHECK(bits.chunk_count() < 2 || (bits.is_shared(0) && bits.is_shared(bits.chunk_count() - 1)));
+
+        write(bits, model, (std::min)(size, chunk_size), 500);
+        WOJ_CHECK(matches(bits, model) && !bits.is_shared(0));
+        WOJ_CHECK(bits.chunk_count() < 3 || bits.is_shared(1));
+
+        write(bits, model, size, 2000);
+        WOJ_CHECK(matches(bits, model));
+
+        // Writes that leave a bit as it is do not clone its chunk
+        woj::cow_bitset<BlockType> unchanged(size);
+        unchanged.reset(size - 1);
+        unchanged.set(0, false);
+        WOJ_CHECK(unchanged.chunk_count() < 2 || unchanged.is_shared(0));
+    }
+
+    // A snapshot keeps its bits while the original is written, and the other way around
+    template <typename BlockType>
+    void snapshots(const std::size_t size)
+    {
+        std::vector<bool> model;
+        woj::cow_bitset<BlockType> bits = random_set<BlockType>(size, model);
+        WOJ_CHECK(matches(bits, model));
+
+        const woj::cow_bitset<BlockType> snapshot = bits;
+        const std::vector<bool> snapshot_model = model;
+        bool shared = true;
+        for (std::size_t i = 0; i < bits.chunk_count(); ++i)
+            shared &= bits.is_shared(i) && snapshot.is_shared(i) && &bits.get_chunk(i) == &snapshot.get_chunk(i);
+        WOJ_CHECK(shared && bits == snapshot);
+
+        write(bits, model, size, 300);
+        WOJ_CHECK(matches(bits, model) && matches(snapshot, snapshot_model));
+        WOJ_CHECK((bits == snapshot) == (model == snapshot_model));
+
+        // The written chunk is no longer shared, the others still are
+        const std::size_t index = rng() % size, chunk = index / woj::cow_bitset<BlockType>::chunk_size;
+        bits.flip(index);
+        model[index] = !model[index];
+        WOJ_CHECK(!bits.is_shared(chunk) && &bits.get_chunk(chunk) != &snapshot.get_chunk(chunk));
+        WOJ_CHECK(matches(bits, model) && matches(snapshot, snapshot_model) && (bits == snapshot) == (model == snapshot_model));
+
+        // Writing a copy of the snapshot leaves the snapshot as it is
+        woj::cow_bitset<BlockType> branch = snapshot;
+        std::vector<bool> branch_model = snapshot_model;
+        write(branch, branch_model, size, 300);
+        WOJ_CHECK(matches(branch, branch_model) && matches(snapshot, snapshot_model) && matches(bits, model));
+
+        // set() and reset() on shared chunks replace the table of the written copy only
+        woj::cow_bitset<BlockType> full = snapshot;
+        full.set();
+        WOJ_CHECK(matches(full, std::vector<bool>(size, true)) && matches(snapshot, snapshot_model));
+        woj::cow_bitset<BlockType> empty = full;
+        empty.reset();
+        WOJ_CHECK(matches(empty, std::vector<bool>(size)) && matches(full, std::vector<bool>(size, true)) && matches(snapshot, snapshot_model));
+        empty.set(size - 1);
+        WOJ_CHECK(empty.count() == 1 && full.count() == size);
+        WOJ_CHECK(woj::cow_bitset<BlockType>(size, true) == full && woj::cow_bitset<BlockType>(size, false) == woj::cow_bitset<BlockType>(size));
+    }
+
+    template <typename Op>
+    std::vector<bool> combined(const std::vector<bool>& lhs, const std::vector<bool>& rhs, Op op)
+    {
+        std::vector<bool> result(lhs.size());
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+            result[i] = op(lhs[i], rhs[i]);
+        return result;
+    }
+
+    // Bitwise operators between unrelated bitsets, between a bitset and its written snapshot, and with itself
+    template <typename BlockType>
+    void operators(const std::size_t size)
+    {
+        std::vector<bool> lhs_model, rhs_model;
+        const woj::cow_bitset<BlockType> lhs = random_set<BlockType>(size, lhs_model), rhs = random_set<BlockType>(size, rhs_model);
+        WOJ_CHECK(matches(lhs & rhs, combined(lhs_model, rhs_model, std::bit_and<>())));
+        WOJ_CHECK(matches(lhs | rhs, combined(lhs_model, rhs_model, std::bit_or<>())));
+        WOJ_CHECK(matches(lhs ^ rhs, combined(lhs_model, rhs_model, std::bit_xor<>())));
+
+        woj::cow_bitset<BlockType> written = lhs;
+        std::vector<bool> written_model = lhs_model;
+        write(written, written_model, (std::min)(size, std::size_t{ 1000 }), 100);
+        WOJ_CHECK(matches(lhs & written, combined(lhs_model, written_model, std::bit_and<>())));
+        WOJ_CHECK(matches(lhs | written, combined(lhs_model, written_model, std::bit_or<>())));
+        WOJ_CHECK(matches(lhs ^ written, combined(lhs_model, written_model, std::bit_xor<>())));
+        WOJ_CHECK(matches(lhs, lhs_model) && matches(written, written_model));
+
+        WOJ_CHECK((lhs & lhs) == lhs && (lhs | lhs) == lhs && (lhs ^ lhs).none() && matches(lhs ^ lhs, std::vector<bool>(size)));
+    }
+
+    // A bitset and a copy of it written on two threads at once, the last writer of a chunk writes it in place
+    template <typename BlockType>
+    void threads(const std::size_t size)
+    {
+        std::vector<bool> model;
+        woj::cow_bitset<BlockType> bits = random_set<BlockType>(size, model);
+        for (int round = 0; round < 10; ++round)
+        {
+            woj::cow_bitset<BlockType> branch(bits);
+            std::vector<bool> branch_model = model;
+
+            // Every thread has its own generator, the shared one is not thread-safe
+            const auto flip = [size](woj::cow_bitset<BlockType>& target, std::vector<bool>& target_model, const std::uint64_t seed)
+            {
+                std::mt19937_64 generator(seed);
+                for (int op = 0; op < 1000; ++op)
+                {
+                    const std::size_t index = generator() % size;
+                    target.flip(index);
+                    target_model[index] = !target_model[index];
+                }
+            };
+            std::thread writer(flip, std::ref(bits), std::ref(model), rng());
+            flip(branch, branch_model, rng());
+            writer.join();
+            WOJ_CHECK(matches(bits, model) && matches(branch, branch_model));
+        }
+    }
+
+    template <typename BlockType>
+    void run()
+    {
+        constexpr std::size_t chunk_size = woj::cow_bitset<BlockType>::chunk_size;
+
+        for (const std::size_t size : { std::size_t{ 1 }, std::size_t{ 100 }, chunk_size - 1, chunk_size, chunk_size + 1, 3 * chunk_size + 77 })
+        {
+            writes<BlockType>(size);
+            snapshots<BlockType>(size);
+            operators<BlockType>(size);
+            threads<BlockType>(size);
+        }
+    }
+}
+
+int main()
+{
+    run<std::uint8_t>();
+    run<std::uint16_t>();
+    run<std::uint32_t>();
+    run<std::uint64_t>();
+    WOJ_CHECK(woj::cow_bitset<>().size() == 0 && woj::cow_bitset<>().none() && woj::cow_bitset<>().chunk_count() == 0);
+    return woj::test::report();
+}
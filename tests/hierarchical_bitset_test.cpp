@@ -0,0 +1,167 @@
+#include "test.hpp"
+#include "woj/bitset.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// hierarchical_bitset checked against a std::vector<bool> model, the summaries must follow every change
+
+namespace
+{
+    std::mt19937_64 rng(2026);
+
+    std::size_t model_find_next(const std::vector<bool>& model, std::size_t pos)
+    {
+        for (; pos < model.size(); ++pos)
+        {
+            if (model[pos])
+                return pos;
+        }
+        return model.size();
+    }
+
+    template <typename BlockType>
+    bool matches(const woj::hierarchical_bitset<BlockType>& bits, const std::vector<bool>& model)
+    {
+        if (bits.size() != model.size() || bits.count() != static_cast<std::size_t>(std::count(model.begin(), model.end(), true)))
+            return false;
+        if (bits.any() != (bits.count() != 0) || bits.none() == bits.any())
+            return false;
+        for (std::size_t i = 0; i < model.size(); ++i)
+        {
+            if (bits.test(i) != model[i] || bits[i] != model[i])
+                return false;
+        }
+
+        // Walking the set bits visits exactly those of the model
+        std::size_t expected = model_find_next(model, 0);
+        for (std::size_t i = bits.find_first(); i < bits.size(); i = bits.find_next(i + 1))
+        {
+            if (i != expected)
+                return false;
+            expected = model_find_next(model, i + 1);
+        }
+        return expected == model.size();
+    }
+
+    /**
+     * Sets, resets and flips bits clustered in a few regions, so whole blocks and summary blocks fill up and empty again
+     */
+    template <typename BlockType>
+    void updates(const std::size_t size)
+    {
+        constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+        woj::hierarchical_bitset<BlockType> bits(size);
+        std::vector<bool> model(size);
+        std::size_t levels = 1;
+        for (std::size_t bottom = size; bottom > block_size; bottom = (bottom + block_size - 1) / block_size)
+            ++levels;
+        WOJ_CHECK(bits.levels() == levels);
+        WOJ_CHECK(matches(bits, model) && bits.find_first() == size);
+
+        const std::size_t region = (std::min)(size, 3 * block_size);
+        for (int round = 0; round < 8; ++round)
+        {
+            const std::size_t base = rng() % (size - region + 1);
+            for (int op = 0; op < 200; ++op)
+            {
+                const std::size_t index = base + rng() % region;
+                switch (rng() % 4)
+                {
+                case 0:
+                    bits.set(index);
+                    model[index] = true;
+                    break;
+                case 1:
+                    bits.reset(index);
+                    model[index] = false;
+                    break;
+                case 2:
+                    bits.flip(index);
+                    model[index] = !model[index];
+                    break;
+                default:
+                {
+                    const bool value = rng() & 1;
+                    bits.set(index, value);
+                    model[index] = value;
+                    break;
+                }
+                }
+            }
+            WOJ_CHECK(matches(bits, model));
+
+            // find_next from arbitrary positions, including ones past the size
+            bool found = true;
+            for (int probe = 0; probe < 50; ++probe)
+            {
+                const std::size_t pos = rng() % (size + 2);
+                found &= bits.find_next(pos) == model_find_next(model, pos);
+            }
+            WOJ_CHECK(found);
+
+            // Emptying the region must clear the summaries above it
+            if (round % 3 == 2)
+            {
+                for (std::size_t i = base; i < base + region; ++i)
+                {
+                    bits.reset(i);
+                    model[i] = false;
+                }
+                WOJ_CHECK(matches(bits, model));
+            }
+        }
+
+        bits.reset();
+        std::fill(model.begin(), model.end(), false);
+        WOJ_CHECK(matches(bits, model) && bits.find_first() == size);
+        bits.set(size - 1);
+        WOJ_CHECK(bits.find_first() == size - 1 && bits.find_next(size - 1) == size - 1 && bits.count() == 1);
+    }
+
+    // Construction from a dynamic_bitset ignores the bits past its size
+    template <typename BlockType>
+    void construction(const std::size_t size)
+    {
+        constexpr std::size_t block_size = sizeof(BlockType) * CHAR_BIT;
+
+        woj::dynamic_bitset<BlockType> source(size);
+        std::vector<bool> model(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            model[i] = rng() % 16 == 0;
+            source.set(i, model[i]);
+        }
+        if (size % block_size)
+            source.get_block(size / block_size) |= static_cast<BlockType>(~BlockType{ 0 } << size % block_size);
+
+        const woj::hierarchical_bitset<BlockType> bits(source);
+        WOJ_CHECK(matches(bits, model));
+        WOJ_CHECK(bits.bits().size() == size);
+    }
+
+    template <typename BlockType>
+    void run()
+    {
+        for (const std::size_t size : { 1, 7, 8, 9, 63, 64, 65, 200, 4097, 70000 })
+        {
+            updates<BlockType>(size);
+            construction<BlockType>(size);
+        }
+    }
+}
+
+int main()
+{
+    run<std::uint8_t>();
+    run<std::uint16_t>();
+    run<std::uint32_t>();
+    run<std::uint64_t>();
+    WOJ_CHECK(woj::hierarchical_bitset<>().size() == 0 && woj::hierarchical_bitset<>().find_first() == 0);
+    return woj::test::report();
+}
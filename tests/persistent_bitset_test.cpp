@@ -0,0 +1,194 @@
+#include "test.hpp"
+#include "woj/bitset.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
+// persistent_bitset checked against a std::vector<bool> model per version, updates must leave the old versions unchanged
+
+namespace
+{
+    std::mt19937_64 rng(2026);
+
+    bool matches(const woj::persistent_bitset& bits, const std::vector<bool>& model)
+    {
+        if (bits.size() != model.size() || bits.count() != static_cast<std::size_t>(std::count(model.begin(), model.end(), true)))
+            return false;
+        if (bits.any() == bits.none() || bits.any() != (bits.count() != 0))
+            return false;
+        const woj::dynamic_bitset<std::uint64_t> copy = bits.to_dynamic_bitset();
+        if (copy.size() != model.size())
+            return false;
+        for (std::size_t i = 0; i < model.size(); ++i)
+        {
+            if (bits.test(i) != model[i] || bits[i] != model[i] || copy.test(i) != model[i])
+                return false;
+        }
+
+        // Walking the set bits visits exactly those of the model
+        std::size_t expected = static_cast<std::size_t>(std::find(model.begin(), model.end(), true) - model.begin());
+        for (std::size_t i = bits.find_first(); i < bits.size(); i = bits.find_next(i + 1))
+        {
+            if (i != expected)
+                return false;
+            expected = static_cast<std::size_t>(std::find(model.begin() + static_cast<std::ptrdiff_t>(i) + 1, model.end(), true) - model.begin());
+        }
+        return expected == model.size() && bits.find_next(model.size()) == model.size();
+    }
+
+    std::vector<std::size_t> model_diff(const std::vector<bool>& lhs, const std::vector<bool>& rhs)
+    {
+        std::vector<std::size_t> result;
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+        {
+            if (lhs[i] != rhs[i])
+                result.push_back(i);
+        }
+        return result;
+    }
+
+    /**
+     * Indices clustered in a few leaves, so that leaves and whole paths become empty and get removed again
+     */
+    std::size_t random_index(const std::size_t size)
+    {
+        const std::size_t leaf = woj::persistent_bitset::leaf_type::size();
+        const std::size_t leaves = (size + leaf - 1) / leaf;
+        const std::size_t index = rng() % (std::min)(leaves, std::size_t{ 5 }) * (leaves / 5 + 1) * leaf + rng() % 40;
+        return index < size ? index : rng() % size;
+    }
+
+    // A chain of versions, every one compared with its model after all the later updates
+    void versions(const std::size_t size)
+    {
+        std::vector<woj::persistent_bitset> chain{ woj::persistent_bitset(size) };
+        std::vector<std::vector<bool>> models{ std::vector<bool>(size) };
+        WOJ_CHECK(matches(chain[0], models[0]) && chain[0].find_first() == size);
+
+        for (int round = 0; round < 300; ++round)
+        {
+            const woj::persistent_bitset& last = chain.back();
+            std::vector<bool> model = models.back();
+            const std::size_t index = random_index(size);
+            woj::persistent_bitset next;
+            switch (rng() % 3)
+            {
+            case 0:
+                next = last.set(index);
+                model[index] = true;
+                break;
+            case 1:
+                next = last.reset(index);
+                model[index] = false;
+                break;
+            default:
+                next = last.flip(index);
+                model[index] = !model[index];
+                break;
+            }
+
+            // Setting a bit to the value it has keeps the version
+            WOJ_CHECK(next.set(index, model[index]).shares_root(next));
+            chain.push_back(next);
+            models.push_back(model);
+        }
+
+        bool unchanged = true;
+        for (std::size_t i = 0; i < chain.size(); ++i)
+            unchanged &= matches(chain[i], models[i]);
+        WOJ_CHECK(unchanged);
+
+        // diff and == between random pairs of versions
+        bool same = true;
+        for (int pair = 0; pair < 60; ++pair)
+        {
+            const std::size_t lhs = rng() % chain.size(), rhs = rng() % chain.size();
+            const std::vector<std::size_t> expected = model_diff(models[lhs], models[rhs]);
+            same &= chain[lhs].diff(chain[rhs]) == expected && chain[rhs].diff(chain[lhs]) == expected;
+            std::vector<std::size_t> visited;
+            chain[lhs].for_each_difference(chain[rhs], [&visited](const std::size_t index) { visited.push_back(index); });
+            same &= visited == expected;
+            same &= (chain[lhs] == chain[rhs]) == expected.empty();
+        }
+        WOJ_CHECK(same);
+
+        // Emptying every bit removes the whole tree
+        woj::persistent_bitset empty = chain.back();
+        for (std::size_t i = empty.find_first(); i < size; i = empty.find_next(i))
+            empty = empty.reset(i);
+        WOJ_CHECK(empty.none() && empty == woj::persistent_bitset(size) && empty.shares_root(woj::persistent_bitset(size)));
+        WOJ_CHECK(matches(chain.back(), models.back()));
+    }
+
+    template <typename Op>
+    std::vector<bool> combined(const std::vector<bool>& lhs, const std::vector<bool>& rhs, Op op)
+    {
+        std::vector<bool> result(lhs.size());
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+            result[i] = op(lhs[i], rhs[i]);
+        return result;
+    }
+
+    // Conversion from a dynamic_bitset, and &, |, ^ between unrelated versions and between versions sharing nodes
+    void operators(const std::size_t size)
+    {
+        woj::dynamic_bitset<std::uint64_t> source(size);
+        std::vector<bool> lhs_model(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            // Mostly empty leaves with a few dense ones
+            lhs_model[i] = i / 512 % 3 == 0 ? rng() & 1 : rng() % 300 == 0;
+            source.set(i, lhs_model[i]);
+        }
+        if (size % 64)
+            source.get_block(size / 64) |= ~std::uint64_t{ 0 } << size % 64;
+        const woj::persistent_bitset lhs(source);
+        WOJ_CHECK(matches(lhs, lhs_model));
+
+        woj::persistent_bitset rhs = lhs;
+        std::vector<bool> rhs_model = lhs_model;
+        for (int op = 0; op < 50; ++op)
+        {
+            const std::size_t index = random_index(size);
+            rhs = rhs.flip(index);
+            rhs_model[index] = !rhs_model[index];
+        }
+
+        woj::persistent_bitset other(size);
+        std::vector<bool> other_model(size);
+        for (int op = 0; op < 200; ++op)
+        {
+            const std::size_t index = rng() % size;
+            other = other.set(index);
+            other_model[index] = true;
+        }
+
+        for (const auto& [operand, operand_model] : { std::pair{ &rhs, &rhs_model }, std::pair{ &other, &other_model } })
+        {
+            WOJ_CHECK(matches(lhs & *operand, combined(lhs_model, *operand_model, std::bit_and<>())));
+            WOJ_CHECK(matches(lhs | *operand, combined(lhs_model, *operand_model, std::bit_or<>())));
+            WOJ_CHECK(matches(lhs ^ *operand, combined(lhs_model, *operand_model, std::bit_xor<>())));
+            WOJ_CHECK((lhs ^ *operand).diff(woj::persistent_bitset(size)) == model_diff(lhs_model, *operand_model));
+        }
+        WOJ_CHECK((lhs & lhs).shares_root(lhs) && (lhs | lhs).shares_root(lhs) && (lhs ^ lhs).none());
+        WOJ_CHECK((lhs | woj::persistent_bitset(size)).shares_root(lhs) && (lhs & woj::persistent_bitset(size)).none());
+        WOJ_CHECK(matches(lhs, lhs_model) && matches(rhs, rhs_model) && matches(other, other_model));
+    }
+}
+
+int main()
+{
+    for (const std::size_t size : { 1, 100, 511, 512, 513, 32768, 32769, 300000 })
+    {
+        versions(size);
+        operators(size);
+    }
+    WOJ_CHECK(woj::persistent_bitset(512).height() == 0 && woj::persistent_bitset(513).height() == 1 && woj::persistent_bitset(32769).height() == 2);
+    WOJ_CHECK(woj::persistent_bitset().size() == 0 && woj::persistent_bitset().find_first() == 0);
+    return woj::test::report();
+}
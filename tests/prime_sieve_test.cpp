@@ -0,0 +1,58 @@
+#include "test.hpp"
+#include "woj/prime_sieve.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// prime_sieve checked against a plain sieve of Eratosthenes, single and multi-threaded
+
+namespace
+{
+    std::vector<std::uint64_t> naive_primes(const std::uint64_t limit)
+    {
+        std::vector<bool> composite(limit + 1);
+        std::vector<std::uint64_t> primes;
+        for (std::uint64_t i = 2; i <= limit; ++i)
+        {
+            if (composite[i])
+                continue;
+            primes.push_back(i);
+            for (std::uint64_t j = i * i; j <= limit; j += i)
+                composite[j] = true;
+        }
+        return primes;
+    }
+
+    /**
+     * Compares primes() and count() with 1, several and the hardware count of threads against the plain sieve
+     */
+    void sieve(const std::uint64_t limit)
+    {
+        const std::vector<std::uint64_t> expected = naive_primes(limit);
+        const woj::prime_sieve sieve(limit);
+        WOJ_CHECK(sieve.limit() == limit);
+        WOJ_CHECK(sieve.primes() == expected);
+        WOJ_CHECK(sieve.count(1) == expected.size());
+        WOJ_CHECK(sieve.count(3) == expected.size());
+        WOJ_CHECK(sieve.count(0) == expected.size());
+    }
+}
+
+int main()
+{
+    // The wheel primes 3 to 13 are restored in the first segment only up to the limit
+    for (std::uint64_t limit = 0; limit <= 14; ++limit)
+        sieve(limit);
+
+    // One segment holds the odd numbers below 2 * segment_size
+    constexpr std::uint64_t boundary = 2 * woj::prime_sieve::segment_size;
+    for (const std::uint64_t limit : { boundary - 1, boundary, boundary + 1 })
+        sieve(limit);
+
+    // Several segments, and the known count of primes below 10^6
+    sieve(1000000);
+    WOJ_CHECK(woj::prime_sieve(1000000).count(4) == 78498);
+
+    return woj::test::report();
+}
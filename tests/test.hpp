@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdio>
+
+// Minimal self-contained check harness used by the woj::bitset tests
+
+namespace woj::test
+{
+    /**
+     * Count of failed checks of the running test
+     * @return Reference to the counter
+     */
+    inline int& failures() noexcept
+    {
+        static int count = 0;
+        return count;
+    }
+
+    /**
+     * Records the result of a check, printing the failed ones
+     * @param condition Result of the check
+     * @param expression Text of the checked expression
+     * @param file File of the check
+     * @param line Line of the check
+     */
+    inline void check(const bool condition, const char* expression, const char* file, const int line) noexcept
+    {
+        if (condition)
+            return;
+        ++failures();
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+    }
+
+    /**
+     * Prints the count of failed checks
+     * @return Exit code of the test (0 if every check passed)
+     */
+    inline int report() noexcept
+    {
+        if (failures())
+            std::fprintf(stderr, "%d check(s) failed\n", failures());
+        return failures() ? 1 : 0;
+    }
+}
+
+#define WOJ_CHECK(...) ::woj::test::check(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
@@ -0,0 +1,132 @@
+#include "test.hpp"
+#include "woj/bitset.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+// Bit matrix transposition checked against an element-wise transpose
+
+namespace
+{
+    std::mt19937_64 rng(2026);
+
+    void transpose_8x8()
+    {
+        for (int round = 0; round < 1000; ++round)
+        {
+            const std::uint64_t matrix = round < 2 ? (round ? ~std::uint64_t{ 0 } : 0) : rng();
+            const std::uint64_t transposed = woj::transpose_8x8(matrix);
+
+            std::uint64_t expected = 0;
+            for (std::size_t i = 0; i < 8; ++i)
+            {
+                for (std::size_t j = 0; j < 8; ++j)
+                    expected |= (matrix >> (i * 8 + j) & 1) << (j * 8 + i);
+            }
+            WOJ_CHECK(transposed == expected);
+            WOJ_CHECK(woj::transpose_8x8(transposed) == matrix);
+        }
+    }
+
+    /**
+     * Transposes random square matrices of one word per row
+     */
+    template <typename Word, typename Transpose>
+    void transpose_square(Transpose&& transpose)
+    {
+        constexpr std::size_t size = sizeof(Word) * 8;
+
+        for (int round = 0; round < 200; ++round)
+        {
+            Word rows[size];
+            for (Word& row : rows)
+                row = static_cast<Word>(rng());
+            Word transposed[size];
+            std::copy(rows, rows + size, transposed);
+            transpose(transposed);
+
+            bool matches = true;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                for (std::size_t j = 0; j < size; ++j)
+                    matches &= (rows[i] >> j & 1) == (transposed[j] >> i & 1);
+            }
+            WOJ_CHECK(matches);
+
+            transpose(transposed);
+            WOJ_CHECK(std::equal(rows, rows + size, transposed));
+        }
+    }
+
+    /**
+     * Transposes a span of count rows of Size bits, with a dirty tail past Size in every row
+     */
+    template <std::size_t Size>
+    void transpose_span(const std::size_t count)
+    {
+        std::vector<woj::bitset<std::uint64_t, Size>> rows(count);
+        for (auto& row : rows)
+        {
+            for (std::size_t i = 0; i < Size; ++i)
+                row.set(i, rng() & 1);
+            if (Size % 64)
+                row.data()[Size / 64] |= ~std::uint64_t{ 0 } << Size % 64;
+        }
+
+        const auto columns = woj::transpose(std::span<const woj::bitset<std::uint64_t, Size>>(rows));
+        WOJ_CHECK(columns.size() == Size);
+
+        bool matches = true;
+        for (std::size_t c = 0; c < columns.size(); ++c)
+        {
+            matches &= columns[c].size() == count;
+            for (std::size_t r = 0; r < count; ++r)
+                matches &= columns[c].test(r) == rows[r].test(c);
+            matches &= columns[c].count() == static_cast<std::size_t>(std::count_if(rows.begin(), rows.end(), [c](const auto& row) { return row.test(c); }));
+        }
+        WOJ_CHECK(matches);
+
+        // Fixed extent spans take the same path
+        if (count == 3)
+        {
+            const auto fixed = woj::transpose(std::span<const woj::bitset<std::uint64_t, Size>, 3>(rows.data(), 3));
+            WOJ_CHECK(fixed == columns);
+        }
+    }
+
+    template <std::size_t Size>
+    void transpose_spans()
+    {
+        for (const std::size_t count : { 0, 1, 3, 63, 64, 65, 130, 200 })
+            transpose_span<Size>(count);
+    }
+}
+
+int main()
+{
+    transpose_8x8();
+    transpose_square<std::uint32_t>([](std::uint32_t (&rows)[32]) { woj::transpose_32x32(rows); });
+    transpose_square<std::uint64_t>([](std::uint64_t (&rows)[64]) { woj::transpose_64x64(rows); });
+
+    transpose_spans<1>();
+    transpose_spans<63>();
+    transpose_spans<64>();
+    transpose_spans<65>();
+    transpose_spans<100>();
+    transpose_spans<192>();
+    transpose_spans<200>();
+
+    // The helpers are constexpr
+    static_assert(woj::transpose_8x8(0x0000000000000002ull) == 0x0000000000000100ull);
+    static_assert([] {
+        std::uint64_t rows[64] = {};
+        rows[3] = std::uint64_t{ 1 } << 60;
+        woj::transpose_64x64(rows);
+        return rows[60] == std::uint64_t{ 1 } << 3;
+    }());
+    return woj::test::report();
+}